@@ -0,0 +1,59 @@
+/***********************************************************************
+ActiveCellIndex - Abstract base class for indices of a data set's cells
+by their ranges of scalar values, to speed up repeated global isosurface
+extraction.
+Part of the abstract interface to the templatized visualization
+components.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_ABSTRACT_ACTIVECELLINDEX_INCLUDED
+#define VISUALIZATION_ABSTRACT_ACTIVECELLINDEX_INCLUDED
+
+#include <stddef.h>
+
+namespace Visualization {
+
+namespace Abstract {
+
+class ActiveCellIndex
+	{
+	/* Constructors and destructors: */
+	public:
+	ActiveCellIndex(void) // Default constructor
+		{
+		}
+	private:
+	ActiveCellIndex(const ActiveCellIndex& source); // Prohibit copy constructor
+	ActiveCellIndex& operator=(const ActiveCellIndex& source); // Prohibit assignment operator
+	public:
+	virtual ~ActiveCellIndex(void) // Destructor
+		{
+		}
+	
+	/* Methods: */
+	virtual size_t getNumCells(void) const =0; // Returns the number of indexed cells
+	virtual size_t getMemorySize(void) const =0; // Returns the number of bytes of memory used by the index
+	};
+
+}
+
+}
+
+#endif
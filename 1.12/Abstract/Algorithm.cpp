@@ -51,6 +51,9 @@ Algorithm::~Algorithm(void)
 	
 	/* Delete the busy function: */
 	delete busyFunction;
+	
+	/* Release the scalar and vector extractors used by the algorithm: */
+	variableReferences.release();
 	}
 
 void Algorithm::setBusyFunction(Algorithm::BusyFunction* newBusyFunction)
@@ -124,6 +127,16 @@ void Algorithm::continueSlaveElement(void)
 	/* Just don't do anything */
 	}
 
+Element* Algorithm::readElement(Parameters* extractParameters,IO::SeekableFile& file)
+	{
+	/* Inherit the parameters object: */
+	delete extractParameters;
+	
+	/* Signal an error: */
+	Misc::throwStdErr("Algorithm: No element geometry reading method defined");
+	return 0;
+	}
+
 }
 
 }
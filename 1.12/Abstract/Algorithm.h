@@ -28,6 +28,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Misc/FunctionCalls.h>
 
 #include <Abstract/DataSet.h>
+#include <Abstract/VariableReferences.h>
 
 /* Forward declarations: */
 namespace Realtime {
@@ -36,6 +37,10 @@ class AlarmTimer;
 namespace Cluster {
 class MulticastPipe;
 }
+namespace IO {
+class File;
+class SeekableFile;
+}
 namespace GLMotif {
 class WidgetManager;
 class Widget;
@@ -43,6 +48,8 @@ class Widget;
 namespace Visualization {
 namespace Abstract {
 class VariableManager;
+class ScalarExtractor;
+class VectorExtractor;
 class Parameters;
 class ParametersSource;
 class Element;
@@ -65,6 +72,7 @@ class Algorithm
 	Cluster::MulticastPipe* pipe; // Multicast pipe to synchronize element extraction in a cluster-based environment; created externally but owned by Algorithm object
 	bool master; // Flag if this instance of the algorithm runs on the master node of a visualization cluster
 	BusyFunction* busyFunction; // Function called at regular intervals during a long-running operation
+	VariableReferences variableReferences; // References to the scalar and vector extractors used by the algorithm
 	
 	/* Constructors and destructors: */
 	public:
@@ -88,6 +96,14 @@ class Algorithm
 		{
 		return master;
 		}
+	const ScalarExtractor* getScalarExtractor(int scalarVariableIndex) // Returns the extractor for the given scalar variable and holds it until the algorithm is destroyed
+		{
+		return variableReferences.getScalarExtractor(variableManager,scalarVariableIndex);
+		}
+	const VectorExtractor* getVectorExtractor(int vectorVariableIndex) // Returns the extractor for the given vector variable and holds it until the algorithm is destroyed
+		{
+		return variableReferences.getVectorExtractor(variableManager,vectorVariableIndex);
+		}
 	void setBusyFunction(BusyFunction* newBusyFunction); // Sets the busy function; object inherits function call object
 	void callBusyFunction(float completionPercentage) // Calls the busy function with a new percentage value
 		{
@@ -108,6 +124,7 @@ class Algorithm
 	virtual void finishElement(void); // Cleans up after an element has been created
 	virtual Element* startSlaveElement(Parameters* extractParameters) =0; // Starts creating a visualization element on the slave node(s) of a cluster environment; inherits parameter object
 	virtual void continueSlaveElement(void); // Receives a fragment of a visualization element on the slave node(s) of a cluster environment
+	virtual Element* readElement(Parameters* extractParameters,IO::SeekableFile& file); // Creates a visualization element from geometry written by the element's writeGeometry method, and streams it to the slave node(s) of a cluster environment; inherits parameter object
 	};
 
 }
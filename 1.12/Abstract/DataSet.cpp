@@ -61,6 +61,42 @@ bool DataSet::Locator::setOrientation(const DataSet::Orientation& newOrientation
 	return result;
 	}
 
+size_t DataSet::Locator::calcScalars(const ScalarExtractor* scalarExtractor,size_t numPoints,const DataSet::Point* points,DataSet::VScalar* values,bool* valids)
+	{
+	/* Evaluate the points one at a time: */
+	size_t numValid=0;
+	for(size_t i=0;i<numPoints;++i)
+		{
+		setPosition(points[i]);
+		valids[i]=isValid();
+		if(valids[i])
+			{
+			values[i]=calcScalar(scalarExtractor);
+			++numValid;
+			}
+		}
+	
+	return numValid;
+	}
+
+size_t DataSet::Locator::calcVectors(const VectorExtractor* vectorExtractor,size_t numPoints,const DataSet::Point* points,DataSet::VVector* values,bool* valids)
+	{
+	/* Evaluate the points one at a time: */
+	size_t numValid=0;
+	for(size_t i=0;i<numPoints;++i)
+		{
+		setPosition(points[i]);
+		valids[i]=isValid();
+		if(valids[i])
+			{
+			values[i]=calcVector(vectorExtractor);
+			++numValid;
+			}
+		}
+	
+	return numValid;
+	}
+
 /************************
 Methods of class DataSet:
 ************************/
@@ -88,6 +124,17 @@ ScalarExtractor* DataSet::getScalarExtractor(int scalarVariableIndex) const
 	return 0;
 	}
 
+void DataSet::releaseScalarExtractor(int scalarVariableIndex) const
+	{
+	/* Data sets keep all variables in memory by default: */
+	}
+
+ActiveCellIndex* DataSet::createActiveCellIndex(const ScalarExtractor* scalarExtractor,bool compactOnly) const
+	{
+	/* Data sets cannot be indexed by default: */
+	return 0;
+	}
+
 int DataSet::getNumVectorVariables(void) const
 	{
 	return 0;
@@ -105,6 +152,11 @@ VectorExtractor* DataSet::getVectorExtractor(int vectorVariableIndex) const
 	return 0;
 	}
 
+void DataSet::releaseVectorExtractor(int vectorVariableIndex) const
+	{
+	/* Data sets keep all variables in memory by default: */
+	}
+
 }
 
 }
@@ -24,6 +24,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_ABSTRACT_DATASET_INCLUDED
 #define VISUALIZATION_ABSTRACT_DATASET_INCLUDED
 
+#include <stddef.h>
 #include <utility>
 #include <Geometry/Point.h>
 #include <Geometry/Rotation.h>
@@ -37,6 +38,8 @@ namespace Visualization {
 namespace Abstract {
 class DataValue;
 class CoordinateTransformer;
+class ActiveCellIndex;
+class ValueStatistics;
 }
 }
 
@@ -89,6 +92,8 @@ class DataSet
 		virtual bool isValid(void) const =0; // Returns true if the locator is inside the data set's domain
 		virtual VScalar calcScalar(const ScalarExtractor* scalarExtractor) const =0; // Calculates scalar value at current locator position (locator must be valid)
 		virtual VVector calcVector(const VectorExtractor* vectorExtractor) const =0; // Calculates vector value at current locator position (locator must be valid)
+		virtual size_t calcScalars(const ScalarExtractor* scalarExtractor,size_t numPoints,const Point* points,VScalar* values,bool* valids); // Moves the locator through the given array of points and calculates scalar values at all points inside the data set's domain; sets each point's valid flag and returns the number of valid points; leaves the locator at the last point
+		virtual size_t calcVectors(const VectorExtractor* vectorExtractor,size_t numPoints,const Point* points,VVector* values,bool* valids); // Ditto for vector values
 		};
 	
 	/* Constructors and destructors: */
@@ -112,11 +117,16 @@ class DataSet
 	virtual int getNumScalarVariables(void) const; // Returns number of scalar variables contained in the data set
 	virtual const char* getScalarVariableName(int scalarVariableIndex) const; // Returns descriptive name of a scalar variable
 	virtual ScalarExtractor* getScalarExtractor(int scalarVariableIndex) const; // Returns scalar extractor for a scalar variable
+	virtual void releaseScalarExtractor(int scalarVariableIndex) const; // Notifies the data set that a scalar extractor returned by getScalarExtractor for the given scalar variable has been deleted
 	virtual VScalarRange calcScalarValueRange(const ScalarExtractor* scalarExtractor) const =0; // Calculates the range of scalar values extracted by the given extractor
+	virtual void calcScalarValueStatistics(const ScalarExtractor* scalarExtractor,ValueStatistics& statistics) const =0; // Calculates the range, mean, and histogram of scalar values extracted by the given extractor
+	virtual ActiveCellIndex* createActiveCellIndex(const ScalarExtractor* scalarExtractor,bool compactOnly) const; // Returns a new index of the data set's cells by their ranges of scalar values extracted by the given extractor, or 0 if the data set cannot be indexed or only has a non-compact index and compactOnly is true
 	virtual int getNumVectorVariables(void) const; // Returns number of vector variables contained in the data set
 	virtual const char* getVectorVariableName(int vectorVariableIndex) const; // Returns descriptive name of a vector variable
 	virtual VectorExtractor* getVectorExtractor(int vectorVariableIndex) const; // Returns vector extractor for a vector variable
+	virtual void releaseVectorExtractor(int vectorVariableIndex) const; // Notifies the data set that a vector extractor returned by getVectorExtractor for the given vector variable has been deleted
 	virtual VScalarRange calcVectorValueMagnitudeRange(const VectorExtractor* vectorExtractor) const =0; // Calculates the magnitude range of vector values extracted by the given extractor
+	virtual void calcVectorValueMagnitudeStatistics(const VectorExtractor* vectorExtractor,ValueStatistics& statistics) const =0; // Calculates the range, mean, and histogram of magnitudes of vector values extracted by the given extractor
 	virtual Locator* getLocator(void) const =0; // Returns an invalid locator for the data set
 	};
 
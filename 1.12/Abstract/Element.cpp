@@ -25,6 +25,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Abstract/Element.h>
 
+#include <Misc/ThrowStdErr.h>
+
 #include <Abstract/Parameters.h>
 
 namespace Visualization {
@@ -41,6 +43,22 @@ Element::~Element(void)
 	delete parameters;
 	}
 
+size_t Element::getMemorySize(void) const
+	{
+	return 0;
+	}
+
+bool Element::canWriteGeometry(void) const
+	{
+	return false;
+	}
+
+void Element::writeGeometry(IO::File& file) const
+	{
+	/* Signal an error: */
+	Misc::throwStdErr("Element: No geometry writing method defined");
+	}
+
 bool Element::usesTransparency(void) const
 	{
 	return false;
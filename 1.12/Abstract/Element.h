@@ -33,6 +33,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 namespace Misc {
 class File;
 }
+namespace IO {
+class File;
+}
 namespace GLMotif {
 class WidgetManager;
 class Widget;
@@ -79,6 +82,9 @@ class Element:public Threads::RefCounted
 		}
 	virtual std::string getName(void) const =0; // Returns a descriptive name for the visualization element
 	virtual size_t getSize(void) const =0; // Returns some size value for the visualization element to compare it to other elements of the same type (number of triangles, points, etc.)
+	virtual size_t getMemorySize(void) const; // Returns the approximate amount of memory in bytes held by the visualization element's geometry
+	virtual bool canWriteGeometry(void) const; // Returns true if the visualization element can write its geometry to a binary file
+	virtual void writeGeometry(IO::File& file) const; // Writes the visualization element's geometry to a binary file
 	virtual bool usesTransparency(void) const; // Returns true if the visualization element uses transparency (and needs to be rendered last)
 	virtual GLMotif::Widget* createSettingsDialog(GLMotif::WidgetManager* widgetManager); // Returns a new UI widget to change internal settings of the element
 	virtual void glRenderAction(GLRenderState& renderState) const =0; // Renders a visualization element into the given OpenGL context
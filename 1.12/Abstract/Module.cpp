@@ -26,11 +26,18 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Abstract/Module.h>
 
 #include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <algorithm>
 #include <Misc/ThrowStdErr.h>
 #include <IO/OpenFile.h>
 #include <Cluster/MulticastPipe.h>
 #include <Cluster/OpenFile.h>
 
+#include <Templatized/CompressedPipe.h>
+#include <Templatized/CompressedPipeFile.h>
+
 namespace Visualization {
 
 namespace Abstract {
@@ -73,7 +80,11 @@ std::string Module::getFullPath(std::string fileName) const
 
 IO::FilePtr Module::openFile(std::string fileName,Cluster::MulticastPipe* pipe) const
 	{
-	if(pipe!=0)
+	addSourceFile(fileName);
+	
+	if(pipe!=0&&Templatized::CompressedPipe::isCompressing())
+		return new Templatized::CompressedPipeFile(pipe->getMultiplexer(),getFullPath(fileName).c_str());
+	else if(pipe!=0)
 		return Cluster::openFile(pipe->getMultiplexer(),getFullPath(fileName).c_str());
 	else
 		return IO::openFile(getFullPath(fileName).c_str());
@@ -81,12 +92,20 @@ IO::FilePtr Module::openFile(std::string fileName,Cluster::MulticastPipe* pipe)
 
 IO::SeekableFilePtr Module::openSeekableFile(std::string fileName,Cluster::MulticastPipe* pipe) const
 	{
+	addSourceFile(fileName);
+	
 	if(pipe!=0)
 		return Cluster::openSeekableFile(pipe->getMultiplexer(),getFullPath(fileName).c_str());
 	else
 		return IO::openSeekableFile(getFullPath(fileName).c_str());
 	}
 
+void Module::addSourceFile(std::string fileName,bool relativeToBaseDirectory) const
+	{
+	Threads::Mutex::Lock sourceFileNamesLock(sourceFileNamesMutex);
+	sourceFileNames.push_back(relativeToBaseDirectory?getFullPath(fileName):fileName);
+	}
+
 Module::Module(const char* sClassName)
 	:Plugins::Factory(sClassName),
 	 baseDirectory("")
@@ -107,6 +126,42 @@ void Module::setBaseDirectory(std::string newBaseDirectory)
 		baseDirectory.push_back('/');
 	}
 
+std::vector<std::string> Module::getSourceFiles(void) const
+	{
+	Threads::Mutex::Lock sourceFileNamesLock(sourceFileNamesMutex);
+	return sourceFileNames;
+	}
+
+std::string Module::getDataSetKey(const std::vector<std::string>& args) const
+	{
+	/* Start the key with the module class name and all module arguments: */
+	std::string result=getClassName();
+	result.push_back('\n');
+	for(std::vector<std::string>::const_iterator aIt=args.begin();aIt!=args.end();++aIt)
+		{
+		result.append(*aIt);
+		result.push_back('\n');
+		}
+	
+	/* Append the sizes and modification times of all source files in a canonical order: */
+	std::vector<std::string> sortedSourceFileNames=getSourceFiles();
+	std::sort(sortedSourceFileNames.begin(),sortedSourceFileNames.end());
+	sortedSourceFileNames.erase(std::unique(sortedSourceFileNames.begin(),sortedSourceFileNames.end()),sortedSourceFileNames.end());
+	for(std::vector<std::string>::iterator sfIt=sortedSourceFileNames.begin();sfIt!=sortedSourceFileNames.end();++sfIt)
+		{
+		struct stat fileStats;
+		if(stat(sfIt->c_str(),&fileStats)==0)
+			{
+			char stamp[64];
+			snprintf(stamp,sizeof(stamp)," %.0f %.0f\n",double(fileStats.st_size),double(fileStats.st_mtime));
+			result.append(*sfIt);
+			result.append(stamp);
+			}
+		}
+	
+	return result;
+	}
+
 int Module::getNumScalarAlgorithms(void) const
 	{
 	return 0;
@@ -28,6 +28,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <string>
 #include <vector>
+#include <Threads/Mutex.h>
 #include <Plugins/Factory.h>
 #include <IO/File.h>
 #include <IO/SeekableFile.h>
@@ -57,13 +58,16 @@ class Module:public Plugins::Factory
 	/* Elements: */
 	private:
 	std::string baseDirectory; // Base directory for all input files
+	mutable Threads::Mutex sourceFileNamesMutex; // Mutex serializing access to the list of source files from concurrent loader threads
+	mutable std::vector<std::string> sourceFileNames; // Full names of all files opened through the module
 	
 	/* Protected methods: */
 	protected:
 	static std::string makeVectorSliceName(std::string vectorName,int sliceIndex); // Creates a scalar slice name for a vector component
 	std::string getFullPath(std::string fileName) const; // Returns the full path name of the given file relative to the base directory
-	IO::FilePtr openFile(std::string fileName,Cluster::MulticastPipe* pipe) const; // Opens the given file relative to the base directory
+	IO::FilePtr openFile(std::string fileName,Cluster::MulticastPipe* pipe) const; // Opens the given file relative to the base directory; in a cluster, the file is read on the master node and streamed to the slave nodes, compressed if pipe compression is enabled
 	IO::SeekableFilePtr openSeekableFile(std::string fileName,Cluster::MulticastPipe* pipe) const; // Ditto, for seekable files
+	void addSourceFile(std::string fileName,bool relativeToBaseDirectory=true) const; // Records a file as a source of the loaded data set; called by openFile and openSeekableFile, and by modules opening files by other means
 	
 	/* Constructors and destructors: */
 	public:
@@ -76,6 +80,8 @@ class Module:public Plugins::Factory
 	
 	/* Methods: */
 	void setBaseDirectory(std::string newBaseDirectory); // Sets the base directory for all following file operations
+	std::vector<std::string> getSourceFiles(void) const; // Returns the full names of all files read by the module so far
+	std::string getDataSetKey(const std::vector<std::string>& args) const; // Returns a key identifying a data set loaded from the given arguments by the module's class name, the arguments, and the sizes and modification times of all files read by the module so far
 	virtual DataSet* load(const std::vector<std::string>& args,Cluster::MulticastPipe* pipe) const =0; // Loads a data set from the given list of arguments
 	virtual DataSetRenderer* getRenderer(const DataSet* dataSet) const =0; // Creates a renderer for the given data set
 	virtual int getNumScalarAlgorithms(void) const; // Returns number of available visualization algorithms
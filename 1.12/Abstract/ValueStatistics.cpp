@@ -0,0 +1,95 @@
+/***********************************************************************
+ValueStatistics - Class to represent the range, mean, and histogram of
+the scalar values or vector magnitudes of a data set's variable.
+Part of the abstract interface to the templatized visualization
+components.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Abstract/ValueStatistics.h>
+
+#include <Misc/ThrowStdErr.h>
+#include <Misc/File.h>
+
+namespace Visualization {
+
+namespace Abstract {
+
+/********************************
+Methods of class ValueStatistics:
+********************************/
+
+ValueStatistics::ValueStatistics(void)
+	:numValues(0),
+	 range(VScalar(0),VScalar(0)),
+	 mean(0.0)
+	{
+	for(int i=0;i<numBins;++i)
+		bins[i]=0;
+	}
+
+size_t ValueStatistics::getMaxBin(void) const
+	{
+	size_t result=0;
+	for(int i=0;i<numBins;++i)
+		if(result<bins[i])
+			result=bins[i];
+	return result;
+	}
+
+void ValueStatistics::setValues(size_t newNumValues,const ValueStatistics::VScalarRange& newRange,double newMean)
+	{
+	numValues=newNumValues;
+	range=newRange;
+	mean=newMean;
+	}
+
+void ValueStatistics::read(Misc::File& file)
+	{
+	/* Read the number of values, range, and mean: */
+	numValues=size_t(file.read<double>());
+	range.first=VScalar(file.read<double>());
+	range.second=VScalar(file.read<double>());
+	mean=file.read<double>();
+	
+	/* Read the histogram: */
+	int fileNumBins=file.read<int>();
+	if(fileNumBins!=numBins)
+		Misc::throwStdErr("ValueStatistics::read: Mismatching number of histogram bins %d",fileNumBins);
+	for(int i=0;i<numBins;++i)
+		bins[i]=size_t(file.read<double>());
+	}
+
+void ValueStatistics::write(Misc::File& file) const
+	{
+	/* Write the number of values, range, and mean: */
+	file.write<double>(double(numValues));
+	file.write<double>(double(range.first));
+	file.write<double>(double(range.second));
+	file.write<double>(mean);
+	
+	/* Write the histogram: */
+	file.write<int>(numBins);
+	for(int i=0;i<numBins;++i)
+		file.write<double>(double(bins[i]));
+	}
+
+}
+
+}
@@ -0,0 +1,91 @@
+/***********************************************************************
+ValueStatistics - Class to represent the range, mean, and histogram of
+the scalar values or vector magnitudes of a data set's variable.
+Part of the abstract interface to the templatized visualization
+components.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_ABSTRACT_VALUESTATISTICS_INCLUDED
+#define VISUALIZATION_ABSTRACT_VALUESTATISTICS_INCLUDED
+
+#include <stddef.h>
+#include <utility>
+#include <Abstract/ScalarExtractor.h>
+
+/* Forward declarations: */
+namespace Misc {
+class File;
+}
+
+namespace Visualization {
+
+namespace Abstract {
+
+class ValueStatistics
+	{
+	/* Embedded classes: */
+	public:
+	typedef ScalarExtractor::Scalar VScalar; // Scalar value type
+	typedef std::pair<VScalar,VScalar> VScalarRange; // Type for scalar value ranges
+	static const int numBins=256; // Number of histogram bins
+	
+	/* Elements: */
+	private:
+	size_t numValues; // Number of values from which the statistics were calculated
+	VScalarRange range; // Range of values
+	double mean; // Mean value
+	size_t bins[numBins]; // Histogram of values in equal-sized bins covering the value range
+	
+	/* Constructors and destructors: */
+	public:
+	ValueStatistics(void); // Creates statistics of an empty set of values
+	
+	/* Methods: */
+	size_t getNumValues(void) const // Returns the number of values
+		{
+		return numValues;
+		}
+	const VScalarRange& getRange(void) const // Returns the range of values
+		{
+		return range;
+		}
+	double getMean(void) const // Returns the mean value
+		{
+		return mean;
+		}
+	size_t getBin(int binIndex) const // Returns the number of values in the given histogram bin
+		{
+		return bins[binIndex];
+		}
+	size_t* getBins(void) // Returns the histogram bin array
+		{
+		return bins;
+		}
+	size_t getMaxBin(void) const; // Returns the number of values in the fullest histogram bin
+	void setValues(size_t newNumValues,const VScalarRange& newRange,double newMean); // Sets the number of values, value range, and mean value
+	void read(Misc::File& file); // Reads statistics from a binary file
+	void write(Misc::File& file) const; // Writes statistics to a binary file
+	};
+
+}
+
+}
+
+#endif
@@ -25,7 +25,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <string.h>
 #include <stdio.h>
 #include <stdexcept>
+#include <iostream>
+#include <vector>
 #include <Misc/CreateNumberedFileName.h>
+#include <Misc/File.h>
+#include <Math/Math.h>
 #include <GL/gl.h>
 #include <GL/GLContextData.h>
 #include <GL/GLColorMap.h>
@@ -36,6 +40,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Abstract/ScalarExtractor.h>
 #include <Abstract/VectorExtractor.h>
+#include <Abstract/ActiveCellIndex.h>
 
 #include <GLRenderState.h>
 #include <ColorBar.h>
@@ -45,15 +50,27 @@ namespace Visualization {
 
 namespace Abstract {
 
+namespace {
+
+/**************
+Helper objects:
+**************/
+
+const char statisticsCacheHeader[]="Visualizer statistics cache v1.1"; // Identifier at the beginning of statistics cache files
+
+}
+
 /************************************************
 Methods of class VariableManager::ScalarVariable:
 ************************************************/
 
 VariableManager::ScalarVariable::ScalarVariable(void)
-	:scalarExtractor(0),
+	:scalarExtractor(0),numUsers(0),
+	 haveStatistics(false),
 	 colorMap(0),
 	 colorMapVersion(0),
-	 palette(0)
+	 palette(0),
+	 activeCellIndex(0)
 	{
 	}
 
@@ -62,6 +79,21 @@ VariableManager::ScalarVariable::~ScalarVariable(void)
 	delete scalarExtractor;
 	delete colorMap;
 	delete palette;
+	delete activeCellIndex;
+	}
+
+/************************************************
+Methods of class VariableManager::VectorVariable:
+************************************************/
+
+VariableManager::VectorVariable::VectorVariable(void)
+	:vectorExtractor(0),numUsers(0)
+	{
+	}
+
+VariableManager::VectorVariable::~VectorVariable(void)
+	{
+	delete vectorExtractor;
 	}
 
 /******************************************
@@ -91,15 +123,128 @@ VariableManager::DataItem::~DataItem(void)
 Methods of class VariableManager:
 ********************************/
 
+void VariableManager::loadStatisticsCache(void)
+	{
+	try
+		{
+		/* Open the statistics cache file: */
+		Misc::File cacheFile(statisticsCacheFileName.c_str(),"rb",Misc::File::LittleEndian);
+		
+		/* Check the file identifier and the cache key: */
+		char header[sizeof(statisticsCacheHeader)];
+		cacheFile.read<char>(header,sizeof(statisticsCacheHeader));
+		if(memcmp(header,statisticsCacheHeader,sizeof(statisticsCacheHeader))!=0)
+			return;
+		unsigned int keyLength=cacheFile.read<unsigned int>();
+		if(keyLength!=statisticsCacheKey.length())
+			return;
+		std::vector<char> cacheKey(keyLength+1);
+		cacheFile.read<char>(&cacheKey[0],keyLength);
+		if(memcmp(&cacheKey[0],statisticsCacheKey.data(),keyLength)!=0)
+			return;
+		
+		/* Read all cached statistics and assign them to scalar variables by name: */
+		int numEntries=cacheFile.read<int>();
+		for(int entry=0;entry<numEntries;++entry)
+			{
+			int nameLength=cacheFile.read<int>();
+			if(nameLength<0||nameLength>1024)
+				return;
+			std::vector<char> name(nameLength+1);
+			cacheFile.read<char>(&name[0],nameLength);
+			name[nameLength]='\0';
+			ValueStatistics statistics;
+			statistics.read(cacheFile);
+			int scalarVariableIndex=getScalarVariable(&name[0]);
+			if(scalarVariableIndex>=0)
+				{
+				scalarVariables[scalarVariableIndex].statistics=statistics;
+				scalarVariables[scalarVariableIndex].haveStatistics=true;
+				}
+			}
+		}
+	catch(std::runtime_error)
+		{
+		/* Ignore missing or corrupt cache files; the statistics will be recalculated: */
+		}
+	}
+
+void VariableManager::saveStatisticsCache(void) const
+	{
+	try
+		{
+		/* Create the statistics cache file: */
+		Misc::File cacheFile(statisticsCacheFileName.c_str(),"wb",Misc::File::LittleEndian);
+		
+		/* Write the file identifier and the cache key: */
+		cacheFile.write<char>(statisticsCacheHeader,sizeof(statisticsCacheHeader));
+		cacheFile.write<unsigned int>((unsigned int)statisticsCacheKey.length());
+		cacheFile.write<char>(statisticsCacheKey.data(),statisticsCacheKey.length());
+		
+		/* Write the statistics of all scalar variables that have them: */
+		int numEntries=0;
+		for(int i=0;i<numScalarVariables;++i)
+			if(scalarVariables[i].haveStatistics)
+				++numEntries;
+		cacheFile.write<int>(numEntries);
+		for(int i=0;i<numScalarVariables;++i)
+			if(scalarVariables[i].haveStatistics)
+				{
+				const char* name=dataSet->getScalarVariableName(i);
+				int nameLength=int(strlen(name));
+				cacheFile.write<int>(nameLength);
+				cacheFile.write<char>(name,nameLength);
+				scalarVariables[i].statistics.write(cacheFile);
+				}
+		}
+	catch(std::runtime_error err)
+		{
+		std::cerr<<"Could not write statistics cache file "<<statisticsCacheFileName<<" due to exception "<<err.what()<<std::endl;
+		}
+	}
+
 void VariableManager::prepareScalarVariable(int scalarVariableIndex)
 	{
 	ScalarVariable& sv=scalarVariables[scalarVariableIndex];
 	
-	/* Get a new scalar extractor: */
-	sv.scalarExtractor=dataSet->getScalarExtractor(scalarVariableIndex);
-	
-	/* Calculate the scalar extractor's value range: */
-	sv.valueRange=dataSet->calcScalarValueRange(sv.scalarExtractor);
+	if(!sv.haveStatistics)
+		{
+		/* Get a temporary scalar extractor if the variable has no users, which loads the variable's values if the data set defers them: */
+		ScalarExtractor* extractor=sv.scalarExtractor;
+		if(extractor==0)
+			extractor=dataSet->getScalarExtractor(scalarVariableIndex);
+		
+		/* Calculate the scalar extractor's value range, mean, and histogram without blocking access to other variables: */
+		ValueStatistics statistics;
+		try
+			{
+			dataSet->calcScalarValueStatistics(extractor,statistics);
+			}
+		catch(...)
+			{
+			if(extractor!=sv.scalarExtractor)
+				{
+				delete extractor;
+				dataSet->releaseScalarExtractor(scalarVariableIndex);
+				}
+			throw;
+			}
+		
+		/* Delete a temporary scalar extractor: */
+		if(extractor!=sv.scalarExtractor)
+			{
+			delete extractor;
+			dataSet->releaseScalarExtractor(scalarVariableIndex);
+			}
+		
+		/* Store the statistics and update the statistics cache file: */
+		Threads::Mutex::Lock variableLock(variableMutex);
+		sv.statistics=statistics;
+		sv.haveStatistics=true;
+		if(!statisticsCacheFileName.empty()&&(headless||Vrui::isMaster()))
+			saveStatisticsCache();
+		}
+	sv.valueRange=sv.statistics.getRange();
 	
 	/* Create a 256-entry OpenGL color map for rendering: */
 	sv.colorMap=new GLColorMap(GLColorMap::GREYSCALE|GLColorMap::RAMP_ALPHA,1.0f,1.0f,sv.valueRange.first,sv.valueRange.second);
@@ -134,14 +279,15 @@ void VariableManager::savePaletteCallback(Misc::CallbackData* cbData)
 		}
 	}
 
-VariableManager::VariableManager(const DataSet* sDataSet,const char* sDefaultColorMapName)
-	:dataSet(sDataSet),
+VariableManager::VariableManager(const DataSet* sDataSet,const char* sDefaultColorMapName,const char* sStatisticsCacheFileName,const char* sStatisticsCacheKey,bool sHeadless)
+	:dataSet(sDataSet),headless(sHeadless),
 	 defaultColorMapName(0),
 	 scalarVariables(0),
 	 colorBarDialogPopup(0),colorBar(0),
 	 paletteEditor(0),
-	 vectorExtractors(0),
-	 currentScalarVariableIndex(-1),currentVectorVariableIndex(-1)
+	 vectorVariables(0),
+	 currentScalarVariableIndex(-1),currentVectorVariableIndex(-1),
+	 useActiveCellIndices(false)
 	{
 	if(sDefaultColorMapName!=0)
 		{
@@ -156,28 +302,36 @@ VariableManager::VariableManager(const DataSet* sDataSet,const char* sDefaultCol
 	if(numScalarVariables>0)
 		scalarVariables=new ScalarVariable[numScalarVariables];
 	
-	/* Get the style sheet: */
-	const GLMotif::StyleSheet& ss=*Vrui::getWidgetManager()->getStyleSheet();
-	
-	/* Create the color bar dialog: */
-	colorBarDialogPopup=new GLMotif::PopupWindow("ColorBarDialogPopup",Vrui::getWidgetManager(),"Color Bar");
-	
-	/* Create the color bar widget: */
-	colorBar=new GLMotif::ColorBar("ColorBar",colorBarDialogPopup,ss.fontHeight*5.0f,6,5);
+	if(sStatisticsCacheFileName!=0)
+		{
+		/* Load cached scalar variable statistics matching the data set's sources: */
+		statisticsCacheFileName=sStatisticsCacheFileName;
+		if(sStatisticsCacheKey!=0)
+			statisticsCacheKey=sStatisticsCacheKey;
+		loadStatisticsCache();
+		}
 	
-	/* Create the palette editor: */
-	paletteEditor=new PaletteEditor;
-	paletteEditor->getColorMapChangedCallbacks().add(this,&VariableManager::colorMapChangedCallback);
-	paletteEditor->getSavePaletteCallbacks().add(this,&VariableManager::savePaletteCallback);
+	if(!headless)
+		{
+		/* Get the style sheet: */
+		const GLMotif::StyleSheet& ss=*Vrui::getWidgetManager()->getStyleSheet();
+		
+		/* Create the color bar dialog: */
+		colorBarDialogPopup=new GLMotif::PopupWindow("ColorBarDialogPopup",Vrui::getWidgetManager(),"Color Bar");
+		
+		/* Create the color bar widget: */
+		colorBar=new GLMotif::ColorBar("ColorBar",colorBarDialogPopup,ss.fontHeight*5.0f,6,5);
+		
+		/* Create the palette editor: */
+		paletteEditor=new PaletteEditor;
+		paletteEditor->getColorMapChangedCallbacks().add(this,&VariableManager::colorMapChangedCallback);
+		paletteEditor->getSavePaletteCallbacks().add(this,&VariableManager::savePaletteCallback);
+		}
 	
-	/* Initialize the vector extractor array: */
+	/* Initialize the vector variable array: */
 	numVectorVariables=dataSet->getNumVectorVariables();
 	if(numVectorVariables>0)
-		{
-		vectorExtractors=new VectorExtractor*[numVectorVariables];
-		for(int i=0;i<numVectorVariables;++i)
-			vectorExtractors[i]=0;
-		}
+		vectorVariables=new VectorVariable[numVectorVariables];
 	
 	/* Initialize the current variable state: */
 	setCurrentScalarVariable(0);
@@ -189,12 +343,8 @@ VariableManager::~VariableManager(void)
 	delete[] defaultColorMapName;
 	if(scalarVariables!=0)
 		delete[] scalarVariables;
-	if(vectorExtractors!=0)
-		{
-		for(int i=0;i<numVectorVariables;++i)
-			delete vectorExtractors[i];
-		delete[] vectorExtractors;
-		}
+	if(vectorVariables!=0)
+		delete[] vectorVariables;
 	
 	delete colorBarDialogPopup;
 	delete paletteEditor;
@@ -246,17 +396,23 @@ void VariableManager::setCurrentScalarVariable(int newCurrentScalarVariableIndex
 	if(currentScalarVariableIndex==newCurrentScalarVariableIndex||newCurrentScalarVariableIndex<0||newCurrentScalarVariableIndex>=numScalarVariables)
 		return;
 	
-	/* Check if the scalar variable has not been requested before: */
+	/* Hold a reference to the new current scalar variable's extractor, which also prepares the variable if it has not been requested before: */
+	getScalarExtractor(newCurrentScalarVariableIndex);
 	ScalarVariable& sv=scalarVariables[newCurrentScalarVariableIndex];
-	if(sv.scalarExtractor==0)
-		prepareScalarVariable(newCurrentScalarVariableIndex);
 	
 	/* Save the palette editor's current palette: */
-	if(currentScalarVariableIndex>=0)
-		scalarVariables[currentScalarVariableIndex].palette=paletteEditor->getPalette();
+	int oldCurrentScalarVariableIndex=currentScalarVariableIndex;
+	if(oldCurrentScalarVariableIndex>=0&&!headless)
+		scalarVariables[oldCurrentScalarVariableIndex].palette=paletteEditor->getPalette();
 	
 	/* Update the current scalar variable: */
 	currentScalarVariableIndex=newCurrentScalarVariableIndex;
+	if(oldCurrentScalarVariableIndex>=0)
+		releaseScalarExtractor(oldCurrentScalarVariableIndex);
+	
+	/* Headless variable managers have no palette editor or color bar to update: */
+	if(headless)
+		return;
 	
 	if(sv.palette==0)
 		{
@@ -291,6 +447,18 @@ void VariableManager::setCurrentScalarVariable(int newCurrentScalarVariableIndex
 	char title[256];
 	snprintf(title,sizeof(title),"Palette Editor - %s",dataSet->getScalarVariableName(newCurrentScalarVariableIndex));
 	paletteEditor->setTitleString(title);
+	
+	/* Show the scalar variable's histogram on a logarithmic scale in the palette editor: */
+	std::vector<GLfloat> histogram;
+	size_t maxBin=sv.statistics.getMaxBin();
+	if(maxBin>0)
+		{
+		histogram.reserve(ValueStatistics::numBins);
+		double scale=1.0/Math::log(double(maxBin)+1.0);
+		for(int i=0;i<ValueStatistics::numBins;++i)
+			histogram.push_back(GLfloat(Math::log(double(sv.statistics.getBin(i))+1.0)*scale));
+		}
+	paletteEditor->getColorMap()->setHistogram(PaletteEditor::ValueRange(sv.valueRange.first,sv.valueRange.second),histogram);
 
 	/* Update the color bar dialog: */
 	snprintf(title,sizeof(title),"Color Bar - %s",dataSet->getScalarVariableName(newCurrentScalarVariableIndex));
@@ -304,12 +472,14 @@ void VariableManager::setCurrentVectorVariable(int newCurrentVectorVariableIndex
 	if(currentVectorVariableIndex==newCurrentVectorVariableIndex||newCurrentVectorVariableIndex<0||newCurrentVectorVariableIndex>=numVectorVariables)
 		return;
 	
-	/* Check if the vector variable has not been requested before: */
-	if(vectorExtractors[newCurrentVectorVariableIndex]==0)
-		vectorExtractors[newCurrentVectorVariableIndex]=dataSet->getVectorExtractor(newCurrentVectorVariableIndex);
+	/* Hold a reference to the new current vector variable's extractor: */
+	getVectorExtractor(newCurrentVectorVariableIndex);
 	
 	/* Update the current vector variable: */
+	int oldCurrentVectorVariableIndex=currentVectorVariableIndex;
 	currentVectorVariableIndex=newCurrentVectorVariableIndex;
+	if(oldCurrentVectorVariableIndex>=0)
+		releaseVectorExtractor(oldCurrentVectorVariableIndex);
 	}
 
 const ScalarExtractor* VariableManager::getScalarExtractor(int scalarVariableIndex)
@@ -317,11 +487,41 @@ const ScalarExtractor* VariableManager::getScalarExtractor(int scalarVariableInd
 	if(scalarVariableIndex<0||scalarVariableIndex>=numScalarVariables)
 		return 0;
 	
+	ScalarVariable& sv=scalarVariables[scalarVariableIndex];
+	Threads::Mutex::Lock scalarVariableLock(sv.mutex);
+	
 	/* Check if the scalar variable has not been requested before: */
-	if(scalarVariables[scalarVariableIndex].scalarExtractor==0)
+	if(sv.colorMap==0)
 		prepareScalarVariable(scalarVariableIndex);
 	
-	return scalarVariables[scalarVariableIndex].scalarExtractor;
+	/* Create the scalar extractor if the variable has no users, which loads the variable's values if the data set defers them: */
+	if(sv.scalarExtractor==0)
+		sv.scalarExtractor=dataSet->getScalarExtractor(scalarVariableIndex);
+	
+	/* Hand out a reference to the scalar extractor: */
+	++sv.numUsers;
+	
+	return sv.scalarExtractor;
+	}
+
+void VariableManager::releaseScalarExtractor(int scalarVariableIndex)
+	{
+	if(scalarVariableIndex<0||scalarVariableIndex>=numScalarVariables)
+		return;
+	
+	ScalarVariable& sv=scalarVariables[scalarVariableIndex];
+	Threads::Mutex::Lock scalarVariableLock(sv.mutex);
+	
+	/* Drop the reference and delete the scalar extractor when its last user is gone: */
+	if(sv.numUsers>0)
+		--sv.numUsers;
+	if(sv.numUsers==0&&sv.scalarExtractor!=0)
+		{
+		/* Delete the scalar extractor and tell the data set that the variable's values are no longer accessed: */
+		delete sv.scalarExtractor;
+		sv.scalarExtractor=0;
+		dataSet->releaseScalarExtractor(scalarVariableIndex);
+		}
 	}
 
 int VariableManager::getScalarVariable(const ScalarExtractor* scalarExtractor) const
@@ -339,11 +539,65 @@ const DataSet::VScalarRange& VariableManager::getScalarValueRange(int scalarVari
 	if(scalarVariableIndex<0||scalarVariableIndex>=numScalarVariables)
 		return scalarVariables[currentScalarVariableIndex].valueRange;
 	
+	ScalarVariable& sv=scalarVariables[scalarVariableIndex];
+	Threads::Mutex::Lock scalarVariableLock(sv.mutex);
+	
 	/* Check if the scalar variable has not been requested before: */
-	if(scalarVariables[scalarVariableIndex].scalarExtractor==0)
+	if(sv.colorMap==0)
 		prepareScalarVariable(scalarVariableIndex);
 	
-	return scalarVariables[scalarVariableIndex].valueRange;
+	return sv.valueRange;
+	}
+
+const ValueStatistics& VariableManager::getScalarValueStatistics(int scalarVariableIndex)
+	{
+	if(scalarVariableIndex<0||scalarVariableIndex>=numScalarVariables)
+		return scalarVariables[currentScalarVariableIndex].statistics;
+	
+	ScalarVariable& sv=scalarVariables[scalarVariableIndex];
+	Threads::Mutex::Lock scalarVariableLock(sv.mutex);
+	
+	/* Check if the scalar variable has not been requested before: */
+	if(sv.colorMap==0)
+		prepareScalarVariable(scalarVariableIndex);
+	
+	return sv.statistics;
+	}
+
+void VariableManager::setUseActiveCellIndices(bool newUseActiveCellIndices)
+	{
+	useActiveCellIndices=newUseActiveCellIndices;
+	}
+
+const ActiveCellIndex* VariableManager::getActiveCellIndex(int scalarVariableIndex)
+	{
+	if(scalarVariableIndex<0||scalarVariableIndex>=numScalarVariables)
+		return 0;
+	
+	Threads::Mutex::Lock activeCellIndexLock(activeCellIndexMutex);
+	ScalarVariable& sv=scalarVariables[scalarVariableIndex];
+	if(sv.activeCellIndex==0)
+		{
+		/* Hold a reference to the scalar variable's extractor, which the active cell index might reference until the variable manager is destroyed: */
+		getScalarExtractor(scalarVariableIndex);
+		
+		/* Index the data set's cells by the scalar variable's value ranges; large indices have to be enabled explicitly: */
+		try
+			{
+			sv.activeCellIndex=dataSet->createActiveCellIndex(sv.scalarExtractor,!useActiveCellIndices);
+			}
+		catch(...)
+			{
+			releaseScalarExtractor(scalarVariableIndex);
+			throw;
+			}
+		if(sv.activeCellIndex==0)
+			releaseScalarExtractor(scalarVariableIndex);
+		else if(headless||Vrui::isMaster())
+			std::cout<<"Active cell index for "<<dataSet->getScalarVariableName(scalarVariableIndex)<<": "<<sv.activeCellIndex->getNumCells()<<" cells, "<<double(sv.activeCellIndex->getMemorySize())/(1024.0*1024.0)<<" MB"<<std::endl;
+		}
+	
+	return sv.activeCellIndex;
 	}
 
 const GLColorMap* VariableManager::getColorMap(int scalarVariableIndex)
@@ -351,11 +605,14 @@ const GLColorMap* VariableManager::getColorMap(int scalarVariableIndex)
 	if(scalarVariableIndex<0||scalarVariableIndex>=numScalarVariables)
 		return 0;
 	
+	ScalarVariable& sv=scalarVariables[scalarVariableIndex];
+	Threads::Mutex::Lock scalarVariableLock(sv.mutex);
+	
 	/* Check if the scalar variable has not been requested before: */
-	if(scalarVariables[scalarVariableIndex].scalarExtractor==0)
+	if(sv.colorMap==0)
 		prepareScalarVariable(scalarVariableIndex);
 	
-	return scalarVariables[scalarVariableIndex].colorMap;
+	return sv.colorMap;
 	}
 
 const DataSet::VScalarRange& VariableManager::getScalarColorMapRange(int scalarVariableIndex)
@@ -363,11 +620,14 @@ const DataSet::VScalarRange& VariableManager::getScalarColorMapRange(int scalarV
 	if(scalarVariableIndex<0||scalarVariableIndex>=numScalarVariables)
 		return scalarVariables[currentScalarVariableIndex].colorMapRange;
 	
+	ScalarVariable& sv=scalarVariables[scalarVariableIndex];
+	Threads::Mutex::Lock scalarVariableLock(sv.mutex);
+	
 	/* Check if the scalar variable has not been requested before: */
-	if(scalarVariables[scalarVariableIndex].scalarExtractor==0)
+	if(sv.colorMap==0)
 		prepareScalarVariable(scalarVariableIndex);
 	
-	return scalarVariables[scalarVariableIndex].colorMapRange;
+	return sv.colorMapRange;
 	}
 
 const VectorExtractor* VariableManager::getVectorExtractor(int vectorVariableIndex)
@@ -375,18 +635,44 @@ const VectorExtractor* VariableManager::getVectorExtractor(int vectorVariableInd
 	if(vectorVariableIndex<0||vectorVariableIndex>=numVectorVariables)
 		return 0;
 	
-	/* Check if the vector variable has not been requested before: */
-	if(vectorExtractors[vectorVariableIndex]==0)
-		vectorExtractors[vectorVariableIndex]=dataSet->getVectorExtractor(vectorVariableIndex);
+	VectorVariable& vv=vectorVariables[vectorVariableIndex];
+	Threads::Mutex::Lock vectorVariableLock(vv.mutex);
+	
+	/* Create the vector extractor if the variable has no users, which loads the variable's values if the data set defers them: */
+	if(vv.vectorExtractor==0)
+		vv.vectorExtractor=dataSet->getVectorExtractor(vectorVariableIndex);
+	
+	/* Hand out a reference to the vector extractor: */
+	++vv.numUsers;
+	
+	return vv.vectorExtractor;
+	}
+
+void VariableManager::releaseVectorExtractor(int vectorVariableIndex)
+	{
+	if(vectorVariableIndex<0||vectorVariableIndex>=numVectorVariables)
+		return;
+	
+	VectorVariable& vv=vectorVariables[vectorVariableIndex];
+	Threads::Mutex::Lock vectorVariableLock(vv.mutex);
 	
-	return vectorExtractors[vectorVariableIndex];
+	/* Drop the reference and delete the vector extractor when its last user is gone: */
+	if(vv.numUsers>0)
+		--vv.numUsers;
+	if(vv.numUsers==0&&vv.vectorExtractor!=0)
+		{
+		/* Delete the vector extractor and tell the data set that the variable's values are no longer accessed: */
+		delete vv.vectorExtractor;
+		vv.vectorExtractor=0;
+		dataSet->releaseVectorExtractor(vectorVariableIndex);
+		}
 	}
 
 int VariableManager::getVectorVariable(const VectorExtractor* vectorExtractor) const
 	{
 	/* Find the vector extractor among the registered extractors: */
 	for(int i=0;i<numVectorVariables;++i)
-		if(vectorExtractors[i]==vectorExtractor)
+		if(vectorVariables[i].vectorExtractor==vectorExtractor)
 			return i;
 	
 	return -1;
@@ -23,9 +23,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_ABSTRACT_VARIABLEMANAGER_INCLUDED
 #define VISUALIZATION_ABSTRACT_VARIABLEMANAGER_INCLUDED
 
+#include <string>
 #include <GL/gl.h>
 #include <GL/GLObject.h>
+#include <Threads/Mutex.h>
 #include <Abstract/DataSet.h>
+#include <Abstract/ValueStatistics.h>
 #include <PaletteEditor.h>
 
 /* Forward declarations: */
@@ -41,6 +44,7 @@ namespace Visualization {
 namespace Abstract {
 class ScalarExtractor;
 class VectorExtractor;
+class ActiveCellIndex;
 }
 }
 class GLRenderState;
@@ -65,18 +69,36 @@ class VariableManager:public GLObject
 		{
 		/* Elements: */
 		public:
-		ScalarExtractor* scalarExtractor; // Scalar extractor for the scalar variable
+		Threads::Mutex mutex; // Mutex serializing preparation of the scalar variable and creation and deletion of its extractor
+		ScalarExtractor* scalarExtractor; // Scalar extractor for the scalar variable; only exists while it has users
+		unsigned int numUsers; // Number of references to the scalar extractor held by the current variable selection, algorithms, parameters, and locators
+		bool haveStatistics; // Flag if the scalar variable's statistics have been calculated or loaded from the statistics cache
+		ValueStatistics statistics; // Range, mean, and histogram of the scalar variable's values
 		DataSet::VScalarRange valueRange; // Value range of the scalar variable
 		GLColorMap* colorMap; // The color map to render the scalar variable
 		unsigned int colorMapVersion; // Version number of the color map
 		DataSet::VScalarRange colorMapRange; // Scalar variable range that is mapped to the full extent of the color map
 		PaletteEditor::Storage* palette; // Pointer to palette editor state for the scalar variable
+		ActiveCellIndex* activeCellIndex; // Index of the data set's cells by their ranges of the scalar variable; created on demand
 		
 		/* Constructors and destructors: */
 		ScalarVariable(void);
 		~ScalarVariable(void);
 		};
 	
+	struct VectorVariable // Structure containing state of a vector variable
+		{
+		/* Elements: */
+		public:
+		Threads::Mutex mutex; // Mutex serializing creation and deletion of the vector variable's extractor
+		VectorExtractor* vectorExtractor; // Vector extractor for the vector variable; only exists while it has users
+		unsigned int numUsers; // Number of references to the vector extractor held by the current variable selection, algorithms, parameters, and locators
+		
+		/* Constructors and destructors: */
+		VectorVariable(void);
+		~VectorVariable(void);
+		};
+	
 	struct DataItem:public GLObject::DataItem // Structure containing the variable manager's per-OpenGL context state
 		{
 		/* Elements: */
@@ -94,6 +116,7 @@ class VariableManager:public GLObject
 	
 	/* Elements: */
 	const DataSet* dataSet; // Data set containing the scalar and vector variables
+	bool headless; // Flag if the variable manager has no user interface and runs outside of a Vrui environment
 	char* defaultColorMapName; // Name of default color map file, or 0 if no default given
 	int numScalarVariables; // Total number of scalar variables
 	ScalarVariable* scalarVariables; // Array of scalar variables for the data set; initialized on demand
@@ -101,18 +124,25 @@ class VariableManager:public GLObject
 	GLMotif::ColorBar* colorBar; // Widget to display color maps
 	PaletteEditor* paletteEditor; // Editor for color maps
 	int numVectorVariables; // Total number of vector variables
-	VectorExtractor** vectorExtractors; // Array of extractors for the data set's vector variables
+	VectorVariable* vectorVariables; // Array of vector variables for the data set
 	int currentScalarVariableIndex; // The index of the currently selected scalar variable
 	int currentVectorVariableIndex; // The index of the currently selected vector variable
+	bool useActiveCellIndices; // Flag whether scalar variables are also indexed by non-compact active cell indices for global isosurface extraction
+	Threads::Mutex variableMutex; // Mutex protecting the scalar variables' statistics and the statistics cache file against concurrent preparation of different scalar variables
+	Threads::Mutex activeCellIndexMutex; // Mutex serializing creation of active cell indices from concurrent extraction threads
+	std::string statisticsCacheFileName; // Name of the file caching scalar variable statistics next to the data file; empty if caching is disabled
+	std::string statisticsCacheKey; // Description of the data set's module arguments and source files, stored in the statistics cache file to detect stale caches
 	
 	/* Private methods: */
-	void prepareScalarVariable(int scalarVariableIndex);
+	void loadStatisticsCache(void); // Loads the statistics of all scalar variables found in a valid statistics cache file
+	void saveStatisticsCache(void) const; // Writes the statistics of all prepared scalar variables to the statistics cache file
+	void prepareScalarVariable(int scalarVariableIndex); // Calculates the statistics of the given scalar variable and creates its color map; must be called with the scalar variable's mutex locked, but not the variable mutex
 	void colorMapChangedCallback(Misc::CallbackData* cbData);
 	void savePaletteCallback(Misc::CallbackData* cbData);
 	
 	/* Constructors and destructors: */
 	public:
-	VariableManager(const DataSet* sDataSet,const char* sDefaultColorMapName); // Creates variable manager for the given data set
+	VariableManager(const DataSet* sDataSet,const char* sDefaultColorMapName,const char* sStatisticsCacheFileName =0,const char* sStatisticsCacheKey =0,bool sHeadless =false); // Creates variable manager for the given data set; caches scalar variable statistics in the given file under the given key describing the data set's sources if the name is not 0; headless variable managers do not create color bars or palette editors and can be used without Vrui
 	virtual ~VariableManager(void);
 	
 	/* Methods from GLObject: */
@@ -127,6 +157,14 @@ class VariableManager:public GLObject
 		{
 		return numVectorVariables;
 		}
+	bool isHeadless(void) const // Returns true if the variable manager runs outside of a Vrui environment
+		{
+		return headless;
+		}
+	const DataSet* getDataSet(void) const // Returns the data set containing the scalar and vector variables
+		{
+		return dataSet;
+		}
 	const DataSet* getDataSetByScalarVariable(int scalarVariableIndex) const; // Returns the data set owning the given scalar variable
 	const DataSet* getDataSetByVectorVariable(int vectorVariableIndex) const; // Returns the data set owning the given vector variable
 	const char* getScalarVariableName(int scalarVariableIndex) const // Returns the name of the given scalar variable
@@ -149,16 +187,25 @@ class VariableManager:public GLObject
 		}
 	void setCurrentScalarVariable(int newCurrentScalarVariable); // Sets the currently selected scalar variable
 	void setCurrentVectorVariable(int newCurrentVectorVariable); // Sets the currently selected vector variable
-	const ScalarExtractor* getScalarExtractor(int scalarVariableIndex); // Returns a new scalar extractor for the given scalar variable
+	const ScalarExtractor* getScalarExtractor(int scalarVariableIndex); // Returns the scalar extractor for the given scalar variable and counts a reference to it; caller must call releaseScalarExtractor when it no longer uses the extractor
+	void releaseScalarExtractor(int scalarVariableIndex); // Releases a reference to the given scalar variable's extractor; deletes the extractor and lets the data set release the variable's values when the last reference is released
 	int getScalarVariable(const ScalarExtractor* scalarExtractor) const; // Returns the index of the given scalar extractor
 	const DataSet::VScalarRange& getScalarValueRange(int scalarVariableIndex); // Returns the value range of the given scalar variable
+	const ValueStatistics& getScalarValueStatistics(int scalarVariableIndex); // Returns the range, mean, and histogram of the given scalar variable
+	bool getUseActiveCellIndices(void) const // Returns true if scalar variables are also indexed by non-compact active cell indices
+		{
+		return useActiveCellIndices;
+		}
+	void setUseActiveCellIndices(bool newUseActiveCellIndices); // Enables or disables non-compact active cell indices for subsequently indexed scalar variables
+	const ActiveCellIndex* getActiveCellIndex(int scalarVariableIndex); // Returns the active cell index of the given scalar variable, creating it on the first call; returns 0 if the data set does not support active cell indices, or only supports non-compact ones and those are disabled
 	const GLColorMap* getColorMap(int scalarVariableIndex); // Returns the color map for the given scalar variable
 	const DataSet::VScalarRange& getScalarColorMapRange(int scalarVariableIndex); // Returns the value range of the given scalar variable that is mapped to the full extent of the color map
-	const VectorExtractor* getVectorExtractor(int vectorVariableIndex); // Returns a new vector extractor for the given vector variable
+	const VectorExtractor* getVectorExtractor(int vectorVariableIndex); // Returns the vector extractor for the given vector variable and counts a reference to it; caller must call releaseVectorExtractor when it no longer uses the extractor
+	void releaseVectorExtractor(int vectorVariableIndex); // Ditto for vector variables
 	int getVectorVariable(const VectorExtractor* vectorExtractor) const; // Returns the index of the given vector extractor
-	const ScalarExtractor* getCurrentScalarExtractor(void) const // Returns the current scalar extractor
+	const ScalarExtractor* getCurrentScalarExtractor(void) // Returns the current scalar extractor and counts a reference to it
 		{
-		return scalarVariables[currentScalarVariableIndex].scalarExtractor;
+		return getScalarExtractor(currentScalarVariableIndex);
 		}
 	const DataSet::VScalarRange& getCurrentScalarValueRange(void) const // Returns the current scalar value range
 		{
@@ -168,9 +215,9 @@ class VariableManager:public GLObject
 		{
 		return scalarVariables[currentScalarVariableIndex].colorMap;
 		}
-	const VectorExtractor* getCurrentVectorExtractor(void) const // Returns the current vector extractor
+	const VectorExtractor* getCurrentVectorExtractor(void) // Returns the current vector extractor and counts a reference to it
 		{
-		return vectorExtractors[currentVectorVariableIndex];
+		return getVectorExtractor(currentVectorVariableIndex);
 		}
 	void showColorBar(bool show); // Shows or hides the color bar dialog
 	GLMotif::PopupWindow* getColorBarDialog(void) // Returns the color bar dialog
@@ -0,0 +1,150 @@
+/***********************************************************************
+VariableReferences - Class to hold references to the scalar and vector
+extractors handed out by a variable manager, and to release them when
+the holding algorithm or parameter object is destroyed.
+Part of the abstract interface to the templatized visualization
+components.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Abstract/VariableReferences.h>
+
+#include <algorithm>
+
+#include <Abstract/VariableManager.h>
+
+namespace Visualization {
+
+namespace Abstract {
+
+/***********************************
+Methods of class VariableReferences:
+***********************************/
+
+VariableReferences::VariableReferences(const VariableReferences& source)
+	:variableManager(0)
+	{
+	/* Acquire additional references to all extractors held by the source: */
+	Threads::Mutex::Lock sourceLock(source.mutex);
+	for(std::vector<int>::const_iterator sviIt=source.scalarVariableIndices.begin();sviIt!=source.scalarVariableIndices.end();++sviIt)
+		getScalarExtractor(source.variableManager,*sviIt);
+	for(std::vector<int>::const_iterator vviIt=source.vectorVariableIndices.begin();vviIt!=source.vectorVariableIndices.end();++vviIt)
+		getVectorExtractor(source.variableManager,*vviIt);
+	}
+
+VariableReferences& VariableReferences::operator=(const VariableReferences& source)
+	{
+	if(this!=&source)
+		{
+		/* Acquire the source's references before releasing the current ones, in case they overlap: */
+		VariableReferences copy(source);
+		swap(copy);
+		}
+	return *this;
+	}
+
+VariableReferences::~VariableReferences(void)
+	{
+	release();
+	}
+
+const ScalarExtractor* VariableReferences::getScalarExtractor(VariableManager* newVariableManager,int scalarVariableIndex)
+	{
+	Threads::Mutex::Lock referencesLock(mutex);
+	
+	/* Get a new reference from the variable manager: */
+	const ScalarExtractor* result=newVariableManager->getScalarExtractor(scalarVariableIndex);
+	if(result!=0)
+		{
+		/* Keep at most one reference per variable: */
+		variableManager=newVariableManager;
+		if(std::find(scalarVariableIndices.begin(),scalarVariableIndices.end(),scalarVariableIndex)!=scalarVariableIndices.end())
+			variableManager->releaseScalarExtractor(scalarVariableIndex);
+		else
+			{
+			try
+				{
+				scalarVariableIndices.push_back(scalarVariableIndex);
+				}
+			catch(...)
+				{
+				variableManager->releaseScalarExtractor(scalarVariableIndex);
+				throw;
+				}
+			}
+		}
+	
+	return result;
+	}
+
+const VectorExtractor* VariableReferences::getVectorExtractor(VariableManager* newVariableManager,int vectorVariableIndex)
+	{
+	Threads::Mutex::Lock referencesLock(mutex);
+	
+	/* Get a new reference from the variable manager: */
+	const VectorExtractor* result=newVariableManager->getVectorExtractor(vectorVariableIndex);
+	if(result!=0)
+		{
+		/* Keep at most one reference per variable: */
+		variableManager=newVariableManager;
+		if(std::find(vectorVariableIndices.begin(),vectorVariableIndices.end(),vectorVariableIndex)!=vectorVariableIndices.end())
+			variableManager->releaseVectorExtractor(vectorVariableIndex);
+		else
+			{
+			try
+				{
+				vectorVariableIndices.push_back(vectorVariableIndex);
+				}
+			catch(...)
+				{
+				variableManager->releaseVectorExtractor(vectorVariableIndex);
+				throw;
+				}
+			}
+		}
+	
+	return result;
+	}
+
+void VariableReferences::swap(VariableReferences& other)
+	{
+	Threads::Mutex::Lock referencesLock(mutex);
+	Threads::Mutex::Lock otherLock(other.mutex);
+	std::swap(variableManager,other.variableManager);
+	scalarVariableIndices.swap(other.scalarVariableIndices);
+	vectorVariableIndices.swap(other.vectorVariableIndices);
+	}
+
+void VariableReferences::release(void)
+	{
+	Threads::Mutex::Lock referencesLock(mutex);
+	
+	/* Release all held references: */
+	for(std::vector<int>::iterator sviIt=scalarVariableIndices.begin();sviIt!=scalarVariableIndices.end();++sviIt)
+		variableManager->releaseScalarExtractor(*sviIt);
+	scalarVariableIndices.clear();
+	for(std::vector<int>::iterator vviIt=vectorVariableIndices.begin();vviIt!=vectorVariableIndices.end();++vviIt)
+		variableManager->releaseVectorExtractor(*vviIt);
+	vectorVariableIndices.clear();
+	variableManager=0;
+	}
+
+}
+
+}
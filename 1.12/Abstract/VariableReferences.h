@@ -0,0 +1,75 @@
+/***********************************************************************
+VariableReferences - Class to hold references to the scalar and vector
+extractors handed out by a variable manager, and to release them when
+the holding algorithm or parameter object is destroyed.
+Part of the abstract interface to the templatized visualization
+components.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_ABSTRACT_VARIABLEREFERENCES_INCLUDED
+#define VISUALIZATION_ABSTRACT_VARIABLEREFERENCES_INCLUDED
+
+#include <vector>
+#include <Threads/Mutex.h>
+
+/* Forward declarations: */
+namespace Visualization {
+namespace Abstract {
+class VariableManager;
+class ScalarExtractor;
+class VectorExtractor;
+}
+}
+
+namespace Visualization {
+
+namespace Abstract {
+
+class VariableReferences
+	{
+	/* Elements: */
+	private:
+	mutable Threads::Mutex mutex; // Mutex serializing access to the held references from the main thread and extraction threads
+	VariableManager* variableManager; // Variable manager that handed out the held extractors, or 0 if no extractors are held
+	std::vector<int> scalarVariableIndices; // Indices of scalar variables whose extractors are held
+	std::vector<int> vectorVariableIndices; // Indices of vector variables whose extractors are held
+	
+	/* Constructors and destructors: */
+	public:
+	VariableReferences(void) // Creates an empty reference set
+		:variableManager(0)
+		{
+		}
+	VariableReferences(const VariableReferences& source); // Holds additional references to all extractors held by the source
+	VariableReferences& operator=(const VariableReferences& source); // Ditto; releases the previously held references
+	~VariableReferences(void); // Releases all held references
+	
+	/* Methods: */
+	const ScalarExtractor* getScalarExtractor(VariableManager* newVariableManager,int scalarVariableIndex); // Returns the extractor for the given scalar variable and holds one reference to it until released
+	const VectorExtractor* getVectorExtractor(VariableManager* newVariableManager,int vectorVariableIndex); // Ditto for vector variables
+	void swap(VariableReferences& other); // Exchanges the held references with the other reference set
+	void release(void); // Releases all held references
+	};
+
+}
+
+}
+
+#endif
@@ -106,7 +106,8 @@ ColorMap::ColorMap(const char* sName,Container* sParent,bool sManageChild)
 	 selectedControlPointColor(1.0f,0.0f,0.0f),
 	 valueRange(0.0,1.0),
 	 first(0.0,ColorMapValue(0.0f,0.0f,0.0f,0.0f)),last(1.0,ColorMapValue(1.0f,1.0f,1.0f,1.0f)),
-	 selected(0),isDragging(false)
+	 selected(0),isDragging(false),
+	 histogramRange(0.0,1.0)
 	{
 	/* Link the first and last control points: */
 	first.right=&last;
@@ -201,6 +202,31 @@ void ColorMap::draw(GLContextData& contextData) const
 		glVertex3f(cpPtr->x,y1,z);
 		}
 	glEnd();
+	if(!histogram.empty())
+		{
+		/* Draw the histogram as a step function over the part of the color map area covered by its value range: */
+		GLfloat x1=colorMapAreaBox.getCorner(0)[0];
+		GLfloat x2=colorMapAreaBox.getCorner(1)[0];
+		GLfloat xScale=GLfloat((histogramRange.second-histogramRange.first)/(valueRange.second-valueRange.first))*(x2-x1)/GLfloat(histogram.size());
+		GLfloat xOffset=GLfloat((histogramRange.first-valueRange.first)/(valueRange.second-valueRange.first))*(x2-x1)+x1;
+		glColor3f(0.5f,0.5f,0.5f);
+		glBegin(GL_LINE_STRIP);
+		for(size_t i=0;i<histogram.size();++i)
+			{
+			GLfloat bx1=GLfloat(i)*xScale+xOffset;
+			GLfloat bx2=GLfloat(i+1)*xScale+xOffset;
+			if(bx2<x1||bx1>x2)
+				continue;
+			if(bx1<x1)
+				bx1=x1;
+			if(bx2>x2)
+				bx2=x2;
+			GLfloat by=histogram[i]*(y2-y1)+y1;
+			glVertex3f(bx1,by,z+marginWidth*0.125f);
+			glVertex3f(bx2,by,z+marginWidth*0.125f);
+			}
+		glEnd();
+		}
 	GLfloat lineWidth;
 	glGetFloatv(GL_LINE_WIDTH,&lineWidth);
 	glLineWidth(3.0f);
@@ -1034,4 +1060,10 @@ void ColorMap::saveColorMap(const char* colorMapFileName) const
 		fprintf(colorMapFile.getFilePtr(),"%f %f %f %f %f\n",cpPtr->value,cpPtr->color[0],cpPtr->color[1],cpPtr->color[2],cpPtr->color[3]);
 	}
 
+void ColorMap::setHistogram(const ColorMap::ValueRange& newHistogramRange,const std::vector<GLfloat>& newHistogram)
+	{
+	histogramRange=newHistogramRange;
+	histogram=newHistogram;
+	}
+
 }
@@ -165,6 +165,8 @@ class ColorMap:public Widget
 	ControlPoint* selected; // Pointer to currently selected control point
 	bool isDragging; // Flag whether a control point is being dragged
 	Point::Vector dragOffset; // Offset between pointer and dragged control point in widget coordinates
+	ValueRange histogramRange; // Range of values covered by the histogram
+	std::vector<GLfloat> histogram; // Heights of histogram bins in [0, 1] drawn behind the color map; empty if no histogram is shown
 	
 	/* Private methods: */
 	void deleteColorMap(void); // Deletes the current color map so it can be recreated
@@ -227,6 +229,7 @@ class ColorMap:public Widget
 	void createColorMap(const std::vector<ControlPoint>& controlPoints); // Creates color map from the given vector of control points; control point values must be monotonically increasing
 	void loadColorMap(const char* colorMapFileName,const ValueRange& newValueRange); // Loads a color map from the given color map file and adjusts it to the given value range (without changing mappings)
 	void saveColorMap(const char* colorMapFileName) const; // Saves color map to the given file
+	void setHistogram(const ValueRange& newHistogramRange,const std::vector<GLfloat>& newHistogram); // Sets a histogram of equal-sized bins covering the given value range to be drawn behind the color map; an empty histogram disables drawing
 	};
 
 }
@@ -87,6 +87,12 @@ class BitBuffer
 		{
 		numBits=0;
 		};
+	bool fill(int numFillBits) // Returns true if the buffer holds at least the given number of bits after filling it from the input stream
+		{
+		if(numBits<numFillBits)
+			fillBuffer();
+		return numBits>=numFillBits;
+		};
 	int peekBits(int numGetBits) // Returns the requested number of bits without removing them from the buffer
 		{
 		/* Check if there are enough bits in the buffer: */
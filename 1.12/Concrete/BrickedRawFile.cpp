@@ -0,0 +1,128 @@
+/***********************************************************************
+BrickedRawFile - Class to encapsulate operations on out-of-core scalar-
+valued data sets stored in raw files of float values, which are accessed
+through a brick file and a brick cache of bounded size.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Concrete/BrickedRawFile.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <Misc/SelfDestructPointer.h>
+#include <Misc/ThrowStdErr.h>
+#include <Plugins/FactoryManager.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+/*******************************
+Methods of class BrickedRawFile:
+*******************************/
+
+BrickedRawFile::BrickedRawFile(void)
+	:BaseModule("BrickedRawFile")
+	{
+	}
+
+Visualization::Abstract::DataSet* BrickedRawFile::load(const std::vector<std::string>& args,Cluster::MulticastPipe* pipe) const
+	{
+	/* Bricks are read on demand from the local file system, which cannot be forwarded through a multicast pipe: */
+	if(pipe!=0)
+		Misc::throwStdErr("BrickedRawFile::load: Out-of-core data sets are not supported in cluster environments");
+	
+	/* Parse the module arguments: */
+	std::string rawFileName;
+	std::string brickFileName;
+	DS::Index numVertices(0);
+	int numSizes=0;
+	DS::Size cellSize(Scalar(1));
+	int brickSize=64;
+	size_t cacheSize=size_t(1024)*size_t(1024*1024);
+	for(std::vector<std::string>::const_iterator aIt=args.begin();aIt!=args.end();++aIt)
+		{
+		if((*aIt)[0]=='-')
+			{
+			if(strcasecmp(aIt->c_str()+1,"cellSize")==0)
+				{
+				for(int i=0;i<3&&aIt+1!=args.end();++i)
+					{
+					++aIt;
+					cellSize[i]=Scalar(atof(aIt->c_str()));
+					}
+				}
+			else if(strcasecmp(aIt->c_str()+1,"brickSize")==0&&aIt+1!=args.end())
+				{
+				++aIt;
+				brickSize=atoi(aIt->c_str());
+				}
+			else if(strcasecmp(aIt->c_str()+1,"cacheSize")==0&&aIt+1!=args.end())
+				{
+				++aIt;
+				cacheSize=size_t(atoi(aIt->c_str()))*size_t(1024*1024);
+				}
+			else if(strcasecmp(aIt->c_str()+1,"brickFile")==0&&aIt+1!=args.end())
+				{
+				++aIt;
+				brickFileName=getFullPath(*aIt);
+				}
+			}
+		else if(rawFileName.empty())
+			rawFileName=getFullPath(*aIt);
+		else if(numSizes<3)
+			numVertices[numSizes++]=atoi(aIt->c_str());
+		}
+	if(rawFileName.empty())
+		Misc::throwStdErr("BrickedRawFile::load: No raw volume file name provided");
+	if(numSizes<3)
+		Misc::throwStdErr("BrickedRawFile::load: No volume size provided");
+	
+	/* Store the brick file next to the raw volume file by default: */
+	if(brickFileName.empty())
+		brickFileName=rawFileName+".bricks";
+	
+	/* Create the data set, which splits the raw volume file into bricks on first use: */
+	Misc::SelfDestructPointer<DataSet> result(new DataSet);
+	result->getDs().setData(numVertices,cellSize,rawFileName,brickFileName,brickSize,cacheSize);
+	
+	return result.releaseTarget();
+	}
+
+}
+
+}
+
+/***************************
+Plug-in interface functions:
+***************************/
+
+extern "C" Visualization::Abstract::Module* createFactory(Plugins::FactoryManager<Visualization::Abstract::Module>& manager)
+	{
+	/* Create module object and insert it into class hierarchy: */
+	Visualization::Concrete::BrickedRawFile* module=new Visualization::Concrete::BrickedRawFile();
+	
+	/* Return module object: */
+	return module;
+	}
+
+extern "C" void destroyFactory(Visualization::Abstract::Module* module)
+	{
+	delete module;
+	}
@@ -0,0 +1,677 @@
+/***********************************************************************
+BulkValueSource - Class to tokenize ASCII data files like IO::ValueSource
+that reads large blocks of text from its source and parses runs of
+numeric records in parallel.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Concrete/BulkValueSource.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <Misc/SizedTypes.h>
+#include <Misc/ThrowStdErr.h>
+
+#include <Templatized/WorkerPool.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+namespace {
+
+/**************
+Helper objects:
+**************/
+
+const size_t initialBufferSize=64*1024; // Size of the text buffer while reading individual tokens
+const size_t batchBufferSize=8*1024*1024; // Size of the text buffer while reading runs of records
+const size_t minChunkSize=256*1024; // Minimum amount of text handed to each parsing worker
+
+const double exactPowersOfTen[23]= // Powers of ten that are exactly representable as doubles
+	{
+	1.0e0,1.0e1,1.0e2,1.0e3,1.0e4,1.0e5,1.0e6,1.0e7,1.0e8,1.0e9,1.0e10,1.0e11,
+	1.0e12,1.0e13,1.0e14,1.0e15,1.0e16,1.0e17,1.0e18,1.0e19,1.0e20,1.0e21,1.0e22
+	};
+
+/****************
+Helper functions:
+****************/
+
+inline bool isSpace(char c)
+	{
+	return c==' '||c=='\t'||c=='\n'||c=='\r'||c=='\f'||c=='\v';
+	}
+
+inline bool isDigit(char c)
+	{
+	return c>='0'&&c<='9';
+	}
+
+bool parseNumber(const char*& ptr,double& value)
+	{
+	/* Parse the optional sign: */
+	const char* p=ptr;
+	bool negative=false;
+	if(*p=='-'||*p=='+')
+		{
+		negative=*p=='-';
+		++p;
+		}
+	
+	/* Accumulate up to 19 significant mantissa digits, which always fit into 64 bits: */
+	Misc::UInt64 mantissa=0;
+	int numSignificantDigits=0;
+	int exponent=0;
+	bool haveDigits=false;
+	bool truncated=false;
+	for(;isDigit(*p);++p)
+		{
+		haveDigits=true;
+		if(numSignificantDigits<19)
+			{
+			mantissa=mantissa*10U+Misc::UInt64(*p-'0');
+			if(mantissa!=0)
+				++numSignificantDigits;
+			}
+		else
+			{
+			++exponent;
+			if(*p!='0')
+				truncated=true;
+			}
+		}
+	if(*p=='.')
+		{
+		for(++p;isDigit(*p);++p)
+			{
+			haveDigits=true;
+			if(numSignificantDigits<19)
+				{
+				mantissa=mantissa*10U+Misc::UInt64(*p-'0');
+				if(mantissa!=0)
+					++numSignificantDigits;
+				--exponent;
+				}
+			else if(*p!='0')
+				truncated=true;
+			}
+		}
+	if(!haveDigits)
+		return false;
+	
+	/* Parse the optional exponent: */
+	if(*p=='e'||*p=='E')
+		{
+		++p;
+		bool negativeExponent=false;
+		if(*p=='-'||*p=='+')
+			{
+			negativeExponent=*p=='-';
+			++p;
+			}
+		if(!isDigit(*p))
+			return false;
+		int e=0;
+		for(;isDigit(*p);++p)
+			if(e<100000)
+				e=e*10+(*p-'0');
+		exponent+=negativeExponent?-e:e;
+		}
+	
+	if(!truncated&&mantissa<=(Misc::UInt64(1)<<53)&&exponent>=-22&&exponent<=22)
+		{
+		/* Both the mantissa and the power of ten are exact, so a single multiplication or division rounds correctly: */
+		double result=double(mantissa);
+		if(exponent<0)
+			result/=exactPowersOfTen[-exponent];
+		else
+			result*=exactPowersOfTen[exponent];
+		value=negative?-result:result;
+		}
+	else
+		{
+		/* Let the C library handle the rare hard cases: */
+		value=strtod(ptr,0);
+		}
+	
+	ptr=p;
+	return true;
+	}
+
+struct RecordChunk // Structure holding the results of parsing a line-aligned chunk of record text
+	{
+	/* Elements: */
+	const char* start; // Beginning of the chunk's text
+	const char* end; // End of the chunk's text
+	std::vector<double> values; // Parsed values; one per column of each line in per-line mode, one per token otherwise
+	std::vector<unsigned char> valid; // Flags whether each line or token was parsed successfully
+	std::vector<unsigned int> itemEnds; // Offsets from the chunk's beginning to the end of each line or token
+	};
+
+class RecordParser // Class to parse record text chunks in parallel on the worker pool
+	{
+	/* Elements: */
+	private:
+	std::vector<RecordChunk>& chunks; // The chunks to parse, one per worker
+	int numColumns; // Number of columns in each record
+	bool recordPerLine; // Flag if each record occupies its own line
+	const std::vector<bool>& ignoreColumns; // Flags for columns whose tokens are not parsed
+	int commentCharacter; // Character starting comment lines, or -1
+	size_t maxNumItems; // Maximum number of lines or tokens to parse per chunk
+	
+	/* Constructors and destructors: */
+	public:
+	RecordParser(std::vector<RecordChunk>& sChunks,int sNumColumns,bool sRecordPerLine,const std::vector<bool>& sIgnoreColumns,int sCommentCharacter,size_t sMaxNumItems)
+		:chunks(sChunks),numColumns(sNumColumns),recordPerLine(sRecordPerLine),ignoreColumns(sIgnoreColumns),commentCharacter(sCommentCharacter),maxNumItems(sMaxNumItems)
+		{
+		}
+	
+	/* Methods: */
+	void operator()(unsigned int workerIndex) // Parses the chunk belonging to the given worker
+		{
+		RecordChunk& chunk=chunks[workerIndex];
+		const char* p=chunk.start;
+		const char* end=chunk.end;
+		size_t numItems=0;
+		if(recordPerLine)
+			{
+			while(p!=end&&numItems<maxNumItems)
+				{
+				/* Skip leading whitespace, blank lines, and comment lines: */
+				while(p!=end&&*p!='\n'&&isSpace(*p))
+					++p;
+				if(p==end)
+					break;
+				if(*p=='\n'||(unsigned char)*p==commentCharacter)
+					{
+					while(p!=end&&*p!='\n')
+						++p;
+					if(p!=end)
+						++p;
+					continue;
+					}
+				
+				/* Parse the line's columns: */
+				bool lineValid=true;
+				size_t base=chunk.values.size();
+				chunk.values.resize(base+numColumns);
+				for(int column=0;column<numColumns&&lineValid;++column)
+					{
+					while(p!=end&&*p!='\n'&&isSpace(*p))
+						++p;
+					if(p==end||*p=='\n')
+						lineValid=false;
+					else if(ignoreColumns[column])
+						{
+						while(p!=end&&!isSpace(*p))
+							++p;
+						}
+					else if(!parseNumber(p,chunk.values[base+column])||(p!=end&&!isSpace(*p)))
+						lineValid=false;
+					}
+				
+				/* Skip the rest of the line: */
+				while(p!=end&&*p!='\n')
+					++p;
+				if(p!=end)
+					++p;
+				chunk.valid.push_back(lineValid);
+				chunk.itemEnds.push_back((unsigned int)(p-chunk.start));
+				++numItems;
+				
+				/* Stop at the first malformed line: */
+				if(!lineValid)
+					break;
+				}
+			}
+		else
+			{
+			while(numItems<maxNumItems)
+				{
+				/* Skip whitespace: */
+				while(p!=end&&isSpace(*p))
+					++p;
+				if(p==end)
+					break;
+				
+				/* Parse the next token; malformed tokens are only errors if they are not in ignored columns: */
+				double value=0.0;
+				bool tokenValid=parseNumber(p,value)&&(p==end||isSpace(*p));
+				while(p!=end&&!isSpace(*p))
+					++p;
+				chunk.values.push_back(value);
+				chunk.valid.push_back(tokenValid);
+				chunk.itemEnds.push_back((unsigned int)(p-chunk.start));
+				++numItems;
+				}
+			}
+		}
+	};
+
+}
+
+/********************************
+Methods of class BulkValueSource:
+********************************/
+
+bool BulkValueSource::fillBuffer(void)
+	{
+	if(sourceEof)
+		return false;
+	
+	/* Move unread text to the front of the buffer: */
+	if(pos>0)
+		{
+		memmove(&buffer[0],&buffer[pos],dataEnd-pos);
+		dataEnd-=pos;
+		pos=0;
+		}
+	
+	/* Grow the buffer if it is full: */
+	if(dataEnd==buffer.size()-1)
+		buffer.resize((buffer.size()-1)*2+1);
+	
+	/* Read as much text as fits into the buffer: */
+	size_t oldDataEnd=dataEnd;
+	while(dataEnd<buffer.size()-1)
+		{
+		size_t readSize=source->readUpTo(&buffer[dataEnd],buffer.size()-1-dataEnd);
+		if(readSize==0)
+			{
+			sourceEof=true;
+			break;
+			}
+		dataEnd+=readSize;
+		}
+	buffer[dataEnd]='\0';
+	
+	return dataEnd>oldDataEnd;
+	}
+
+void BulkValueSource::ensureLine(void)
+	{
+	while(memchr(&buffer[pos],'\n',dataEnd-pos)==0&&fillBuffer())
+		;
+	}
+
+void BulkValueSource::checkNumberEnd(const char* end)
+	{
+	size_t endPos=end-&buffer[0];
+	if(endPos!=dataEnd&&(characterClasses[(unsigned char)*end]&(WHITESPACE|PUNCTUATION))==0)
+		throw NumberError("BulkValueSource: Malformed number");
+	}
+
+void BulkValueSource::parseBatch(void)
+	{
+	recordValues.clear();
+	numBatchRecords=0;
+	nextBatchRecord=0;
+	
+	/* Switch to a larger buffer to give the parsing workers enough text: */
+	if(!sourceEof&&buffer.size()-1<batchBufferSize)
+		{
+		buffer.resize(batchBufferSize+1);
+		fillBuffer();
+		}
+	
+	while(true)
+		{
+		/* Top up the buffer if less than half of it holds unread text: */
+		if(!sourceEof&&(dataEnd-pos)*2<buffer.size()-1)
+			fillBuffer();
+		
+		/* Only parse complete lines unless the entire source has been read: */
+		size_t regionEnd=dataEnd;
+		if(!sourceEof)
+			while(regionEnd>pos&&buffer[regionEnd-1]!='\n')
+				--regionEnd;
+		if(regionEnd==pos)
+			{
+			/* Read more text, or fail if there is none: */
+			if(!fillBuffer())
+				{
+				batchFailed=true;
+				break;
+				}
+			continue;
+			}
+		
+		/* Split the text into line-aligned chunks, one per worker: */
+		const char* regionStart=&buffer[pos];
+		const char* regionStop=&buffer[0]+regionEnd;
+		size_t regionSize=regionEnd-pos;
+		unsigned int numChunks=Templatized::WorkerPool::getNumWorkers();
+		if(numChunks>regionSize/minChunkSize)
+			numChunks=(unsigned int)(regionSize/minChunkSize);
+		if(numChunks<1)
+			numChunks=1;
+		std::vector<RecordChunk> chunks(numChunks);
+		const char* chunkStart=regionStart;
+		for(unsigned int i=0;i<numChunks;++i)
+			{
+			const char* chunkEnd=i==numChunks-1?regionStop:regionStart+(regionSize*(i+1))/numChunks;
+			if(chunkEnd<chunkStart)
+				chunkEnd=chunkStart;
+			while(chunkEnd!=regionStop&&(chunkEnd==chunkStart||chunkEnd[-1]!='\n'))
+				++chunkEnd;
+			chunks[i].start=chunkStart;
+			chunks[i].end=chunkEnd;
+			chunkStart=chunkEnd;
+			}
+		
+		/* Parse all chunks in parallel: */
+		size_t maxNumItems=recordPerLine?numRecordsLeft:numRecordsLeft*size_t(numColumns);
+		RecordParser parser(chunks,numColumns,recordPerLine,ignoreColumns,commentCharacter,maxNumItems);
+		Templatized::WorkerPool::run(parser,numChunks);
+		
+		/* Assemble the chunks' items into records in order: */
+		size_t newPos=pos;
+		int column=0;
+		bool done=false;
+		for(unsigned int i=0;i<numChunks&&!done;++i)
+			{
+			const RecordChunk& chunk=chunks[i];
+			size_t chunkOffset=chunk.start-&buffer[0];
+			size_t numItems=chunk.valid.size();
+			for(size_t item=0;item<numItems;++item)
+				{
+				if(numBatchRecords==numRecordsLeft)
+					{
+					done=true;
+					break;
+					}
+				if(recordPerLine)
+					{
+					if(!chunk.valid[item])
+						{
+						batchFailed=true;
+						done=true;
+						break;
+						}
+					recordValues.insert(recordValues.end(),chunk.values.begin()+item*numColumns,chunk.values.begin()+(item+1)*numColumns);
+					++numBatchRecords;
+					newPos=chunkOffset+chunk.itemEnds[item];
+					}
+				else
+					{
+					if(!chunk.valid[item]&&!ignoreColumns[column])
+						{
+						batchFailed=true;
+						done=true;
+						break;
+						}
+					recordValues.push_back(chunk.values[item]);
+					if(++column==numColumns)
+						{
+						column=0;
+						++numBatchRecords;
+						newPos=chunkOffset+chunk.itemEnds[item];
+						}
+					}
+				}
+			}
+		
+		/* Drop the values of a trailing partial record; it will be parsed again with the next batch: */
+		recordValues.resize(numBatchRecords*numColumns);
+		pos=newPos;
+		if(numBatchRecords>0||batchFailed)
+			break;
+		
+		/* The text did not contain a complete record; read more text, or fail if there is none: */
+		if(!fillBuffer())
+			{
+			batchFailed=true;
+			break;
+			}
+		}
+	
+	numRecordsLeft-=numBatchRecords;
+	if(batchFailed)
+		numRecordsLeft=0;
+	else if(numRecordsLeft==0)
+		{
+		/* Continue tokenizing after the last record: */
+		skipWs();
+		}
+	}
+
+BulkValueSource::BulkValueSource(IO::FilePtr sSource)
+	:source(sSource),
+	 buffer(initialBufferSize+1),pos(0),dataEnd(0),sourceEof(false),
+	 commentCharacter(-1),
+	 numRecordsLeft(0),numColumns(0),recordPerLine(false),
+	 numBatchRecords(0),nextBatchRecord(0),batchFailed(false)
+	{
+	buffer[0]='\0';
+	
+	/* Initialize the character classes: */
+	for(int i=0;i<256;++i)
+		characterClasses[i]=0;
+	setWhitespace(" \t\n\v\f\r");
+	}
+
+void BulkValueSource::setWhitespace(int character,bool whitespace)
+	{
+	if(whitespace)
+		characterClasses[character]=(characterClasses[character]|WHITESPACE)&~PUNCTUATION;
+	else
+		characterClasses[character]&=~WHITESPACE;
+	}
+
+void BulkValueSource::setWhitespace(const char* whitespace)
+	{
+	for(int i=0;i<256;++i)
+		characterClasses[i]&=~WHITESPACE;
+	for(const char* wPtr=whitespace;*wPtr!='\0';++wPtr)
+		setWhitespace((unsigned char)*wPtr,true);
+	}
+
+void BulkValueSource::setPunctuation(int character,bool punctuation)
+	{
+	if(punctuation)
+		characterClasses[character]=(characterClasses[character]|PUNCTUATION)&~WHITESPACE;
+	else
+		characterClasses[character]&=~PUNCTUATION;
+	}
+
+void BulkValueSource::setPunctuation(const char* punctuation)
+	{
+	for(int i=0;i<256;++i)
+		characterClasses[i]&=~PUNCTUATION;
+	for(const char* pPtr=punctuation;*pPtr!='\0';++pPtr)
+		setPunctuation((unsigned char)*pPtr,true);
+	}
+
+void BulkValueSource::setQuotes(const char* quotes)
+	{
+	for(int i=0;i<256;++i)
+		characterClasses[i]&=~QUOTE;
+	for(const char* qPtr=quotes;*qPtr!='\0';++qPtr)
+		characterClasses[(unsigned char)*qPtr]|=QUOTE;
+	}
+
+void BulkValueSource::skipWs(void)
+	{
+	int c;
+	while((c=currentChar())>=0&&(characterClasses[c]&WHITESPACE))
+		++pos;
+	}
+
+void BulkValueSource::skipLine(void)
+	{
+	while(true)
+		{
+		/* Look for the line terminator in the buffer: */
+		const char* nl=static_cast<const char*>(memchr(&buffer[pos],'\n',dataEnd-pos));
+		if(nl!=0)
+			{
+			pos=(nl-&buffer[0])+1;
+			break;
+			}
+		
+		/* Skip the entire buffer and read more text: */
+		pos=dataEnd;
+		if(!fillBuffer())
+			break;
+		}
+	}
+
+void BulkValueSource::skipString(void)
+	{
+	readString();
+	}
+
+std::string BulkValueSource::readString(void)
+	{
+	std::string result;
+	int c=currentChar();
+	if(c>=0&&(characterClasses[c]&PUNCTUATION))
+		{
+		/* Punctuation characters are strings by themselves: */
+		result.push_back(char(c));
+		++pos;
+		}
+	else
+		{
+		/* Read characters until whitespace, punctuation, or end of file: */
+		while(c>=0&&(characterClasses[c]&(WHITESPACE|PUNCTUATION))==0)
+			{
+			if(characterClasses[c]&QUOTE)
+				{
+				/* Read a quoted string up to the matching quote, honoring backslash escapes: */
+				int quote=c;
+				++pos;
+				while((c=currentChar())>=0&&c!=quote)
+					{
+					if(c=='\\')
+						{
+						++pos;
+						if((c=currentChar())<0)
+							break;
+						}
+					result.push_back(char(c));
+					++pos;
+					}
+				if(c==quote)
+					++pos;
+				}
+			else
+				{
+				result.push_back(char(c));
+				++pos;
+				}
+			c=currentChar();
+			}
+		}
+	
+	skipWs();
+	return result;
+	}
+
+int BulkValueSource::readInteger(void)
+	{
+	/* Make sure the entire token is in the buffer: */
+	ensureLine();
+	
+	/* Parse the integer: */
+	const char* p=&buffer[pos];
+	bool negative=false;
+	if(*p=='-'||*p=='+')
+		{
+		negative=*p=='-';
+		++p;
+		}
+	if(!isDigit(*p))
+		throw NumberError("BulkValueSource::readInteger: Malformed integer");
+	unsigned int limit=negative?unsigned(INT_MAX)+1U:unsigned(INT_MAX);
+	unsigned int result=0;
+	for(;isDigit(*p);++p)
+		{
+		unsigned int digit=unsigned(*p-'0');
+		if(result>(limit-digit)/10U)
+			throw NumberError("BulkValueSource::readInteger: Integer out of range");
+		result=result*10U+digit;
+		}
+	checkNumberEnd(p);
+	
+	pos=p-&buffer[0];
+	skipWs();
+	return negative&&result!=0U?-int(result-1U)-1:int(result);
+	}
+
+double BulkValueSource::readNumber(void)
+	{
+	/* Make sure the entire token is in the buffer: */
+	ensureLine();
+	
+	/* Parse the number: */
+	const char* p=&buffer[pos];
+	double result;
+	if(!parseNumber(p,result))
+		throw NumberError("BulkValueSource::readNumber: Malformed number");
+	checkNumberEnd(p);
+	
+	pos=p-&buffer[0];
+	skipWs();
+	return result;
+	}
+
+void BulkValueSource::startRecords(size_t newNumRecords,int newNumColumns,bool newRecordPerLine,const bool newIgnoreColumns[])
+	{
+	if(newNumColumns<1)
+		Misc::throwStdErr("BulkValueSource::startRecords: Invalid number of columns %d",newNumColumns);
+	
+	/* Initialize the run state: */
+	numRecordsLeft=newNumRecords;
+	numColumns=newNumColumns;
+	recordPerLine=newRecordPerLine;
+	ignoreColumns.assign(numColumns,false);
+	if(newIgnoreColumns!=0)
+		for(int i=0;i<numColumns;++i)
+			ignoreColumns[i]=newIgnoreColumns[i];
+	recordValues.clear();
+	numBatchRecords=0;
+	nextBatchRecord=0;
+	batchFailed=false;
+	}
+
+const double* BulkValueSource::readRecord(void)
+	{
+	if(nextBatchRecord==numBatchRecords)
+		{
+		/* Check for errors or the end of the run: */
+		if(batchFailed)
+			throw NumberError("BulkValueSource::readRecord: Malformed record");
+		if(numRecordsLeft==0)
+			Misc::throwStdErr("BulkValueSource::readRecord: No records left in current run");
+		
+		/* Parse the next batch of records: */
+		parseBatch();
+		if(numBatchRecords==0)
+			throw NumberError("BulkValueSource::readRecord: Malformed record");
+		}
+	
+	return &recordValues[(nextBatchRecord++)*numColumns];
+	}
+
+}
+
+}
@@ -0,0 +1,132 @@
+/***********************************************************************
+BulkValueSource - Class to tokenize ASCII data files like IO::ValueSource
+that reads large blocks of text from its source and parses runs of
+numeric records in parallel.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_CONCRETE_BULKVALUESOURCE_INCLUDED
+#define VISUALIZATION_CONCRETE_BULKVALUESOURCE_INCLUDED
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <IO/File.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+class BulkValueSource
+	{
+	/* Embedded classes: */
+	public:
+	class NumberError:public std::runtime_error // Exception class to report malformed numbers
+		{
+		/* Constructors and destructors: */
+		public:
+		NumberError(const char* what)
+			:std::runtime_error(what)
+			{
+			}
+		};
+	
+	private:
+	enum CharacterClasses // Enumerated type for character class flags
+		{
+		WHITESPACE=0x1,PUNCTUATION=0x2,QUOTE=0x4
+		};
+	
+	/* Elements: */
+	IO::FilePtr source; // File from which text is read
+	std::vector<char> buffer; // Buffer holding a block of text from the source file, followed by a NUL sentinel
+	size_t pos; // Index of the current character in the buffer
+	size_t dataEnd; // Index one past the last valid character in the buffer
+	bool sourceEof; // Flag if the source file has been read completely
+	unsigned char characterClasses[256]; // Character class flags for the tokenizer
+	int commentCharacter; // Character starting comment lines between per-line records, or -1 if there are no comments
+	
+	/* State of the current run of numeric records: */
+	size_t numRecordsLeft; // Number of records in the current run that have not been parsed yet
+	int numColumns; // Number of columns in each record
+	bool recordPerLine; // Flag if each record occupies its own line, with unread columns at the end of each line being ignored
+	std::vector<bool> ignoreColumns; // Flags for columns whose tokens are skipped instead of parsed
+	std::vector<double> recordValues; // Column values of the current batch of parsed records
+	size_t numBatchRecords; // Number of records in the current batch
+	size_t nextBatchRecord; // Index of the next record to return from the current batch
+	bool batchFailed; // Flag if the record following the current batch is malformed
+	
+	/* Private methods: */
+	bool fillBuffer(void); // Moves unread text to the front of the buffer and reads more text from the source; grows the buffer if it is full; returns false if no more text could be read
+	int currentChar(void) // Returns the current character, or -1 at end of file
+		{
+		if(pos==dataEnd&&!fillBuffer())
+			return -1;
+		return (unsigned char)buffer[pos];
+		}
+	void ensureLine(void); // Ensures that the buffer contains the rest of the current line
+	void checkNumberEnd(const char* end); // Throws a NumberError if the given position does not end a token
+	void parseBatch(void); // Parses the next batch of records in parallel
+	
+	/* Constructors and destructors: */
+	public:
+	BulkValueSource(IO::FilePtr sSource); // Creates a tokenizer for the given source file with default character classes
+	private:
+	BulkValueSource(const BulkValueSource& source); // Prohibit copy constructor
+	BulkValueSource& operator=(const BulkValueSource& source); // Prohibit assignment operator
+	
+	/* Methods to change the tokenizer's character classes: */
+	public:
+	void setWhitespace(int character,bool whitespace); // Sets the whitespace flag of the given character
+	void setWhitespace(const char* whitespace); // Sets the set of whitespace characters
+	void setPunctuation(int character,bool punctuation); // Sets the punctuation flag of the given character
+	void setPunctuation(const char* punctuation); // Sets the set of punctuation characters
+	void setQuotes(const char* quotes); // Sets the set of quote characters
+	void setCommentCharacter(int newCommentCharacter) // Sets the character starting comment lines that are skipped between per-line records; -1 disables comments
+		{
+		commentCharacter=newCommentCharacter;
+		}
+	
+	/* Methods to read individual tokens: */
+	bool eof(void) // Returns true if the entire source file has been read
+		{
+		return currentChar()<0;
+		}
+	int peekc(void) // Returns the current character without consuming it, or -1 at end of file
+		{
+		return currentChar();
+		}
+	void skipWs(void); // Skips whitespace
+	void skipLine(void); // Skips the rest of the current line, including the line terminator
+	void skipString(void); // Skips the next string and following whitespace
+	std::string readString(void); // Reads the next string and skips following whitespace
+	int readInteger(void); // Reads the next integer and skips following whitespace; throws NumberError on malformed integers
+	double readNumber(void); // Reads the next number and skips following whitespace; throws NumberError on malformed numbers
+	
+	/* Methods to read runs of numeric records: */
+	void startRecords(size_t newNumRecords,int newNumColumns,bool newRecordPerLine,const bool newIgnoreColumns[]=0); // Starts a run of the given number of records of whitespace-separated numbers; columns whose ignore flag is set can contain arbitrary tokens
+	const double* readRecord(void); // Returns the column values of the next record of the current run; values of ignored columns are undefined; throws NumberError if the record is malformed
+	};
+
+}
+
+}
+
+#endif
@@ -105,6 +105,7 @@ Visualization::Abstract::DataSet* CSConvectionFile::load(const std::vector<std::
 	{
 	/* Open the data file: */
 	Misc::File dataFile(args[0].c_str(),"rt");
+	addSourceFile(args[0],false);
 	
 	/* Read data file's header: */
 	char line[256];
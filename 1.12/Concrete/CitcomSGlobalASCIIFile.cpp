@@ -31,19 +31,52 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Misc/StandardValueCoders.h>
 #include <Plugins/FactoryManager.h>
 #include <IO/OpenFile.h>
-#include <IO/ValueSource.h>
 #include <Cluster/MulticastPipe.h>
 #include <Math/Math.h>
 #include <Math/Constants.h>
 
+#include <Templatized/CompactSlice.h>
+
 #include <Concrete/SphericalCoordinateTransformer.h>
 #include <Concrete/EarthDataSet.h>
 #include <Concrete/CitcomSCfgFileParser.h>
+#include <Concrete/BulkValueSource.h>
+#include <Concrete/DataSetCache.h>
 
 namespace Visualization {
 
 namespace Concrete {
 
+namespace {
+
+/****************
+Helper functions:
+****************/
+
+std::string makeCoordFileName(const std::string& dataDir,const std::string& dataFileName,int cpuLinearIndex)
+	{
+	std::string result=dataDir;
+	result.append(dataFileName);
+	result.append(".coord.");
+	result.append(Misc::ValueCoder<int>::encode(cpuLinearIndex));
+	return result;
+	}
+
+std::string makeDataValueFileName(const std::string& dataDir,const std::string& dataFileName,const std::string& variableName,int cpuLinearIndex,int timeStepIndex)
+	{
+	std::string result=dataDir;
+	result.append(dataFileName);
+	result.push_back('.');
+	result.append(variableName);
+	result.push_back('.');
+	result.append(Misc::ValueCoder<int>::encode(cpuLinearIndex));
+	result.push_back('.');
+	result.append(Misc::ValueCoder<int>::encode(timeStepIndex));
+	return result;
+	}
+
+}
+
 /***************************************
 Methods of class CitcomSGlobalASCIIFile:
 ***************************************/
@@ -65,11 +98,22 @@ Visualization::Abstract::DataSet* CitcomSGlobalASCIIFile::load(const std::vector
 	/* Parse command line parameters related to the grid definition file: */
 	std::vector<std::string>::const_iterator argIt=args.begin();
 	bool storeSphericals=false;
+	bool useCache=false;
+	int compactEncoding=-1;
 	while((*argIt)[0]=='-')
 		{
 		/* Parse the command line parameter: */
 		if(*argIt=="-storeCoords")
 			storeSphericals=true;
+		else if(*argIt=="-cache")
+			useCache=true;
+		else if(*argIt=="-compactSlices"&&argIt+1!=args.end())
+			{
+			++argIt;
+			compactEncoding=Visualization::Templatized::CompactSlice::parseEncoding(argIt->c_str());
+			if(compactEncoding<0)
+				Misc::throwStdErr("CitcomSGlobalASCIIFile::load: unknown compact slice encoding %s",argIt->c_str());
+			}
 		
 		++argIt;
 		}
@@ -113,94 +157,152 @@ Visualization::Abstract::DataSet* CitcomSGlobalASCIIFile::load(const std::vector
 		cpuNumVertices[i]=(numVertices[i]-1)/numCpus[i]+1;
 	int totalCpuNumVertices=cpuNumVertices.calcIncrement(-1);
 	
+	/* Read the time step index given on the command line: */
+	std::vector<std::string>::const_iterator timeStepArgIt=argIt+1;
+	if(timeStepArgIt==args.end())
+		Misc::throwStdErr("CitcomSGlobalASCIIFile::load: no time step index provided");
+	bool isNumber=true;
+	int timeStepIndex=0;
+	for(std::string::const_iterator tiIt=timeStepArgIt->begin();isNumber&&tiIt!=timeStepArgIt->end();++tiIt)
+		{
+		if(*tiIt>='0'&&*tiIt<='9')
+			timeStepIndex=timeStepIndex*10+int(*tiIt-'0');
+		else
+			isNumber=false;
+		}
+	if(!isNumber)
+		Misc::throwStdErr("CitcomSGlobalASCIIFile::load: no time step index provided");
+	
+	/* Check for a binary cache of the grid and all requested variables from a previous session: */
+	Misc::SelfDestructPointer<DataSetCache> cache;
+	bool haveCache=false;
+	if(useCache&&pipe!=0)
+		{
+		if(master)
+			std::cout<<"CitcomSGlobalASCIIFile::load: Ignoring -cache option in cluster environment"<<std::endl;
+		}
+	else if(useCache)
+		{
+		/* Key the cache by the module arguments and all files read by this module: */
+		cache.setTarget(new DataSetCache(fullCfgName+".cache",args));
+		cache->addSourceFile(fullCfgName);
+		int numCpuFiles=numSurfaces*numCpus.calcIncrement(-1);
+		for(int cpuLinearIndex=0;cpuLinearIndex<numCpuFiles;++cpuLinearIndex)
+			cache->addSourceFile(getFullPath(makeCoordFileName(dataDir,dataFileName,cpuLinearIndex)));
+		for(std::vector<std::string>::const_iterator vIt=timeStepArgIt+1;vIt!=args.end();++vIt)
+			if(*vIt!="-log"&&*vIt!="-vector")
+				for(int cpuLinearIndex=0;cpuLinearIndex<numCpuFiles;++cpuLinearIndex)
+					cache->addSourceFile(getFullPath(makeDataValueFileName(dataDir,dataFileName,*vIt,cpuLinearIndex,timeStepIndex)));
+		
+		/* Open the cache file: */
+		haveCache=cache->open();
+		}
+	
 	/* Prepare the spherical-to-Cartesian formula: */
 	const double a=6378.14e3; // Equatorial radius in m
 	// const double f=1.0/298.247; // Geoid flattening factor (not used, since there could be vector values)
 	const double scaleFactor=1.0e-3; // Scale factor for Cartesian coordinates
 	
-	/* Read the grid coordinate files for all CPUs: */
-	std::cout<<"Reading grid vertex positions...   0%"<<std::flush;
-	int cpuCounter=0;
-	for(int surfaceIndex=0;surfaceIndex<numSurfaces;++surfaceIndex)
-		for(DS::Index cpuIndex(0);cpuIndex[0]<numCpus[0];cpuIndex.preInc(numCpus),++cpuCounter)
+	if(haveCache)
+		{
+		/* Read the grid vertex positions from the cache: */
+		std::cout<<"Reading grid vertex positions from cache..."<<std::flush;
+		for(int surfaceIndex=0;surfaceIndex<numSurfaces;++surfaceIndex)
 			{
 			DS::GridArray& grid=dataSet.getGrid(surfaceIndex).getGrid();
-			
-			/* Open the CPU's coordinate file: */
-			int cpuLinearIndex=((surfaceIndex*numCpus[1]+cpuIndex[1])*numCpus[0]+cpuIndex[0])*numCpus[2]+cpuIndex[2];
-			std::string coordFileName=dataDir;
-			coordFileName.append(dataFileName);
-			coordFileName.append(".coord.");
-			coordFileName.append(Misc::ValueCoder<int>::encode(cpuLinearIndex));
-			IO::ValueSource coordReader(openFile(coordFileName,pipe));
-			coordReader.skipWs();
-			
-			/* Read and check the header line: */
-			try
+			cache->read(grid.getArray(),size_t(grid.getNumElements()));
+			}
+		
+		/* Read the stored spherical coordinates from the cache: */
+		for(int sliceIndex=0;sliceIndex<dataSet.getNumSlices();++sliceIndex)
+			cache->read(dataSet.getSliceArray(sliceIndex),dataSet.getTotalNumVertices());
+		std::cout<<" done"<<std::endl;
+		}
+	else
+		{
+		/* Read the grid coordinate files for all CPUs: */
+		std::cout<<"Reading grid vertex positions...   0%"<<std::flush;
+		int cpuCounter=0;
+		for(int surfaceIndex=0;surfaceIndex<numSurfaces;++surfaceIndex)
+			for(DS::Index cpuIndex(0);cpuIndex[0]<numCpus[0];cpuIndex.preInc(numCpus),++cpuCounter)
 				{
-				/* Skip the unknown value: */
-				coordReader.readInteger();
+				DS::GridArray& grid=dataSet.getGrid(surfaceIndex).getGrid();
 				
-				/* Read the number of vertices: */
-				if(coordReader.readInteger()!=totalCpuNumVertices)
-					Misc::throwStdErr("CitcomSGlobalASCIIFile::load: Mismatching grid size in coordinate file %s",coordFileName.c_str());
-				}
-			catch(IO::ValueSource::NumberError err)
-				{
-				Misc::throwStdErr("CitcomSGlobalASCIIFile::load: Invalid header line in coordinate file %s",coordFileName.c_str());
-				}
-			
-			/* Compute the CPU's base index in the surface's grid: */
-			DS::Index cpuBaseIndex;
-			for(int i=0;i<3;++i)
-				cpuBaseIndex[i]=(cpuNumVertices[i]-1)*cpuIndex[i];
-			
-			/* Read the grid vertices: */
-			DS::Index gridIndex;
-			for(gridIndex[1]=0;gridIndex[1]<cpuNumVertices[1];++gridIndex[1])
-				for(gridIndex[0]=0;gridIndex[0]<cpuNumVertices[0];++gridIndex[0])
-					for(gridIndex[2]=0;gridIndex[2]<cpuNumVertices[2];++gridIndex[2])
-						{
-						/* Read the next grid vertex: */
-						try
+				/* Open the CPU's coordinate file: */
+				int cpuLinearIndex=((surfaceIndex*numCpus[1]+cpuIndex[1])*numCpus[0]+cpuIndex[0])*numCpus[2]+cpuIndex[2];
+				std::string coordFileName=makeCoordFileName(dataDir,dataFileName,cpuLinearIndex);
+				BulkValueSource coordReader(openFile(coordFileName,pipe));
+				coordReader.skipWs();
+				
+				/* Read and check the header line: */
+				try
+					{
+					/* Skip the unknown value: */
+					coordReader.readInteger();
+					
+					/* Read the number of vertices: */
+					if(coordReader.readInteger()!=totalCpuNumVertices)
+						Misc::throwStdErr("CitcomSGlobalASCIIFile::load: Mismatching grid size in coordinate file %s",coordFileName.c_str());
+					}
+				catch(BulkValueSource::NumberError err)
+					{
+					Misc::throwStdErr("CitcomSGlobalASCIIFile::load: Invalid header line in coordinate file %s",coordFileName.c_str());
+					}
+				
+				/* Compute the CPU's base index in the surface's grid: */
+				DS::Index cpuBaseIndex;
+				for(int i=0;i<3;++i)
+					cpuBaseIndex[i]=(cpuNumVertices[i]-1)*cpuIndex[i];
+				
+				/* Read the grid vertices: */
+				coordReader.startRecords(totalCpuNumVertices,3,false);
+				DS::Index gridIndex;
+				for(gridIndex[1]=0;gridIndex[1]<cpuNumVertices[1];++gridIndex[1])
+					for(gridIndex[0]=0;gridIndex[0]<cpuNumVertices[0];++gridIndex[0])
+						for(gridIndex[2]=0;gridIndex[2]<cpuNumVertices[2];++gridIndex[2])
 							{
-							double colatitude=coordReader.readNumber();
-							double longitude=coordReader.readNumber();
-							double radius=coordReader.readNumber();
-							
-							/* Convert the vertex to Cartesian coordinates: */
-							double latitude=Math::rad(90.0)-colatitude;
-							double s0=Math::sin(latitude);
-							double c0=Math::cos(latitude);
-							double s1=Math::sin(longitude);
-							double c1=Math::cos(longitude);
-							double r=radius*a*scaleFactor;
-							double xy=r*c0;
-							DS::Index gIndex=cpuBaseIndex+gridIndex;
-							DS::Point& vertex=grid(gIndex);
-							vertex[0]=Scalar(xy*c1);
-							vertex[1]=Scalar(xy*s1);
-							vertex[2]=Scalar(r*s0);
-							
-							if(storeSphericals)
+							/* Read the next grid vertex: */
+							try
 								{
-								/* Store the original spherical coordinates as a scalar field: */
-								dataSet.getVertexValue(0,surfaceIndex,gIndex)=Scalar(Math::deg(colatitude));
-								dataSet.getVertexValue(1,surfaceIndex,gIndex)=Scalar(Math::deg(longitude));
-								dataSet.getVertexValue(2,surfaceIndex,gIndex)=Scalar(r);
+								const double* coords=coordReader.readRecord();
+								double colatitude=coords[0];
+								double longitude=coords[1];
+								double radius=coords[2];
+								
+								/* Convert the vertex to Cartesian coordinates: */
+								double latitude=Math::rad(90.0)-colatitude;
+								double s0=Math::sin(latitude);
+								double c0=Math::cos(latitude);
+								double s1=Math::sin(longitude);
+								double c1=Math::cos(longitude);
+								double r=radius*a*scaleFactor;
+								double xy=r*c0;
+								DS::Index gIndex=cpuBaseIndex+gridIndex;
+								DS::Point& vertex=grid(gIndex);
+								vertex[0]=Scalar(xy*c1);
+								vertex[1]=Scalar(xy*s1);
+								vertex[2]=Scalar(r*s0);
+								
+								if(storeSphericals)
+									{
+									/* Store the original spherical coordinates as a scalar field: */
+									dataSet.getVertexValue(0,surfaceIndex,gIndex)=Scalar(Math::deg(colatitude));
+									dataSet.getVertexValue(1,surfaceIndex,gIndex)=Scalar(Math::deg(longitude));
+									dataSet.getVertexValue(2,surfaceIndex,gIndex)=Scalar(r);
+									}
+								}
+							catch(BulkValueSource::NumberError err)
+								{
+								Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid vertex definition in coordinate file %s",coordFileName.c_str());
 								}
 							}
-						catch(IO::ValueSource::NumberError err)
-							{
-							Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid vertex definition in coordinate file %s",coordFileName.c_str());
-							}
-						}
-			if(master)
-				std::cout<<"\b\b\b\b"<<std::setw(3)<<((cpuCounter+1)*100)/(numSurfaces*numCpus.calcIncrement(-1))<<"%"<<std::flush;
-			}
-	if(master)
-		std::cout<<"\b\b\b\bdone"<<std::endl;
-
+				if(master)
+					std::cout<<"\b\b\b\b"<<std::setw(3)<<((cpuCounter+1)*100)/(numSurfaces*numCpus.calcIncrement(-1))<<"%"<<std::flush;
+				}
+		if(master)
+			std::cout<<"\b\b\b\bdone"<<std::endl;
+		}
+	
 	/* Finalize the grid structure: */
 	if(master)
 		std::cout<<"Finalizing grid structure..."<<std::flush;
@@ -208,24 +310,10 @@ Visualization::Abstract::DataSet* CitcomSGlobalASCIIFile::load(const std::vector
 	if(master)
 		std::cout<<" done"<<std::endl;
 	
-	/* Read the time step index given on the command line: */
-	++argIt;
-	bool isNumber=true;
-	int timeStepIndex=0;
-	for(std::string::const_iterator tiIt=argIt->begin();isNumber&&tiIt!=argIt->end();++tiIt)
-		{
-		if(*tiIt>='0'&&*tiIt<='9')
-			timeStepIndex=timeStepIndex*10+int(*tiIt-'0');
-		else
-			isNumber=false;
-		}
-	if(!isNumber)
-		Misc::throwStdErr("CitcomSGlobalASCIIFile::load: no time step index provided");
-	
 	/* Read all data components given on the command line: */
 	bool logNextScalar=false;
 	bool nextVector=false;
-	for(++argIt;argIt!=args.end();++argIt)
+	for(argIt=timeStepArgIt+1;argIt!=args.end();++argIt)
 		{
 		if(*argIt=="-log")
 			logNextScalar=true;
@@ -289,116 +377,120 @@ Visualization::Abstract::DataSet* CitcomSGlobalASCIIFile::load(const std::vector
 					}
 				}
 			
-			/* Read data files for all CPUs: */
-			cpuCounter=0;
-			for(int surfaceIndex=0;surfaceIndex<numSurfaces;++surfaceIndex)
-				for(DS::Index cpuIndex(0);cpuIndex[0]<numCpus[0];cpuIndex.preInc(numCpus),++cpuCounter)
-					{
-					DS::GridArray& grid=dataSet.getGrid(surfaceIndex).getGrid();
-					
-					/* Open the CPU's data value file: */
-					int cpuLinearIndex=((surfaceIndex*numCpus[1]+cpuIndex[1])*numCpus[0]+cpuIndex[0])*numCpus[2]+cpuIndex[2];
-					std::string dataValueFileName=dataDir;
-					dataValueFileName.append(dataFileName);
-					dataValueFileName.push_back('.');
-					dataValueFileName.append(*argIt);
-					dataValueFileName.push_back('.');
-					dataValueFileName.append(Misc::ValueCoder<int>::encode(cpuLinearIndex));
-					dataValueFileName.push_back('.');
-					dataValueFileName.append(Misc::ValueCoder<int>::encode(timeStepIndex));
-					IO::ValueSource dataValueReader(openFile(dataValueFileName,pipe));
-					dataValueReader.skipWs();
-					
-					/* Read and check the header line(s) in the data value file: */
-					try
+			if(haveCache)
+				{
+				/* Read the variable's slices from the cache: */
+				for(int i=sliceIndex;i<dataSet.getNumSlices();++i)
+					cache->read(dataSet.getSliceArray(i),dataSet.getTotalNumVertices());
+				}
+			else
+				{
+				/* Read data files for all CPUs: */
+				int cpuCounter=0;
+				for(int surfaceIndex=0;surfaceIndex<numSurfaces;++surfaceIndex)
+					for(DS::Index cpuIndex(0);cpuIndex[0]<numCpus[0];cpuIndex.preInc(numCpus),++cpuCounter)
 						{
-						int dataValueFileNumVertices1=totalCpuNumVertices;
-						if(isVeloFile)
+						DS::GridArray& grid=dataSet.getGrid(surfaceIndex).getGrid();
+						
+						/* Open the CPU's data value file: */
+						int cpuLinearIndex=((surfaceIndex*numCpus[1]+cpuIndex[1])*numCpus[0]+cpuIndex[0])*numCpus[2]+cpuIndex[2];
+						std::string dataValueFileName=makeDataValueFileName(dataDir,dataFileName,*argIt,cpuLinearIndex,timeStepIndex);
+						BulkValueSource dataValueReader(openFile(dataValueFileName,pipe));
+						dataValueReader.skipWs();
+						
+						/* Read and check the header line(s) in the data value file: */
+						try
 							{
-							/* Read the first header line only found in velo files: */
+							int dataValueFileNumVertices1=totalCpuNumVertices;
+							if(isVeloFile)
+								{
+								/* Read the first header line only found in velo files: */
+								dataValueReader.readInteger();
+								dataValueFileNumVertices1=dataValueReader.readInteger();
+								dataValueReader.readNumber();
+								}
+							
+							/* Read the common header line: */
 							dataValueReader.readInteger();
-							dataValueFileNumVertices1=dataValueReader.readInteger();
-							dataValueReader.readNumber();
+							int dataValueFileNumVertices2=dataValueReader.readInteger();
+							
+							/* Check for consistency: */
+							if(dataValueFileNumVertices1!=totalCpuNumVertices||dataValueFileNumVertices2!=totalCpuNumVertices)
+								Misc::throwStdErr("CitcomSGlobalASCIIFile::load: Mismatching grid size in data value file %s",dataValueFileName.c_str());
+							}
+						catch(BulkValueSource::NumberError err)
+							{
+							Misc::throwStdErr("CitcomSGlobalASCIIFile::load: Invalid header line in data value file %s",dataValueFileName.c_str());
 							}
 						
-						/* Read the common header line: */
-						dataValueReader.readInteger();
-						int dataValueFileNumVertices2=dataValueReader.readInteger();
+						/* Compute the CPU's base index in the surface's grid: */
+						DS::Index cpuBaseIndex;
+						for(int i=0;i<3;++i)
+							cpuBaseIndex[i]=(cpuNumVertices[i]-1)*cpuIndex[i];
 						
-						/* Check for consistency: */
-						if(dataValueFileNumVertices1!=totalCpuNumVertices||dataValueFileNumVertices2!=totalCpuNumVertices)
-							Misc::throwStdErr("CitcomSGlobalASCIIFile::load: Mismatching grid size in data value file %s",dataValueFileName.c_str());
-						}
-					catch(IO::ValueSource::NumberError err)
-						{
-						Misc::throwStdErr("CitcomSGlobalASCIIFile::load: Invalid header line in data value file %s",dataValueFileName.c_str());
-						}
-					
-					/* Compute the CPU's base index in the surface's grid: */
-					DS::Index cpuBaseIndex;
-					for(int i=0;i<3;++i)
-						cpuBaseIndex[i]=(cpuNumVertices[i]-1)*cpuIndex[i];
-					
-					/* Read the grid vertices: */
-					DS::Index gridIndex;
-					for(gridIndex[1]=0;gridIndex[1]<cpuNumVertices[1];++gridIndex[1])
-						for(gridIndex[0]=0;gridIndex[0]<cpuNumVertices[0];++gridIndex[0])
-							for(gridIndex[2]=0;gridIndex[2]<cpuNumVertices[2];++gridIndex[2])
-								{
-								/* Read the next vertex' value: */
-								DS::Index index=cpuBaseIndex+gridIndex;
-								
-								try
+						/* Read the grid vertices: */
+						dataValueReader.startRecords(totalCpuNumVertices,isVeloFile?4:nextVector?3:1,false);
+						DS::Index gridIndex;
+						for(gridIndex[1]=0;gridIndex[1]<cpuNumVertices[1];++gridIndex[1])
+							for(gridIndex[0]=0;gridIndex[0]<cpuNumVertices[0];++gridIndex[0])
+								for(gridIndex[2]=0;gridIndex[2]<cpuNumVertices[2];++gridIndex[2])
 									{
-									if(isVeloFile||nextVector)
+									/* Read the next vertex' value: */
+									DS::Index index=cpuBaseIndex+gridIndex;
+									
+									try
 										{
-										/* Read the vector components: */
-										double colatitude=dataValueReader.readNumber();
-										double longitude=dataValueReader.readNumber();
-										double radius=dataValueReader.readNumber();
-										
-										/* Convert the vector from spherical to Cartesian coordinates: */
-										const DS::Point& p=grid(index);
-										double xy=Math::sqr(double(p[0]))+Math::sqr(double(p[1]));
-										double r=xy+Math::sqr(double(p[2]));
-										xy=Math::sqrt(xy);
-										r=Math::sqrt(r);
-										double s0=double(p[2])/r;
-										double c0=xy/r;
-										double s1=double(p[1])/xy;
-										double c1=double(p[0])/xy;
-										DataValue::VVector vector;
-										vector[0]=VScalar(c1*(c0*radius+s0*colatitude)-s1*longitude);
-										vector[1]=VScalar(s1*(c0*radius+s0*colatitude)+c1*longitude);
-										vector[2]=VScalar(s0*radius-c0*colatitude);
-										dataSet.getVertexValue(sliceIndex+0,surfaceIndex,index)=VScalar(colatitude);
-										dataSet.getVertexValue(sliceIndex+1,surfaceIndex,index)=VScalar(longitude);
-										dataSet.getVertexValue(sliceIndex+2,surfaceIndex,index)=VScalar(radius);
-										for(int i=0;i<3;++i)
-											dataSet.getVertexValue(sliceIndex+3+i,surfaceIndex,index)=vector[i];
-										dataSet.getVertexValue(sliceIndex+6,surfaceIndex,index)=VScalar(Geometry::mag(vector));
-										
-										if(isVeloFile)
+										const double* values=dataValueReader.readRecord();
+										if(isVeloFile||nextVector)
+											{
+											/* Read the vector components: */
+											double colatitude=values[0];
+											double longitude=values[1];
+											double radius=values[2];
+											
+											/* Convert the vector from spherical to Cartesian coordinates: */
+											const DS::Point& p=grid(index);
+											double xy=Math::sqr(double(p[0]))+Math::sqr(double(p[1]));
+											double r=xy+Math::sqr(double(p[2]));
+											xy=Math::sqrt(xy);
+											r=Math::sqrt(r);
+											double s0=double(p[2])/r;
+											double c0=xy/r;
+											double s1=double(p[1])/xy;
+											double c1=double(p[0])/xy;
+											DataValue::VVector vector;
+											vector[0]=VScalar(c1*(c0*radius+s0*colatitude)-s1*longitude);
+											vector[1]=VScalar(s1*(c0*radius+s0*colatitude)+c1*longitude);
+											vector[2]=VScalar(s0*radius-c0*colatitude);
+											dataSet.getVertexValue(sliceIndex+0,surfaceIndex,index)=VScalar(colatitude);
+											dataSet.getVertexValue(sliceIndex+1,surfaceIndex,index)=VScalar(longitude);
+											dataSet.getVertexValue(sliceIndex+2,surfaceIndex,index)=VScalar(radius);
+											for(int i=0;i<3;++i)
+												dataSet.getVertexValue(sliceIndex+3+i,surfaceIndex,index)=vector[i];
+											dataSet.getVertexValue(sliceIndex+6,surfaceIndex,index)=VScalar(Geometry::mag(vector));
+											
+											if(isVeloFile)
+												{
+												/* Read the temperature value: */
+												double temp=values[3];
+												dataSet.getVertexValue(sliceIndex+7,surfaceIndex,index)=logNextScalar?VScalar(Math::log10(temp)):VScalar(temp);
+												}
+											}
+										else
 											{
-											/* Read the temperature value: */
-											double temp=dataValueReader.readNumber();
-											dataSet.getVertexValue(sliceIndex+7,surfaceIndex,index)=logNextScalar?VScalar(Math::log10(temp)):VScalar(temp);
+											/* Read the scalar value: */
+											double value=values[0];
+											dataSet.getVertexValue(sliceIndex,surfaceIndex,index)=logNextScalar?VScalar(Math::log10(value)):VScalar(value);
 											}
 										}
-									else
+									catch(BulkValueSource::NumberError err)
 										{
-										/* Read the scalar value: */
-										double value=dataValueReader.readNumber();
-										dataSet.getVertexValue(sliceIndex,surfaceIndex,index)=logNextScalar?VScalar(Math::log10(value)):VScalar(value);
+										Misc::throwStdErr("CitcomSGlobalASCIIFile::load: Invalid vertex value definition in data value file %s",dataValueFileName.c_str());
 										}
 									}
-								catch(IO::ValueSource::NumberError err)
-									{
-									Misc::throwStdErr("CitcomSGlobalASCIIFile::load: Invalid vertex value definition in data value file %s",dataValueFileName.c_str());
-									}
-								}
-				if(master)
-					std::cout<<"\b\b\b\b"<<std::setw(3)<<((cpuCounter+1)*100)/(numSurfaces*numCpus.calcIncrement(-1))<<"%"<<std::flush;
+					if(master)
+						std::cout<<"\b\b\b\b"<<std::setw(3)<<((cpuCounter+1)*100)/(numSurfaces*numCpus.calcIncrement(-1))<<"%"<<std::flush;
+					}
 				}
 			if(master)
 				std::cout<<"\b\b\b\bdone"<<std::endl;
@@ -410,6 +502,38 @@ Visualization::Abstract::DataSet* CitcomSGlobalASCIIFile::load(const std::vector
 			}
 		}
 	
+	if(useCache&&!haveCache&&pipe==0)
+		{
+		/* Save the grid and all variables to the cache for the next session: */
+		try
+			{
+			cache->create();
+			for(int surfaceIndex=0;surfaceIndex<numSurfaces;++surfaceIndex)
+				{
+				const DS::GridArray& grid=dataSet.getGrid(surfaceIndex).getGrid();
+				cache->write(grid.getArray(),size_t(grid.getNumElements()));
+				}
+			for(int sliceIndex=0;sliceIndex<dataSet.getNumSlices();++sliceIndex)
+				cache->write(dataSet.getSliceArray(sliceIndex),dataSet.getTotalNumVertices());
+			cache->finish();
+			}
+		catch(std::runtime_error err)
+			{
+			std::cerr<<"CitcomSGlobalASCIIFile::load: Could not write cache file due to exception "<<err.what()<<std::endl;
+			}
+		}
+	
+	if(compactEncoding>=0)
+		{
+		/* Replace all slices with their compact representations: */
+		if(master)
+			std::cout<<"Compacting variables..."<<std::flush;
+		for(int sliceIndex=0;sliceIndex<dataSet.getNumSlices();++sliceIndex)
+			dataSet.compactSlice(sliceIndex,Visualization::Templatized::CompactSlice::Encoding(compactEncoding));
+		if(master)
+			std::cout<<" done"<<std::endl;
+		}
+	
 	/* Return the result data set: */
 	return result.releaseTarget();
 	}
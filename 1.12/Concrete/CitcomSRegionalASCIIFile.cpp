@@ -31,7 +31,6 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Misc/StandardValueCoders.h>
 #include <Plugins/FactoryManager.h>
 #include <IO/OpenFile.h>
-#include <IO/ValueSource.h>
 #include <Cluster/MulticastPipe.h>
 #include <Math/Math.h>
 #include <Math/Constants.h>
@@ -39,6 +38,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Concrete/SphericalCoordinateTransformer.h>
 #include <Concrete/EarthDataSet.h>
 #include <Concrete/CitcomSCfgFileParser.h>
+#include <Concrete/BulkValueSource.h>
 
 namespace Visualization {
 
@@ -133,7 +133,7 @@ Visualization::Abstract::DataSet* CitcomSRegionalASCIIFile::load(const std::vect
 		coordFileName.append(dataFileName);
 		coordFileName.append(".coord.");
 		coordFileName.append(Misc::ValueCoder<int>::encode(cpuLinearIndex));
-		IO::ValueSource coordReader(openFile(coordFileName,pipe));
+		BulkValueSource coordReader(openFile(coordFileName,pipe));
 		coordReader.skipWs();
 		
 		/* Read and check the header line: */
@@ -146,7 +146,7 @@ Visualization::Abstract::DataSet* CitcomSRegionalASCIIFile::load(const std::vect
 			if(coordReader.readInteger()!=totalCpuNumVertices)
 				Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Mismatching grid size in coordinate file %s",coordFileName.c_str());
 			}
-		catch(IO::ValueSource::NumberError err)
+		catch(BulkValueSource::NumberError err)
 			{
 			Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid header line in coordinate file %s",coordFileName.c_str());
 			}
@@ -157,6 +157,7 @@ Visualization::Abstract::DataSet* CitcomSRegionalASCIIFile::load(const std::vect
 			cpuBaseIndex[i]=(cpuNumVertices[i]-1)*cpuIndex[i];
 		
 		/* Read the grid vertices: */
+		coordReader.startRecords(totalCpuNumVertices,3,false);
 		DS::Index gridIndex;
 		for(gridIndex[1]=0;gridIndex[1]<cpuNumVertices[1];++gridIndex[1])
 			for(gridIndex[0]=0;gridIndex[0]<cpuNumVertices[0];++gridIndex[0])
@@ -165,9 +166,10 @@ Visualization::Abstract::DataSet* CitcomSRegionalASCIIFile::load(const std::vect
 					/* Read the next grid vertex: */
 					try
 						{
-						double colatitude=coordReader.readNumber();
-						double longitude=coordReader.readNumber();
-						double radius=coordReader.readNumber();
+						const double* coords=coordReader.readRecord();
+						double colatitude=coords[0];
+						double longitude=coords[1];
+						double radius=coords[2];
 						
 						/* Convert the vertex to Cartesian coordinates: */
 						double latitude=Math::rad(90.0)-colatitude;
@@ -191,7 +193,7 @@ Visualization::Abstract::DataSet* CitcomSRegionalASCIIFile::load(const std::vect
 							dataSet.getVertexValue(2,gIndex)=Scalar(r);
 							}
 						}
-					catch(IO::ValueSource::NumberError err)
+					catch(BulkValueSource::NumberError err)
 						{
 						Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid vertex definition in coordinate file %s",coordFileName.c_str());
 						}
@@ -305,7 +307,7 @@ Visualization::Abstract::DataSet* CitcomSRegionalASCIIFile::load(const std::vect
 				dataValueFileName.append(Misc::ValueCoder<int>::encode(cpuLinearIndex));
 				dataValueFileName.push_back('.');
 				dataValueFileName.append(Misc::ValueCoder<int>::encode(timeStepIndex));
-				IO::ValueSource dataValueReader(openFile(dataValueFileName,pipe));
+				BulkValueSource dataValueReader(openFile(dataValueFileName,pipe));
 				dataValueReader.skipWs();
 				
 				/* Read and check the header line(s) in the data value file: */
@@ -328,7 +330,7 @@ Visualization::Abstract::DataSet* CitcomSRegionalASCIIFile::load(const std::vect
 					if(dataValueFileNumVertices1!=totalCpuNumVertices||dataValueFileNumVertices2!=totalCpuNumVertices)
 						Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Mismatching grid size in data value file %s",dataValueFileName.c_str());
 					}
-				catch(IO::ValueSource::NumberError err)
+				catch(BulkValueSource::NumberError err)
 					{
 					Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid header line in data value file %s",dataValueFileName.c_str());
 					}
@@ -339,6 +341,7 @@ Visualization::Abstract::DataSet* CitcomSRegionalASCIIFile::load(const std::vect
 					cpuBaseIndex[i]=(cpuNumVertices[i]-1)*cpuIndex[i];
 				
 				/* Read the grid vertices: */
+				dataValueReader.startRecords(totalCpuNumVertices,isVeloFile?4:nextVector?3:1,false);
 				DS::Index gridIndex;
 				for(gridIndex[1]=0;gridIndex[1]<cpuNumVertices[1];++gridIndex[1])
 					for(gridIndex[0]=0;gridIndex[0]<cpuNumVertices[0];++gridIndex[0])
@@ -349,12 +352,13 @@ Visualization::Abstract::DataSet* CitcomSRegionalASCIIFile::load(const std::vect
 							
 							try
 								{
+								const double* values=dataValueReader.readRecord();
 								if(isVeloFile||nextVector)
 									{
 									/* Read the vector components: */
-									double colatitude=dataValueReader.readNumber();
-									double longitude=dataValueReader.readNumber();
-									double radius=dataValueReader.readNumber();
+									double colatitude=values[0];
+									double longitude=values[1];
+									double radius=values[2];
 									
 									/* Convert the vector from spherical to Cartesian coordinates: */
 									const DS::Point& p=grid(index);
@@ -380,18 +384,18 @@ Visualization::Abstract::DataSet* CitcomSRegionalASCIIFile::load(const std::vect
 									if(isVeloFile)
 										{
 										/* Read the temperature value: */
-										double temp=dataValueReader.readNumber();
+										double temp=values[3];
 										dataSet.getVertexValue(sliceIndex+7,index)=logNextScalar?VScalar(Math::log10(temp)):VScalar(temp);
 										}
 									}
 								else
 									{
 									/* Read the scalar value: */
-									double value=dataValueReader.readNumber();
+									double value=values[0];
 									dataSet.getVertexValue(sliceIndex,index)=logNextScalar?VScalar(Math::log10(value)):VScalar(value);
 									}
 								}
-							catch(IO::ValueSource::NumberError err)
+							catch(BulkValueSource::NumberError err)
 								{
 								Misc::throwStdErr("CitcomSRegionalASCIIFile::load: Invalid vertex value definition in data value file %s",dataValueFileName.c_str());
 								}
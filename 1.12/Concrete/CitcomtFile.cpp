@@ -54,6 +54,7 @@ Visualization::Abstract::DataSet* CitcomtFile::load(const std::vector<std::strin
 	{
 	/* Open the data file: */
 	Misc::File dataFile(args[0].c_str(),"rt");
+	addSourceFile(args[0],false);
 	
 	/* Check if the user wants to load a specific variable: */
 	bool logScale=false;
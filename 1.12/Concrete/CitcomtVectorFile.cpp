@@ -54,6 +54,7 @@ Visualization::Abstract::DataSet* CitcomtVectorFile::load(const std::vector<std:
 	{
 	/* Open the data file: */
 	Misc::File dataFile(args[0].c_str(),"rt");
+	addSourceFile(args[0],false);
 	
 	/* Check if the user wants to load a specific variable: */
 	bool logScale=false;
@@ -287,6 +288,7 @@ Visualization::Abstract::DataSet* CitcomtVectorFile::load(const std::vector<std:
 	
 	/* Read all vertex positions and values: */
 	Misc::File vectorFile(args[1].c_str(),"rt");
+	addSourceFile(args[1],false);
 	std::cout<<"Reading grid vertex positions and values...   0%"<<std::flush;
 	DS::Array& vertices=result->getDs().getVertices();
 	DS::Index index;
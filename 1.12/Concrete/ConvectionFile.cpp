@@ -44,6 +44,7 @@ Visualization::Abstract::DataSet* ConvectionFile::load(const std::vector<std::st
 	{
 	/* Open the data file: */
 	Misc::File dataFile(args[0].c_str(),"rt");
+	addSourceFile(args[0],false);
 	
 	char line[256];
 	
@@ -0,0 +1,225 @@
+/***********************************************************************
+DataSetCache - Helper class to store the bulk arrays of a loaded data
+set in a binary file next to its source files, keyed by the module
+arguments and the sizes and modification times of all source files.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Concrete/DataSetCache.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdexcept>
+#include <Misc/SizedTypes.h>
+#include <Misc/ThrowStdErr.h>
+#include <Misc/File.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+namespace {
+
+/**************
+Helper objects:
+**************/
+
+const char cacheFileHeader[]="Visualizer data set cache v1.1"; // Identifier at the beginning of data set cache files
+const unsigned int endiannessMarker=0x01020304U; // Marker to reject cache files written on machines of different endianness
+
+}
+
+/*****************************
+Methods of class DataSetCache:
+*****************************/
+
+void DataSetCache::readRaw(void* data,size_t size)
+	{
+	/* Skip the padding aligning all arrays to eight bytes: */
+	readOffset=(readOffset+7)&~size_t(7);
+	if(readOffset+size>readFileSize)
+		Misc::throwStdErr("DataSetCache::read: Cache file %s is truncated",cacheFileName.c_str());
+	
+	/* Read the array straight into the destination buffer: */
+	char* dataPtr=static_cast<char*>(data);
+	while(size>0)
+		{
+		ssize_t readSize=pread(readFd,dataPtr,size,off_t(readOffset));
+		if(readSize<0&&errno==EINTR)
+			continue;
+		if(readSize<=0)
+			Misc::throwStdErr("DataSetCache::read: Error while reading cache file %s",cacheFileName.c_str());
+		dataPtr+=readSize;
+		size-=size_t(readSize);
+		readOffset+=size_t(readSize);
+		}
+	}
+
+void DataSetCache::writeRaw(const void* data,size_t size)
+	{
+	/* Pad the file to align all arrays to eight bytes: */
+	static const char padding[8]={0,0,0,0,0,0,0,0};
+	size_t paddingSize=((writeOffset+7)&~size_t(7))-writeOffset;
+	if(paddingSize>0)
+		writeFile->write<char>(padding,paddingSize);
+	
+	writeFile->write<char>(static_cast<const char*>(data),size);
+	writeOffset+=paddingSize+size;
+	}
+
+DataSetCache::DataSetCache(const std::string& sCacheFileName,const std::vector<std::string>& args)
+	:cacheFileName(sCacheFileName),
+	 readFd(-1),readFileSize(0),readOffset(0),
+	 writeFile(0),writeOffset(0),payloadSizeOffset(0),payloadOffset(0)
+	{
+	/* Start the key with the module arguments: */
+	for(std::vector<std::string>::const_iterator aIt=args.begin();aIt!=args.end();++aIt)
+		{
+		key.append(*aIt);
+		key.push_back('\n');
+		}
+	}
+
+DataSetCache::~DataSetCache(void)
+	{
+	/* Close the cache file: */
+	if(readFd>=0)
+		close(readFd);
+	
+	if(writeFile!=0)
+		{
+		/* Remove the incomplete new cache file: */
+		delete writeFile;
+		unlink((cacheFileName+".tmp").c_str());
+		}
+	}
+
+void DataSetCache::addSourceFile(const std::string& sourceFileName)
+	{
+	/* Get the source file's size and modification time: */
+	struct stat sourceFileStats;
+	if(stat(sourceFileName.c_str(),&sourceFileStats)!=0)
+		Misc::throwStdErr("DataSetCache::addSourceFile: Could not access source file %s",sourceFileName.c_str());
+	
+	/* Append the source file's name and stamp to the key: */
+	char stamp[64];
+	snprintf(stamp,sizeof(stamp)," %.0f %.0f\n",double(sourceFileStats.st_size),double(sourceFileStats.st_mtime));
+	key.append(sourceFileName);
+	key.append(stamp);
+	}
+
+bool DataSetCache::open(void)
+	{
+	/* Open the cache file and get its size: */
+	readFd=::open(cacheFileName.c_str(),O_RDONLY);
+	if(readFd<0)
+		return false;
+	struct stat cacheFileStats;
+	if(fstat(readFd,&cacheFileStats)!=0||cacheFileStats.st_size<=0)
+		{
+		close(readFd);
+		readFd=-1;
+		return false;
+		}
+	readFileSize=size_t(cacheFileStats.st_size);
+	readOffset=0;
+	
+	/* Check the file identifier, endianness, and key: */
+	bool valid=false;
+	try
+		{
+		char header[sizeof(cacheFileHeader)];
+		read<char>(header,sizeof(cacheFileHeader));
+		unsigned int marker;
+		read<unsigned int>(&marker,1);
+		unsigned int keyLength;
+		read<unsigned int>(&keyLength,1);
+		if(memcmp(header,cacheFileHeader,sizeof(cacheFileHeader))==0&&marker==endiannessMarker&&keyLength==key.length())
+			{
+			std::vector<char> cacheKey(keyLength+1);
+			read<char>(&cacheKey[0],keyLength);
+			Misc::UInt64 payloadSize;
+			read<Misc::UInt64>(&payloadSize,1);
+			
+			/* Treat cache files whose payload was cut short or extended as stale: */
+			valid=memcmp(&cacheKey[0],key.data(),keyLength)==0&&Misc::UInt64(readOffset)+payloadSize==Misc::UInt64(readFileSize);
+			}
+		}
+	catch(std::runtime_error)
+		{
+		/* Treat truncated cache files as stale: */
+		}
+	
+	if(!valid)
+		{
+		/* Close the stale cache file: */
+		close(readFd);
+		readFd=-1;
+		readFileSize=0;
+		}
+	
+	return valid;
+	}
+
+void DataSetCache::create(void)
+	{
+	/* Create a temporary cache file to not clobber the current one until the new one is complete: */
+	writeFile=new Misc::File((cacheFileName+".tmp").c_str(),"wb");
+	writeOffset=0;
+	
+	/* Write the file identifier, endianness marker, and key: */
+	write<char>(cacheFileHeader,sizeof(cacheFileHeader));
+	write<unsigned int>(&endiannessMarker,1);
+	unsigned int keyLength=(unsigned int)key.length();
+	write<unsigned int>(&keyLength,1);
+	write<char>(key.data(),key.length());
+	
+	/* Write a placeholder for the payload size, to be filled in when the cache file is finished: */
+	Misc::UInt64 payloadSize=0;
+	write<Misc::UInt64>(&payloadSize,1);
+	payloadSizeOffset=writeOffset-sizeof(Misc::UInt64);
+	payloadOffset=writeOffset;
+	}
+
+void DataSetCache::finish(void)
+	{
+	/* Fill in the total size of the payload following the header: */
+	Misc::UInt64 payloadSize=Misc::UInt64(writeOffset-payloadOffset);
+	writeFile->seekSet(payloadSizeOffset);
+	writeFile->write<Misc::UInt64>(&payloadSize,1);
+	
+	/* Close the temporary cache file and move it into place: */
+	delete writeFile;
+	writeFile=0;
+	std::string tempFileName=cacheFileName+".tmp";
+	if(rename(tempFileName.c_str(),cacheFileName.c_str())!=0)
+		{
+		unlink(tempFileName.c_str());
+		Misc::throwStdErr("DataSetCache::finish: Could not replace cache file %s",cacheFileName.c_str());
+		}
+	}
+
+}
+
+}
@@ -0,0 +1,88 @@
+/***********************************************************************
+DataSetCache - Helper class to store the bulk arrays of a loaded data
+set in a binary file next to its source files, keyed by the module
+arguments and the sizes and modification times of all source files.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_CONCRETE_DATASETCACHE_INCLUDED
+#define VISUALIZATION_CONCRETE_DATASETCACHE_INCLUDED
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+/* Forward declarations: */
+namespace Misc {
+class File;
+}
+
+namespace Visualization {
+
+namespace Concrete {
+
+class DataSetCache
+	{
+	/* Elements: */
+	private:
+	std::string cacheFileName; // Name of the cache file
+	std::string key; // Description of the cached data set's sources, stored in the cache file to detect stale caches
+	int readFd; // File descriptor of a valid cache file, or -1
+	size_t readFileSize; // Size of the valid cache file in bytes
+	size_t readOffset; // Offset of the next array in the cache file
+	Misc::File* writeFile; // Temporary cache file while a new cache is written, or 0
+	size_t writeOffset; // Offset of the next array in the temporary cache file
+	size_t payloadSizeOffset; // Offset of the payload size field in the temporary cache file's header
+	size_t payloadOffset; // Offset of the first array following the temporary cache file's header
+	
+	/* Private methods: */
+	void readRaw(void* data,size_t size); // Reads the next array from the cache file directly into the given buffer
+	void writeRaw(const void* data,size_t size); // Appends an array to the temporary cache file
+	
+	/* Constructors and destructors: */
+	public:
+	DataSetCache(const std::string& sCacheFileName,const std::vector<std::string>& args); // Creates a cache of the given name for a data set loaded with the given module arguments
+	private:
+	DataSetCache(const DataSetCache& source); // Prohibit copy constructor
+	DataSetCache& operator=(const DataSetCache& source); // Prohibit assignment operator
+	public:
+	~DataSetCache(void); // Closes the cache file, and removes an incomplete new cache file
+	
+	/* Methods: */
+	void addSourceFile(const std::string& sourceFileName); // Adds the size and modification time of the given source file to the cache key
+	bool open(void); // Opens the cache file for reading; returns true if the cache file exists, matches the current module arguments and source files, and has the payload size recorded in its header
+	template <class DataParam>
+	void read(DataParam* data,size_t numItems) // Reads the next array of the given number of items from the cache file
+		{
+		readRaw(data,numItems*sizeof(DataParam));
+		}
+	void create(void); // Starts writing a new cache file for the current module arguments and source files
+	template <class DataParam>
+	void write(const DataParam* data,size_t numItems) // Appends an array of the given number of items to the new cache file
+		{
+		writeRaw(data,numItems*sizeof(DataParam));
+		}
+	void finish(void); // Replaces the cache file with the completely written new cache file
+	};
+
+}
+
+}
+
+#endif
@@ -33,12 +33,57 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Plugins/FactoryManager.h>
 #include <Cluster/OpenFile.h>
 
+#include <Templatized/VolumeFilter.h>
 #include <Concrete/DicomFile.h>
+#include <Concrete/ImageSliceLoader.h>
 
 namespace Visualization {
 
 namespace Concrete {
 
+namespace {
+
+/**************
+Helper classes:
+**************/
+
+class DicomSliceLoader:public ImageSliceLoader // Class to decode the images of a DICOM image stack into the slices of the data set
+	{
+	/* Elements: */
+	private:
+	Cluster::MulticastPipe* pipe; // Pipe to read image files in a cluster environment
+	const DicomFile::ImageStackDescriptor& isd; // Descriptor of the image stack
+	bool flip; // Flag whether to store the images in reverse stack order
+	DS::Array& vertices; // The data set's vertex array
+	ptrdiff_t increments[2]; // Pointer increments between neighboring pixels in an image slice
+	
+	/* Protected methods from ImageSliceLoader: */
+	protected:
+	virtual void loadSlice(int sliceIndex)
+		{
+		/* Open the slice DICOM file: */
+		DicomFile dcm(isd.imageFileNames[sliceIndex],Cluster::openFile(pipe!=0?pipe->getMultiplexer():0,isd.imageFileNames[sliceIndex]));
+		
+		/* Read the slice image descriptor: */
+		Misc::SelfDestructPointer<DicomFile::ImageDescriptor> id(dcm.readImageDescriptor());
+		
+		/* Read the slice image: */
+		Value* sliceBase=vertices.getAddress(flip?isd.numImages-sliceIndex-1:sliceIndex,0,0);
+		dcm.readImage(*id,sliceBase,increments);
+		}
+	
+	/* Constructors and destructors: */
+	public:
+	DicomSliceLoader(Cluster::MulticastPipe* sPipe,const DicomFile::ImageStackDescriptor& sIsd,bool sFlip,DS::Array& sVertices)
+		:pipe(sPipe),isd(sIsd),flip(sFlip),vertices(sVertices)
+		{
+		increments[0]=vertices.getIncrement(2);
+		increments[1]=vertices.getIncrement(1);
+		}
+	};
+
+}
+
 /********************************
 Methods of class DicomImageStack:
 ********************************/
@@ -54,6 +99,8 @@ Visualization::Abstract::DataSet* DicomImageStack::load(const std::vector<std::s
 	std::string fileName;
 	int seriesNumber=-1;
 	bool flip=false;
+	bool medianFilter=false;
+	bool lowpassFilter=false;
 	for(std::vector<std::string>::const_iterator aIt=args.begin();aIt!=args.end();++aIt)
 		{
 		if((*aIt)[0]=='-')
@@ -65,6 +112,10 @@ Visualization::Abstract::DataSet* DicomImageStack::load(const std::vector<std::s
 				}
 			else if(strcasecmp(aIt->c_str()+1,"flip")==0)
 				flip=true;
+			else if(strcasecmp(aIt->c_str()+1,"medianFilter")==0)
+				medianFilter=true;
+			else if(strcasecmp(aIt->c_str()+1,"lowpassFilter")==0)
+				lowpassFilter=true;
 			}
 		else if(fileName.empty())
 			fileName=getFullPath(*aIt);
@@ -110,21 +161,18 @@ Visualization::Abstract::DataSet* DicomImageStack::load(const std::vector<std::s
 	DS::Size cellSize(isd->sliceThickness,isd->pixelSize[1],isd->pixelSize[0]);
 	result->getDs().setData(numVertices,cellSize);
 	
-	/* Read each slice: */
-	ptrdiff_t increments[2];
-	increments[0]=result->getDs().getVertices().getIncrement(2);
-	increments[1]=result->getDs().getVertices().getIncrement(1);
-	for(int i=0;i<isd->numImages;++i)
+	/* Decode all slices, in parallel unless the slice files have to be read in order through the multicast pipe: */
+	DicomSliceLoader sliceLoader(pipe,*isd,flip,result->getDs().getVertices());
+	sliceLoader.load(isd->numImages,false,pipe==0);
+	
+	if(medianFilter||lowpassFilter)
 		{
-		/* Open the slice DICOM file: */
-		DicomFile dcm(isd->imageFileNames[i],Cluster::openFile(pipe!=0?pipe->getMultiplexer():0,isd->imageFileNames[i]));
-		
-		/* Read the slice image descriptor: */
-		Misc::SelfDestructPointer<DicomFile::ImageDescriptor> id(dcm.readImageDescriptor());
-		
-		/* Read the slice image: */
-		Value* sliceBase=result->getDs().getVertices().getAddress(flip?isd->numImages-i-1:i,0,0);
-		dcm.readImage(*id,sliceBase,increments);
+		/* Run a median + lowpass filter on all slice triples to reduce random speckle: */
+		Visualization::Templatized::VolumeFilter<Value> filter(result->getDs().getVertices());
+		if(medianFilter)
+			filter.medianFilter(0);
+		if(lowpassFilter)
+			filter.lowpassFilter(0);
 		}
 	
 	return result.releaseTarget();
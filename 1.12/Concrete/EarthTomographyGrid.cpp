@@ -190,6 +190,7 @@ Visualization::Abstract::DataSet* EarthTomographyGrid::load(const std::vector<st
 		gridFileName.push_back('/');
 		gridFileName.append(gridFiles[vertices.getSize(0)-1-index[0]].fileName);
 		Misc::File gridFile(gridFileName.c_str(),"rt");
+		addSourceFile(gridFileName,false);
 		double depth=double(gridFiles[vertices.getSize(0)-1-index[0]].depth)*1000.0;
 		
 		/* Constant parameters for geoid formula: */
@@ -57,6 +57,7 @@ Visualization::Abstract::DataSet* ExampleModule::load(const std::vector<std::str
 	
 	/* Open the input file: */
 	FILE* file=fopen(args[0].c_str(),"rt"); // args[0] is the first module command line parameter
+	addSourceFile(args[0],false); // Files not opened through openFile must be recorded for the statistics cache
 	
 	/* Read the input file's header: */
 	DS::Index numVertices; // DS::Index is a helper type containing three integers NI, NJ, NK
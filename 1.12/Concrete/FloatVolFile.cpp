@@ -42,6 +42,7 @@ Visualization::Abstract::DataSet* FloatVolFile::load(const std::vector<std::stri
 	{
 	/* Open the volume file: */
 	Misc::File file(args[0].c_str(),"rb",Misc::File::BigEndian);
+	addSourceFile(args[0],false);
 	
 	/* Read the volume file header: */
 	int volSize[3];
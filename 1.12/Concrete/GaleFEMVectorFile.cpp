@@ -50,6 +50,7 @@ Visualization::Abstract::DataSet* GaleFEMVectorFile::load(const std::vector<std:
 	{
 	/* Open the data file: */
 	Misc::File dataFile(args[0].c_str(),"rt");
+	addSourceFile(args[0],false);
 	
 	/* Create result data set: */
 	DS::Index numVertices(33,33,33); // Hard-coded; there is no dimension field in the data file
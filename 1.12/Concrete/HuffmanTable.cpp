@@ -87,21 +87,41 @@ HuffmanTable::HuffmanTable(int sBits[17],unsigned char sValues[256])
 		}
 	maxcode[17]=0xfffff;
 	
-	/* Build look-up table from numBits to value to quickly identify short Huffman codes: */
-	for(p=0;p<256;++p)
+	/* Build look-up tables from lookahead bit patterns to quickly identify short Huffman codes: */
+	for(p=0;p<(1<<lookaheadBits);++p)
+		{
 		numBits[p]=0;
+		numDiffBits[p]=0;
+		}
 	for(p=0;p<lastP;++p)
 		{
 		int size=huffmanSizes[p];
-		if(size<=8)
+		if(size<=lookaheadBits)
 			{
-			/* Calculate the range of bytes that start with the short Huffman code: */
-			int ll=int(huffmanCodes[p])<<(8-size);
-			int ul=ll|((0x1<<(8-size))-1);
+			/* Calculate the range of bit patterns that start with the short Huffman code: */
+			int ll=int(huffmanCodes[p])<<(lookaheadBits-size);
+			int ul=ll|((0x1<<(lookaheadBits-size))-1);
+			int s=values[p];
 			for(int i=ll;i<=ul;++i)
 				{
 				numBits[i]=size;
 				value[i]=values[p];
+				
+				/* Check if the difference bits following the code are contained in the bit pattern as well: */
+				if(s==0)
+					{
+					numDiffBits[i]=size;
+					diff[i]=0;
+					}
+				else if(s<16&&size+s<=lookaheadBits)
+					{
+					/* Decode the signed difference the same way as BitBuffer::getSignedBits: */
+					int d=(i>>(lookaheadBits-size-s))&((0x1<<s)-1);
+					if(d<(0x1<<(s-1)))
+						d+=((-1)<<s)+1;
+					numDiffBits[i]=size+s;
+					diff[i]=d;
+					}
 				}
 			}
 		}
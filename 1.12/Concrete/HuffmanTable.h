@@ -43,8 +43,11 @@ class HuffmanTable
 	int mincode[17];
 	int maxcode[18];
 	int valPtr[17];
-	int numBits[256];
-	int value[256];
+	static const int lookaheadBits=12; // Number of bits to peek at to identify short Huffman codes
+	unsigned char numBits[1<<lookaheadBits]; // Lengths of short Huffman codes starting with each lookahead bit pattern, or 0 for long codes
+	unsigned char value[1<<lookaheadBits]; // Decoded values of short Huffman codes starting with each lookahead bit pattern
+	unsigned char numDiffBits[1<<lookaheadBits]; // Total lengths of short Huffman codes and their following difference bits contained in each lookahead bit pattern, or 0 if the difference does not fit
+	int diff[1<<lookaheadBits]; // Decoded signed differences contained in each lookahead bit pattern
 	
 	/* Constructors and destructors: */
 	public:
@@ -53,8 +56,8 @@ class HuffmanTable
 	
 	int decode(BitBuffer& bb) const // Decodes a bit sequence
 		{
-		/* Peek at the next eight bits in the buffer to determine whether the next code is a short code: */
-		int code=bb.peekBits(8);
+		/* Peek at the next bits in the buffer to determine whether the next code is a short code: */
+		int code=bb.peekBits(lookaheadBits);
 		if(numBits[code]!=0)
 			{
 			/* Remove the short code from the bit buffer: */
@@ -66,8 +69,8 @@ class HuffmanTable
 		else
 			{
 			/* Keep adding more bits to the code until it is valid: */
-			int codeBits=8;
-			bb.flushBits(8);
+			int codeBits=lookaheadBits;
+			bb.flushBits(lookaheadBits);
 			while(code>maxcode[codeBits])
 				{
 				code=(code<<1)|bb.getBit();
@@ -82,6 +85,26 @@ class HuffmanTable
 			return values[valPtr[codeBits]+(code-mincode[codeBits])];
 			}
 		}
+	int decodeDifference(BitBuffer& bb) const // Decodes a bit sequence and the signed difference value following it
+		{
+		/* Check if the next code and its difference bits are entirely contained in the lookahead bits: */
+		if(bb.fill(lookaheadBits))
+			{
+			int code=bb.peekBits(lookaheadBits);
+			if(numDiffBits[code]!=0)
+				{
+				/* Remove the code and difference bits from the bit buffer in one go: */
+				bb.flushBits(numDiffBits[code]);
+				
+				/* Return the pre-decoded difference: */
+				return diff[code];
+				}
+			}
+		
+		/* Decode the code and difference separately: */
+		int s=decode(bb);
+		return s!=0?bb.getSignedBits(s):0;
+		}
 	};
 
 }
@@ -0,0 +1,110 @@
+/***********************************************************************
+ImageSliceLoader - Base class to decode the slices of image stacks out
+of order on a team of worker threads, each slice directly into its final
+position in the data set.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Concrete/ImageSliceLoader.h>
+
+#include <stdexcept>
+#include <iostream>
+#include <iomanip>
+
+#include <Templatized/WorkerPool.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+/*********************************
+Methods of class ImageSliceLoader:
+*********************************/
+
+void ImageSliceLoader::processSlices(unsigned int workerIndex)
+	{
+	while(true)
+		{
+		/* Grab the next slice: */
+		int sliceIndex;
+		{
+		Threads::Mutex::Lock sliceLock(sliceMutex);
+		if(failed||nextSlice==numSlices)
+			break;
+		sliceIndex=nextSlice;
+		++nextSlice;
+		}
+		
+		/* Decode the slice: */
+		try
+			{
+			loadSlice(sliceIndex);
+			}
+		catch(std::runtime_error err)
+			{
+			/* Stop the other workers and forward the error to the worker pool: */
+			{
+			Threads::Mutex::Lock sliceLock(sliceMutex);
+			failed=true;
+			}
+			throw;
+			}
+		
+		/* Report aggregate progress: */
+		{
+		Threads::Mutex::Lock sliceLock(sliceMutex);
+		++numLoadedSlices;
+		if(showProgress)
+			std::cout<<"\b\b\b\b"<<std::setw(3)<<(numLoadedSlices*100)/numSlices<<"%"<<std::flush;
+		}
+		}
+	}
+
+ImageSliceLoader::ImageSliceLoader(void)
+	:numSlices(0),nextSlice(0),numLoadedSlices(0),
+	 failed(false),showProgress(false)
+	{
+	}
+
+ImageSliceLoader::~ImageSliceLoader(void)
+	{
+	}
+
+void ImageSliceLoader::load(int newNumSlices,bool newShowProgress,bool parallel)
+	{
+	/* Initialize the slice dispatch state: */
+	numSlices=newNumSlices;
+	nextSlice=0;
+	numLoadedSlices=0;
+	failed=false;
+	showProgress=newShowProgress;
+	
+	/* Decode all slices, but don't start more workers than there are slices: */
+	unsigned int numWorkers=parallel?Templatized::WorkerPool::getNumWorkers():1U;
+	if(numSlices<1)
+		numWorkers=1;
+	else if(numWorkers>(unsigned int)numSlices)
+		numWorkers=(unsigned int)numSlices;
+	LoadJob job(this);
+	Templatized::WorkerPool::run(job,numWorkers);
+	}
+
+}
+
+}
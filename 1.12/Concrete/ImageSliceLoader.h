@@ -0,0 +1,91 @@
+/***********************************************************************
+ImageSliceLoader - Base class to decode the slices of image stacks out
+of order on a team of worker threads, each slice directly into its final
+position in the data set.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_CONCRETE_IMAGESLICELOADER_INCLUDED
+#define VISUALIZATION_CONCRETE_IMAGESLICELOADER_INCLUDED
+
+#include <Threads/Mutex.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+class ImageSliceLoader
+	{
+	/* Embedded classes: */
+	private:
+	class LoadJob // Helper class to decode slices on a team of worker threads
+		{
+		/* Elements: */
+		private:
+		ImageSliceLoader* isl; // The slice loader
+		
+		/* Constructors and destructors: */
+		public:
+		LoadJob(ImageSliceLoader* sIsl)
+			:isl(sIsl)
+			{
+			}
+		
+		/* Methods: */
+		void operator()(unsigned int workerIndex)
+			{
+			isl->processSlices(workerIndex);
+			}
+		};
+	
+	friend class LoadJob;
+	
+	/* Elements: */
+	Threads::Mutex sliceMutex; // Mutex serializing access to the slice dispatch state
+	int numSlices; // Number of slices in the image stack
+	int nextSlice; // Index of the next slice to be handed to a worker
+	int numLoadedSlices; // Number of completely decoded slices
+	bool failed; // Flag if decoding any slice failed; stops dispatching further slices
+	bool showProgress; // Flag whether to print the percentage of decoded slices
+	
+	/* Private methods: */
+	void processSlices(unsigned int workerIndex); // Worker method to decode slices until all slices are done
+	
+	/* Protected methods: */
+	protected:
+	virtual void loadSlice(int sliceIndex) =0; // Decodes the slice of the given index into the data set; called concurrently from all worker threads
+	
+	/* Constructors and destructors: */
+	public:
+	ImageSliceLoader(void); // Creates a slice loader
+	private:
+	ImageSliceLoader(const ImageSliceLoader& source); // Prohibit copy constructor
+	ImageSliceLoader& operator=(const ImageSliceLoader& source); // Prohibit assignment operator
+	public:
+	virtual ~ImageSliceLoader(void);
+	
+	/* Methods: */
+	void load(int newNumSlices,bool newShowProgress,bool parallel); // Decodes all slices of an image stack, using all worker threads of the worker pool if parallel is true; prints progress as percentage updates if showProgress is true
+	};
+
+}
+
+}
+
+#endif
@@ -35,187 +35,70 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Images/RGBImage.h>
 #include <Images/ReadImageFile.h>
 
+#include <Templatized/VolumeFilter.h>
+#include <Concrete/ImageSliceLoader.h>
+
 namespace Visualization {
 
 namespace Concrete {
 
-#if 0
-
-namespace {
+/*************************************
+Embedded classes of class ImageStack:
+*************************************/
 
-void minimumFilter(Misc::Array<unsigned char,3>& data,int filterSize)
+class ImageStack::SliceLoader:public ImageSliceLoader
 	{
-	typedef Misc::Array<unsigned char,3> Array;
-	typedef Array::Index Index;
+	/* Elements: */
+	private:
+	const ImageStack& module; // The module loading the image stack
+	Cluster::MulticastPipe* pipe; // Pipe to read slice files in a cluster environment
+	const std::string& sliceDirectory; // Directory containing the slice files
+	const std::string& sliceFileNameTemplate; // printf-style template to generate slice file names
+	int sliceIndexStart,sliceIndexFactor; // Mapping from slice indices to slice file name indices
+	const int* regionOrigin; // Origin of the region of each slice image that is loaded
+	DS::Index numVertices; // Size of the image stack
+	DS::Array& vertices; // Vertex array receiving the slices
 	
-	std::cout<<"Minimum filter...   0%"<<std::flush;
-	int counter=0;
-	int maxCounter=data.getSize(0)+data.getSize(1)+data.getSize(2);
-	for(int direction=0;direction<3;++direction)
+	/* Protected methods from ImageSliceLoader: */
+	protected:
+	virtual void loadSlice(int sliceIndex)
 		{
-		unsigned char* buffer=new unsigned char[data.getSize(direction)];
+		/* Generate the slice file name: */
+		std::string fullSliceFileName=sliceDirectory;
+		char sliceFileName[1024];
+		snprintf(sliceFileName,sizeof(sliceFileName),sliceFileNameTemplate.c_str(),sliceIndex*sliceIndexFactor+sliceIndexStart);
+		fullSliceFileName.append(sliceFileName);
+		fullSliceFileName=module.getFullPath(fullSliceFileName);
 		
-		for(int i1=0;i1<data.getSize((direction+1)%3);++i1,++counter)
-			{
-			for(int i2=0;i2<data.getSize((direction+2)%3);++i2)
-				{
-				Index baseIndex(0);
-				baseIndex[(direction+1)%3]=i1;
-				baseIndex[(direction+2)%3]=i2;
-				unsigned char* base=data.getAddress(baseIndex);
-				ptrdiff_t increment=data.getIncrement(direction);
-				
-				for(int i=0;i<filterSize;++i)
-					{
-					unsigned char min=255;
-					for(int di=-i;di<=filterSize;++di)
-						if(min>base[(i+di)*increment])
-							min=base[(i+di)*increment];
-					buffer[i]=min;
-					}
-				for(int i=filterSize;i<data.getSize(direction)-filterSize;++i)
-					{
-					unsigned char min=255;
-					for(int di=-filterSize;di<=filterSize;++di)
-						if(min>base[(i+di)*increment])
-							min=base[(i+di)*increment];
-					buffer[i]=min;
-					}
-				for(int i=data.getSize(direction)-filterSize;i<data.getSize(direction);++i)
-					{
-					unsigned char min=255;
-					for(int di=-filterSize;di<data.getSize(direction)-i;++di)
-						if(min>base[(i+di)*increment])
-							min=base[(i+di)*increment];
-					buffer[i]=min;
-					}
-				
-				for(int i=0;i<data.getSize(direction);++i)
-					base[i*increment]=buffer[i];
-				}
-			
-			std::cout<<"\b\b\b\b"<<std::setw(3)<<((counter+1)*100)/maxCounter<<"%"<<std::flush;
-			}
+		/* Load the slice as an RGB image: */
+		Images::RGBImage slice=Images::readImageFile(fullSliceFileName.c_str(),module.openFile(fullSliceFileName,pipe));
 		
-		delete[] buffer;
-		}
-	std::cout<<"\b\b\b\bdone"<<std::endl;
-	}
-
-void maximumFilter(Misc::Array<unsigned char,3>& data,int filterSize)
-	{
-	typedef Misc::Array<unsigned char,3> Array;
-	typedef Array::Index Index;
-	
-	std::cout<<"Maximum filter...   0%"<<std::flush;
-	int counter=0;
-	int maxCounter=data.getSize(0)+data.getSize(1)+data.getSize(2);
-	for(int direction=0;direction<3;++direction)
-		{
-		unsigned char* buffer=new unsigned char[data.getSize(direction)];
+		/* Check if the slice conforms: */
+		if(slice.getSize(0)<(unsigned int)(regionOrigin[0]+numVertices[2])||slice.getSize(1)<(unsigned int)(regionOrigin[1]+numVertices[1]))
+			Misc::throwStdErr("ImageStack::load: Size of slice file \"%s\" does not match image stack size",fullSliceFileName.c_str());
 		
-		for(int i1=0;i1<data.getSize((direction+1)%3);++i1,++counter)
-			{
-			for(int i2=0;i2<data.getSize((direction+2)%3);++i2)
+		/* Convert the slice's pixels to greyscale and copy them into the slice's plane of the data set: */
+		unsigned char* vertexPtr=vertices.getAddress(sliceIndex,0,0);
+		for(int y=regionOrigin[1];y<regionOrigin[1]+numVertices[1];++y)
+			for(int x=regionOrigin[0];x<regionOrigin[0]+numVertices[2];++x,++vertexPtr)
 				{
-				Index baseIndex(0);
-				baseIndex[(direction+1)%3]=i1;
-				baseIndex[(direction+2)%3]=i2;
-				unsigned char* base=data.getAddress(baseIndex);
-				ptrdiff_t increment=data.getIncrement(direction);
-				
-				for(int i=0;i<filterSize;++i)
-					{
-					unsigned char max=0;
-					for(int di=-i;di<=filterSize;++di)
-						if(max<base[(i+di)*increment])
-							max=base[(i+di)*increment];
-					buffer[i]=max;
-					}
-				for(int i=filterSize;i<data.getSize(direction)-filterSize;++i)
-					{
-					unsigned char max=0;
-					for(int di=-filterSize;di<=filterSize;++di)
-						if(max<base[(i+di)*increment])
-							max=base[(i+di)*increment];
-					buffer[i]=max;
-					}
-				for(int i=data.getSize(direction)-filterSize;i<data.getSize(direction);++i)
-					{
-					unsigned char max=0;
-					for(int di=-filterSize;di<data.getSize(direction)-i;++di)
-						if(max<base[(i+di)*increment])
-							max=base[(i+di)*increment];
-					buffer[i]=max;
-					}
-				
-				for(int i=0;i<data.getSize(direction);++i)
-					base[i*increment]=buffer[i];
+				const Images::RGBImage::Color& pixel=slice.getPixel(x,y);
+				float value=float(pixel[0])*0.299f+float(pixel[1])*0.587+float(pixel[2])*0.114f;
+				*vertexPtr=(unsigned char)(Math::floor(value+0.5f));
 				}
-			
-			std::cout<<"\b\b\b\b"<<std::setw(3)<<((counter+1)*100)/maxCounter<<"%"<<std::flush;
-			}
-		
-		delete[] buffer;
 		}
-	std::cout<<"\b\b\b\bdone"<<std::endl;
-	}
-
-void sphereFilter(Misc::Array<unsigned char,3>& data,int sphereRadius,unsigned char sphereValue)
-	{
-	typedef Misc::Array<unsigned char,3> Array;
-	typedef Array::Index Index;
-	
-	/* Create an array of index offsets: */
-	std::vector<Index> offsets;
-	{
-	Index d;
-	for(d[0]=-sphereRadius;d[0]<=sphereRadius;++d[0])
-		for(d[1]=-sphereRadius;d[1]<=sphereRadius;++d[1])
-			for(d[2]=-sphereRadius;d[2]<=sphereRadius;++d[2])
-				if(d[0]*d[0]+d[1]*d[1]+d[2]*d[2]<=sphereRadius*sphereRadius+sphereRadius)
-					offsets.push_back(d);
-	}
 	
-	unsigned char* temp=new unsigned char[data.getNumElements()];
-	
-	std::cout<<"Sphere filter...   0%"<<std::flush;
-	Index index;
-	for(index[0]=0;index[0]<data.getSize(0);++index[0])
+	/* Constructors and destructors: */
+	public:
+	SliceLoader(const ImageStack& sModule,Cluster::MulticastPipe* sPipe,const std::string& sSliceDirectory,const std::string& sSliceFileNameTemplate,int sSliceIndexStart,int sSliceIndexFactor,const int sRegionOrigin[2],const DS::Index& sNumVertices,DS::Array& sVertices)
+		:module(sModule),pipe(sPipe),
+		 sliceDirectory(sSliceDirectory),sliceFileNameTemplate(sSliceFileNameTemplate),
+		 sliceIndexStart(sSliceIndexStart),sliceIndexFactor(sSliceIndexFactor),
+		 regionOrigin(sRegionOrigin),
+		 numVertices(sNumVertices),vertices(sVertices)
 		{
-		for(index[1]=0;index[1]<data.getSize(1);++index[1])
-			for(index[2]=0;index[2]<data.getSize(2);++index[2])
-				{
-				double rms=0.0;
-				int numSamples=0;
-				for(std::vector<Index>::const_iterator oIt=offsets.begin();oIt!=offsets.end();++oIt)
-					{
-					Index sample=index+*oIt;
-					if(data.isValid(sample))
-						{
-						rms+=Math::sqr(double(data(sample))-double(sphereValue));
-						++numSamples;
-						}
-					}
-
-				rms=Math::sqrt(rms/double(numSamples));
-				temp[data.calcLinearIndex(index)]=(unsigned char)Math::floor(rms+0.5);
-				}
-		
-		std::cout<<"\b\b\b\b"<<std::setw(3)<<((index[0]+1)*100)/data.getSize(0)<<"%"<<std::flush;
 		}
-	std::cout<<"\b\b\b\bdone"<<std::endl;
-	
-	unsigned char* dPtr=data.getArray();
-	unsigned char* sPtr=temp;
-	for(int i=data.getNumElements();i>0;--i,++sPtr,++dPtr)
-		*dPtr=*sPtr;
-	delete[] temp;
-	}
-
-}
-
-#endif
+	};
 
 /***************************
 Methods of class ImageStack:
@@ -315,38 +198,12 @@ Visualization::Abstract::DataSet* ImageStack::load(const std::vector<std::string
 	DataSet* result=new DataSet;
 	result->getDs().setData(numVertices,cellSize);
 	
-	/* Load all image slices: */
+	/* Load all image slices out of order, reading them serially in a cluster environment to keep the pipe in sync: */
 	if(master)
 		std::cout<<"Reading image slices...   0%"<<std::flush;
 	DataSet::DS::Array& vertices=result->getDs().getVertices();
-	unsigned char* vertexPtr=vertices.getArray();
-	for(int i=0;i<numVertices[0];++i)
-		{
-		/* Generate the slice file name: */
-		std::string fullSliceFileName=sliceDirectory;
-		char sliceFileName[1024];
-		snprintf(sliceFileName,sizeof(sliceFileName),sliceFileNameTemplate.c_str(),i*sliceIndexFactor+sliceIndexStart);
-		fullSliceFileName.append(sliceFileName);
-		fullSliceFileName=getFullPath(fullSliceFileName);
-		
-		/* Load the slice as an RGB image: */
-		Images::RGBImage slice=Images::readImageFile(fullSliceFileName.c_str(),openFile(fullSliceFileName,pipe));
-		
-		/* Check if the slice conforms: */
-		if(slice.getSize(0)<(unsigned int)(regionOrigin[0]+numVertices[2])||slice.getSize(1)<(unsigned int)(regionOrigin[1]+numVertices[1]))
-			Misc::throwStdErr("ImageStack::load: Size of slice file \"%s\" does not match image stack size",fullSliceFileName.c_str());
-		
-		/* Convert the slice's pixels to greyscale and copy them into the data set: */
-		for(int y=regionOrigin[1];y<regionOrigin[1]+numVertices[1];++y)
-			for(int x=regionOrigin[0];x<regionOrigin[0]+numVertices[2];++x,++vertexPtr)
-				{
-				const Images::RGBImage::Color& pixel=slice.getPixel(x,y);
-				float value=float(pixel[0])*0.299f+float(pixel[1])*0.587+float(pixel[2])*0.114f;
-				*vertexPtr=(unsigned char)(Math::floor(value+0.5f));
-				}
-		if(master)
-			std::cout<<"\b\b\b\b"<<std::setw(3)<<((i+1)*100)/numVertices[0]<<"%"<<std::flush;
-		}
+	SliceLoader sliceLoader(*this,pipe,sliceDirectory,sliceFileNameTemplate,sliceIndexStart,sliceIndexFactor,regionOrigin,numVertices,vertices);
+	sliceLoader.load(numVertices[0],master,pipe==0);
 	if(master)
 		std::cout<<"\b\b\b\bdone"<<std::endl;
 	
@@ -354,75 +211,14 @@ Visualization::Abstract::DataSet* ImageStack::load(const std::vector<std::string
 		{
 		/* Run a median + lowpass filter on all slice triples to reduce random speckle: */
 		if(master)
-			std::cout<<"Filtering image stack...   0%"<<std::flush;
-		unsigned char* filtered=new unsigned char[numVertices[0]];
-		ptrdiff_t vPtrInc=vertices.getIncrement(0);
-		for(int y=0;y<numVertices[1];++y)
-			{
-			for(int x=0;x<numVertices[2];++x)
-				{
-				if(medianFilter)
-					{
-					/* Run median filter: */
-					unsigned char* vPtr=vertices.getAddress(0,y,x);
-					filtered[0]=*vPtr;
-					vPtr+=vPtrInc;
-					for(int z=1;z<numVertices[0]-1;++z,vPtr+=vPtrInc)
-						{
-						if(vPtr[-vPtrInc]<vPtr[0])
-							{
-							if(vPtr[0]<vPtr[vPtrInc])
-								filtered[z]=vPtr[0];
-							else
-								filtered[z]=vPtr[-vPtrInc]<vPtr[vPtrInc]?vPtr[vPtrInc]:vPtr[-vPtrInc];
-							}
-						else
-							{
-							if(vPtr[-vPtrInc]<vPtr[vPtrInc])
-								filtered[z]=vPtr[-vPtrInc];
-							else
-								filtered[z]=vPtr[0]<vPtr[vPtrInc]?vPtr[vPtrInc]:vPtr[0];
-							}
-						}
-					filtered[numVertices[0]-1]=*vPtr;
-					}
-				else if(lowpassFilter)
-					{
-					/* Copy the source image data to allow lowpass filtering: */
-					unsigned char* vPtr=vertices.getAddress(0,y,x);
-					for(int z=0;z<numVertices[0];++z,vPtr+=vPtrInc)
-						filtered[z]=*vPtr;
-					}
-				
-				if(lowpassFilter)
-					{
-					/* Run lowpass filter: */
-					unsigned char* vPtr=vertices.getAddress(0,y,x);
-					*vPtr=(unsigned char)((int(filtered[0])*3+int(filtered[1])*2+int(filtered[2])+3)/6);
-					vPtr+=vPtrInc;
-					*vPtr=(unsigned char)((int(filtered[0])*2+int(filtered[1])*3+int(filtered[2])*2+int(filtered[3])+4)/8);
-					vPtr+=vPtrInc;
-					for(int z=2;z<numVertices[0]-2;++z,vPtr+=vPtrInc)
-						*vPtr=(unsigned char)((int(filtered[z-2])+int(filtered[z-1])*2+int(filtered[z])*3+int(filtered[z+1])*2+int(filtered[z+2])+4)/9);
-					*vPtr=(unsigned char)((int(filtered[numVertices[0]-4])+int(filtered[numVertices[0]-3])*2+int(filtered[numVertices[0]-2])*3+int(filtered[numVertices[0]-1])*2+4)/8);
-					vPtr+=vPtrInc;
-					*vPtr=(unsigned char)((int(filtered[numVertices[0]-3])+int(filtered[numVertices[0]-2])*2+int(filtered[numVertices[0]-1])*3+3)/6);
-					}
-				else if(medianFilter)
-					{
-					/* Copy the filtered data back to the volume: */
-					unsigned char* vPtr=vertices.getAddress(0,y,x);
-					for(int z=0;z<numVertices[0];++z,vPtr+=vPtrInc)
-						*vPtr=filtered[z];
-					}
-				}
-			if(master)
-				std::cout<<"\b\b\b\b"<<std::setw(3)<<((y+1)*100)/numVertices[1]<<"%"<<std::flush;
-			}
+			std::cout<<"Filtering image stack..."<<std::flush;
+		Visualization::Templatized::VolumeFilter<unsigned char> filter(vertices);
+		if(medianFilter)
+			filter.medianFilter(0);
+		if(lowpassFilter)
+			filter.lowpassFilter(0);
 		if(master)
-			std::cout<<"\b\b\b\bdone"<<std::endl;
-		
-		delete[] filtered;
+			std::cout<<" done"<<std::endl;
 		}
 	
 	return result;
@@ -46,6 +46,12 @@ typedef Visualization::Wrappers::Module<DS,DataValue> BaseModule; // Module base
 
 class ImageStack:public BaseModule
 	{
+	/* Embedded classes: */
+	private:
+	class SliceLoader; // Class to decode the slices of an image stack into a data set's vertex array
+	
+	friend class SliceLoader;
+	
 	/* Constructors and destructors: */
 	public:
 	ImageStack(void); // Default constructor
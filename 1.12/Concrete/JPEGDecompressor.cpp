@@ -423,7 +423,7 @@ void JPEGDecompressor::readImage(JPEGImageWriter& imageWriter)
 				
 				/* Reset the restart interval: */
 				restartRowsToGo=restartInRows-1;
-				nextRestartNumber=(nextRestartNumber+1)%7;
+				nextRestartNumber=(nextRestartNumber+1)%8;
 				
 				/* Clear the bit buffer: */
 				bb.clear();
@@ -435,8 +435,7 @@ void JPEGDecompressor::readImage(JPEGImageWriter& imageWriter)
 			for(int comp=0;comp<numScanComponents;++comp,++pirPtr,++cirPtr)
 				{
 				/* Decode the difference: */
-				int s=scanTables[comp]->decode(bb);
-				int diff=s!=0?bb.getSignedBits(s):0;
+				int diff=scanTables[comp]->decodeDifference(bb);
 				
 				/* Set the pixel value: */
 				*cirPtr=short((1<<(numBits-pt-1))+diff);
@@ -448,8 +447,7 @@ void JPEGDecompressor::readImage(JPEGImageWriter& imageWriter)
 				for(int comp=0;comp<numScanComponents;++comp,++pirPtr,++cirPtr)
 					{
 					/* Decode the difference: */
-					int s=scanTables[comp]->decode(bb);
-					int diff=s!=0?bb.getSignedBits(s):0;
+					int diff=scanTables[comp]->decodeDifference(bb);
 					
 					/* Set the pixel value: */
 					*cirPtr=short(int(cirPtr[-numScanComponents])+diff);
@@ -462,8 +460,7 @@ void JPEGDecompressor::readImage(JPEGImageWriter& imageWriter)
 			for(int comp=0;comp<numScanComponents;++comp,++pirPtr,++cirPtr)
 				{
 				/* Decode the difference: */
-				int s=scanTables[comp]->decode(bb);
-				int diff=s!=0?bb.getSignedBits(s):0;
+				int diff=scanTables[comp]->decodeDifference(bb);
 				
 				/* Set the pixel value: */
 				*cirPtr=short(int(*pirPtr)+diff);
@@ -475,8 +472,7 @@ void JPEGDecompressor::readImage(JPEGImageWriter& imageWriter)
 				for(int comp=0;comp<numScanComponents;++comp,++pirPtr,++cirPtr)
 					{
 					/* Decode the difference: */
-					int s=scanTables[comp]->decode(bb);
-					int diff=s!=0?bb.getSignedBits(s):0;
+					int diff=scanTables[comp]->decodeDifference(bb);
 						
 					/* Calculate the predictor value: */
 					int predicted=0;
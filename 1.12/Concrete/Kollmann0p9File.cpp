@@ -60,6 +60,7 @@ Visualization::Abstract::DataSet* Kollmann0p9File::load(const std::vector<std::s
 	{
 	/* Open the data file: */
 	Misc::File dataFile(args[0].c_str(),"rt");
+	addSourceFile(args[0],false);
 	
 	/* Create result data set: */
 	DS::Index numVertices(195,71,129); // Hard-coded; there is no dimension field in the data file
@@ -44,6 +44,7 @@ Visualization::Abstract::DataSet* MagaliSubductionFile::load(const std::vector<s
 	{
 	/* Open the data file: */
 	Misc::File dataFile(args[0].c_str(),"rb",Misc::File::LittleEndian);
+	addSourceFile(args[0],false);
 	
 	/* Create result data set: */
 	DS::Index numVertices;
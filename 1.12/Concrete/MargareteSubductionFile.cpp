@@ -47,6 +47,7 @@ Visualization::Abstract::DataSet* MargareteSubductionFile::load(const std::vecto
 	{
 	/* Open the data file: */
 	Misc::File dataFile(args[0].c_str(),"rt");
+	addSourceFile(args[0],false);
 	
 	/* Skip any header lines in the data set: */
 	char line[256];
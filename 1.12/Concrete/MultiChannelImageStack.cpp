@@ -41,6 +41,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Images/RGBImage.h>
 #include <Images/ReadImageFile.h>
 
+#include <Templatized/VolumeFilter.h>
+#include <Concrete/ImageSliceLoader.h>
+
 namespace Visualization {
 
 namespace Concrete {
@@ -201,20 +204,20 @@ void loadGreyscaleImage(StackDescriptor& sd,Value* slicePtr,const char* imageFil
 		}
 	}
 
-void loadGreyscaleImageStack(StackDescriptor& sd,int newSliceIndex,const char* imageFileNameTemplate)
+class GreyscaleSliceLoader:public ImageSliceLoader // Class to decode the images of a greyscale image stack into a slice of the data set
 	{
+	/* Elements: */
+	private:
+	StackDescriptor& sd; // Descriptor of the image stack
+	Value* slicePtr; // Pointer to the data set slice receiving the images
+	const char* imageFileNameTemplate; // printf-style template to generate image file names
 	#ifdef IMAGES_HAVE_TIFF
-	/* Check if the image file name template matches TIFF images: */
-	const char* ext=Misc::getExtension(imageFileNameTemplate);
-	bool isTiff=strcasecmp(ext,".tif")==0||strcasecmp(ext,".tiff")==0;
+	bool isTiff; // Flag whether the image file name template matches TIFF images
 	#endif
 	
-	/* Get a pointer to the slice: */
-	Value* slicePtr=sd.dataSet.getSliceArray(newSliceIndex);
-	if(sd.master)
-		std::cout<<"Reading greyscale image stack "<<imageFileNameTemplate<<"...   0%"<<std::flush;
-	Misc::Timer loadTimer;
-	for(int imageIndex=0;imageIndex<sd.numVertices[2];++imageIndex,slicePtr+=sd.dataSet.getVertexStride(2))
+	/* Protected methods from ImageSliceLoader: */
+	protected:
+	virtual void loadSlice(int imageIndex)
 		{
 		/* Generate the image file name: */
 		char imageFileNameBuffer[1024];
@@ -222,35 +225,42 @@ void loadGreyscaleImageStack(StackDescriptor& sd,int newSliceIndex,const char* i
 		std::string imageFileName=sd.imageDirectory;
 		imageFileName.append(imageFileNameBuffer);
 		
-		/* Load the image: */
+		/* Load the image into its plane of the slice: */
+		Value* imagePtr=slicePtr+ptrdiff_t(imageIndex)*sd.dataSet.getVertexStride(2);
 		#ifdef IMAGES_HAVE_TIFF
 		if(isTiff)
-			loadGreyscaleTiffImage(sd,slicePtr,imageFileName.c_str());
+			loadGreyscaleTiffImage(sd,imagePtr,imageFileName.c_str());
 		else
-			loadGreyscaleImage(sd,slicePtr,imageFileName.c_str());
+			loadGreyscaleImage(sd,imagePtr,imageFileName.c_str());
 		#else
-		loadGreyscaleImage(sd,slicePtr,imageFileName.c_str());
+		loadGreyscaleImage(sd,imagePtr,imageFileName.c_str());
 		#endif
-		
-		if(sd.master)
-			std::cout<<"\b\b\b\b"<<std::setw(3)<<((imageIndex+1)*100)/sd.numVertices[2]<<"%"<<std::flush;
 		}
-	loadTimer.elapse();
-	if(sd.master)
-		std::cout<<"\b\b\b\bdone in "<<loadTimer.getTime()*1000.0<<" ms"<<std::endl;
-	}
+	
+	/* Constructors and destructors: */
+	public:
+	GreyscaleSliceLoader(StackDescriptor& sSd,Value* sSlicePtr,const char* sImageFileNameTemplate)
+		:sd(sSd),slicePtr(sSlicePtr),imageFileNameTemplate(sImageFileNameTemplate)
+		{
+		#ifdef IMAGES_HAVE_TIFF
+		/* Check if the image file name template matches TIFF images: */
+		const char* ext=Misc::getExtension(imageFileNameTemplate);
+		isTiff=strcasecmp(ext,".tif")==0||strcasecmp(ext,".tiff")==0;
+		#endif
+		}
+	};
 
-void loadColorImageStack(StackDescriptor& sd,const int newSliceIndices[3],const char* imageFileNameTemplate)
+class ColorSliceLoader:public ImageSliceLoader // Class to decode the images of a color image stack into three slices of the data set
 	{
-	/* Get a pointer to the slice: */
-	Value* slices[3];
-	for(int i=0;i<3;++i)
-		slices[i]=sd.dataSet.getSliceArray(newSliceIndices[i]);
-	ptrdiff_t sliceIndex=0;
-	if(sd.master)
-		std::cout<<"Reading color image stack "<<imageFileNameTemplate<<"...   0%"<<std::flush;
-	Misc::Timer loadTimer;
-	for(int imageIndex=0;imageIndex<sd.numVertices[2];++imageIndex,sliceIndex+=sd.dataSet.getVertexStride(2))
+	/* Elements: */
+	private:
+	StackDescriptor& sd; // Descriptor of the image stack
+	Value* slices[3]; // Pointers to the data set slices receiving the images' color channels
+	const char* imageFileNameTemplate; // printf-style template to generate image file names
+	
+	/* Protected methods from ImageSliceLoader: */
+	protected:
+	virtual void loadSlice(int imageIndex)
 		{
 		/* Generate the image file name: */
 		char imageFileName[1024];
@@ -263,8 +273,8 @@ void loadColorImageStack(StackDescriptor& sd,const int newSliceIndices[3],const
 		if(image.getSize(0)<(unsigned int)(sd.regionOrigin[0]+sd.numVertices[0])||image.getSize(1)<(unsigned int)(sd.regionOrigin[1]+sd.numVertices[1]))
 			Misc::throwStdErr("MultiChannelImageStack::load: Size of image file \"%s\" does not match image stack size",imageFileName);
 		
-		/* Copy the image's pixels into the data set: */
-		ptrdiff_t rowIndex=sliceIndex;
+		/* Copy the image's pixels into its plane of the slices: */
+		ptrdiff_t rowIndex=ptrdiff_t(imageIndex)*sd.dataSet.getVertexStride(2);
 		for(int y=sd.regionOrigin[1];y<sd.regionOrigin[1]+sd.numVertices[1];++y,rowIndex+=sd.dataSet.getVertexStride(1))
 			{
 			ptrdiff_t vIndex=rowIndex;
@@ -275,9 +285,39 @@ void loadColorImageStack(StackDescriptor& sd,const int newSliceIndices[3],const
 					slices[i][vIndex]=Value(pixel[i]);
 				}
 			}
-		if(sd.master)
-			std::cout<<"\b\b\b\b"<<std::setw(3)<<((imageIndex+1)*100)/sd.numVertices[2]<<"%"<<std::flush;
 		}
+	
+	/* Constructors and destructors: */
+	public:
+	ColorSliceLoader(StackDescriptor& sSd,const int newSliceIndices[3],const char* sImageFileNameTemplate)
+		:sd(sSd),imageFileNameTemplate(sImageFileNameTemplate)
+		{
+		for(int i=0;i<3;++i)
+			slices[i]=sd.dataSet.getSliceArray(newSliceIndices[i]);
+		}
+	};
+
+void loadGreyscaleImageStack(StackDescriptor& sd,int newSliceIndex,const char* imageFileNameTemplate)
+	{
+	/* Decode all images in parallel: */
+	if(sd.master)
+		std::cout<<"Reading greyscale image stack "<<imageFileNameTemplate<<"...   0%"<<std::flush;
+	Misc::Timer loadTimer;
+	GreyscaleSliceLoader sliceLoader(sd,sd.dataSet.getSliceArray(newSliceIndex),imageFileNameTemplate);
+	sliceLoader.load(sd.numVertices[2],sd.master,true);
+	loadTimer.elapse();
+	if(sd.master)
+		std::cout<<"\b\b\b\bdone in "<<loadTimer.getTime()*1000.0<<" ms"<<std::endl;
+	}
+
+void loadColorImageStack(StackDescriptor& sd,const int newSliceIndices[3],const char* imageFileNameTemplate)
+	{
+	/* Decode all images in parallel: */
+	if(sd.master)
+		std::cout<<"Reading color image stack "<<imageFileNameTemplate<<"...   0%"<<std::flush;
+	Misc::Timer loadTimer;
+	ColorSliceLoader sliceLoader(sd,newSliceIndices,imageFileNameTemplate);
+	sliceLoader.load(sd.numVertices[2],sd.master,true);
 	loadTimer.elapse();
 	if(sd.master)
 		std::cout<<"\b\b\b\bdone in "<<loadTimer.getTime()*1000.0<<" ms"<<std::endl;
@@ -285,93 +325,27 @@ void loadColorImageStack(StackDescriptor& sd,const int newSliceIndices[3],const
 
 void filterImageStack(StackDescriptor& sd,int sliceIndex,bool medianFilter,bool lowpassFilter)
 	{
-	/* Get a pointer to the slice: */
-	Value* slicePtr=sd.dataSet.getSliceArray(sliceIndex);
 	if(sd.master)
-		std::cout<<"Filtering image stack...   0%"<<std::flush;
+		std::cout<<"Filtering image stack..."<<std::flush;
 	Misc::Timer filterTimer;
 	
-	/* Create a buffer for a single voxel pile: */
-	Value* pileBuffer=new Value[sd.numVertices[2]];
-	
-	/* Filter all pixels through all images: */
-	Value* columnPtr=slicePtr;
-	for(int x=0;x<sd.numVertices[0];++x,columnPtr+=sd.dataSet.getVertexStride(0))
+	/* Filter all pixel piles through all images: */
+	int size[3];
+	ptrdiff_t increments[3];
+	for(int i=0;i<3;++i)
 		{
-		Value* pilePtr=columnPtr;
-		for(int y=0;y<sd.numVertices[1];++y,pilePtr+=sd.dataSet.getVertexStride(1))
-			{
-			Value* vPtr=pilePtr;
-			int vInc=sd.dataSet.getVertexStride(2);
-			Value* pPtr=pileBuffer;
-			
-			if(medianFilter)
-				{
-				/* Run a median filter over the pixel pile: */
-				*pPtr=*vPtr;
-				vPtr+=vInc;
-				++pPtr;
-				for(int z=2;z<sd.numVertices[2];++z,vPtr+=vInc,++pPtr)
-					{
-					if(vPtr[-vInc]<vPtr[0])
-						{
-						if(vPtr[0]<vPtr[vInc])
-							*pPtr=vPtr[0];
-						else
-							*pPtr=vPtr[-vInc]<vPtr[vInc]?vPtr[vInc]:vPtr[-vInc];
-						}
-					else
-						{
-						if(vPtr[-vInc]<vPtr[vInc])
-							*pPtr=vPtr[-vInc];
-						else
-							*pPtr=vPtr[0]<vPtr[vInc]?vPtr[vInc]:vPtr[0];
-						}
-					}
-				*pPtr=*vPtr;
-				}
-			else
-				{
-				/* Copy the voxel pile into the pile buffer for the lowpass filter: */
-				for(int z=0;z<sd.numVertices[2];++z,vPtr+=vInc,++pPtr)
-					*pPtr=*vPtr;
-				}
-			
-			vPtr=pilePtr;
-			pPtr=pileBuffer;
-			
-			if(lowpassFilter)
-				{
-				/* Run a lowpass filter over the pixel pile: */
-				*vPtr=Value((int(pPtr[0])*3+int(pPtr[1])*2+int(pPtr[2])+3)/6);
-				vPtr+=vInc;
-				++pPtr;
-				*vPtr=Value((int(pPtr[-1])*2+int(pPtr[0])*3+int(pPtr[1])*2+int(pPtr[2])+4)/8);
-				vPtr+=vInc;
-				++pPtr;
-				for(int z=4;z<sd.numVertices[2];++z,vPtr+=vInc,++pPtr)
-					*vPtr=Value((int(pPtr[-2])+int(pPtr[-1])*2+int(pPtr[0])*3+int(pPtr[1])*2+int(pPtr[2])+4)/9);
-				*vPtr=Value((int(pPtr[-2])+int(pPtr[-1])*2+int(pPtr[0])*3+int(pPtr[1])*2+4)/8);
-				vPtr+=vInc;
-				++pPtr;
-				*vPtr=Value((int(pPtr[-2])+int(pPtr[-1])*2+int(pPtr[0])*3+3)/6);
-				}
-			else
-				{
-				/* Copy the pile buffer back into the voxel pile: */
-				for(int z=0;z<sd.numVertices[2];++z,vPtr+=vInc,++pPtr)
-					*vPtr=*pPtr;
-				}
-			}
-		if(sd.master)
-			std::cout<<"\b\b\b\b"<<std::setw(3)<<((x+1)*100)/sd.numVertices[0]<<"%"<<std::flush;
+		size[i]=sd.numVertices[i];
+		increments[i]=sd.dataSet.getVertexStride(i);
 		}
-	
-	delete[] pileBuffer;
+	Visualization::Templatized::VolumeFilter<Value> filter(sd.dataSet.getSliceArray(sliceIndex),size,increments);
+	if(medianFilter)
+		filter.medianFilter(2);
+	if(lowpassFilter)
+		filter.lowpassFilter(2);
 	
 	filterTimer.elapse();
 	if(sd.master)
-		std::cout<<"\b\b\b\bdone in "<<filterTimer.getTime()*1000.0<<" ms"<<std::endl;
+		std::cout<<" done in "<<filterTimer.getTime()*1000.0<<" ms"<<std::endl;
 	}
 
 }
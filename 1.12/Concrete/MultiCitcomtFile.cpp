@@ -52,6 +52,7 @@ Visualization::Abstract::DataSet* MultiCitcomtFile::load(const std::vector<std::
 	{
 	/* Open the data file: */
 	Misc::File dataFile(args[0].c_str(),"rt");
+	addSourceFile(args[0],false);
 	
 	/* Check if the user wants to load specific variables: */
 	bool varLogScale[numValues];
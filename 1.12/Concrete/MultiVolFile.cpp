@@ -22,18 +22,27 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Concrete/MultiVolFile.h>
 
+#include <stdexcept>
 #include <iostream>
 #include <Misc/SelfDestructPointer.h>
 #include <Misc/File.h>
 #include <Plugins/FactoryManager.h>
 #include <Geometry/Point.h>
 
+#include <Templatized/MappedFile.h>
+
 namespace Visualization {
 
 namespace Concrete {
 
 namespace {
 
+/**************
+Helper objects:
+**************/
+
+const size_t volHeaderSize=3*sizeof(int)+6*sizeof(float)+sizeof(unsigned int); // Size of a vol file's header in bytes
+
 /**************
 Helper methods:
 **************/
@@ -92,6 +101,7 @@ Visualization::Abstract::DataSet* MultiVolFile::load(const std::vector<std::stri
 		{
 		/* Open the vol file: */
 		Misc::File volFile(args[argc+1].c_str(),"rb",Misc::File::LittleEndian);
+		addSourceFile(args[argc+1],false);
 		
 		/* Read the vol file header: */
 		DS::Index volGridSize;
@@ -130,21 +140,43 @@ Visualization::Abstract::DataSet* MultiVolFile::load(const std::vector<std::stri
 			unsigned int volTypeSize=volFile.read<unsigned int>();
 			if(volTypeSize==1||volTypeSize==2||volTypeSize==4||volTypeSize==8)
 				{
-				/* Add a new slice to the data set: */
-				int newSliceIndex=dataSet.addSlice();
-				
 				/* Add a new scalar variable to the data value: */
 				dataValue.addScalarVariable(args[argc].c_str());
 				
-				/* Read the vol file: */
-				if(volTypeSize==1)
-					readVolFile<unsigned char>(volFile,dataSet,newSliceIndex);
-				else if(volTypeSize==2)
-					readVolFile<signed short int>(volFile,dataSet,newSliceIndex);
-				else if(volTypeSize==4)
-					readVolFile<float>(volFile,dataSet,newSliceIndex);
-				else
-					readVolFile<double>(volFile,dataSet,newSliceIndex);
+				bool mapped=false;
+				if(volTypeSize==sizeof(Value)&&Visualization::Templatized::MappedFile::isHostLittleEndian())
+					{
+					/* Back a new slice directly with the vol file's pages if the vol file contains the entire grid: */
+					try
+						{
+						Misc::SelfDestructPointer<Visualization::Templatized::MappedFile> volMapping(new Visualization::Templatized::MappedFile(args[argc+1].c_str()));
+						if(volMapping->getSize()>=volHeaderSize+size_t(gridSize.calcIncrement(-1))*sizeof(Value))
+							{
+							dataSet.addMappedSlice(volMapping.releaseTarget(),volHeaderSize);
+							mapped=true;
+							}
+						}
+					catch(std::runtime_error err)
+						{
+						/* Fall back to reading the vol file: */
+						}
+					}
+				
+				if(!mapped)
+					{
+					/* Add a new slice to the data set: */
+					int newSliceIndex=dataSet.addSlice();
+					
+					/* Read the vol file: */
+					if(volTypeSize==1)
+						readVolFile<unsigned char>(volFile,dataSet,newSliceIndex);
+					else if(volTypeSize==2)
+						readVolFile<signed short int>(volFile,dataSet,newSliceIndex);
+					else if(volTypeSize==4)
+						readVolFile<float>(volFile,dataSet,newSliceIndex);
+					else
+						readVolFile<double>(volFile,dataSet,newSliceIndex);
+					}
 				}
 			else
 				std::cout<<"Vol file "<<args[argc+1]<<" has unknown data type; skipping"<<std::endl;
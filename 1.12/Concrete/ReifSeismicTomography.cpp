@@ -87,7 +87,9 @@ Visualization::Abstract::DataSet* ReifSeismicTomography::load(const std::vector<
 	
 	/* Open the P and S wave velocity files: */
 	Misc::File pFile(dataFileNames[0],"rt");
+	addSourceFile(dataFileNames[0],false);
 	Misc::File sFile(dataFileNames[1],"rt");
+	addSourceFile(dataFileNames[1],false);
 	
 	/* Data size is depth, longitude, latitude in C memory order (latitude varies fastest) */
 	
@@ -34,6 +34,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <IO/ValueSource.h>
 #include <Cluster/MulticastPipe.h>
 
+#include <Templatized/CompressedPipe.h>
+
 namespace Visualization {
 
 namespace Concrete {
@@ -89,6 +91,9 @@ Visualization::Abstract::DataSet* SCTFile::load(const std::vector<std::string>&
 	{
 	bool master=pipe==0||pipe->isMaster();
 	
+	/* Stream the volume data to the slave nodes through a compressing wrapper: */
+	Visualization::Templatized::CompressedPipe stream(pipe);
+	
 	/* Determine the volume data layout: */
 	DS::Index numVertices(0,0,0);
 	DS::Size cellSize(0,0,0);
@@ -129,9 +134,9 @@ Visualization::Abstract::DataSet* SCTFile::load(const std::vector<std::string>&
 			if(pipe!=0)
 				{
 				/* Forward the volume data layout to the slave nodes: */
-				pipe->write<int>(1);
-				pipe->write<int>(numVertices.getComponents(),3);
-				pipe->write<DS::Scalar>(cellSize.getComponents(),3);
+				stream.write<int>(1);
+				stream.write<int>(numVertices.getComponents(),3);
+				stream.write<DS::Scalar>(cellSize.getComponents(),3);
 				}
 			}
 		catch(std::runtime_error err)
@@ -139,8 +144,8 @@ Visualization::Abstract::DataSet* SCTFile::load(const std::vector<std::string>&
 			if(pipe!=0)
 				{
 				/* Send an error code to the slaves: */
-				pipe->write<int>(0);
-				pipe->flush();
+				stream.write<int>(0);
+				stream.flush();
 				}
 			
 			/* Throw an error: */
@@ -151,15 +156,15 @@ Visualization::Abstract::DataSet* SCTFile::load(const std::vector<std::string>&
 	else
 		{
 		/* Check for read errors: */
-		if(pipe->read<int>()==0)
+		if(stream.read<int>()==0)
 			{
 			/* Throw an error: */
 			Misc::throwStdErr("SCTFile::load: Caught exception while loading stack descriptor %s",args[0].c_str());
 			}
 		
 		/* Read the volume data layout from the master: */
-		pipe->read<int>(numVertices.getComponents(),3);
-		pipe->read<DS::Scalar>(cellSize.getComponents(),3);
+		stream.read<int>(numVertices.getComponents(),3);
+		stream.read<DS::Scalar>(cellSize.getComponents(),3);
 		}
 	
 	/* Create the data set: */
@@ -232,8 +237,8 @@ Visualization::Abstract::DataSet* SCTFile::load(const std::vector<std::string>&
 				if(pipe!=0)
 					{
 					/* Forward the slice to the slave nodes: */
-					pipe->write<int>(1);
-					pipe->write<DS::Value>(vertexPtr,sizeY*sizeX);
+					stream.write<int>(1);
+					stream.write<DS::Value>(vertexPtr,sizeY*sizeX);
 					}
 				
 				/* Go to the next slice: */
@@ -244,8 +249,8 @@ Visualization::Abstract::DataSet* SCTFile::load(const std::vector<std::string>&
 				if(pipe!=0)
 					{
 					/* Send an error code to the slaves: */
-					pipe->write<int>(0);
-					pipe->flush();
+					stream.write<int>(0);
+					stream.flush();
 					}
 				
 				/* Throw an error: */
@@ -256,6 +261,8 @@ Visualization::Abstract::DataSet* SCTFile::load(const std::vector<std::string>&
 			/* Update the progress counter: */
 			std::cout<<"\b\b\b\b"<<std::setw(3)<<((sliceIndex+1)*100)/numVertices[0]<<"%"<<std::flush;
 			}
+		if(pipe!=0)
+			stream.flush();
 		std::cout<<"\b\b\b\bdone"<<std::endl;
 		}
 	else
@@ -263,14 +270,14 @@ Visualization::Abstract::DataSet* SCTFile::load(const std::vector<std::string>&
 		for(int sliceIndex=0;sliceIndex<numVertices[0];++sliceIndex)
 			{
 			/* Check for read errors: */
-			if(pipe->read<int>()==0)
+			if(stream.read<int>()==0)
 				{
 				/* Throw an error: */
 				Misc::throwStdErr("SCTFile::load: Caught exception while loading slice image %d",sliceIndex);
 				}
 			
 			/* Read the volume slice: */
-			pipe->read<DS::Value>(vertexPtr,numVertices[1]*numVertices[2]);
+			stream.read<DS::Value>(vertexPtr,numVertices[1]*numVertices[2]);
 			
 			/* Go to the next slice: */
 			vertexPtr+=numVertices[1]*numVertices[2];
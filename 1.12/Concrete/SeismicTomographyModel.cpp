@@ -304,6 +304,7 @@ Visualization::Abstract::DataSet* SeismicTomographyModel::load(const std::vector
 		{
 		/* Open the input wave velocity file: */
 		vFile=new Misc::File(dataFileName,"rt");
+		addSourceFile(dataFileName,false);
 		}
 	for(index[am[0]]=0;index[am[0]]<numVertices[am[0]];++index[am[0]])
 		{
@@ -314,6 +315,7 @@ Visualization::Abstract::DataSet* SeismicTomographyModel::load(const std::vector
 			std::string sliceFileName=sliceBaseDir;
 			sliceFileName+=sliceFiles[index[am[0]]].fileName;
 			vFile=new Misc::File(sliceFileName.c_str(),"rt");
+			addSourceFile(sliceFileName,false);
 			depth=double(sliceFiles[index[am[0]]].depth);
 			}
 		for(index[am[1]]=0;index[am[1]]<numVertices[am[1]];++index[am[1]])
@@ -34,13 +34,13 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Plugins/FactoryManager.h>
 #include <IO/File.h>
 #include <IO/OpenFile.h>
-#include <IO/ValueSource.h>
 #include <Cluster/MulticastPipe.h>
 #include <Math/Math.h>
 #include <Math/Constants.h>
 
 #include <Concrete/SphericalCoordinateTransformer.h>
 #include <Concrete/EarthDataSet.h>
+#include <Concrete/BulkValueSource.h>
 
 namespace Visualization {
 
@@ -208,7 +208,7 @@ Visualization::Abstract::DataSet* SphericalASCIIFile::load(const std::vector<std
 		Misc::throwStdErr("SphericalASCIIFile::load: No scalar or vector data values specified");
 	
 	/* Open the data file: */
-	IO::ValueSource reader(openFile(dataFileName,pipe));
+	BulkValueSource reader(openFile(dataFileName,pipe));
 	reader.setPunctuation('\n',true);
 	
 	/* Skip the data file header: */
@@ -263,9 +263,6 @@ Visualization::Abstract::DataSet* SphericalASCIIFile::load(const std::vector<std
 	// const double f=1.0/298.247; // Geoid flattening factor (not used, since there could be vector values)
 	const double scaleFactor=1.0e-3; // Scale factor for Cartesian coordinates
 	
-	/* Allocate an array to parse the file's data columns: */
-	double* columns=new double[maxColumnIndex+1];
-	
 	/* Read all node positions and values: */
 	if(master)
 		std::cout<<"Reading grid vertex positions and values...   0%"<<std::flush;
@@ -285,21 +282,20 @@ Visualization::Abstract::DataSet* SphericalASCIIFile::load(const std::vector<std
 		index0Increment=1;
 		}
 	unsigned int lineNumber=numHeaderLines+1;
+	reader.startRecords(size_t(numVertices.calcIncrement(-1)),maxColumnIndex+1,true);
 	for(index[nodeCountOrder[0]]=index0Min;index[nodeCountOrder[0]]!=index0Max;index[nodeCountOrder[0]]+=index0Increment)
 		{
 		for(index[nodeCountOrder[1]]=0;index[nodeCountOrder[1]]<numVertices[nodeCountOrder[1]];++index[nodeCountOrder[1]])
 			for(index[nodeCountOrder[2]]=0;index[nodeCountOrder[2]]<numVertices[nodeCountOrder[2]];++index[nodeCountOrder[2]])
 				{
+				const double* columns=0;
 				try
 					{
 					/* Read all relevant columns from the next line: */
-					for(int i=0;i<=maxColumnIndex;++i)
-						columns[i]=reader.readNumber();
-					reader.skipLine();
-					reader.skipWs();
+					columns=reader.readRecord();
 					++lineNumber;
 					}
-				catch(IO::ValueSource::NumberError err)
+				catch(BulkValueSource::NumberError err)
 					{
 					Misc::throwStdErr("SphericalASCIIFile::load: Number format error in line %u",lineNumber);
 					}
@@ -376,8 +372,6 @@ Visualization::Abstract::DataSet* SphericalASCIIFile::load(const std::vector<std
 	if(master)
 		std::cout<<"\b\b\b\bdone"<<std::endl;
 	
-	delete[] columns;
-	
 	/* Finalize the grid structure: */
 	if(master)
 		std::cout<<"Finalizing grid structure..."<<std::flush;
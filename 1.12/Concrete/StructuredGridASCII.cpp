@@ -33,10 +33,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Misc/ThrowStdErr.h>
 #include <Plugins/FactoryManager.h>
 #include <IO/OpenFile.h>
-#include <IO/ValueSource.h>
 #include <Cluster/MulticastPipe.h>
 #include <Math/Math.h>
 
+#include <Concrete/BulkValueSource.h>
+
 namespace Visualization {
 
 namespace Concrete {
@@ -72,8 +73,9 @@ Visualization::Abstract::DataSet* StructuredGridASCII::load(const std::vector<st
 	/* Open the grid definition file: */
 	if(master)
 		std::cout<<"Reading grid file "<<*argIt<<"..."<<std::flush;
-	IO::ValueSource gridReader(openFile(*argIt,pipe));
+	BulkValueSource gridReader(openFile(*argIt,pipe));
 	gridReader.setPunctuation("#\n");
+	gridReader.setCommentCharacter('#');
 	gridReader.skipWs();
 	
 	/* Parse the grid file header: */
@@ -97,7 +99,7 @@ Visualization::Abstract::DataSet* StructuredGridASCII::load(const std::vector<st
 				for(int i=0;i<3;++i)
 					numVertices[i]=gridReader.readInteger();
 				}
-			catch(IO::ValueSource::NumberError err)
+			catch(BulkValueSource::NumberError err)
 				{
 				Misc::throwStdErr("StructuredGridASCII::load: Invalid grid size in line %u in grid file %s",lineIndex,argIt->c_str());
 				}
@@ -150,80 +152,64 @@ Visualization::Abstract::DataSet* StructuredGridASCII::load(const std::vector<st
 	// const double f=1.0/298.247; // Geoid flattening factor (not used, since there could be vector values)
 	const double scaleFactor=1.0e-3; // Scale factor for Cartesian coordinates
 	
-	/* Read all vertex positions: */
+	/* Read all vertex positions, one per line: */
 	if(master)
 		std::cout<<"   0%"<<std::flush;
+	gridReader.startRecords(size_t(numVertices.calcIncrement(-1)),3,true);
 	DS::Index index(0);
 	while(index[2]<numVertices[2])
 		{
-		/* Check if the file is already over: */
-		if(gridReader.eof())
-			Misc::throwStdErr("StructuredGridASCII::load: early end-of-file in grid file %s",argIt->c_str());
+		/* Read the next vertex' line: */
+		const double* coords=0;
+		try
+			{
+			coords=gridReader.readRecord();
+			}
+		catch(BulkValueSource::NumberError err)
+			{
+			Misc::throwStdErr("StructuredGridASCII::load: Invalid or missing %s vertex coordinate for vertex (%d, %d, %d) in grid file %s",sphericalCoordinates?"spherical":"Cartesian",index[0],index[1],index[2],argIt->c_str());
+			}
 		
-		/* Check for empty or comment lines: */
-		if(gridReader.peekc()!='\n'&&gridReader.peekc()!='#')
+		DS::Point& vertex=dataSet.getVertexPosition(index);
+		if(sphericalCoordinates)
 			{
-			/* Parse the line: */
-			DS::Point& vertex=dataSet.getVertexPosition(index);
-			if(sphericalCoordinates)
-				{
-				try
-					{
-					/* Read the vertex' position in spherical coordinates: */
-					double longitude=gridReader.readNumber();
-					double latitude=gridReader.readNumber();
-					double radius=gridReader.readNumber();
-					
-					/* Convert the vertex position to Cartesian coordinates: */
-					double s0=Math::sin(latitude);
-					double c0=Math::cos(latitude);
-					double r=radius*scaleFactor;
-					double xy=r*c0;
-					double s1=Math::sin(longitude);
-					double c1=Math::cos(longitude);
-					vertex[0]=Scalar(xy*c1);
-					vertex[1]=Scalar(xy*s1);
-					vertex[2]=Scalar(r*s0);
-					
-					if(storeSphericals)
-						{
-						/* Store the spherical coordinate components in the first three value slices: */
-						dataSet.getVertexValue(0,index)=Scalar(Math::deg(latitude));
-						dataSet.getVertexValue(1,index)=Scalar(Math::deg(longitude));
-						dataSet.getVertexValue(2,index)=Scalar(r);
-						}
-					}
-				catch(IO::ValueSource::NumberError err)
-					{
-					Misc::throwStdErr("StructuredGridASCII::load: Invalid spherical vertex coordinate in line %u in grid file %s",lineIndex,argIt->c_str());
-					}
-				}
-			else
+			/* Get the vertex' position in spherical coordinates: */
+			double longitude=coords[0];
+			double latitude=coords[1];
+			double radius=coords[2];
+			
+			/* Convert the vertex position to Cartesian coordinates: */
+			double s0=Math::sin(latitude);
+			double c0=Math::cos(latitude);
+			double r=radius*scaleFactor;
+			double xy=r*c0;
+			double s1=Math::sin(longitude);
+			double c1=Math::cos(longitude);
+			vertex[0]=Scalar(xy*c1);
+			vertex[1]=Scalar(xy*s1);
+			vertex[2]=Scalar(r*s0);
+			
+			if(storeSphericals)
 				{
-				try
-					{
-					for(int i=0;i<3;++i)
-						vertex[i]=DS::Scalar(gridReader.readNumber());
-					}
-				catch(IO::ValueSource::NumberError err)
-					{
-					Misc::throwStdErr("StructuredGridASCII::load: Invalid Cartesian vertex coordinate in line %u in grid file %s",lineIndex,argIt->c_str());
-					}
+				/* Store the spherical coordinate components in the first three value slices: */
+				dataSet.getVertexValue(0,index)=Scalar(Math::deg(latitude));
+				dataSet.getVertexValue(1,index)=Scalar(Math::deg(longitude));
+				dataSet.getVertexValue(2,index)=Scalar(r);
 				}
-			
-			/* Go to the next vertex: */
-			int incDim;
-			for(incDim=0;incDim<2&&index[incDim]==numVertices[incDim]-1;++incDim)
-				index[incDim]=0;
-			++index[incDim];
-			if(incDim==2&&master)
-				std::cout<<"\b\b\b\b"<<std::setw(3)<<(index[2]*100)/numVertices[2]<<"%"<<std::flush;
+			}
+		else
+			{
+			for(int i=0;i<3;++i)
+				vertex[i]=DS::Scalar(coords[i]);
 			}
 		
-		/* Go to the next line: */
-		gridReader.skipLine();
-		gridReader.skipWs();
-		++lineIndex;
+		/* Go to the next vertex: */
+		int incDim;
+		for(incDim=0;incDim<2&&index[incDim]==numVertices[incDim]-1;++incDim)
+			index[incDim]=0;
+		++index[incDim];
+		if(incDim==2&&master)
+			std::cout<<"\b\b\b\b"<<std::setw(3)<<(index[2]*100)/numVertices[2]<<"%"<<std::flush;
 		}
 	if(master)
 		std::cout<<"\b\b\b\bdone"<<std::endl;
@@ -246,8 +232,9 @@ Visualization::Abstract::DataSet* StructuredGridASCII::load(const std::vector<st
 			/* Open the slice file: */
 			if(master)
 				std::cout<<"Reading slice file "<<*argIt<<"..."<<std::flush;
-			IO::ValueSource sliceReader(openFile(*argIt,pipe));
+			BulkValueSource sliceReader(openFile(*argIt,pipe));
 			sliceReader.setPunctuation("#\n");
+			sliceReader.setCommentCharacter('#');
 			sliceReader.skipWs();
 			
 			/* Parse the slice file header: */
@@ -272,7 +259,7 @@ Visualization::Abstract::DataSet* StructuredGridASCII::load(const std::vector<st
 						for(int i=0;i<3;++i)
 							sliceNumVertices[i]=sliceReader.readInteger();
 						}
-					catch(IO::ValueSource::NumberError err)
+					catch(BulkValueSource::NumberError err)
 						{
 						Misc::throwStdErr("StructuredGridASCII::load: Invalid grid size in line %u in grid file %s",lineIndex,argIt->c_str());
 						}
@@ -309,6 +296,7 @@ Visualization::Abstract::DataSet* StructuredGridASCII::load(const std::vector<st
 					if(!vectorName.empty()&&vectorName!="\n")
 						{
 						/* Add another vector variable to the data value: */
+						vectorValue=true;
 						int vectorVariableIndex=dataValue.addVectorVariable(vectorName.c_str());
 						
 						/* Add four new slices to the data set (three components plus magnitude): */
@@ -334,111 +322,76 @@ Visualization::Abstract::DataSet* StructuredGridASCII::load(const std::vector<st
 				++lineIndex;
 				}
 			
-			/* Read all vertex attributes: */
+			/* Read all vertex attributes, one per line: */
 			if(master)
 				std::cout<<"   0%"<<std::flush;
+			sliceReader.startRecords(size_t(numVertices.calcIncrement(-1)),vectorValue?3:1,true);
 			DS::Index index(0);
 			while(index[2]<numVertices[2])
 				{
-				/* Check if the file is already over: */
-				if(sliceReader.eof())
-					Misc::throwStdErr("StructuredGridASCII::load: early end-of-file in slice file %s",argIt->c_str());
+				/* Read the next vertex' line: */
+				const double* values=0;
+				try
+					{
+					values=sliceReader.readRecord();
+					}
+				catch(BulkValueSource::NumberError err)
+					{
+					Misc::throwStdErr("StructuredGridASCII::load: Invalid or missing %s vertex attribute for vertex (%d, %d, %d) in slice file %s",vectorValue?"vector":"scalar",index[0],index[1],index[2],argIt->c_str());
+					}
 				
-				/* Check for empty or comment lines: */
-				if(sliceReader.peekc()!='\n'&&sliceReader.peekc()!='#')
+				if(vectorValue)
 					{
-					/* Parse the line: */
-					if(vectorValue)
+					DataValue::VVector vector;
+					if(sphericalCoordinates)
 						{
-						DataValue::VVector vector;
-						if(sphericalCoordinates)
-							{
-							try
-								{
-								/* Read the vector attribute in spherical coordinates: */
-								double longitude=sliceReader.readNumber();
-								double latitude=sliceReader.readNumber();
-								double radius=sliceReader.readNumber();
-								
-								/* Convert the vector to Cartesian coordinates: */
-								const DS::Point& p=dataSet.getVertexPosition(index);
-								double xy=Math::sqr(double(p[0]))+Math::sqr(double(p[1]));
-								double r=xy+Math::sqr(double(p[2]));
-								xy=Math::sqrt(xy);
-								r=Math::sqrt(r);
-								double s0=double(p[2])/r;
-								double c0=xy/r;
-								double s1=double(p[1])/xy;
-								double c1=double(p[0])/xy;
-								vector[0]=Scalar(c1*(c0*radius-s0*latitude)-s1*longitude);
-								vector[1]=Scalar(s1*(c0*radius-s0*latitude)+c1*longitude);
-								vector[2]=Scalar(c0*latitude+s0*radius);
-								}
-							catch(IO::ValueSource::NumberError err)
-								{
-								Misc::throwStdErr("StructuredGridASCII::load: Invalid spherical vector attribute in line %u in slice file %s",lineIndex,argIt->c_str());
-								}
-							}
-						else
-							{
-							try
-								{
-								/* Read the vector attribute in Cartesian coordinates: */
-								for(int i=0;i<3;++i)
-									vector[i]=DataValue::VVector::Scalar(sliceReader.readNumber());
-								}
-							catch(IO::ValueSource::NumberError err)
-								{
-								Misc::throwStdErr("StructuredGridASCII::load: Invalid Cartesian vector attribute in line %u in slice file %s",lineIndex,argIt->c_str());
-								}
-							}
+						/* Get the vector attribute in spherical coordinates: */
+						double longitude=values[0];
+						double latitude=values[1];
+						double radius=values[2];
 						
-						/* Store the vector's components and magnitude: */
-						for(int i=0;i<3;++i)
-							dataSet.getVertexValue(sliceIndex+i,index)=vector[i];
-						dataSet.getVertexValue(sliceIndex+3,index)=Scalar(Geometry::mag(vector));
+						/* Convert the vector to Cartesian coordinates: */
+						const DS::Point& p=dataSet.getVertexPosition(index);
+						double xy=Math::sqr(double(p[0]))+Math::sqr(double(p[1]));
+						double r=xy+Math::sqr(double(p[2]));
+						xy=Math::sqrt(xy);
+						r=Math::sqrt(r);
+						double s0=double(p[2])/r;
+						double c0=xy/r;
+						double s1=double(p[1])/xy;
+						double c1=double(p[0])/xy;
+						vector[0]=Scalar(c1*(c0*radius-s0*latitude)-s1*longitude);
+						vector[1]=Scalar(s1*(c0*radius-s0*latitude)+c1*longitude);
+						vector[2]=Scalar(c0*latitude+s0*radius);
 						}
 					else
 						{
-						/* Read the scalar attribute: */
-						if(logNextScalar)
-							{
-							try
-								{
-								double value=sliceReader.readNumber();
-								dataSet.getVertexValue(sliceIndex,index)=Scalar(Math::log10(value));
-								}
-							catch(IO::ValueSource::NumberError err)
-								{
-								Misc::throwStdErr("StructuredGridASCII::load: Invalid logarithmic scalar vertex attribute in line %u in slice file %s",lineIndex,argIt->c_str());
-								}
-							}
-						else
-							{
-							try
-								{
-								dataSet.getVertexValue(sliceIndex,index)=Scalar(sliceReader.readNumber());
-								}
-							catch(IO::ValueSource::NumberError err)
-								{
-								Misc::throwStdErr("StructuredGridASCII::load: Invalid scalar vertex attribute in line %u in slice file %s",lineIndex,argIt->c_str());
-								}
-							}
+						/* Get the vector attribute in Cartesian coordinates: */
+						for(int i=0;i<3;++i)
+							vector[i]=DataValue::VVector::Scalar(values[i]);
 						}
-
-					/* Go to the next vertex: */
-					int incDim;
-					for(incDim=0;incDim<2&&index[incDim]==numVertices[incDim]-1;++incDim)
-						index[incDim]=0;
-					++index[incDim];
-					if(incDim==2&&master)
-						std::cout<<"\b\b\b\b"<<std::setw(3)<<(index[2]*100)/numVertices[2]<<"%"<<std::flush;
+					
+					/* Store the vector's components and magnitude: */
+					for(int i=0;i<3;++i)
+						dataSet.getVertexValue(sliceIndex+i,index)=vector[i];
+					dataSet.getVertexValue(sliceIndex+3,index)=Scalar(Geometry::mag(vector));
+					}
+				else
+					{
+					/* Store the scalar attribute: */
+					if(logNextScalar)
+						dataSet.getVertexValue(sliceIndex,index)=Scalar(Math::log10(values[0]));
+					else
+						dataSet.getVertexValue(sliceIndex,index)=Scalar(values[0]);
 					}
 				
-				/* Go to the next line: */
-				sliceReader.skipLine();
-				sliceReader.skipWs();
-				++lineIndex;
+				/* Go to the next vertex: */
+				int incDim;
+				for(incDim=0;incDim<2&&index[incDim]==numVertices[incDim]-1;++incDim)
+					index[incDim]=0;
+				++index[incDim];
+				if(incDim==2&&master)
+					std::cout<<"\b\b\b\b"<<std::setw(3)<<(index[2]*100)/numVertices[2]<<"%"<<std::flush;
 				}
 			if(master)
 				std::cout<<"\b\b\b\bdone"<<std::endl;
@@ -22,16 +22,22 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Concrete/StructuredGridVTK.h>
 
+#include <string.h>
+#include <stdlib.h>
 #include <string>
+#include <vector>
 #include <iostream>
 #include <iomanip>
 #include <Misc/SizedTypes.h>
 #include <Misc/SelfDestructPointer.h>
 #include <Misc/ThrowStdErr.h>
 #include <Plugins/FactoryManager.h>
+#include <IO/SeekableFile.h>
 #include <IO/OpenFile.h>
 #include <IO/ValueSource.h>
-#include <Math/Interval.h>
+
+#include <Templatized/WorkerPool.h>
+#include <Templatized/CompactSlice.h>
 
 namespace Visualization {
 
@@ -39,118 +45,393 @@ namespace Concrete {
 
 namespace {
 
-/****************
-Helper functions:
-****************/
+/**************
+Helper objects:
+**************/
 
-template <class FileValueParam>
-inline
-void
-readVertexPositions(
-	DS& dataSet,
-	IO::File& file,
-	bool master)
+const size_t binaryBlockSize=64*1024*1024; // Amount of binary data to read and decode at once
+
+/**************
+Helper classes:
+**************/
+
+template <int sizeParam>
+class FileWord // Class to reverse the byte order of file values of the given size as unsigned integers
+	{
+	};
+
+template <>
+class FileWord<1>
+	{
+	/* Embedded classes: */
+	public:
+	typedef Misc::UInt8 Type;
+	
+	/* Methods: */
+	static Type swap(Type word)
+		{
+		return word;
+		}
+	};
+
+template <>
+class FileWord<2>
+	{
+	/* Embedded classes: */
+	public:
+	typedef Misc::UInt16 Type;
+	
+	/* Methods: */
+	static Type swap(Type word)
+		{
+		return Type((word>>8)|(word<<8));
+		}
+	};
+
+template <>
+class FileWord<4>
+	{
+	/* Embedded classes: */
+	public:
+	typedef Misc::UInt32 Type;
+	
+	/* Methods: */
+	static Type swap(Type word)
+		{
+		return (word>>24)|((word>>8)&0x0000ff00U)|((word<<8)&0x00ff0000U)|(word<<24);
+		}
+	};
+
+template <>
+class FileWord<8>
+	{
+	/* Embedded classes: */
+	public:
+	typedef Misc::UInt64 Type;
+	
+	/* Methods: */
+	static Type swap(Type word)
+		{
+		return (Type(FileWord<4>::swap(Misc::UInt32(word)))<<32)|Type(FileWord<4>::swap(Misc::UInt32(word>>32)));
+		}
+	};
+
+class PositionScatterer // Class to store vertex positions in the data set's grid
+	{
+	/* Elements: */
+	public:
+	static const int numValues=3; // Number of file values used per vertex
+	private:
+	DS& dataSet; // The data set
+	
+	/* Constructors and destructors: */
+	public:
+	PositionScatterer(DS& sDataSet)
+		:dataSet(sDataSet)
+		{
+		}
+	
+	/* Methods: */
+	void store(const DS::Index& index,const double values[numValues])
+		{
+		DS::Point& vertex=dataSet.getVertexPosition(index);
+		for(int i=0;i<3;++i)
+			vertex[i]=DS::Scalar(values[i]);
+		}
+	};
+
+class VectorScatterer // Class to store vector attributes and their magnitudes in four consecutive slices
+	{
+	/* Elements: */
+	public:
+	static const int numValues=3; // Number of file values used per vertex
+	private:
+	DS& dataSet; // The data set
+	int sliceIndex; // Index of the slice receiving the vectors' first component
+	
+	/* Constructors and destructors: */
+	public:
+	VectorScatterer(DS& sDataSet,int sSliceIndex)
+		:dataSet(sDataSet),sliceIndex(sSliceIndex)
+		{
+		}
+	
+	/* Methods: */
+	void store(const DS::Index& index,const double values[numValues])
+		{
+		DataValue::VVector vector;
+		for(int i=0;i<3;++i)
+			vector[i]=DataValue::VVector::Scalar(values[i]);
+		
+		/* Store the vector's components and magnitude: */
+		for(int i=0;i<3;++i)
+			dataSet.getVertexValue(sliceIndex+i,index)=vector[i];
+		dataSet.getVertexValue(sliceIndex+3,index)=DataValue::VScalar(Geometry::mag(vector));
+		}
+	};
+
+class ScalarScatterer // Class to store the first component of scalar attributes in a slice
+	{
+	/* Elements: */
+	public:
+	static const int numValues=1; // Number of file values used per vertex
+	private:
+	DS& dataSet; // The data set
+	int sliceIndex; // Index of the slice receiving the scalars
+	
+	/* Constructors and destructors: */
+	public:
+	ScalarScatterer(DS& sDataSet,int sSliceIndex)
+		:dataSet(sDataSet),sliceIndex(sSliceIndex)
+		{
+		}
+	
+	/* Methods: */
+	void store(const DS::Index& index,const double values[numValues])
+		{
+		dataSet.getVertexValue(sliceIndex,index)=DS::ValueScalar(values[0]);
+		}
+	};
+
+template <class FileValueParam,class ScattererParam>
+class PlaneDecoder // Class to convert a block of vertex planes from file byte order and store them in the data set in parallel
 	{
+	/* Embedded classes: */
+	private:
 	typedef FileValueParam FileValue;
+	typedef FileWord<sizeof(FileValue)> Word;
 	
-	const DS::Index& size=dataSet.getNumVertices();
-	DS::Index index;
-	if(master)
-		std::cout<<"Reading grid vertices...   0%"<<std::flush;
-	for(index[2]=0;index[2]<size[2];++index[2])
+	/* Elements: */
+	typename Word::Type* block; // Block of raw file values
+	int firstPlane; // Index of the block's first vertex plane
+	int numPlanes; // Number of vertex planes in the block
+	const DS::Index& size; // Number of vertices in the data set
+	int numComponents; // Number of file values per vertex
+	bool swap; // Flag whether file values need to be byte-swapped
+	ScattererParam& scatterer; // Object storing decoded vertex values
+	unsigned int numWorkers; // Number of workers sharing the block
+	
+	/* Constructors and destructors: */
+	public:
+	PlaneDecoder(typename Word::Type* sBlock,int sFirstPlane,int sNumPlanes,const DS::Index& sSize,int sNumComponents,bool sSwap,ScattererParam& sScatterer,unsigned int sNumWorkers)
+		:block(sBlock),firstPlane(sFirstPlane),numPlanes(sNumPlanes),size(sSize),
+		 numComponents(sNumComponents),swap(sSwap),scatterer(sScatterer),numWorkers(sNumWorkers)
 		{
-		for(index[1]=0;index[1]<size[1];++index[1])
-			for(index[0]=0;index[0]<size[0];++index[0])
-				{
-				DS::Point& vertex=dataSet.getVertexPosition(index);
-				for(int i=0;i<3;++i)
-					vertex[i]=DS::Scalar(file.read<FileValue>());
-				}
-		if(master)
-			std::cout<<"\b\b\b\b"<<std::setw(3)<<((index[2]+1)*100+size[2]/2)/size[2]<<"%"<<std::flush;
 		}
-	if(master)
-		std::cout<<"\b\b\b\bdone"<<std::endl;
+	
+	/* Methods: */
+	void operator()(unsigned int workerIndex) // Decodes every numWorkers-th plane, starting at the worker's index
+		{
+		size_t planeSize=size_t(size[0])*size_t(size[1])*size_t(numComponents);
+		for(int plane=int(workerIndex);plane<numPlanes;plane+=int(numWorkers))
+			{
+			typename Word::Type* planeWords=block+size_t(plane)*planeSize;
+			
+			/* Convert the entire plane to host byte order in a tight loop the compiler can vectorize: */
+			if(swap)
+				for(size_t i=0;i<planeSize;++i)
+					planeWords[i]=Word::swap(planeWords[i]);
+			
+			/* Store the plane's vertex values, which are ordered with the first index varying fastest: */
+			const typename Word::Type* wPtr=planeWords;
+			DS::Index index;
+			index[2]=firstPlane+plane;
+			for(index[1]=0;index[1]<size[1];++index[1])
+				for(index[0]=0;index[0]<size[0];++index[0],wPtr+=numComponents)
+					{
+					double values[ScattererParam::numValues];
+					for(int i=0;i<ScattererParam::numValues;++i)
+						{
+						FileValue value;
+						memcpy(&value,wPtr+i,sizeof(FileValue));
+						values[i]=double(value);
+						}
+					scatterer.store(index,values);
+					}
+			}
+		}
+	};
+
+/****************
+Helper functions:
+****************/
+
+inline bool isHostLittleEndian(void)
+	{
+	const Misc::UInt16 marker=0x0102U;
+	return *reinterpret_cast<const Misc::UInt8*>(&marker)==0x02U;
 	}
 
-template <class FileValueParam>
+template <class FileValueParam,class ScattererParam>
 inline
 void
-readVectorAttributes(
-	DS& dataSet,
-	const std::string& attributeName,
-	int sliceIndex,
+readBinaryPlanes(
 	IO::File& file,
+	const DS::Index& size,
+	int numComponents,
+	ScattererParam& scatterer,
 	bool master)
 	{
-	typedef FileValueParam FileValue;
+	typedef FileWord<sizeof(FileValueParam)> Word;
 	
-	const DS::Index& size=dataSet.getNumVertices();
-	DS::Index index;
-	if(master)
-		std::cout<<"Reading vector attribute "<<attributeName<<"...   0%"<<std::flush;
-	Math::Interval<DataValue::VScalar> range[3];
-	for(int i=0;i<3;++i)
-		range[i]=Math::Interval<DataValue::VScalar>::empty;
-	for(index[2]=0;index[2]<size[2];++index[2])
+	/* Read as many whole vertex planes at once as fit into a block: */
+	size_t planeSize=size_t(size[0])*size_t(size[1])*size_t(numComponents);
+	size_t blockNumPlanes=binaryBlockSize/(planeSize*sizeof(typename Word::Type));
+	if(blockNumPlanes<1)
+		blockNumPlanes=1;
+	if(blockNumPlanes>size_t(size[2]))
+		blockNumPlanes=size_t(size[2]);
+	std::vector<typename Word::Type> block(blockNumPlanes*planeSize);
+	
+	/* Binary legacy VTK files are always big-endian: */
+	bool swap=sizeof(typename Word::Type)>1&&isHostLittleEndian();
+	
+	for(int firstPlane=0;firstPlane<size[2];firstPlane+=int(blockNumPlanes))
 		{
-		for(index[1]=0;index[1]<size[1];++index[1])
-			for(index[0]=0;index[0]<size[0];++index[0])
-				{
-				DataValue::VVector vector;
-				for(int i=0;i<3;++i)
-					{
-					vector[i]=DataValue::VVector::Scalar(file.read<FileValue>());
-					range[i].addValue(vector[i]);
-					}
-				
-				/* Store the vector's components and magnitude: */
-				for(int i=0;i<3;++i)
-					dataSet.getVertexValue(sliceIndex+i,index)=vector[i];
-				dataSet.getVertexValue(sliceIndex+3,index)=DataValue::VScalar(Geometry::mag(vector));
-				}
+		/* Read the next block of planes: */
+		int numPlanes=size[2]-firstPlane;
+		if(numPlanes>int(blockNumPlanes))
+			numPlanes=int(blockNumPlanes);
+		file.readRaw(&block[0],size_t(numPlanes)*planeSize*sizeof(typename Word::Type));
+		
+		/* Decode and store the block's planes in parallel: */
+		unsigned int numWorkers=Templatized::WorkerPool::getNumWorkers();
+		if(numWorkers>(unsigned int)numPlanes)
+			numWorkers=(unsigned int)numPlanes;
+		PlaneDecoder<FileValueParam,ScattererParam> decoder(&block[0],firstPlane,numPlanes,size,numComponents,swap,scatterer,numWorkers);
+		Templatized::WorkerPool::run(decoder,numWorkers);
+		
 		if(master)
-			std::cout<<"\b\b\b\b"<<std::setw(3)<<((index[2]+1)*100+size[2]/2)/size[2]<<"%"<<std::flush;
+			std::cout<<"\b\b\b\b"<<std::setw(3)<<((firstPlane+numPlanes)*100+size[2]/2)/size[2]<<"%"<<std::flush;
 		}
 	if(master)
 		std::cout<<"\b\b\b\bdone"<<std::endl;
-	
-	for(int i=0;i<3;++i)
-		std::cout<<range[i].getMin()<<" - "<<range[i].getMax()<<std::endl;
 	}
 
-template <class FileValueParam>
+template <class ScattererParam>
 inline
-void
-readScalarAttributes(
-	DS& dataSet,
-	const std::string& attributeName,
-	int attributeNumScalars,
-	int sliceIndex,
+bool
+readBinaryAttribute(
 	IO::File& file,
+	const std::string& dataType,
+	const DS::Index& size,
+	int numComponents,
+	ScattererParam& scatterer,
 	bool master)
 	{
-	typedef FileValueParam FileValue;
+	if(dataType=="unsigned_char")
+		readBinaryPlanes<Misc::UInt8>(file,size,numComponents,scatterer,master);
+	else if(dataType=="char")
+		readBinaryPlanes<Misc::SInt8>(file,size,numComponents,scatterer,master);
+	else if(dataType=="unsigned_short")
+		readBinaryPlanes<Misc::UInt16>(file,size,numComponents,scatterer,master);
+	else if(dataType=="short")
+		readBinaryPlanes<Misc::SInt16>(file,size,numComponents,scatterer,master);
+	else if(dataType=="unsigned_int")
+		readBinaryPlanes<Misc::UInt32>(file,size,numComponents,scatterer,master);
+	else if(dataType=="int")
+		readBinaryPlanes<Misc::SInt32>(file,size,numComponents,scatterer,master);
+	else if(dataType=="unsigned_long")
+		readBinaryPlanes<Misc::UInt64>(file,size,numComponents,scatterer,master);
+	else if(dataType=="long")
+		readBinaryPlanes<Misc::SInt64>(file,size,numComponents,scatterer,master);
+	else if(dataType=="float")
+		readBinaryPlanes<Misc::Float32>(file,size,numComponents,scatterer,master);
+	else if(dataType=="double")
+		readBinaryPlanes<Misc::Float64>(file,size,numComponents,scatterer,master);
+	else
+		return false;
 	
-	const DS::Index& size=dataSet.getNumVertices();
-	DS::Index index;
-	if(master)
-		std::cout<<"Reading "<<attributeNumScalars<<"-component scalar attribute "<<attributeName<<"...   0%"<<std::flush;
-	for(index[2]=0;index[2]<size[2];++index[2])
+	return true;
+	}
+
+size_t getBinaryTypeSize(const std::string& dataType) // Returns the size of a binary value of the given type in bytes, or 0 for unsupported types
+	{
+	if(dataType=="unsigned_char"||dataType=="char")
+		return 1;
+	else if(dataType=="unsigned_short"||dataType=="short")
+		return 2;
+	else if(dataType=="unsigned_int"||dataType=="int"||dataType=="float")
+		return 4;
+	else if(dataType=="unsigned_long"||dataType=="long"||dataType=="double")
+		return 8;
+	else
+		return 0;
+	}
+
+/*****************************************
+Helper class to load attributes on demand:
+*****************************************/
+
+class AttributeLoader:public DataValue::SliceLoader // Class to read a binary point attribute from the VTK file when it is first used
+	{
+	/* Elements: */
+	private:
+	DS& dataSet; // The data set
+	std::string fileName; // Full name of the VTK file
+	IO::SeekableFile::Offset dataOffset; // Position of the attribute's values in the VTK file
+	std::string attributeName; // Name of the attribute
+	std::string dataType; // Type of the attribute's file values
+	int numComponents; // Number of file values per vertex
+	bool vectors; // Flag if the attribute is a vector attribute filling four slices
+	int sliceIndex; // Index of the first slice receiving the attribute
+	int compactEncoding; // Compact encoding for the attribute's slices, or -1 to store them in full
+	
+	/* Constructors and destructors: */
+	public:
+	AttributeLoader(DS& sDataSet,const std::string& sFileName,IO::SeekableFile::Offset sDataOffset,const std::string& sAttributeName,const std::string& sDataType,int sNumComponents,bool sVectors,int sSliceIndex,int sCompactEncoding)
+		:dataSet(sDataSet),fileName(sFileName),dataOffset(sDataOffset),
+		 attributeName(sAttributeName),dataType(sDataType),
+		 numComponents(sNumComponents),vectors(sVectors),sliceIndex(sSliceIndex),
+		 compactEncoding(sCompactEncoding)
 		{
-		for(index[1]=0;index[1]<size[1];++index[1])
-			for(index[0]=0;index[0]<size[0];++index[0])
+		}
+	
+	/* Methods from DataValue::SliceLoader: */
+	virtual size_t loadSlices(void)
+		{
+		/* Allocate the attribute's slices: */
+		int numSlices=vectors?4:1;
+		for(int i=0;i<numSlices;++i)
+			dataSet.allocateSlice(sliceIndex+i);
+		
+		/* Re-open the VTK file and read the attribute's values: */
+		IO::SeekableFilePtr file(IO::openSeekableFile(fileName.c_str()));
+		file->setReadPosAbs(dataOffset);
+		if(vectors)
+			{
+			std::cout<<"Loading vector attribute "<<attributeName<<"...   0%"<<std::flush;
+			VectorScatterer scatterer(dataSet,sliceIndex);
+			readBinaryAttribute(*file,dataType,dataSet.getNumVertices(),numComponents,scatterer,true);
+			}
+		else
+			{
+			std::cout<<"Loading scalar attribute "<<attributeName<<"...   0%"<<std::flush;
+			ScalarScatterer scatterer(dataSet,sliceIndex);
+			readBinaryAttribute(*file,dataType,dataSet.getNumVertices(),numComponents,scatterer,true);
+			}
+		
+		if(compactEncoding>=0)
+			{
+			/* Replace the attribute's slices with their compact representations: */
+			size_t memorySize=0;
+			for(int i=0;i<numSlices;++i)
 				{
-				/* Reand and store the next scalar attribute: */
-				dataSet.getVertexValue(sliceIndex,index)=DS::ValueScalar(file.read<FileValue>());
-				file.skip<FileValue>(attributeNumScalars-1);
+				dataSet.compactSlice(sliceIndex+i,Visualization::Templatized::CompactSlice::Encoding(compactEncoding));
+				memorySize+=dataSet.getCompactSlice(sliceIndex+i)->getMemorySize();
 				}
-		if(master)
-			std::cout<<"\b\b\b\b"<<std::setw(3)<<((index[2]+1)*100+size[2]/2)/size[2]<<"%"<<std::flush;
+			return memorySize;
+			}
+		else
+			return size_t(numSlices)*size_t(dataSet.getNumVertices().calcIncrement(-1))*sizeof(DS::ValueScalar);
 		}
-	if(master)
-		std::cout<<"\b\b\b\bdone"<<std::endl;
-	}
+	virtual void releaseSlices(void)
+		{
+		int numSlices=vectors?4:1;
+		for(int i=0;i<numSlices;++i)
+			dataSet.releaseSlice(sliceIndex+i);
+		}
+	};
 
 }
 
@@ -167,6 +448,28 @@ Visualization::Abstract::DataSet* StructuredGridVTK::load(const std::vector<std:
 	{
 	bool master=pipe==0||pipe->isMaster();
 	
+	/* Parse the module arguments: */
+	bool loadAll=false;
+	size_t variableMemory=0;
+	int compactEncoding=-1;
+	for(std::vector<std::string>::const_iterator aIt=args.begin()+1;aIt!=args.end();++aIt)
+		{
+		if(strcasecmp(aIt->c_str(),"-loadAll")==0)
+			loadAll=true;
+		else if(strcasecmp(aIt->c_str(),"-variableMemory")==0&&aIt+1!=args.end())
+			{
+			++aIt;
+			variableMemory=size_t(atoi(aIt->c_str()))*size_t(1024*1024);
+			}
+		else if(strcasecmp(aIt->c_str(),"-compactSlices")==0&&aIt+1!=args.end())
+			{
+			++aIt;
+			compactEncoding=Visualization::Templatized::CompactSlice::parseEncoding(aIt->c_str());
+			if(compactEncoding<0)
+				Misc::throwStdErr("StructuredGridVTK::load: unknown compact slice encoding %s",aIt->c_str());
+			}
+		}
+	
 	/* Create the result data set: */
 	Misc::SelfDestructPointer<DataSet> result(new DataSet);
 	DS& dataSet=result->getDs();
@@ -174,6 +477,11 @@ Visualization::Abstract::DataSet* StructuredGridVTK::load(const std::vector<std:
 	/* Open the input file: */
 	IO::FilePtr file(openFile(args[0],pipe));
 	
+	/* Binary point attributes in seekable files are read on first use when running on a single machine: */
+	IO::SeekableFile* seekableFile=0;
+	if(pipe==0&&!loadAll)
+		seekableFile=dynamic_cast<IO::SeekableFile*>(file.getPointer());
+	
 	/* Attach a value source to the file to read the header: */
 	DS::Index numVertices;
 	bool binary=false;
@@ -248,27 +556,10 @@ Visualization::Abstract::DataSet* StructuredGridVTK::load(const std::vector<std:
 	/* Read the grid points: */
 	if(binary)
 		{
-		if(gridPointDataType=="unsigned_char")
-			readVertexPositions<Misc::UInt8>(dataSet,*file,master);
-		else if(gridPointDataType=="char")
-			readVertexPositions<Misc::SInt8>(dataSet,*file,master);
-		else if(gridPointDataType=="unsigned_short")
-			readVertexPositions<Misc::UInt16>(dataSet,*file,master);
-		else if(gridPointDataType=="short")
-			readVertexPositions<Misc::SInt16>(dataSet,*file,master);
-		else if(gridPointDataType=="unsigned_int")
-			readVertexPositions<Misc::UInt32>(dataSet,*file,master);
-		else if(gridPointDataType=="int")
-			readVertexPositions<Misc::SInt32>(dataSet,*file,master);
-		else if(gridPointDataType=="unsigned_long")
-			readVertexPositions<Misc::UInt64>(dataSet,*file,master);
-		else if(gridPointDataType=="long")
-			readVertexPositions<Misc::SInt64>(dataSet,*file,master);
-		else if(gridPointDataType=="float")
-			readVertexPositions<Misc::Float32>(dataSet,*file,master);
-		else if(gridPointDataType=="double")
-			readVertexPositions<Misc::Float64>(dataSet,*file,master);
-		else
+		if(master)
+			std::cout<<"Reading grid vertices...   0%"<<std::flush;
+		PositionScatterer scatterer(dataSet);
+		if(!readBinaryAttribute(*file,gridPointDataType,numVertices,3,scatterer,master))
 			Misc::throwStdErr("StructuredGridVTK::load: unsupported grid point data type %s",gridPointDataType.c_str());
 		}
 	else
@@ -310,6 +601,8 @@ Visualization::Abstract::DataSet* StructuredGridVTK::load(const std::vector<std:
 	/* Initialize the result data set's data value: */
 	DataValue& dataValue=result->getDataValue();
 	dataValue.initialize(&dataSet,0);
+	dataValue.setMemoryBudget(variableMemory);
+	bool deferAttributes=binary&&seekableFile!=0;
 	
 	/* Read all point attributes stored in the file: */
 	while(true)
@@ -349,7 +642,10 @@ Visualization::Abstract::DataSet* StructuredGridVTK::load(const std::vector<std:
 		if(attributeType=="SCALARS")
 			{
 			/* Add another slice to the data set: */
-			dataSet.addSlice();
+			if(deferAttributes)
+				dataSet.addDeferredSlice();
+			else
+				dataSet.addSlice();
 			
 			/* Add another scalar variable to the data value: */
 			dataValue.addScalarVariable(attributeName.c_str());
@@ -363,7 +659,10 @@ Visualization::Abstract::DataSet* StructuredGridVTK::load(const std::vector<std:
 			/* Add four new slices to the data set (three components plus magnitude): */
 			for(int i=0;i<4;++i)
 				{
-				dataSet.addSlice();
+				if(deferAttributes)
+					dataSet.addDeferredSlice();
+				else
+					dataSet.addSlice();
 				int variableIndex=dataValue.addScalarVariable(makeVectorSliceName(attributeName,i).c_str());
 				if(i<3)
 					dataValue.setVectorVariableScalarIndex(vectorVariableIndex,i,variableIndex);
@@ -373,56 +672,41 @@ Visualization::Abstract::DataSet* StructuredGridVTK::load(const std::vector<std:
 			Misc::throwStdErr("StructuredGridVTK::load: VTK data file %s has unknown point attribute type %s",args[0].c_str(),attributeType.c_str());
 		
 		/* Read the vertex attributes: */
-		if(binary)
+		if(deferAttributes)
+			{
+			/* Check the attribute's data type: */
+			size_t typeSize=getBinaryTypeSize(attributeScalarType);
+			if(typeSize==0)
+				Misc::throwStdErr("StructuredGridVTK::load: unsupported attribute scalar data type %s in attribute %s",attributeScalarType.c_str(),attributeName.c_str());
+			
+			/* Register a loader for the attribute's slices: */
+			int numComponents=attributeVectors?3:attributeNumScalars;
+			IO::SeekableFile::Offset dataOffset=seekableFile->getReadPos();
+			AttributeLoader* loader=new AttributeLoader(dataSet,getFullPath(args[0]),dataOffset,attributeName,attributeScalarType,numComponents,attributeVectors,sliceIndex,compactEncoding);
+			int numSlices=attributeVectors?4:1;
+			for(int i=0;i<numSlices;++i)
+				dataValue.setSliceLoader(sliceIndex+i,loader);
+			
+			/* Skip the attribute's values: */
+			size_t dataSize=size_t(numVertices.calcIncrement(-1))*size_t(numComponents)*typeSize;
+			seekableFile->setReadPosAbs(dataOffset+IO::SeekableFile::Offset(dataSize));
+			}
+		else if(binary)
 			{
 			if(attributeVectors)
 				{
-				if(attributeScalarType=="unsigned_char")
-					readVectorAttributes<Misc::UInt8>(dataSet,attributeName,sliceIndex,*file,master);
-				else if(attributeScalarType=="char")
-					readVectorAttributes<Misc::SInt8>(dataSet,attributeName,sliceIndex,*file,master);
-				else if(attributeScalarType=="unsigned_short")
-					readVectorAttributes<Misc::UInt16>(dataSet,attributeName,sliceIndex,*file,master);
-				else if(attributeScalarType=="short")
-					readVectorAttributes<Misc::SInt16>(dataSet,attributeName,sliceIndex,*file,master);
-				else if(attributeScalarType=="unsigned_int")
-					readVectorAttributes<Misc::UInt32>(dataSet,attributeName,sliceIndex,*file,master);
-				else if(attributeScalarType=="int")
-					readVectorAttributes<Misc::SInt32>(dataSet,attributeName,sliceIndex,*file,master);
-				else if(attributeScalarType=="unsigned_long")
-					readVectorAttributes<Misc::UInt64>(dataSet,attributeName,sliceIndex,*file,master);
-				else if(attributeScalarType=="long")
-					readVectorAttributes<Misc::SInt64>(dataSet,attributeName,sliceIndex,*file,master);
-				else if(attributeScalarType=="float")
-					readVectorAttributes<Misc::Float32>(dataSet,attributeName,sliceIndex,*file,master);
-				else if(attributeScalarType=="double")
-					readVectorAttributes<Misc::Float64>(dataSet,attributeName,sliceIndex,*file,master);
-				else
+				if(master)
+					std::cout<<"Reading vector attribute "<<attributeName<<"...   0%"<<std::flush;
+				VectorScatterer scatterer(dataSet,sliceIndex);
+				if(!readBinaryAttribute(*file,attributeScalarType,numVertices,3,scatterer,master))
 					Misc::throwStdErr("StructuredGridVTK::load: unsupported attribute scalar data type %s in vector attribute %s",attributeScalarType.c_str(),attributeName.c_str());
 				}
 			else
 				{
-				if(attributeScalarType=="unsigned_char")
-					readScalarAttributes<Misc::UInt8>(dataSet,attributeName,attributeNumScalars,sliceIndex,*file,master);
-				else if(attributeScalarType=="char")
-					readScalarAttributes<Misc::SInt8>(dataSet,attributeName,attributeNumScalars,sliceIndex,*file,master);
-				else if(attributeScalarType=="unsigned_short")
-					readScalarAttributes<Misc::UInt16>(dataSet,attributeName,attributeNumScalars,sliceIndex,*file,master);
-				else if(attributeScalarType=="short")
-					readScalarAttributes<Misc::SInt16>(dataSet,attributeName,attributeNumScalars,sliceIndex,*file,master);
-				else if(attributeScalarType=="unsigned_int")
-					readScalarAttributes<Misc::UInt32>(dataSet,attributeName,attributeNumScalars,sliceIndex,*file,master);
-				else if(attributeScalarType=="int")
-					readScalarAttributes<Misc::SInt32>(dataSet,attributeName,attributeNumScalars,sliceIndex,*file,master);
-				else if(attributeScalarType=="unsigned_long")
-					readScalarAttributes<Misc::UInt64>(dataSet,attributeName,attributeNumScalars,sliceIndex,*file,master);
-				else if(attributeScalarType=="long")
-					readScalarAttributes<Misc::SInt64>(dataSet,attributeName,attributeNumScalars,sliceIndex,*file,master);
-				else if(attributeScalarType=="float")
-					readScalarAttributes<Misc::Float32>(dataSet,attributeName,attributeNumScalars,sliceIndex,*file,master);
-				else if(attributeScalarType=="double")
-					readScalarAttributes<Misc::Float64>(dataSet,attributeName,attributeNumScalars,sliceIndex,*file,master);
-				else
+				if(master)
+					std::cout<<"Reading "<<attributeNumScalars<<"-component scalar attribute "<<attributeName<<"...   0%"<<std::flush;
+				ScalarScatterer scatterer(dataSet,sliceIndex);
+				if(!readBinaryAttribute(*file,attributeScalarType,numVertices,attributeNumScalars,scatterer,master))
 					Misc::throwStdErr("StructuredGridVTK::load: unsupported attribute scalar data type %s in scalar attribute %s",attributeScalarType.c_str(),attributeName.c_str());
 				}
 			}
@@ -479,6 +763,14 @@ Visualization::Abstract::DataSet* StructuredGridVTK::load(const std::vector<std:
 			if(master)
 				std::cout<<"\b\b\b\bdone"<<std::endl;
 			}
+		
+		if(!deferAttributes&&compactEncoding>=0)
+			{
+			/* Replace the attribute's slices with their compact representations: */
+			int numSlices=attributeVectors?4:1;
+			for(int i=0;i<numSlices;++i)
+				dataSet.compactSlice(sliceIndex+i,Visualization::Templatized::CompactSlice::Encoding(compactEncoding));
+			}
 		}
 	
 	/* Return the result data set: */
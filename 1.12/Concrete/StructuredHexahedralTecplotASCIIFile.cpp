@@ -194,7 +194,6 @@ Visualization::Abstract::DataSet* StructuredHexahedralTecplotASCIIFile::load(con
 	/* Read zones from the file until end-of-file: */
 	if(master)
 		std::cout<<"Reading input file "<<parser.getTitle()<<std::endl;
-	double* columnBuffer=new double[numVariables];
 	int zoneIndex=0;
 	while(true)
 		{
@@ -212,8 +211,8 @@ Visualization::Abstract::DataSet* StructuredHexahedralTecplotASCIIFile::load(con
 		int gridIndex=dataSet.addGrid(numZoneVertices);
 		DS::Grid& grid=dataSet.getGrid(gridIndex);
 		
-		/* Read all grid vertices and scalar values for the zone: */
-		parser.setWhitespace('\n',false);
+		/* Read all grid vertices and scalar values for the zone, one vertex per line: */
+		parser.startRecords(size_t(numZoneVertices.calcIncrement(-1)),numVariables,true,ignoreFlags);
 		int index0Start=0;
 		int index0End=numZoneVertices[0];
 		int index0Inc=1;
@@ -230,11 +229,10 @@ Visualization::Abstract::DataSet* StructuredHexahedralTecplotASCIIFile::load(con
 				for(index[2]=0;index[2]<numZoneVertices[2];++index[2],++line)
 					{
 					/* Parse the line: */
+					const double* columnBuffer=0;
 					try
 						{
-						parser.readDoubles(numVariables,ignoreFlags,columnBuffer);
-						parser.skipLine();
-						parser.skipWs();
+						columnBuffer=parser.readRecord();
 						}
 					catch(std::runtime_error err)
 						{
@@ -263,7 +261,6 @@ Visualization::Abstract::DataSet* StructuredHexahedralTecplotASCIIFile::load(con
 						dataSet.getVertexValue(vectorSliceIndices[i*4+3],gridIndex,index)=vector.mag();
 						}
 					}
-		parser.setWhitespace('\n',true);
 		if(master)
 			std::cout<<" done"<<std::endl;
 		
@@ -278,7 +275,6 @@ Visualization::Abstract::DataSet* StructuredHexahedralTecplotASCIIFile::load(con
 	delete[] scalarSliceIndices;
 	delete[] vectorColumnIndices;
 	delete[] vectorSliceIndices;
-	delete[] columnBuffer;
 	
 	/* Finalize the grid structure: */
 	if(master)
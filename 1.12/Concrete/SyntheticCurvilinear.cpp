@@ -0,0 +1,92 @@
+/***********************************************************************
+SyntheticCurvilinear - Visualization module creating synthetic
+curvilinear data sets of configurable size from analytic scalar and
+vector fields with turbulence.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Plugins/FactoryManager.h>
+
+#include <Wrappers/CurvilinearIncludes.h>
+#include <Wrappers/ScalarVectorValue.h>
+#include <Concrete/SyntheticModule.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+namespace {
+
+/* Basic type declarations: */
+typedef float Scalar; // Scalar type of data set domain
+typedef float VScalar; // Scalar type of data set value
+typedef Visualization::Wrappers::ScalarVectorValue<VScalar,3> Value; // Memory representation of data set value
+typedef Visualization::Templatized::Curvilinear<Scalar,3,Value> DS; // Templatized data set type
+typedef Visualization::Wrappers::ScalarVectorDataValue<DS,VScalar> DataValue; // Type of data value descriptor
+typedef SyntheticModule<DS,DataValue> SyntheticCurvilinear; // Module class type
+
+}
+
+/*************************************
+Methods of class SyntheticCurvilinear:
+*************************************/
+
+template <>
+void SyntheticCurvilinear::createDataSet(SyntheticCurvilinear::DataSet& result,const SyntheticField::Arguments& arguments,const SyntheticField& field) const
+	{
+	/* Create the grid: */
+	result.getDataValue().setScalarVariableName("Scalar");
+	result.getDataValue().setVectorVariableName("Vector");
+	DS& dataSet=result.getDs();
+	DS::Index numVertices(arguments.numVertices[0],arguments.numVertices[1],arguments.numVertices[2]);
+	dataSet.setData(numVertices);
+	
+	/* Place all grid vertices and evaluate the synthetic fields at their positions: */
+	for(DS::Index index(0);index[0]<numVertices[0];index.preInc(numVertices))
+		{
+		SyntheticField::Point p=SyntheticField::calcGridPosition(index.getComponents(),numVertices.getComponents(),arguments.curved);
+		dataSet.getVertexPosition(index)=DS::Point(p);
+		calcValue(field,p,dataSet.getVertexValue(index));
+		}
+	
+	/* Finalize the grid structure: */
+	dataSet.finalizeGrid();
+	}
+
+}
+
+}
+
+/***************************
+Plug-in interface functions:
+***************************/
+
+extern "C" Visualization::Abstract::Module* createFactory(Plugins::FactoryManager<Visualization::Abstract::Module>& manager)
+	{
+	/* Create module object and insert it into class hierarchy: */
+	Visualization::Concrete::SyntheticCurvilinear* module=new Visualization::Concrete::SyntheticCurvilinear("SyntheticCurvilinear");
+	
+	/* Return module object: */
+	return module;
+	}
+
+extern "C" void destroyFactory(Visualization::Abstract::Module* module)
+	{
+	delete module;
+	}
@@ -0,0 +1,140 @@
+/***********************************************************************
+SyntheticField - Class to evaluate reproducible synthetic scalar and
+vector fields inside the unit cube by combining analytic functions with
+Perlin turbulence, to create data sets of arbitrary size for performance
+measurements.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Concrete/SyntheticField.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <Misc/ThrowStdErr.h>
+#include <Math/Math.h>
+#include <Math/Constants.h>
+
+#include <Concrete/Noise.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+/******************************************
+Methods of class SyntheticField::Arguments:
+******************************************/
+
+SyntheticField::Arguments::Arguments(const std::vector<std::string>& args,const char* moduleClassName)
+	:seed(1U),curved(false)
+	{
+	/* Parse the module arguments: */
+	int numSizes=0;
+	for(std::vector<std::string>::const_iterator aIt=args.begin();aIt!=args.end();++aIt)
+		{
+		if((*aIt)[0]=='-')
+			{
+			if(strcasecmp(aIt->c_str()+1,"seed")==0&&aIt+1!=args.end())
+				{
+				++aIt;
+				seed=(unsigned int)atoi(aIt->c_str());
+				}
+			else if(strcasecmp(aIt->c_str()+1,"curved")==0)
+				curved=true;
+			else
+				Misc::throwStdErr("%s::load: Unrecognized option %s",moduleClassName,aIt->c_str());
+			}
+		else if(numSizes<3)
+			{
+			numVertices[numSizes]=atoi(aIt->c_str());
+			++numSizes;
+			}
+		else
+			Misc::throwStdErr("%s::load: Extra argument %s",moduleClassName,aIt->c_str());
+		}
+	
+	/* A single size applies to all axes: */
+	if(numSizes==1)
+		numVertices[2]=numVertices[1]=numVertices[0];
+	else if(numSizes!=3)
+		Misc::throwStdErr("%s::load: Data set size must be given as one or three numbers of vertices",moduleClassName);
+	for(int i=0;i<3;++i)
+		if(numVertices[i]<2)
+			Misc::throwStdErr("%s::load: Data set must have at least two vertices along each axis",moduleClassName);
+	}
+
+/*******************************
+Methods of class SyntheticField:
+*******************************/
+
+SyntheticField::SyntheticField(unsigned int seed)
+	:noise(0)
+	{
+	/* Seed the random number generator used to fill the noise array to make the fields reproducible: */
+	srand(seed);
+	noise=new Noise(5);
+	}
+
+SyntheticField::~SyntheticField(void)
+	{
+	delete noise;
+	}
+
+SyntheticField::Point SyntheticField::calcGridPosition(const int index[3],const int numVertices[3],bool curved)
+	{
+	/* Place the vertex on a regular lattice spanning the unit cube: */
+	float u[3];
+	for(int i=0;i<3;++i)
+		u[i]=float(index[i])/float(numVertices[i]-1);
+	if(!curved)
+		return Point(u[0],u[1],u[2]);
+	
+	/* Displace the vertex by a smooth warp that keeps the domain boundary and does not fold the grid: */
+	const float a=0.05f;
+	const float pi=Math::Constants<float>::pi;
+	Point result;
+	for(int i=0;i<3;++i)
+		result[i]=u[i]+a*Math::sin(pi*u[i])*Math::sin(2.0f*pi*u[(i+1)%3]);
+	return result;
+	}
+
+float SyntheticField::calcScalar(const SyntheticField::Point& p) const
+	{
+	/* Perturb the distance from the domain center by turbulence to create nested, wrinkled shells: */
+	Vector d=p-Point(0.5f,0.5f,0.5f);
+	Point np(p[0]*8.0f,p[1]*8.0f,p[2]*8.0f);
+	return d.mag()+0.2f*noise->calcTurbulence(np,4);
+	}
+
+SyntheticField::Vector SyntheticField::calcVector(const SyntheticField::Point& p) const
+	{
+	/* Combine a vortex around the vertical axis with an upward flow and turbulence: */
+	Vector result(0.5f-p[1],p[0]-0.5f,0.25f);
+	for(int i=0;i<3;++i)
+		{
+		/* Sample the noise at different offsets for each vector component: */
+		Point np(p[0]*8.0f,p[1]*8.0f,p[2]*8.0f);
+		np[i]+=float(11+i*2);
+		result[i]+=0.25f*noise->calcTurbulence(np,4);
+		}
+	return result;
+	}
+
+}
+
+}
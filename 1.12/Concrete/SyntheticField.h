@@ -0,0 +1,86 @@
+/***********************************************************************
+SyntheticField - Class to evaluate reproducible synthetic scalar and
+vector fields inside the unit cube by combining analytic functions with
+Perlin turbulence, to create data sets of arbitrary size for performance
+measurements.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_CONCRETE_SYNTHETICFIELD_INCLUDED
+#define VISUALIZATION_CONCRETE_SYNTHETICFIELD_INCLUDED
+
+#include <string>
+#include <vector>
+#include <Geometry/Point.h>
+#include <Geometry/Vector.h>
+
+/* Forward declarations: */
+namespace Visualization {
+namespace Concrete {
+class Noise;
+}
+}
+
+namespace Visualization {
+
+namespace Concrete {
+
+class SyntheticField
+	{
+	/* Embedded classes: */
+	public:
+	typedef Geometry::Point<float,3> Point;
+	typedef Geometry::Vector<float,3> Vector;
+	
+	struct Arguments // Structure for the command line arguments shared by all synthetic data set modules
+		{
+		/* Elements: */
+		public:
+		int numVertices[3]; // Number of grid vertices along each axis
+		unsigned int seed; // Seed for the random number generator creating the turbulence
+		bool curved; // Flag whether grid vertices are displaced from a regular lattice in grid types that support it
+		
+		/* Constructors and destructors: */
+		Arguments(const std::vector<std::string>& args,const char* moduleClassName); // Parses the given module command line
+		};
+	
+	/* Elements: */
+	private:
+	Noise* noise; // Perlin noise generator for the turbulent parts of the fields
+	
+	/* Constructors and destructors: */
+	public:
+	SyntheticField(unsigned int seed); // Creates the fields for the given random seed
+	private:
+	SyntheticField(const SyntheticField& source); // Prohibit copy constructor
+	SyntheticField& operator=(const SyntheticField& source); // Prohibit assignment operator
+	public:
+	~SyntheticField(void);
+	
+	/* Methods: */
+	static Point calcGridPosition(const int index[3],const int numVertices[3],bool curved); // Returns the position of the grid vertex of the given index inside the unit cube
+	float calcScalar(const Point& p) const; // Returns the scalar field at the given position
+	Vector calcVector(const Point& p) const; // Returns the vector field at the given position
+	};
+
+}
+
+}
+
+#endif
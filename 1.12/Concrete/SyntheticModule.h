@@ -0,0 +1,83 @@
+/***********************************************************************
+SyntheticModule - Base class for visualization modules creating
+synthetic data sets of configurable size and of a given data set type
+from analytic scalar and vector fields with turbulence.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_CONCRETE_SYNTHETICMODULE_INCLUDED
+#define VISUALIZATION_CONCRETE_SYNTHETICMODULE_INCLUDED
+
+#include <Wrappers/Module.h>
+
+#include <Concrete/SyntheticField.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+template <class DSParam,class DataValueParam>
+class SyntheticModule:public Visualization::Wrappers::Module<DSParam,DataValueParam>
+	{
+	/* Embedded classes: */
+	public:
+	typedef Visualization::Wrappers::Module<DSParam,DataValueParam> BaseModule; // Module base class type
+	typedef typename BaseModule::DS DS; // Templatized data set type
+	typedef typename BaseModule::DataValue DataValue; // Data value descriptor type
+	typedef typename BaseModule::VScalar VScalar; // Data type for scalar values
+	typedef typename BaseModule::DataSet DataSet; // Data set class
+	
+	/* Private methods: */
+	private:
+	template <class ValueParam>
+	static void calcValue(const SyntheticField& field,const SyntheticField::Point& p,ValueParam& value) // Stores the synthetic fields at the given position in a combined scalar and vector value
+		{
+		value.scalar=VScalar(field.calcScalar(p));
+		SyntheticField::Vector v=field.calcVector(p);
+		for(int i=0;i<3;++i)
+			value.vector[i]=VScalar(v[i]);
+		}
+	static void calcSliceValues(const SyntheticField& field,const SyntheticField::Point& p,VScalar sliceValues[5]) // Stores the synthetic fields at the given position as scalar, vector component, and vector magnitude slice values
+		{
+		sliceValues[0]=VScalar(field.calcScalar(p));
+		SyntheticField::Vector v=field.calcVector(p);
+		for(int i=0;i<3;++i)
+			sliceValues[1+i]=VScalar(v[i]);
+		sliceValues[4]=VScalar(v.mag());
+		}
+	void addSliceVariables(DataSet& dataSet) const; // Defines a scalar variable and a vector variable stored as three component slices plus a magnitude slice in a sliced data set
+	void createDataSet(DataSet& dataSet,const SyntheticField::Arguments& arguments,const SyntheticField& field) const; // Creates the data set's grid and evaluates the synthetic fields at its vertices; specialized for each data set type
+	
+	/* Constructors and destructors: */
+	public:
+	SyntheticModule(const char* sClassName); // Creates a synthetic data set module of the given class name
+	
+	/* Methods: */
+	virtual Visualization::Abstract::DataSet* load(const std::vector<std::string>& args,Cluster::MulticastPipe* pipe) const;
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_CONCRETE_SYNTHETICMODULE_IMPLEMENTATION
+#include <Concrete/SyntheticModule.icpp>
+#endif
+
+#endif
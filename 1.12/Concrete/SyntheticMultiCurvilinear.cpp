@@ -0,0 +1,109 @@
+/***********************************************************************
+SyntheticMultiCurvilinear - Visualization module creating synthetic
+multi-block curvilinear data sets of configurable size from analytic
+scalar and vector fields with turbulence.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Misc/ThrowStdErr.h>
+#include <Plugins/FactoryManager.h>
+
+#include <Wrappers/MultiCurvilinearIncludes.h>
+#include <Wrappers/ScalarVectorValue.h>
+#include <Concrete/SyntheticModule.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+namespace {
+
+/* Basic type declarations: */
+typedef float Scalar; // Scalar type of data set domain
+typedef float VScalar; // Scalar type of data set value
+typedef Visualization::Wrappers::ScalarVectorValue<VScalar,3> Value; // Memory representation of data set value
+typedef Visualization::Templatized::MultiCurvilinear<Scalar,3,Value> DS; // Templatized data set type
+typedef Visualization::Wrappers::ScalarVectorDataValue<DS,VScalar> DataValue; // Type of data value descriptor
+typedef SyntheticModule<DS,DataValue> SyntheticMultiCurvilinear; // Module class type
+
+}
+
+/******************************************
+Methods of class SyntheticMultiCurvilinear:
+******************************************/
+
+template <>
+void SyntheticMultiCurvilinear::createDataSet(SyntheticMultiCurvilinear::DataSet& result,const SyntheticField::Arguments& arguments,const SyntheticField& field) const
+	{
+	/* Create the grids: */
+	result.getDataValue().setScalarVariableName("Scalar");
+	result.getDataValue().setVectorVariableName("Vector");
+	DS& dataSet=result.getDs();
+	DS::Index numVertices(arguments.numVertices[0],arguments.numVertices[1],arguments.numVertices[2]);
+	
+	/* Split the domain into two grids along the first axis that share their boundary vertices: */
+	int splitIndex=(numVertices[0]-1)/2;
+	if(splitIndex<1)
+		Misc::throwStdErr("%s::load: Data set must have at least three vertices along the first axis",getClassName());
+	int gridOffsets[2]={0,splitIndex};
+	DS::Index gridSizes[2];
+	gridSizes[0]=DS::Index(splitIndex+1,numVertices[1],numVertices[2]);
+	gridSizes[1]=DS::Index(numVertices[0]-splitIndex,numVertices[1],numVertices[2]);
+	dataSet.setGrids(2);
+	for(int gridIndex=0;gridIndex<2;++gridIndex)
+		{
+		dataSet.setGridData(gridIndex,gridSizes[gridIndex]);
+		
+		/* Place all grid vertices and evaluate the synthetic fields at their positions: */
+		DS::Grid& grid=dataSet.getGrid(gridIndex);
+		for(DS::Index index(0);index[0]<gridSizes[gridIndex][0];index.preInc(gridSizes[gridIndex]))
+			{
+			DS::Index globalIndex=index;
+			globalIndex[0]+=gridOffsets[gridIndex];
+			SyntheticField::Point p=SyntheticField::calcGridPosition(globalIndex.getComponents(),numVertices.getComponents(),arguments.curved);
+			grid.getVertexPosition(index)=DS::Point(p);
+			calcValue(field,p,grid.getVertexValue(index));
+			}
+		}
+	
+	/* Finalize the grid structure: */
+	dataSet.finalizeGrid();
+	}
+
+}
+
+}
+
+/***************************
+Plug-in interface functions:
+***************************/
+
+extern "C" Visualization::Abstract::Module* createFactory(Plugins::FactoryManager<Visualization::Abstract::Module>& manager)
+	{
+	/* Create module object and insert it into class hierarchy: */
+	Visualization::Concrete::SyntheticMultiCurvilinear* module=new Visualization::Concrete::SyntheticMultiCurvilinear("SyntheticMultiCurvilinear");
+	
+	/* Return module object: */
+	return module;
+	}
+
+extern "C" void destroyFactory(Visualization::Abstract::Module* module)
+	{
+	delete module;
+	}
@@ -0,0 +1,116 @@
+/***********************************************************************
+SyntheticSimplical - Visualization module creating synthetic tetrahedral
+data sets of configurable size from analytic scalar and vector fields
+with turbulence.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <vector>
+#include <Misc/ArrayIndex.h>
+#include <Plugins/FactoryManager.h>
+
+#include <Wrappers/SimplicalIncludes.h>
+#include <Wrappers/ScalarVectorValue.h>
+#include <Concrete/SyntheticModule.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+namespace {
+
+/* Basic type declarations: */
+typedef float Scalar; // Scalar type of data set domain
+typedef float VScalar; // Scalar type of data set value
+typedef Visualization::Wrappers::ScalarVectorValue<VScalar,3> Value; // Memory representation of data set value
+typedef Visualization::Templatized::Simplical<Scalar,3,Value> DS; // Templatized data set type
+typedef Visualization::Wrappers::ScalarVectorDataValue<DS,VScalar> DataValue; // Type of data value descriptor
+typedef SyntheticModule<DS,DataValue> SyntheticSimplical; // Module class type
+
+}
+
+/***********************************
+Methods of class SyntheticSimplical:
+***********************************/
+
+template <>
+void SyntheticSimplical::createDataSet(SyntheticSimplical::DataSet& result,const SyntheticField::Arguments& arguments,const SyntheticField& field) const
+	{
+	/* Create the grid: */
+	result.getDataValue().setScalarVariableName("Scalar");
+	result.getDataValue().setVectorVariableName("Vector");
+	DS& dataSet=result.getDs();
+	Misc::ArrayIndex<3> numVertices(arguments.numVertices[0],arguments.numVertices[1],arguments.numVertices[2]);
+	
+	/* Add all grid vertices with their synthetic field values: */
+	std::vector<DS::GridVertexIterator> vertices;
+	vertices.reserve(numVertices.calcIncrement(-1));
+	for(Misc::ArrayIndex<3> index(0);index[0]<numVertices[0];index.preInc(numVertices))
+		{
+		SyntheticField::Point p=SyntheticField::calcGridPosition(index.getComponents(),numVertices.getComponents(),arguments.curved);
+		Value value;
+		calcValue(field,p,value);
+		vertices.push_back(dataSet.addVertex(DS::Point(p),value));
+		}
+	
+	/* Split each cell of the vertex lattice into six tetrahedra around its main diagonal, which creates a conforming mesh: */
+	static const int axisOrders[6][3]={{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}};
+	Misc::ArrayIndex<3> numCells(numVertices[0]-1,numVertices[1]-1,numVertices[2]-1);
+	for(Misc::ArrayIndex<3> cellIndex(0);cellIndex[0]<numCells[0];cellIndex.preInc(numCells))
+		{
+		for(int tet=0;tet<6;++tet)
+			{
+			/* Walk from the cell's first corner to its opposite corner along the axes in the tetrahedron's order: */
+			DS::GridVertexIterator cellVertices[4];
+			Misc::ArrayIndex<3> corner=cellIndex;
+			cellVertices[0]=vertices[numVertices.calcOffset(corner)];
+			for(int i=0;i<3;++i)
+				{
+				++corner[axisOrders[tet][i]];
+				cellVertices[i+1]=vertices[numVertices.calcOffset(corner)];
+				}
+			dataSet.addCell(cellVertices);
+			}
+		}
+	
+	/* Finalize the grid structure: */
+	dataSet.finalizeGrid();
+	}
+
+}
+
+}
+
+/***************************
+Plug-in interface functions:
+***************************/
+
+extern "C" Visualization::Abstract::Module* createFactory(Plugins::FactoryManager<Visualization::Abstract::Module>& manager)
+	{
+	/* Create module object and insert it into class hierarchy: */
+	Visualization::Concrete::SyntheticSimplical* module=new Visualization::Concrete::SyntheticSimplical("SyntheticSimplical");
+	
+	/* Return module object: */
+	return module;
+	}
+
+extern "C" void destroyFactory(Visualization::Abstract::Module* module)
+	{
+	delete module;
+	}
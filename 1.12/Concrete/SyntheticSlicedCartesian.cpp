@@ -0,0 +1,92 @@
+/***********************************************************************
+SyntheticSlicedCartesian - Visualization module creating synthetic
+sliced Cartesian data sets of configurable size from analytic scalar and
+vector fields with turbulence.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Plugins/FactoryManager.h>
+
+#include <Wrappers/SlicedCartesianIncludes.h>
+#include <Wrappers/SlicedScalarVectorDataValue.h>
+#include <Concrete/SyntheticModule.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+namespace {
+
+/* Basic type declarations: */
+typedef float Scalar; // Scalar type of data set domain
+typedef float VScalar; // Scalar type of data set value
+typedef Visualization::Templatized::SlicedCartesian<Scalar,3,VScalar> DS; // Templatized data set type
+typedef Visualization::Wrappers::SlicedScalarVectorDataValue<DS,VScalar> DataValue; // Type of data value descriptor
+typedef SyntheticModule<DS,DataValue> SyntheticSlicedCartesian; // Module class type
+
+}
+
+/*****************************************
+Methods of class SyntheticSlicedCartesian:
+*****************************************/
+
+template <>
+void SyntheticSlicedCartesian::createDataSet(SyntheticSlicedCartesian::DataSet& result,const SyntheticField::Arguments& arguments,const SyntheticField& field) const
+	{
+	/* Create the grid and its variables: */
+	DS& dataSet=result.getDs();
+	DS::Index numVertices(arguments.numVertices[0],arguments.numVertices[1],arguments.numVertices[2]);
+	DS::Size cellSize;
+	for(int i=0;i<3;++i)
+		cellSize[i]=Scalar(1)/Scalar(numVertices[i]-1);
+	dataSet.setData(numVertices,cellSize,0);
+	addSliceVariables(result);
+	
+	/* Evaluate the synthetic fields at all grid vertices: */
+	for(DS::Index index(0);index[0]<numVertices[0];index.preInc(numVertices))
+		{
+		SyntheticField::Point p=SyntheticField::calcGridPosition(index.getComponents(),numVertices.getComponents(),false);
+		VScalar sliceValues[5];
+		calcSliceValues(field,p,sliceValues);
+		for(int i=0;i<5;++i)
+			dataSet.getVertexValue(i,index)=sliceValues[i];
+		}
+	}
+
+}
+
+}
+
+/***************************
+Plug-in interface functions:
+***************************/
+
+extern "C" Visualization::Abstract::Module* createFactory(Plugins::FactoryManager<Visualization::Abstract::Module>& manager)
+	{
+	/* Create module object and insert it into class hierarchy: */
+	Visualization::Concrete::SyntheticSlicedCartesian* module=new Visualization::Concrete::SyntheticSlicedCartesian("SyntheticSlicedCartesian");
+	
+	/* Return module object: */
+	return module;
+	}
+
+extern "C" void destroyFactory(Visualization::Abstract::Module* module)
+	{
+	delete module;
+	}
@@ -0,0 +1,109 @@
+/***********************************************************************
+SyntheticSlicedHypercubic - Visualization module creating synthetic
+sliced unstructured hexahedral data sets of configurable size from
+analytic scalar and vector fields with turbulence.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Misc/ArrayIndex.h>
+#include <Plugins/FactoryManager.h>
+
+#include <Wrappers/SlicedHypercubicIncludes.h>
+#include <Wrappers/SlicedScalarVectorDataValue.h>
+#include <Concrete/SyntheticModule.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+namespace {
+
+/* Basic type declarations: */
+typedef float Scalar; // Scalar type of data set domain
+typedef float VScalar; // Scalar type of data set value
+typedef Visualization::Templatized::SlicedHypercubic<Scalar,3,VScalar> DS; // Templatized data set type
+typedef Visualization::Wrappers::SlicedScalarVectorDataValue<DS,VScalar> DataValue; // Type of data value descriptor
+typedef SyntheticModule<DS,DataValue> SyntheticSlicedHypercubic; // Module class type
+
+}
+
+/******************************************
+Methods of class SyntheticSlicedHypercubic:
+******************************************/
+
+template <>
+void SyntheticSlicedHypercubic::createDataSet(SyntheticSlicedHypercubic::DataSet& result,const SyntheticField::Arguments& arguments,const SyntheticField& field) const
+	{
+	/* Create the grid's variables: */
+	DS& dataSet=result.getDs();
+	Misc::ArrayIndex<3> numVertices(arguments.numVertices[0],arguments.numVertices[1],arguments.numVertices[2]);
+	addSliceVariables(result);
+	
+	/* Add all grid vertices with their synthetic field values: */
+	for(Misc::ArrayIndex<3> index(0);index[0]<numVertices[0];index.preInc(numVertices))
+		{
+		SyntheticField::Point p=SyntheticField::calcGridPosition(index.getComponents(),numVertices.getComponents(),arguments.curved);
+		DS::VertexIndex vertexIndex=dataSet.addVertex(DS::Point(p)).getIndex();
+		VScalar sliceValues[5];
+		calcSliceValues(field,p,sliceValues);
+		for(int i=0;i<5;++i)
+			dataSet.setVertexValue(i,vertexIndex,sliceValues[i]);
+		}
+	
+	/* Add one hexahedron per cell of the vertex lattice, with vertices in the order of their index bits: */
+	Misc::ArrayIndex<3> numCells(numVertices[0]-1,numVertices[1]-1,numVertices[2]-1);
+	for(Misc::ArrayIndex<3> cellIndex(0);cellIndex[0]<numCells[0];cellIndex.preInc(numCells))
+		{
+		DS::VertexID cellVertices[8];
+		for(int i=0;i<8;++i)
+			{
+			Misc::ArrayIndex<3> corner=cellIndex;
+			for(int j=0;j<3;++j)
+				if(i&(1<<j))
+					++corner[j];
+			cellVertices[i]=DS::VertexID(DS::VertexIndex(numVertices.calcOffset(corner)));
+			}
+		dataSet.addCell(cellVertices);
+		}
+	
+	/* Finalize the grid structure: */
+	dataSet.finalizeGrid();
+	}
+
+}
+
+}
+
+/***************************
+Plug-in interface functions:
+***************************/
+
+extern "C" Visualization::Abstract::Module* createFactory(Plugins::FactoryManager<Visualization::Abstract::Module>& manager)
+	{
+	/* Create module object and insert it into class hierarchy: */
+	Visualization::Concrete::SyntheticSlicedHypercubic* module=new Visualization::Concrete::SyntheticSlicedHypercubic("SyntheticSlicedHypercubic");
+	
+	/* Return module object: */
+	return module;
+	}
+
+extern "C" void destroyFactory(Visualization::Abstract::Module* module)
+	{
+	delete module;
+	}
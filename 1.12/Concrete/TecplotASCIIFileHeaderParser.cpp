@@ -147,7 +147,7 @@ void TecplotASCIIFileHeaderParser::parseZone(void)
 	}
 
 TecplotASCIIFileHeaderParser::TecplotASCIIFileHeaderParser(IO::FilePtr source)
-	:IO::ValueSource(source)
+	:BulkValueSource(source)
 	{
 	/* Set the punctuation characters: */
 	setPunctuation("#,=");
@@ -220,23 +220,6 @@ bool TecplotASCIIFileHeaderParser::readNextZoneHeader(void)
 	return !eof();
 	}
 
-void TecplotASCIIFileHeaderParser::readDoubles(int numValues,const bool ignoreFlags[],double values[])
-	{
-	for(int i=0;i<numValues;++i)
-		{
-		if(ignoreFlags[i])
-			{
-			/* Skip the value: */
-			skipString();
-			}
-		else
-			{
-			/* Read, parse, and store the value: */
-			values[i]=readNumber();
-			}
-		}
-	}
-
 }
 
 }
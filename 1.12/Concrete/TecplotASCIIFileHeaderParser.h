@@ -25,13 +25,15 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <string>
 #include <vector>
-#include <IO/ValueSource.h>
+#include <IO/File.h>
+
+#include <Concrete/BulkValueSource.h>
 
 namespace Visualization {
 
 namespace Concrete {
 
-class TecplotASCIIFileHeaderParser:public IO::ValueSource
+class TecplotASCIIFileHeaderParser:public BulkValueSource
 	{
 	/* Embedded classes: */
 	public:
@@ -125,9 +127,6 @@ class TecplotASCIIFileHeaderParser:public IO::ValueSource
 		{
 		return zoneNumElements;
 		}
-	
-	/* Methods to read column values: */
-	void readDoubles(int numValues,const bool ignoreFlags[],double values[]); // Reads an array of double values, but ignores those values whose ignoreFlag is true
 	};
 
 }
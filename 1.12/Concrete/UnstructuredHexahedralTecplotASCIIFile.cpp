@@ -190,7 +190,6 @@ Visualization::Abstract::DataSet* UnstructuredHexahedralTecplotASCIIFile::load(c
 	/* Read zones from the file until end-of-file: */
 	if(master)
 		std::cout<<"Reading input file "<<parser.getTitle()<<std::endl;
-	double* columnBuffer=new double[numVariables];
 	while(true)
 		{
 		/* Check for the correct zone type and layout: */
@@ -210,12 +209,14 @@ Visualization::Abstract::DataSet* UnstructuredHexahedralTecplotASCIIFile::load(c
 		
 		/* Read all grid vertices and scalar values for the zone: */
 		DS::VertexIndex zoneVertexIndexBase=dataSet.getTotalNumVertices();
+		parser.startRecords(parser.getZoneNumVertices(),numVariables,false,ignoreFlags);
 		for(int i=0;i<parser.getZoneNumVertices();++i)
 			{
 			/* Parse the line: */
+			const double* columnBuffer=0;
 			try
 				{
-				parser.readDoubles(numVariables,ignoreFlags,columnBuffer);
+				columnBuffer=parser.readRecord();
 				}
 			catch(std::runtime_error err)
 				{
@@ -248,7 +249,7 @@ Visualization::Abstract::DataSet* UnstructuredHexahedralTecplotASCIIFile::load(c
 		/* Read all grid cells for the zone: */
 		for(int i=0;i<parser.getZoneNumElements();++i)
 			{
-			/* Parse the line: */
+			/* Parse the line's vertex indices as integers: */
 			int indexBuffer[8]={-1,-1,-1,-1,-1,-1,-1,-1};
 			try
 				{
@@ -260,6 +261,11 @@ Visualization::Abstract::DataSet* UnstructuredHexahedralTecplotASCIIFile::load(c
 				Misc::throwStdErr("UnstructuredHexahedralTecplotASCIIFile::load: %s while reading zone cells from file %s",err.what(),dataFileName);
 				}
 			
+			/* Reject vertex indices outside the zone's range of one-based vertex indices: */
+			for(int i=0;i<8;++i)
+				if(indexBuffer[i]<1||indexBuffer[i]>parser.getZoneNumVertices())
+					Misc::throwStdErr("UnstructuredHexahedralTecplotASCIIFile::load: Invalid vertex index %d while reading zone cells from file %s",indexBuffer[i],dataFileName);
+			
 			/* Read and unswizzle the cell vertex indices: */
 			static const int vertexOrder[8]={0,1,3,2,4,5,7,6}; // Tecplot's cube vertex counting order
 			DS::VertexID cellVertices[8];
@@ -282,7 +288,6 @@ Visualization::Abstract::DataSet* UnstructuredHexahedralTecplotASCIIFile::load(c
 	delete[] scalarSliceIndices;
 	delete[] vectorColumnIndices;
 	delete[] vectorSliceIndices;
-	delete[] columnBuffer;
 	
 	/* Finalize the grid structure: */
 	if(master)
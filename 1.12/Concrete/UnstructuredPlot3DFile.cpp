@@ -185,11 +185,13 @@ Visualization::Abstract::DataSet* UnstructuredPlot3DFile::load(const std::vector
 	char gridFilename[1024];
 	snprintf(gridFilename,sizeof(gridFilename),"%s.grid",args[0].c_str());
 	readGrid(&result->getDs(),gridFilename);
+	addSourceFile(gridFilename,false);
 	
 	/* Read the data values: */
 	char solutionFilename[1024];
 	snprintf(solutionFilename,sizeof(solutionFilename),"%s.sol",args[0].c_str());
 	readData(&result->getDs(),solutionFilename);
+	addSourceFile(solutionFilename,false);
 	
 	return result;
 	}
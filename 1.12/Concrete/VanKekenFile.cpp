@@ -112,7 +112,9 @@ Visualization::Abstract::DataSet* VanKekenFile::load(const std::vector<std::stri
 		{
 		/* Open the grid and data files: */
 		Misc::File gridFile(args[0].c_str(),"rb",Misc::File::LittleEndian);
+		addSourceFile(args[0],false);
 		Misc::File dataFile(args[1].c_str(),"rb",Misc::File::LittleEndian);
+		addSourceFile(args[1],false);
 		
 		/* Read the grid/data file header: */
 		int numGrids=gridFile.read<int>();
@@ -268,6 +270,7 @@ Visualization::Abstract::DataSet* VanKekenFile::load(const std::vector<std::stri
 			char radiusFileName[2048];
 			snprintf(radiusFileName,sizeof(radiusFileName),"%s/%s",args[0].c_str(),dirEntry->d_name);
 			Misc::File radiusFile(radiusFileName,"rt");
+			addSourceFile(radiusFileName,false);
 			while(true)
 				{
 				double radius;
@@ -339,6 +342,7 @@ Visualization::Abstract::DataSet* VanKekenFile::load(const std::vector<std::stri
 		char coordFileName[2048];
 		snprintf(coordFileName,sizeof(coordFileName),"%s/%s",args[0].c_str(),coordFiles[gridIndex].fileName.c_str());
 		Misc::File coordFile(coordFileName,"rt");
+		addSourceFile(coordFileName,false);
 		LongLat* longLats=new LongLat[gridSize[1]*gridSize[0]];
 		for(int i=0;i<gridSize[1]*gridSize[0];++i)
 			{
@@ -366,6 +370,7 @@ Visualization::Abstract::DataSet* VanKekenFile::load(const std::vector<std::stri
 		char valueFileName[2048];
 		snprintf(valueFileName,sizeof(valueFileName),"%s/%s",args[0].c_str(),valueFiles[gridIndex].fileName.c_str());
 		Misc::File valueFile(valueFileName,"rt");
+		addSourceFile(valueFileName,false);
 		int dummy,numValues;
 		if(fscanf(valueFile.getFilePtr(),"%d %d",&dummy,&numValues)!=2)
 			Misc::throwStdErr("VanKekenFile::load: Missing header in value file %s",valueFileName);
@@ -44,6 +44,7 @@ Visualization::Abstract::DataSet* VecVolFile::load(const std::vector<std::string
 	{
 	/* Open the volume file: */
 	Misc::File file(args[0].c_str(),"rb",Misc::File::BigEndian);
+	addSourceFile(args[0],false);
 	
 	/* Read the volume file header: */
 	int volSize[3];
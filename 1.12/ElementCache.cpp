@@ -0,0 +1,353 @@
+/***********************************************************************
+ElementCache - Class to keep previously extracted visualization elements
+in memory, indexed by their data set, algorithm, and binary extraction
+parameters, to return them instantly on repeated extraction requests.
+Evicted elements can be spilled to element geometry files on disk and
+reloaded on later requests.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include "ElementCache.h"
+
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <stdexcept>
+#include <iostream>
+#include <Misc/StandardMarshallers.h>
+#include <Misc/ThrowStdErr.h>
+#include <IO/File.h>
+#include <IO/SeekableFile.h>
+#include <IO/FixedMemoryFile.h>
+#include <IO/OpenFile.h>
+
+#include <Abstract/VariableManager.h>
+#include <Abstract/Parameters.h>
+#include <Abstract/BinaryParametersSize.h>
+#include <Abstract/BinaryParametersSink.h>
+#include <Abstract/BinaryParametersSource.h>
+#include <Abstract/Algorithm.h>
+#include <Abstract/Element.h>
+
+#include "ElementGeometryFile.h"
+
+/***********************************
+Methods of class ElementCache::Key:
+***********************************/
+
+ElementCache::Key::Key(const VariableManager* sVariableManager,const char* sAlgorithmName,const Parameters* parameters)
+	:variableManager(sVariableManager),dataSet(variableManager->getDataSet()),algorithmName(sAlgorithmName),
+	 hash(0)
+	{
+	/* Write the extraction parameters in raw form into a memory buffer: */
+	Visualization::Abstract::BinaryParametersSize size(variableManager,true);
+	parameters->write(size);
+	IO::FixedMemoryFile blobFile(size.getSize());
+	Visualization::Abstract::BinaryParametersSink sink(variableManager,blobFile,true);
+	parameters->write(sink);
+	const Misc::UInt8* blobPtr=static_cast<const Misc::UInt8*>(blobFile.getMemory());
+	parameterBlob.assign(blobPtr,blobPtr+size.getSize());
+	
+	/* Calculate a 64-bit FNV-1a hash value of the algorithm name and the parameter blob: */
+	const Misc::UInt64 fnvPrime=(Misc::UInt64(0x00000100U)<<32)|Misc::UInt64(0x000001b3U);
+	hash=(Misc::UInt64(0xcbf29ce4U)<<32)|Misc::UInt64(0x84222325U);
+	for(std::string::const_iterator anIt=algorithmName.begin();anIt!=algorithmName.end();++anIt)
+		hash=(hash^Misc::UInt64((unsigned char)*anIt))*fnvPrime;
+	hash*=fnvPrime; // Hash a NUL byte to separate the name from the blob
+	for(std::vector<Misc::UInt8>::const_iterator pbIt=parameterBlob.begin();pbIt!=parameterBlob.end();++pbIt)
+		hash=(hash^Misc::UInt64(*pbIt))*fnvPrime;
+	}
+
+bool ElementCache::Key::operator==(const ElementCache::Key& other) const
+	{
+	/* Compare the hash values first to reject most mismatches quickly: */
+	return hash==other.hash&&dataSet==other.dataSet&&algorithmName==other.algorithmName&&parameterBlob==other.parameterBlob;
+	}
+
+/*****************************
+Methods of class ElementCache:
+*****************************/
+
+void ElementCache::evict(ElementCache::CacheEntryList& evictedEntries)
+	{
+	/* Move the least recently used elements to the eviction list until the cache fits into its budget: */
+	while(memorySize>memoryBudget&&!entries.empty())
+		{
+		memorySize-=entries.back().memorySize;
+		entryIndex.removeEntry(entries.back().key.getHash());
+		evictedEntries.splice(evictedEntries.end(),entries,--entries.end());
+		}
+	}
+
+void ElementCache::removeSpilledEntry(ElementCache::SpilledEntryList::iterator seIt)
+	{
+	unlink(seIt->fileName.c_str());
+	spillSize-=seIt->fileSize;
+	spilledEntryIndex.removeEntry(seIt->key.getHash());
+	spilledEntries.erase(seIt);
+	}
+
+void ElementCache::spill(ElementCache::CacheEntryList& evictedEntries)
+	{
+	for(CacheEntryList::iterator ceIt=evictedEntries.begin();ceIt!=evictedEntries.end();++ceIt)
+		{
+		/* Get a unique name for the element's geometry file: */
+		std::string fileName;
+		std::string fileDataSetKey;
+		{
+		Threads::Mutex::Lock cacheLock(cacheMutex);
+		
+		/* Bail out if spilling was disabled in the meantime, or if the element can't be written: */
+		if(spillBudget==0||!ceIt->element->canWriteGeometry())
+			continue;
+		
+		char fileNameBuffer[64];
+		snprintf(fileNameBuffer,sizeof(fileNameBuffer),"/VisualizerElementCache-%d-%u",int(getpid()),nextSpillFileIndex);
+		++nextSpillFileIndex;
+		fileName=spillDirectory;
+		fileName.append(fileNameBuffer);
+		fileName.append(ElementGeometryFile::getFileExtension());
+		fileDataSetKey=dataSetKey;
+		}
+		
+		/* Write the element to its geometry file without holding the cache mutex: */
+		size_t fileSize=0;
+		try
+			{
+			{
+			IO::FilePtr file(IO::openFile(fileName.c_str(),IO::File::WriteOnly));
+			ElementGeometryFile::writeHeader(*file,fileDataSetKey);
+			ElementGeometryFile::writeElement(*file,ceIt->key.getVariableManager(),ceIt->key.getAlgorithmName().c_str(),ceIt->element.getPointer(),0.0);
+			}
+			
+			/* Get the size of the complete geometry file: */
+			struct stat fileStats;
+			if(stat(fileName.c_str(),&fileStats)!=0)
+				Misc::throwStdErr("ElementCache::spill: Unable to query size of geometry file %s",fileName.c_str());
+			fileSize=size_t(fileStats.st_size);
+			}
+		catch(std::runtime_error err)
+			{
+			/* Drop the element: */
+			std::cerr<<"ElementCache: Unable to spill element due to exception "<<err.what()<<std::endl;
+			unlink(fileName.c_str());
+			continue;
+			}
+		
+		Threads::Mutex::Lock cacheLock(cacheMutex);
+		
+		/* Drop the geometry file if it does not fit into the spill budget, or if an identical request was cached or spilled in the meantime: */
+		if(fileSize>spillBudget||!entryIndex.findEntry(ceIt->key.getHash()).isFinished()||!spilledEntryIndex.findEntry(ceIt->key.getHash()).isFinished())
+			{
+			unlink(fileName.c_str());
+			continue;
+			}
+		
+		/* Add the spilled element as the most recently spilled one and remove old spilled elements: */
+		spilledEntries.push_front(SpilledEntry(ceIt->key,fileName,fileSize));
+		spilledEntryIndex.setEntry(SpilledEntryIndex::Entry(ceIt->key.getHash(),spilledEntries.begin()));
+		spillSize+=fileSize;
+		while(spillSize>spillBudget)
+			removeSpilledEntry(--spilledEntries.end());
+		}
+	
+	/* Release the evicted elements: */
+	evictedEntries.clear();
+	}
+
+ElementCache::ElementPointer ElementCache::reload(const ElementCache::Key& key,ElementCache::Algorithm* algorithm)
+	{
+	/* Find a spilled entry with the same hash value and check that it matches the given key: */
+	std::string fileName;
+	std::string fileDataSetKey;
+	{
+	Threads::Mutex::Lock cacheLock(cacheMutex);
+	
+	SpilledEntryIndex::Iterator seiIt=spilledEntryIndex.findEntry(key.getHash());
+	if(seiIt.isFinished()||!(seiIt->getDest()->key==key))
+		return 0;
+	
+	/* Take the spilled entry out of the cache; its geometry file is removed after reading: */
+	SpilledEntryList::iterator seIt=seiIt->getDest();
+	fileName=seIt->fileName;
+	fileDataSetKey=dataSetKey;
+	spillSize-=seIt->fileSize;
+	spilledEntryIndex.removeEntry(key.getHash());
+	spilledEntries.erase(seIt);
+	}
+	
+	/* Read the element from its geometry file without holding the cache mutex: */
+	ElementPointer result;
+	try
+		{
+		IO::SeekableFilePtr file(IO::openSeekableFile(fileName.c_str()));
+		ElementGeometryFile::readHeader(*file,fileDataSetKey);
+		if(Misc::Marshaller<std::string>::read(*file)!=key.getAlgorithmName())
+			Misc::throwStdErr("ElementCache::reload: Geometry file %s holds an element of a different algorithm",fileName.c_str());
+		
+		/* Read the element's extraction parameters: */
+		Parameters* parameters=algorithm->cloneParameters();
+		try
+			{
+			Visualization::Abstract::BinaryParametersSource source(algorithm->getVariableManager(),*file,false);
+			parameters->read(source);
+			if(!ElementGeometryFile::readElementStats(*file).hasGeometry)
+				Misc::throwStdErr("ElementCache::reload: Geometry file %s does not contain geometry",fileName.c_str());
+			}
+		catch(...)
+			{
+			delete parameters;
+			throw;
+			}
+		
+		/* Read the element's geometry: */
+		result=algorithm->readElement(parameters,*file);
+		}
+	catch(std::runtime_error err)
+		{
+		/* Treat the element as not cached: */
+		std::cerr<<"ElementCache: Unable to reload spilled element due to exception "<<err.what()<<std::endl;
+		result=0;
+		}
+	unlink(fileName.c_str());
+	
+	/* Put the reloaded element back into the cache: */
+	if(result!=0)
+		insert(key,result.getPointer());
+	
+	return result;
+	}
+
+ElementCache::ElementCache(size_t sMemoryBudget)
+	:memoryBudget(sMemoryBudget),memorySize(0),
+	 entryIndex(101),
+	 spillBudget(0),spillSize(0),nextSpillFileIndex(0),
+	 spilledEntryIndex(101)
+	{
+	}
+
+ElementCache::~ElementCache(void)
+	{
+	/* Remove the geometry files of all spilled elements: */
+	for(SpilledEntryList::iterator seIt=spilledEntries.begin();seIt!=spilledEntries.end();++seIt)
+		unlink(seIt->fileName.c_str());
+	}
+
+void ElementCache::setMemoryBudget(size_t newMemoryBudget)
+	{
+	CacheEntryList evictedEntries;
+	{
+	Threads::Mutex::Lock cacheLock(cacheMutex);
+	
+	memoryBudget=newMemoryBudget;
+	evict(evictedEntries);
+	}
+	
+	/* Spill the evicted elements after releasing the cache mutex: */
+	spill(evictedEntries);
+	}
+
+void ElementCache::setSpilling(const std::string& newSpillDirectory,size_t newSpillBudget,const std::string& newDataSetKey)
+	{
+	Threads::Mutex::Lock cacheLock(cacheMutex);
+	
+	/* Remove all spilled elements, which might have been written for a different data set: */
+	while(!spilledEntries.empty())
+		removeSpilledEntry(spilledEntries.begin());
+	
+	spillDirectory=newSpillDirectory;
+	spillBudget=newSpillBudget;
+	dataSetKey=newDataSetKey;
+	}
+
+ElementCache::ElementPointer ElementCache::lookup(const ElementCache::Key& key,ElementCache::Algorithm* algorithm)
+	{
+	{
+	Threads::Mutex::Lock cacheLock(cacheMutex);
+	
+	/* Find an entry with the same hash value and check that it matches the given key: */
+	CacheEntryIndex::Iterator ceiIt=entryIndex.findEntry(key.getHash());
+	if(!ceiIt.isFinished()&&ceiIt->getDest()->key==key)
+		{
+		/* Mark the entry as most recently used: */
+		entries.splice(entries.begin(),entries,ceiIt->getDest());
+		
+		return entries.front().element;
+		}
+	
+	/* Bail out if there are no spilled elements: */
+	if(spilledEntries.empty())
+		return 0;
+	}
+	
+	/* Reload the element if it was spilled: */
+	return reload(key,algorithm);
+	}
+
+void ElementCache::insert(const ElementCache::Key& key,ElementCache::Element* element)
+	{
+	/* Calculate the memory accounted to the new entry: */
+	size_t entrySize=key.getMemorySize()+element->getMemorySize();
+	
+	CacheEntryList evictedEntries;
+	{
+	Threads::Mutex::Lock cacheLock(cacheMutex);
+	
+	/* Remove an existing entry with the same hash value, which can happen if two identical requests were extracted concurrently, or if two different requests' hash values collide: */
+	CacheEntryIndex::Iterator ceiIt=entryIndex.findEntry(key.getHash());
+	if(!ceiIt.isFinished())
+		{
+		memorySize-=ceiIt->getDest()->memorySize;
+		entries.erase(ceiIt->getDest());
+		entryIndex.removeEntry(key.getHash());
+		}
+	
+	/* Remove a spilled element with the same hash value, as it is either outdated or a collision: */
+	SpilledEntryIndex::Iterator seiIt=spilledEntryIndex.findEntry(key.getHash());
+	if(!seiIt.isFinished())
+		removeSpilledEntry(seiIt->getDest());
+	
+	/* Don't cache elements that would not fit into the budget at all: */
+	if(entrySize>memoryBudget)
+		return;
+	
+	/* Add the new entry as the most recently used one and evict old entries: */
+	entries.push_front(CacheEntry(key,element,entrySize));
+	entryIndex.setEntry(CacheEntryIndex::Entry(key.getHash(),entries.begin()));
+	memorySize+=entrySize;
+	evict(evictedEntries);
+	}
+	
+	/* Spill the evicted elements after releasing the cache mutex: */
+	spill(evictedEntries);
+	}
+
+void ElementCache::clear(void)
+	{
+	Threads::Mutex::Lock cacheLock(cacheMutex);
+	
+	entries.clear();
+	entryIndex.clear();
+	memorySize=0;
+	
+	/* Remove the geometry files of all spilled elements: */
+	while(!spilledEntries.empty())
+		removeSpilledEntry(spilledEntries.begin());
+	}
@@ -0,0 +1,187 @@
+/***********************************************************************
+ElementCache - Class to keep previously extracted visualization elements
+in memory, indexed by their data set, algorithm, and binary extraction
+parameters, to return them instantly on repeated extraction requests.
+Evicted elements can be spilled to element geometry files on disk and
+reloaded on later requests.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef ELEMENTCACHE_INCLUDED
+#define ELEMENTCACHE_INCLUDED
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include <list>
+#include <Misc/SizedTypes.h>
+#include <Misc/Autopointer.h>
+#include <Misc/HashTable.h>
+#include <Threads/Mutex.h>
+
+/* Forward declarations: */
+namespace Visualization {
+namespace Abstract {
+class DataSet;
+class VariableManager;
+class Parameters;
+class Algorithm;
+class Element;
+}
+}
+
+class ElementCache
+	{
+	/* Embedded classes: */
+	public:
+	typedef Visualization::Abstract::DataSet DataSet;
+	typedef Visualization::Abstract::VariableManager VariableManager;
+	typedef Visualization::Abstract::Parameters Parameters;
+	typedef Visualization::Abstract::Algorithm Algorithm;
+	typedef Visualization::Abstract::Element Element;
+	typedef Misc::Autopointer<Element> ElementPointer;
+	
+	class Key // Class identifying an extraction request by data set, algorithm name, and extraction parameters
+		{
+		/* Elements: */
+		private:
+		const VariableManager* variableManager; // Variable manager used to serialize the extraction parameters
+		const DataSet* dataSet; // Data set from which the element is extracted
+		std::string algorithmName; // Name of the algorithm extracting the element
+		std::vector<Misc::UInt8> parameterBlob; // Raw binary representation of the extraction parameters
+		Misc::UInt64 hash; // Hash value of the algorithm name and the parameter blob
+		
+		/* Constructors and destructors: */
+		public:
+		Key(const VariableManager* variableManager,const char* sAlgorithmName,const Parameters* parameters); // Creates a key for the given extraction request
+		
+		/* Methods: */
+		const VariableManager* getVariableManager(void) const // Returns the variable manager used to serialize the extraction parameters
+			{
+			return variableManager;
+			}
+		const std::string& getAlgorithmName(void) const // Returns the name of the extracting algorithm
+			{
+			return algorithmName;
+			}
+		Misc::UInt64 getHash(void) const // Returns the key's hash value
+			{
+			return hash;
+			}
+		size_t getMemorySize(void) const // Returns the approximate amount of memory used by the key
+			{
+			return sizeof(Key)+algorithmName.size()+parameterBlob.size();
+			}
+		bool operator==(const Key& other) const; // Returns true if the two keys identify the same extraction request
+		};
+	
+	private:
+	struct CacheEntry // Structure for a cached visualization element
+		{
+		/* Elements: */
+		public:
+		Key key; // Extraction request that created the element
+		ElementPointer element; // Pointer to the element itself
+		size_t memorySize; // Memory accounted to the cache entry in bytes
+		
+		/* Constructors and destructors: */
+		CacheEntry(const Key& sKey,Element* sElement,size_t sMemorySize)
+			:key(sKey),element(sElement),memorySize(sMemorySize)
+			{
+			}
+		};
+	
+	typedef std::list<CacheEntry> CacheEntryList;
+	
+	struct SpilledEntry // Structure for an evicted visualization element spilled to a geometry file
+		{
+		/* Elements: */
+		public:
+		Key key; // Extraction request that created the element
+		std::string fileName; // Name of the geometry file holding the element
+		size_t fileSize; // Size of the geometry file in bytes
+		
+		/* Constructors and destructors: */
+		SpilledEntry(const Key& sKey,const std::string& sFileName,size_t sFileSize)
+			:key(sKey),fileName(sFileName),fileSize(sFileSize)
+			{
+			}
+		};
+	
+	typedef std::list<SpilledEntry> SpilledEntryList;
+	
+	struct HashValueHasher // Hash function for keys' hash values
+		{
+		/* Methods: */
+		public:
+		static size_t hash(const Misc::UInt64& source,size_t tableSize)
+			{
+			return size_t(source%Misc::UInt64(tableSize));
+			}
+		};
+	
+	typedef Misc::HashTable<Misc::UInt64,CacheEntryList::iterator,HashValueHasher> CacheEntryIndex; // Type for hash tables mapping keys' hash values to cache entries
+	typedef Misc::HashTable<Misc::UInt64,SpilledEntryList::iterator,HashValueHasher> SpilledEntryIndex; // Type for hash tables mapping keys' hash values to spilled entries
+	
+	/* Elements: */
+	Threads::Mutex cacheMutex; // Mutex protecting the cache state against concurrent extractor threads
+	size_t memoryBudget; // Maximum amount of memory held by cached elements in bytes
+	size_t memorySize; // Amount of memory currently held by cached elements in bytes
+	CacheEntryList entries; // List of cached elements, most recently used first
+	CacheEntryIndex entryIndex; // Index of cached elements by their keys' hash values; holds at most one entry per hash value
+	std::string spillDirectory; // Directory in which to create geometry files for spilled elements
+	std::string dataSetKey; // Key identifying the data set in the headers of geometry files
+	size_t spillBudget; // Maximum total size of geometry files of spilled elements in bytes; 0 disables spilling
+	size_t spillSize; // Total size of the geometry files of spilled elements in bytes
+	unsigned int nextSpillFileIndex; // Index to create unique geometry file names for spilled elements
+	SpilledEntryList spilledEntries; // List of spilled elements, most recently spilled first
+	SpilledEntryIndex spilledEntryIndex; // Index of spilled elements by their keys' hash values; holds at most one entry per hash value
+	
+	/* Private methods: */
+	void evict(CacheEntryList& evictedEntries); // Moves least recently used elements to the given list until the cache fits into its memory budget; assumes the cache mutex is locked
+	void removeSpilledEntry(SpilledEntryList::iterator seIt); // Removes a spilled element and its geometry file; assumes the cache mutex is locked
+	void spill(CacheEntryList& evictedEntries); // Writes the given evicted elements to geometry files; must be called without the cache mutex locked
+	ElementPointer reload(const Key& key,Algorithm* algorithm); // Reloads a spilled element of the given key using the given algorithm; returns 0 if the element was not spilled or could not be read
+	
+	/* Constructors and destructors: */
+	public:
+	ElementCache(size_t sMemoryBudget); // Creates an empty cache with the given memory budget in bytes
+	private:
+	ElementCache(const ElementCache& source); // Prohibit copy constructor
+	ElementCache& operator=(const ElementCache& source); // Prohibit assignment operator
+	public:
+	~ElementCache(void); // Destroys the cache, releases all cached elements, and removes the geometry files of all spilled elements
+	
+	/* Methods: */
+	size_t getMemoryBudget(void) const // Returns the cache's memory budget in bytes
+		{
+		return memoryBudget;
+		}
+	void setMemoryBudget(size_t newMemoryBudget); // Sets a new memory budget and evicts elements if necessary
+	void setSpilling(const std::string& newSpillDirectory,size_t newSpillBudget,const std::string& newDataSetKey); // Spills evicted elements into geometry files in the given directory up to the given total size in bytes; files are tagged with the given data set key
+	size_t getMemorySize(void) const // Returns the amount of memory currently held by cached elements
+		{
+		return memorySize;
+		}
+	ElementPointer lookup(const Key& key,Algorithm* algorithm); // Returns the element extracted by an identical request, reloading it with the given algorithm if it was spilled, or 0 if no such element is cached; the returned element is shared with all other users of the same request
+	void insert(const Key& key,Element* element); // Adds an element extracted by the given request to the cache
+	void clear(void); // Releases all cached elements and removes the geometry files of all spilled elements
+	};
+
+#endif
@@ -0,0 +1,111 @@
+/***********************************************************************
+ElementGeometryFile - Helper class to read and write files of
+pre-computed visualization elements, storing each element's algorithm,
+extraction parameters, extraction statistics, and, if supported by the
+element, its extracted geometry.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include "ElementGeometryFile.h"
+
+#include <string>
+#include <Misc/SizedTypes.h>
+#include <Misc/ThrowStdErr.h>
+#include <Misc/StandardMarshallers.h>
+#include <IO/File.h>
+
+#include <Abstract/VariableManager.h>
+#include <Abstract/Parameters.h>
+#include <Abstract/BinaryParametersSink.h>
+#include <Abstract/Element.h>
+
+/********************************************
+Static elements of class ElementGeometryFile:
+********************************************/
+
+const char* ElementGeometryFile::fileHeader="Visualizer Element Geometry File v1.1";
+const unsigned int ElementGeometryFile::byteOrderMarker=0x01020304U;
+
+/************************************
+Methods of class ElementGeometryFile:
+************************************/
+
+void ElementGeometryFile::writeHeader(IO::File& file,const std::string& dataSetKey)
+	{
+	/* Geometry files use the same endianness as binary element files: */
+	file.setEndianness(Misc::LittleEndian);
+	
+	/* Write the identification string: */
+	Misc::Marshaller<std::string>::write(fileHeader,file);
+	
+	/* Write the byte order marker in host byte order, as geometry arrays are written without conversion: */
+	Misc::UInt32 marker=byteOrderMarker;
+	file.writeRaw(&marker,sizeof(Misc::UInt32));
+	
+	/* Write the identity of the data set from which the elements were extracted: */
+	Misc::Marshaller<std::string>::write(dataSetKey,file);
+	}
+
+void ElementGeometryFile::readHeader(IO::File& file,const std::string& dataSetKey)
+	{
+	file.setEndianness(Misc::LittleEndian);
+	
+	/* Check the identification string: */
+	if(Misc::Marshaller<std::string>::read(file)!=fileHeader)
+		Misc::throwStdErr("ElementGeometryFile::readHeader: File is not an element geometry file");
+	
+	/* Check that the file's geometry arrays use the host byte order: */
+	Misc::UInt32 marker;
+	file.readRaw(&marker,sizeof(Misc::UInt32));
+	if(marker!=byteOrderMarker)
+		Misc::throwStdErr("ElementGeometryFile::readHeader: File was written on a host of different byte order");
+	
+	/* Check that the elements were extracted from the current data set and its current source files: */
+	if(Misc::Marshaller<std::string>::read(file)!=dataSetKey)
+		Misc::throwStdErr("ElementGeometryFile::readHeader: File was written for a different data set or different versions of its source files");
+	}
+
+void ElementGeometryFile::writeElement(IO::File& file,const ElementGeometryFile::VariableManager* variableManager,const char* algorithmName,const ElementGeometryFile::Element* element,double extractionTime)
+	{
+	/* Write the algorithm name and the element's extraction parameters in the same format as binary element files: */
+	Misc::Marshaller<std::string>::write(algorithmName,file);
+	Visualization::Abstract::BinaryParametersSink sink(variableManager,file,false);
+	element->getParameters()->write(sink);
+	
+	/* Write the extraction statistics: */
+	file.write<Misc::Float64>(extractionTime);
+	file.write<Misc::UInt64>(element->getSize());
+	file.write<Misc::UInt64>(element->getMemorySize());
+	
+	/* Write the element's geometry if the element supports it: */
+	bool hasGeometry=element->canWriteGeometry();
+	file.write<Misc::UInt8>(hasGeometry?1:0);
+	if(hasGeometry)
+		element->writeGeometry(file);
+	}
+
+ElementGeometryFile::ElementStats ElementGeometryFile::readElementStats(IO::File& file)
+	{
+	ElementStats result;
+	result.extractionTime=file.read<Misc::Float64>();
+	result.size=size_t(file.read<Misc::UInt64>());
+	result.memorySize=size_t(file.read<Misc::UInt64>());
+	result.hasGeometry=file.read<Misc::UInt8>()!=0;
+	return result;
+	}
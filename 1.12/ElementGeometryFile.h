@@ -0,0 +1,76 @@
+/***********************************************************************
+ElementGeometryFile - Helper class to read and write files of
+pre-computed visualization elements, storing each element's algorithm,
+extraction parameters, extraction statistics, and, if supported by the
+element, its extracted geometry.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef ELEMENTGEOMETRYFILE_INCLUDED
+#define ELEMENTGEOMETRYFILE_INCLUDED
+
+#include <stddef.h>
+#include <string>
+
+/* Forward declarations: */
+namespace IO {
+class File;
+}
+namespace Visualization {
+namespace Abstract {
+class VariableManager;
+class Element;
+}
+}
+
+class ElementGeometryFile
+	{
+	/* Embedded classes: */
+	public:
+	typedef Visualization::Abstract::VariableManager VariableManager;
+	typedef Visualization::Abstract::Element Element;
+	
+	struct ElementStats // Structure for the extraction statistics of a pre-computed visualization element
+		{
+		/* Elements: */
+		public:
+		double extractionTime; // Time spent extracting the element in seconds
+		size_t size; // Size of the element as returned by Element::getSize()
+		size_t memorySize; // Memory held by the element's geometry as returned by Element::getMemorySize()
+		bool hasGeometry; // Flag if the element's geometry follows in the file
+		};
+	
+	/* Elements: */
+	private:
+	static const char* fileHeader; // Identification string at the beginning of each geometry file
+	static const unsigned int byteOrderMarker; // Value identifying the byte order of geometry arrays
+	
+	/* Methods: */
+	public:
+	static const char* getFileExtension(void) // Returns the file name extension of geometry files
+		{
+		return ".elemgeom";
+		}
+	static void writeHeader(IO::File& file,const std::string& dataSetKey); // Sets up the given file for writing and writes the geometry file header for the data set of the given key
+	static void readHeader(IO::File& file,const std::string& dataSetKey); // Sets up the given file for reading and checks the geometry file header; throws exception if the file is not a compatible geometry file or was written for a different data set
+	static void writeElement(IO::File& file,const VariableManager* variableManager,const char* algorithmName,const Element* element,double extractionTime); // Writes a pre-computed visualization element to the given file
+	static ElementStats readElementStats(IO::File& file); // Reads the extraction statistics of a pre-computed element after its algorithm name and parameters; caller must read the element's geometry if there is any
+	};
+
+#endif
@@ -227,6 +227,18 @@ void ElementList::clear(void)
 
 void ElementList::addElement(Element* newElement,const char* elementName)
 	{
+	/* Check if the element is already in the list, which happens when the element cache returns a previously extracted element: */
+	for(ListElementList::iterator eIt=elements.begin();eIt!=elements.end();++eIt)
+		if(eIt->element.getPointer()==newElement)
+			{
+			/* Show and select the existing entry instead of adding a duplicate: */
+			eIt->show=true;
+			elementList->selectItem(int(eIt-elements.begin()),true);
+			updateUiState();
+			
+			return;
+			}
+	
 	/* Create the element's list structure: */
 	ListElement le;
 	le.element=newElement;
@@ -92,7 +92,7 @@ class ElementList
 	
 	/* Methods: */
 	void clear(void); // Deletes all elements from the list
-	void addElement(Element* newElement,const char* elementName); // Adds a new visualization element to the list
+	void addElement(Element* newElement,const char* elementName); // Adds a new visualization element to the list, or shows and selects the element if it is already in the list
 	void saveElements(const char* elementFileName,bool ascii,const Visualization::Abstract::VariableManager* variableManager) const; // Saves all visible visualization elements to the given file
 	GLMotif::PopupWindow* getElementListDialog(void) // Returns the element list dialog
 		{
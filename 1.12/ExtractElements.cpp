@@ -0,0 +1,354 @@
+/***********************************************************************
+ExtractElements - Utility to extract the visualization elements defined
+in an element file from a data set without a display, and to write the
+extracted elements into a geometry file that can be loaded by the 3D
+Visualizer without repeating the extraction.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdexcept>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <Misc/ThrowStdErr.h>
+#include <Misc/Timer.h>
+#include <Misc/Autopointer.h>
+#include <Misc/StandardMarshallers.h>
+#include <Misc/FileNameExtensions.h>
+#include <Threads/Mutex.h>
+#include <Plugins/FactoryManager.h>
+#include <IO/File.h>
+#include <IO/OpenFile.h>
+#include <IO/ValueSource.h>
+
+#include <Abstract/DataSet.h>
+#include <Abstract/VariableManager.h>
+#include <Abstract/Parameters.h>
+#include <Abstract/BinaryParametersSource.h>
+#include <Abstract/FileParametersSource.h>
+#include <Abstract/Algorithm.h>
+#include <Abstract/Element.h>
+#include <Abstract/Module.h>
+#include <Templatized/WorkerPool.h>
+
+#include "ElementGeometryFile.h"
+
+namespace {
+
+/**************
+Helper classes:
+**************/
+
+typedef Visualization::Abstract::DataSet DataSet;
+typedef Visualization::Abstract::VariableManager VariableManager;
+typedef Visualization::Abstract::Parameters Parameters;
+typedef Visualization::Abstract::Algorithm Algorithm;
+typedef Visualization::Abstract::Element Element;
+typedef Visualization::Abstract::Module Module;
+typedef Plugins::FactoryManager<Module> ModuleManager;
+
+struct ExtractedElement // Structure for a visualization element read from an element file
+	{
+	/* Elements: */
+	public:
+	std::string algorithmName; // Name of the algorithm extracting the element
+	Algorithm* algorithm; // Algorithm extracting the element
+	Parameters* parameters; // Extraction parameters read from the element file; inherited by the extracted element
+	Misc::Autopointer<Element> element; // The extracted element, or 0 if extraction has not happened or failed
+	std::string error; // Error message if extraction failed
+	double extractionTime; // Time spent extracting the element in seconds
+	
+	/* Constructors and destructors: */
+	ExtractedElement(const std::string& sAlgorithmName,Algorithm* sAlgorithm,Parameters* sParameters)
+		:algorithmName(sAlgorithmName),algorithm(sAlgorithm),parameters(sParameters),
+		 element(0),extractionTime(0.0)
+		{
+		}
+	};
+
+class ElementExtractionJob // Class to extract a list of visualization elements on a team of worker threads
+	{
+	/* Elements: */
+	private:
+	std::vector<ExtractedElement>& elements; // List of elements to extract
+	Threads::Mutex nextElementMutex; // Mutex protecting the index of the next element to extract
+	size_t nextElementIndex; // Index of the next element to be picked up by any worker
+	
+	/* Constructors and destructors: */
+	public:
+	ElementExtractionJob(std::vector<ExtractedElement>& sElements)
+		:elements(sElements),nextElementIndex(0)
+		{
+		}
+	
+	/* Methods: */
+	void operator()(unsigned int)
+		{
+		while(true)
+			{
+			/* Pick up the next element that has not been extracted yet: */
+			size_t elementIndex;
+			{
+			Threads::Mutex::Lock nextElementLock(nextElementMutex);
+			if(nextElementIndex==elements.size())
+				break;
+			elementIndex=nextElementIndex;
+			++nextElementIndex;
+			}
+			
+			/* Extract the element: */
+			ExtractedElement& ee=elements[elementIndex];
+			Misc::Timer extractionTimer;
+			try
+				{
+				ee.element=ee.algorithm->createElement(ee.parameters);
+				}
+			catch(std::runtime_error err)
+				{
+				ee.error=err.what();
+				}
+			extractionTimer.elapse();
+			ee.extractionTime=extractionTimer.getTime();
+			}
+		}
+	};
+
+/****************
+Helper functions:
+****************/
+
+void readElementFile(const char* elementFileName,const Module* module,VariableManager* variableManager,std::vector<ExtractedElement>& elements)
+	{
+	if(Misc::hasCaseExtension(elementFileName,".asciielem"))
+		{
+		/* Open the element file: */
+		IO::ValueSource elementFile(IO::openFile(elementFileName));
+		elementFile.setPunctuation("");
+		elementFile.setQuotes("\"");
+		elementFile.skipWs();
+		
+		/* Read all elements from the file: */
+		while(!elementFile.eof())
+			{
+			/* Read the next algorithm name and create an extractor for it: */
+			std::string algorithmName=elementFile.readLine();
+			elementFile.skipWs();
+			Algorithm* algorithm=module->getAlgorithm(algorithmName.c_str(),variableManager,0);
+			if(algorithm==0)
+				Misc::throwStdErr("ExtractElements: Unknown algorithm %s in element file %s",algorithmName.c_str(),elementFileName);
+			
+			try
+				{
+				/* Read the element's extraction parameters from the file: */
+				Visualization::Abstract::FileParametersSource source(variableManager,elementFile);
+				Parameters* parameters=algorithm->cloneParameters();
+				parameters->read(source);
+				
+				/* Queue the element for extraction: */
+				elements.push_back(ExtractedElement(algorithmName,algorithm,parameters));
+				}
+			catch(...)
+				{
+				/* Destroy the extractor and re-throw: */
+				delete algorithm;
+				throw;
+				}
+			}
+		}
+	else if(Misc::hasCaseExtension(elementFileName,".binelem"))
+		{
+		/* Open the element file and create a data source to read from it: */
+		IO::FilePtr elementFile(IO::openFile(elementFileName));
+		elementFile->setEndianness(Misc::LittleEndian);
+		Visualization::Abstract::BinaryParametersSource source(variableManager,*elementFile,false);
+		
+		/* Read all elements from the file: */
+		while(!elementFile->eof())
+			{
+			/* Read the next algorithm name and create an extractor for it: */
+			std::string algorithmName=Misc::Marshaller<std::string>::read(*elementFile);
+			Algorithm* algorithm=module->getAlgorithm(algorithmName.c_str(),variableManager,0);
+			if(algorithm==0)
+				Misc::throwStdErr("ExtractElements: Unknown algorithm %s in element file %s",algorithmName.c_str(),elementFileName);
+			
+			try
+				{
+				/* Read the element's extraction parameters from the file: */
+				Parameters* parameters=algorithm->cloneParameters();
+				parameters->read(source);
+				
+				/* Queue the element for extraction: */
+				elements.push_back(ExtractedElement(algorithmName,algorithm,parameters));
+				}
+			catch(...)
+				{
+				/* Destroy the extractor and re-throw: */
+				delete algorithm;
+				throw;
+				}
+			}
+		}
+	else
+		Misc::throwStdErr("ExtractElements: Element file %s has unknown type",elementFileName);
+	}
+
+}
+
+int main(int argc,char* argv[])
+	{
+	/* Parse the command line: */
+	std::string moduleClassName="";
+	std::vector<std::string> dataSetArgs;
+	bool useActiveCellIndices=false;
+	const char* elementFileName=0;
+	const char* geometryFileName=0;
+	for(int i=1;i<argc;++i)
+		{
+		if(argv[i][0]=='-')
+			{
+			if(strcasecmp(argv[i]+1,"class")==0)
+				{
+				/* Get visualization module class name and data set arguments from command line: */
+				++i;
+				if(i>=argc)
+					{
+					std::cerr<<"Missing module class name after -class"<<std::endl;
+					return 1;
+					}
+				moduleClassName=argv[i];
+				++i;
+				while(i<argc&&strcmp(argv[i],";")!=0)
+					{
+					dataSetArgs.push_back(argv[i]);
+					++i;
+					}
+				}
+			else if(strcasecmp(argv[i]+1,"numThreads")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Set the number of worker threads for parallel extraction: */
+					Visualization::Templatized::WorkerPool::setNumWorkers((unsigned int)atoi(argv[i]));
+					}
+				else
+					std::cerr<<"Missing number of threads after -numThreads"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"activeCellIndex")==0)
+				{
+				/* Index the data set's cells to speed up repeated global isosurface extraction: */
+				useActiveCellIndices=true;
+				}
+			else
+				std::cerr<<"Ignoring unknown option "<<argv[i]<<std::endl;
+			}
+		else if(elementFileName==0)
+			elementFileName=argv[i];
+		else if(geometryFileName==0)
+			geometryFileName=argv[i];
+		else
+			std::cerr<<"Ignoring extra argument "<<argv[i]<<std::endl;
+		}
+	
+	/* Check the command line: */
+	if(moduleClassName==""||dataSetArgs.empty()||elementFileName==0||geometryFileName==0)
+		{
+		std::cerr<<"Usage: "<<argv[0]<<" [-numThreads <number of threads>] [-activeCellIndex] -class <module class name> <data set arguments> ; <element file name> <geometry file name>"<<std::endl;
+		return 1;
+		}
+	
+	ModuleManager moduleManager(VISUALIZER_MODULENAMETEMPLATE);
+	DataSet* dataSet=0;
+	VariableManager* variableManager=0;
+	std::vector<ExtractedElement> elements;
+	int result=0;
+	try
+		{
+		/* Load the appropriate visualization module: */
+		Module* module=moduleManager.loadClass(moduleClassName.c_str());
+		
+		/* Load the data set: */
+		Misc::Timer loadTimer;
+		dataSet=module->load(dataSetArgs,0);
+		loadTimer.elapse();
+		std::cout<<"Time to load data set: "<<loadTimer.getTime()*1000.0<<" ms"<<std::endl;
+		
+		/* Create a variable manager without user interface: */
+		variableManager=new VariableManager(dataSet,0,0,0,true);
+		variableManager->setUseActiveCellIndices(useActiveCellIndices);
+		
+		/* Read all element definitions from the element file: */
+		readElementFile(elementFileName,module,variableManager,elements);
+		
+		/* Extract all elements concurrently: */
+		std::cout<<"Creating "<<elements.size()<<" visualization elements..."<<std::flush;
+		Misc::Timer extractionTimer;
+		ElementExtractionJob job(elements);
+		unsigned int numWorkers=Visualization::Templatized::WorkerPool::getNumWorkers();
+		if(numWorkers>elements.size())
+			numWorkers=(unsigned int)elements.size();
+		Visualization::Templatized::WorkerPool::run(job,numWorkers);
+		extractionTimer.elapse();
+		std::cout<<" done in "<<extractionTimer.getTime()*1000.0<<" ms"<<std::endl;
+		
+		/* Write all extracted elements to the geometry file in element file order: */
+		IO::FilePtr geometryFile(IO::openFile(geometryFileName,IO::File::WriteOnly));
+		ElementGeometryFile::writeHeader(*geometryFile,module->getDataSetKey(dataSetArgs));
+		double totalExtractionTime=0.0;
+		size_t totalMemorySize=0;
+		for(std::vector<ExtractedElement>::iterator eeIt=elements.begin();eeIt!=elements.end();++eeIt)
+			{
+			if(eeIt->element!=0)
+				{
+				ElementGeometryFile::writeElement(*geometryFile,variableManager,eeIt->algorithmName.c_str(),eeIt->element.getPointer(),eeIt->extractionTime);
+				std::cout<<"Created "<<eeIt->algorithmName<<" in "<<eeIt->extractionTime*1000.0<<" ms, size "<<eeIt->element->getSize()<<", "<<double(eeIt->element->getMemorySize())/(1024.0*1024.0)<<" MB";
+				if(!eeIt->element->canWriteGeometry())
+					std::cout<<" (geometry not saved)";
+				std::cout<<std::endl;
+				totalExtractionTime+=eeIt->extractionTime;
+				totalMemorySize+=eeIt->element->getMemorySize();
+				}
+			else
+				{
+				std::cout<<"Cancelled "<<eeIt->algorithmName<<" due to exception "<<eeIt->error<<std::endl;
+				result=1;
+				}
+			}
+		std::cout<<"Total extraction time "<<totalExtractionTime*1000.0<<" ms, total geometry "<<double(totalMemorySize)/(1024.0*1024.0)<<" MB"<<std::endl;
+		}
+	catch(std::runtime_error err)
+		{
+		std::cerr<<"Caught exception "<<err.what()<<std::endl;
+		result=1;
+		}
+	
+	/* Destroy all elements and extractors before the variable manager and data set: */
+	for(std::vector<ExtractedElement>::iterator eeIt=elements.begin();eeIt!=elements.end();++eeIt)
+		{
+		eeIt->element=0;
+		delete eeIt->algorithm;
+		}
+	elements.clear();
+	delete variableManager;
+	delete dataSet;
+	
+	return result;
+	}
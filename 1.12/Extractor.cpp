@@ -34,6 +34,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Abstract/Algorithm.h>
 #include <Abstract/Element.h>
 
+#include "ElementCache.h"
+
 /**************************
 Methods of class Extractor:
 **************************/
@@ -75,10 +77,42 @@ void* Extractor::masterExtractorThreadMethod(void)
 		requestID=seedRequestID;
 		}
 		
+		#ifdef VISUALIZATION_USE_PROFILING
+		/* Collect the counters and timers of this request in the extractor's profile: */
+		Visualization::Templatized::Profiler::Scope profilerScope(&profile);
+		Visualization::Templatized::Profiler::ScopedTimer extractionTimer(Visualization::Templatized::Profiler::EXTRACTION_TIME);
+		#endif
+		
+		/* Check if an identical visualization element was extracted before: */
+		ElementCache::Key* cacheKey=0;
+		ElementPointer cachedElement;
+		if(elementCache!=0&&extractor->getPipe()==0&&parameters->isValid())
+			{
+			cacheKey=new ElementCache::Key(extractor->getVariableManager(),extractor->getName(),parameters);
+			cachedElement=elementCache->lookup(*cacheKey,extractor);
+			}
+		
 		/* Start a new visualization element: */
 		std::pair<ElementPointer,unsigned int>& element=trackedElements.startNewValue();
-		if(parameters->isValid())
+		if(cachedElement!=0)
 			{
+			/* Store the cached visualization element: */
+			element.first=cachedElement;
+			element.second=requestID;
+			
+			/* Push this visualization element to the main thread: */
+			trackedElements.postNewValue();
+			update();
+			
+			/* Delete the unused extraction parameters; the cached element holds an identical copy: */
+			delete parameters;
+			}
+		else if(parameters->isValid())
+			{
+			#ifdef VISUALIZATION_USE_PROFILING
+			Visualization::Templatized::Profiler::count(Visualization::Templatized::Profiler::EXTRACTED_ELEMENTS);
+			#endif
+			
 			/* Prepare for extracting a new visualization element: */
 			if(extractor->getPipe()!=0)
 				{
@@ -97,12 +131,14 @@ void* Extractor::masterExtractorThreadMethod(void)
 				element.second=requestID;
 				
 				/* Continue extracting the visualization element until it is done: */
-				bool keepGrowing;
+				Element* newElement=element.first.getPointer();
+				bool complete,keepGrowing;
 				do
 					{
 					/* Grow the visualization element by a little bit: */
 					alarm.armTimer(expirationTime);
-					keepGrowing=!extractor->continueElement(alarm);
+					complete=extractor->continueElement(alarm);
+					keepGrowing=!complete;
 					
 					/* Push this visualization element to the main thread: */
 					trackedElements.postNewValue();
@@ -126,6 +162,10 @@ void* Extractor::masterExtractorThreadMethod(void)
 				
 				/* Finish the element: */
 				extractor->finishElement();
+				
+				/* Cache the element unless its extraction was interrupted by another seed request: */
+				if(cacheKey!=0&&complete)
+					elementCache->insert(*cacheKey,newElement);
 				}
 			else
 				{
@@ -133,6 +173,10 @@ void* Extractor::masterExtractorThreadMethod(void)
 				element.first=extractor->createElement(parameters);
 				element.second=requestID;
 				
+				/* Cache the visualization element: */
+				if(cacheKey!=0&&element.first!=0)
+					elementCache->insert(*cacheKey,element.first.getPointer());
+				
 				if(extractor->getPipe()!=0)
 					{
 					/* Tell the slave nodes that the current visualization element is finished: */
@@ -166,6 +210,9 @@ void* Extractor::masterExtractorThreadMethod(void)
 			/* Delete the unused extraction parameters: */
 			delete parameters;
 			}
+		
+		/* Delete the cache key: */
+		delete cacheKey;
 		}
 	
 	return 0;
@@ -235,8 +282,8 @@ void* Extractor::slaveExtractorThreadMethod(void)
 	return 0;
 	}
 
-Extractor::Extractor(Extractor::Algorithm* sExtractor)
-	:extractor(sExtractor),
+Extractor::Extractor(Extractor::Algorithm* sExtractor,ElementCache* sElementCache)
+	:extractor(sExtractor),elementCache(sElementCache),
 	 #if !THREADS_CONFIG_CAN_CANCEL
 	 terminate(false),
 	 #endif
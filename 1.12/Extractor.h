@@ -31,6 +31,10 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Threads/Thread.h>
 #include <Threads/TripleBuffer.h>
 
+#ifdef VISUALIZATION_USE_PROFILING
+#include <Templatized/Profiler.h>
+#endif
+
 /* Forward declarations: */
 namespace Visualization {
 namespace Abstract {
@@ -39,6 +43,7 @@ class Algorithm;
 class Element;
 }
 }
+class ElementCache;
 class GLRenderState;
 
 class Extractor
@@ -55,6 +60,7 @@ class Extractor
 	
 	/* Persistent state: */
 	Algorithm* extractor; // Visualization element extractor
+	ElementCache* elementCache; // Cache of previously extracted visualization elements, or 0 if extracted elements are not cached
 	
 	/* Persistent extractor thread state: */
 	private:
@@ -76,6 +82,11 @@ class Extractor
 	/* Extractor thread communication output: */
 	Threads::TripleBuffer<std::pair<ElementPointer,unsigned int> > trackedElements; // Triple-buffer of currently tracked visualization elements and their IDs
 	
+	#ifdef VISUALIZATION_USE_PROFILING
+	/* Profiling state: */
+	Visualization::Templatized::Profiler::Profile profile; // Counters and timers aggregated over all extraction requests handled by this extractor
+	#endif
+	
 	/* Private methods: */
 	private:
 	void* masterExtractorThreadMethod(void); // The extractor thread method for single computers or masters in a cluster environment
@@ -83,7 +94,7 @@ class Extractor
 	
 	/* Constructors and destructors: */
 	public:
-	Extractor(Algorithm* sExtractor); // Creates extractor for the given algorithm; inherits algorithm
+	Extractor(Algorithm* sExtractor,ElementCache* sElementCache =0); // Creates extractor for the given algorithm and optional element cache; inherits algorithm
 	virtual ~Extractor(void); // Destroys the extractor
 	
 	/* Methods: */
@@ -100,6 +111,12 @@ class Extractor
 	virtual ElementPointer checkUpdates(void); // Method to synchronize the extraction thread's state back to the main thread; returns pointer to new finished element or 0
 	void glRenderAction(GLRenderState& renderState,bool transparent) const; // Renders the extractor's current opaque or transparent geometry
 	virtual void update(void); // Hook method called asynchronously when the visual state of the extractor changes
+	#ifdef VISUALIZATION_USE_PROFILING
+	Visualization::Templatized::Profiler::Profile& getProfile(void) // Returns the extractor's profile
+		{
+		return profile;
+		}
+	#endif
 	};
 
 #endif
@@ -45,6 +45,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include "Visualizer.h"
 #include "ElementList.h"
+#ifdef VISUALIZATION_USE_PROFILING
+#include "ProfileDialog.h"
+#endif
 
 /*********************************
 Methods of class ExtractorLocator:
@@ -79,7 +82,7 @@ void ExtractorLocator::busyFunction(float newCompletionPercentage)
 	}
 
 ExtractorLocator::ExtractorLocator(Vrui::LocatorTool* sLocatorTool,Visualizer* sApplication,Extractor::Algorithm* sExtractor,Misc::ConfigurationFileSection* cfg)
-	:BaseLocator(sLocatorTool,sApplication),Extractor(sExtractor),
+	:BaseLocator(sLocatorTool,sApplication),Extractor(sExtractor,sApplication->elementCache),
 	 settingsDialog(extractor->createSettingsDialog(Vrui::getWidgetManager())),
 	 busyDialog(createBusyDialog(extractor->getName())),
 	 locator(application->dataSet->getLocator()),
@@ -98,6 +101,11 @@ ExtractorLocator::ExtractorLocator(Vrui::LocatorTool* sLocatorTool,Visualizer* s
 		}
 	#endif
 	
+	#ifdef VISUALIZATION_USE_PROFILING
+	/* Register this locator's extractor with the profile dialog: */
+	application->profileDialog->addExtractor(this,extractor->getName());
+	#endif
+	
 	if(settingsDialog!=0)
 		{
 		/* Show the algorithm's settings dialog if it has one: */
@@ -121,6 +129,11 @@ ExtractorLocator::~ExtractorLocator(void)
 		}
 	#endif
 	
+	#ifdef VISUALIZATION_USE_PROFILING
+	/* Keep this locator's extractor profile in the profile dialog: */
+	application->profileDialog->removeExtractor(this);
+	#endif
+	
 	/* Delete the locator: */
 	delete locator;
 	
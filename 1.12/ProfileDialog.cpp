@@ -0,0 +1,257 @@
+/***********************************************************************
+ProfileDialog - Class to display the profiling counters and timers
+aggregated by all extractors, and to save them to a file.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include "ProfileDialog.h"
+
+#include <stdio.h>
+#include <stdexcept>
+#include <iostream>
+#include <Misc/File.h>
+#include <Misc/CreateNumberedFileName.h>
+#include <GLMotif/PopupWindow.h>
+#include <GLMotif/RowColumn.h>
+#include <GLMotif/Separator.h>
+#include <GLMotif/Label.h>
+#include <GLMotif/TextField.h>
+#include <GLMotif/Button.h>
+#include <GLMotif/ScrolledListBox.h>
+#include <Vrui/Vrui.h>
+
+#include "Extractor.h"
+
+/******************************
+Methods of class ProfileDialog:
+******************************/
+
+ProfileDialog::Profiler::Counters ProfileDialog::getTotals(const ProfileDialog::ListEntry& entry) const
+	{
+	/* Query live extractors; destroyed extractors left their last totals: */
+	if(entry.extractor!=0)
+		return entry.extractor->getProfile().getTotals();
+	else
+		return entry.finalTotals;
+	}
+
+void ProfileDialog::extractorListValueChangedCallback(GLMotif::ListBox::ValueChangedCallbackData* cbData)
+	{
+	/* Show the newly selected extractor's profile: */
+	update();
+	}
+
+void ProfileDialog::resetProfileSelectedCallback(Misc::CallbackData* cbData)
+	{
+	int selectedEntryIndex=extractorList->getSelectedItem();
+	if(selectedEntryIndex>=0)
+		{
+		/* Reset the selected extractor's profile: */
+		ListEntry& entry=entries[selectedEntryIndex];
+		if(entry.extractor!=0)
+			entry.extractor->getProfile().reset();
+		else
+			entry.finalTotals=Profiler::Counters();
+		
+		/* Update the displayed values: */
+		update();
+		}
+	}
+
+void ProfileDialog::saveProfilesSelectedCallback(Misc::CallbackData* cbData)
+	{
+	if(Vrui::isMaster())
+		{
+		try
+			{
+			/* Save all profiles to a new numbered file: */
+			char profileFileNameBuffer[256];
+			Misc::createNumberedFileName("ExtractorProfiles.csv",4,profileFileNameBuffer);
+			saveProfiles(profileFileNameBuffer);
+			}
+		catch(std::runtime_error err)
+			{
+			std::cerr<<"Caught exception "<<err.what()<<" while saving extractor profiles"<<std::endl;
+			}
+		}
+	}
+
+ProfileDialog::ProfileDialog(GLMotif::WidgetManager* sWidgetManager)
+	:widgetManager(sWidgetManager),
+	 profileDialogPopup(0),extractorList(0)
+	{
+	/* Create the profile dialog window: */
+	profileDialogPopup=new GLMotif::PopupWindow("ProfileDialogPopup",widgetManager,"Extractor Profiles");
+	profileDialogPopup->setResizableFlags(true,true);
+	
+	GLMotif::RowColumn* profileDialog=new GLMotif::RowColumn("ProfileDialog",profileDialogPopup,false);
+	profileDialog->setOrientation(GLMotif::RowColumn::HORIZONTAL);
+	profileDialog->setPacking(GLMotif::RowColumn::PACK_TIGHT);
+	profileDialog->setNumMinorWidgets(1);
+	
+	/* Create a listbox containing all extractors: */
+	GLMotif::ScrolledListBox* scrolledExtractorList=new GLMotif::ScrolledListBox("ScrolledExtractorList",profileDialog,GLMotif::ListBox::ALWAYS_ONE,20,10);
+	scrolledExtractorList->showHorizontalScrollBar(false);
+	extractorList=scrolledExtractorList->getListBox();
+	extractorList->getValueChangedCallbacks().add(this,&ProfileDialog::extractorListValueChangedCallback);
+	
+	profileDialog->setColumnWeight(0,1.0f);
+	
+	/* Create a table of the selected extractor's counters and timers: */
+	GLMotif::RowColumn* valueBox=new GLMotif::RowColumn("ValueBox",profileDialog,false);
+	valueBox->setOrientation(GLMotif::RowColumn::VERTICAL);
+	valueBox->setPacking(GLMotif::RowColumn::PACK_TIGHT);
+	valueBox->setNumMinorWidgets(2);
+	
+	for(int i=0;i<Profiler::NUM_COUNTERS;++i)
+		{
+		char widgetName[40];
+		snprintf(widgetName,sizeof(widgetName),"CounterLabel%d",i);
+		new GLMotif::Label(widgetName,valueBox,Profiler::getCounterName(i));
+		snprintf(widgetName,sizeof(widgetName),"CounterValue%d",i);
+		counterValues[i]=new GLMotif::TextField(widgetName,valueBox,14);
+		}
+	for(int i=0;i<Profiler::NUM_TIMERS;++i)
+		{
+		char widgetName[40];
+		snprintf(widgetName,sizeof(widgetName),"TimerLabel%d",i);
+		char labelText[80];
+		snprintf(labelText,sizeof(labelText),"%s (ms)",Profiler::getTimerName(i));
+		new GLMotif::Label(widgetName,valueBox,labelText);
+		snprintf(widgetName,sizeof(widgetName),"TimerValue%d",i);
+		timerValues[i]=new GLMotif::TextField(widgetName,valueBox,14);
+		}
+	
+	new GLMotif::Separator("Separator1",valueBox,GLMotif::Separator::HORIZONTAL,0.0f,GLMotif::Separator::LOWERED);
+	new GLMotif::Separator("Separator2",valueBox,GLMotif::Separator::HORIZONTAL,0.0f,GLMotif::Separator::LOWERED);
+	
+	GLMotif::Button* resetProfileButton=new GLMotif::Button("ResetProfileButton",valueBox,"Reset");
+	resetProfileButton->getSelectCallbacks().add(this,&ProfileDialog::resetProfileSelectedCallback);
+	
+	GLMotif::Button* saveProfilesButton=new GLMotif::Button("SaveProfilesButton",valueBox,"Save All");
+	saveProfilesButton->getSelectCallbacks().add(this,&ProfileDialog::saveProfilesSelectedCallback);
+	
+	valueBox->manageChild();
+	
+	profileDialog->manageChild();
+	
+	/* Clear the value displays: */
+	update();
+	}
+
+ProfileDialog::~ProfileDialog(void)
+	{
+	/* Delete the profile dialog: */
+	delete profileDialogPopup;
+	}
+
+void ProfileDialog::addExtractor(Extractor* newExtractor,const char* extractorName)
+	{
+	/* Add the extractor to the list and select it: */
+	ListEntry le;
+	le.extractor=newExtractor;
+	le.name=extractorName;
+	entries.push_back(le);
+	extractorList->selectItem(extractorList->addItem(extractorName),true);
+	
+	/* Update the displayed values: */
+	update();
+	}
+
+void ProfileDialog::removeExtractor(Extractor* extractor)
+	{
+	/* Find the extractor's entry and keep its final totals: */
+	for(ListEntryList::iterator leIt=entries.begin();leIt!=entries.end();++leIt)
+		if(leIt->extractor==extractor)
+			{
+			leIt->finalTotals=extractor->getProfile().getTotals();
+			leIt->extractor=0;
+			break;
+			}
+	}
+
+void ProfileDialog::update(void)
+	{
+	int selectedEntryIndex=extractorList->getSelectedItem();
+	if(selectedEntryIndex>=0)
+		{
+		/* Display the selected extractor's counters and timers: */
+		Profiler::Counters totals=getTotals(entries[selectedEntryIndex]);
+		for(int i=0;i<Profiler::NUM_COUNTERS;++i)
+			{
+			char valueText[40];
+			snprintf(valueText,sizeof(valueText),"%.0f",double(totals.counts[i]));
+			counterValues[i]->setString(valueText);
+			}
+		for(int i=0;i<Profiler::NUM_TIMERS;++i)
+			{
+			char valueText[40];
+			snprintf(valueText,sizeof(valueText),"%.3f",totals.times[i]*1000.0);
+			timerValues[i]->setString(valueText);
+			}
+		}
+	else
+		{
+		/* Clear the value displays: */
+		for(int i=0;i<Profiler::NUM_COUNTERS;++i)
+			counterValues[i]->setString("");
+		for(int i=0;i<Profiler::NUM_TIMERS;++i)
+			timerValues[i]->setString("");
+		}
+	}
+
+void ProfileDialog::saveProfiles(const char* profileFileName) const
+	{
+	/* Create the profile file: */
+	Misc::File profileFile(profileFileName,"wt");
+	
+	/* Write the header line: */
+	profileFile.puts("extractor");
+	for(int i=0;i<Profiler::NUM_COUNTERS;++i)
+		{
+		profileFile.puts(",");
+		profileFile.puts(Profiler::getCounterName(i));
+		}
+	for(int i=0;i<Profiler::NUM_TIMERS;++i)
+		{
+		profileFile.puts(",");
+		profileFile.puts(Profiler::getTimerName(i));
+		profileFile.puts(" (ms)");
+		}
+	profileFile.puts("\n");
+	
+	/* Write one line per extractor: */
+	for(ListEntryList::const_iterator leIt=entries.begin();leIt!=entries.end();++leIt)
+		{
+		Profiler::Counters totals=getTotals(*leIt);
+		profileFile.puts(leIt->name.c_str());
+		char valueText[40];
+		for(int i=0;i<Profiler::NUM_COUNTERS;++i)
+			{
+			snprintf(valueText,sizeof(valueText),",%.0f",double(totals.counts[i]));
+			profileFile.puts(valueText);
+			}
+		for(int i=0;i<Profiler::NUM_TIMERS;++i)
+			{
+			snprintf(valueText,sizeof(valueText),",%.3f",totals.times[i]*1000.0);
+			profileFile.puts(valueText);
+			}
+		profileFile.puts("\n");
+		}
+	}
@@ -0,0 +1,92 @@
+/***********************************************************************
+ProfileDialog - Class to display the profiling counters and timers
+aggregated by all extractors, and to save them to a file.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef PROFILEDIALOG_INCLUDED
+#define PROFILEDIALOG_INCLUDED
+
+#include <string>
+#include <vector>
+#include <GLMotif/WidgetManager.h>
+#include <GLMotif/ListBox.h>
+
+#include <Templatized/Profiler.h>
+
+/* Forward declarations: */
+namespace Misc {
+class CallbackData;
+}
+namespace GLMotif {
+class PopupWindow;
+class TextField;
+}
+class Extractor;
+
+class ProfileDialog
+	{
+	/* Embedded classes: */
+	public:
+	typedef Visualization::Templatized::Profiler Profiler;
+	
+	private:
+	struct ListEntry // Structure storing the profile of an extractor
+		{
+		/* Elements: */
+		public:
+		Extractor* extractor; // Pointer to the extractor, or 0 if the extractor was already destroyed
+		std::string name; // Name of the extractor's algorithm
+		Profiler::Counters finalTotals; // Totals of the extractor's profile at the time it was destroyed
+		};
+	
+	typedef std::vector<ListEntry> ListEntryList;
+	
+	/* Elements: */
+	private:
+	ListEntryList entries; // List of current and destroyed extractors
+	GLMotif::WidgetManager* widgetManager; // Pointer to the widget manager
+	GLMotif::PopupWindow* profileDialogPopup; // Dialog showing the profile of the selected extractor
+	GLMotif::ListBox* extractorList; // List box widget containing the names of all extractors
+	GLMotif::TextField* counterValues[Profiler::NUM_COUNTERS]; // Text fields displaying the selected extractor's counters
+	GLMotif::TextField* timerValues[Profiler::NUM_TIMERS]; // Text fields displaying the selected extractor's timers in milliseconds
+	
+	/* Private methods: */
+	Profiler::Counters getTotals(const ListEntry& entry) const; // Returns the current totals of the given entry's profile
+	void extractorListValueChangedCallback(GLMotif::ListBox::ValueChangedCallbackData* cbData);
+	void resetProfileSelectedCallback(Misc::CallbackData* cbData);
+	void saveProfilesSelectedCallback(Misc::CallbackData* cbData);
+	
+	/* Constructors and destructors: */
+	public:
+	ProfileDialog(GLMotif::WidgetManager* sWidgetManager); // Creates an empty profile dialog
+	~ProfileDialog(void); // Destroys the profile dialog
+	
+	/* Methods: */
+	void addExtractor(Extractor* newExtractor,const char* extractorName); // Adds a new extractor to the list
+	void removeExtractor(Extractor* extractor); // Keeps the current totals of an extractor that is about to be destroyed
+	void update(void); // Updates the displayed counters and timers of the selected extractor
+	void saveProfiles(const char* profileFileName) const; // Saves the profiles of all extractors to the given text file as comma-separated values
+	GLMotif::PopupWindow* getProfileDialog(void) // Returns the profile dialog
+		{
+		return profileDialogPopup;
+		}
+	};
+
+#endif
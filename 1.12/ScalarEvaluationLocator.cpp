@@ -107,6 +107,12 @@ ScalarEvaluationLocator::ScalarEvaluationLocator(Vrui::LocatorTool* sLocatorTool
 
 ScalarEvaluationLocator::~ScalarEvaluationLocator(void)
 	{
+	/* Release the scalar extractor: */
+	if(scalarExtractor!=0)
+		{
+		Visualization::Abstract::VariableManager* vm=application->variableManager;
+		vm->releaseScalarExtractor(vm->getScalarVariable(scalarExtractor));
+		}
 	}
 
 void ScalarEvaluationLocator::storeState(Misc::ConfigurationFileSection& configFileSection) const
@@ -48,8 +48,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 Methods of class SharedVisualizationClient::RemoteLocator:
 *********************************************************/
 
-SharedVisualizationClient::RemoteLocator::RemoteLocator(SharedVisualizationClient::Algorithm* sExtractor)
-	:Extractor(sExtractor)
+SharedVisualizationClient::RemoteLocator::RemoteLocator(SharedVisualizationClient::Algorithm* sExtractor,ElementCache* sElementCache)
+	:Extractor(sExtractor,sElementCache)
 	{
 	}
 
@@ -127,7 +127,7 @@ void SharedVisualizationClient::receiveRemoteLocator(SharedVisualizationClient::
 	if(algorithm!=0)
 		{
 		/* Create a new remote locator and add it to the client's hash table: */
-		RemoteLocator* newRemoteLocator=new RemoteLocator(algorithm);
+		RemoteLocator* newRemoteLocator=new RemoteLocator(algorithm,application->elementCache);
 		{
 		Threads::Mutex::Lock locatorLock(rcs->locatorMutex);
 		rcs->locators.setEntry(RemoteLocatorHash::Entry(newLocatorID,newRemoteLocator));
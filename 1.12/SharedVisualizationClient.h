@@ -58,7 +58,7 @@ class SharedVisualizationClient:public Collaboration::ProtocolClient,private Sha
 		{
 		/* Constructors and destructors: */
 		public:
-		RemoteLocator(Algorithm* sExtractor); // Creates a remote locator for the given algorithm
+		RemoteLocator(Algorithm* sExtractor,ElementCache* sElementCache); // Creates a remote locator for the given algorithm and optional element cache
 		
 		/* Methods from Extractor: */
 		virtual void update(void);
@@ -0,0 +1,192 @@
+/***********************************************************************
+ActiveCellIndex - Generic class to index the cells of a data set by
+their ranges of scalar values in an interval tree, to quickly find all
+cells intersecting an isosurface of arbitrary isovalue.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_ACTIVECELLINDEX_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_ACTIVECELLINDEX_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class DataSetParam,class ScalarExtractorParam>
+class ActiveCellIndex
+	{
+	/* Embedded classes: */
+	public:
+	typedef DataSetParam DataSet; // Type of indexed data set
+	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from the data set
+	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
+	typedef typename DataSet::CellID CellID; // Type of the data set's cell IDs
+	typedef CellID CellBlock; // Type for blocks of active cells; the interval tree reports active cells individually
+	static const bool compact=false; // The interval tree stores two value ranges per non-constant cell
+	
+	private:
+	typedef typename DataSet::CellTopology CellTopology; // Topology of the data set's cells
+	
+	struct Interval // Structure for a cell's range of scalar values during index construction
+		{
+		/* Elements: */
+		public:
+		VScalar min,max; // Minimum and maximum scalar value of the cell's vertices
+		CellID cellID; // ID of the cell
+		};
+	
+	class MidLess // Functor class to order intervals by their midpoints
+		{
+		/* Methods: */
+		public:
+		bool operator()(const Interval& i1,const Interval& i2) const
+			{
+			return i1.min+i1.max<i2.min+i2.max;
+			}
+		};
+	
+	class MaxBelow // Functor class to select intervals entirely below a split value
+		{
+		/* Elements: */
+		private:
+		VScalar split; // The split value
+		
+		/* Constructors and destructors: */
+		public:
+		MaxBelow(VScalar sSplit)
+			:split(sSplit)
+			{
+			}
+		
+		/* Methods: */
+		bool operator()(const Interval& i) const
+			{
+			return i.max<split;
+			}
+		};
+	
+	class MinAtOrBelow // Functor class to select intervals not entirely above a split value
+		{
+		/* Elements: */
+		private:
+		VScalar split; // The split value
+		
+		/* Constructors and destructors: */
+		public:
+		MinAtOrBelow(VScalar sSplit)
+			:split(sSplit)
+			{
+			}
+		
+		/* Methods: */
+		bool operator()(const Interval& i) const
+			{
+			return i.min<=split;
+			}
+		};
+	
+	struct Entry // Structure for an interval end point stored in a tree node
+		{
+		/* Elements: */
+		public:
+		VScalar value; // The end point's scalar value
+		CellID cellID; // ID of the cell whose interval the end point belongs to
+		};
+	
+	class EntryLess // Functor class to sort entries by ascending value
+		{
+		/* Methods: */
+		public:
+		bool operator()(const Entry& e1,const Entry& e2) const
+			{
+			return e1.value<e2.value;
+			}
+		};
+	
+	class EntryGreater // Functor class to sort entries by descending value
+		{
+		/* Methods: */
+		public:
+		bool operator()(const Entry& e1,const Entry& e2) const
+			{
+			return e1.value>e2.value;
+			}
+		};
+	
+	struct Node // Structure for interval tree nodes
+		{
+		/* Elements: */
+		public:
+		VScalar split; // Node's split value; node stores all intervals containing the split value
+		size_t firstEntry; // Index of the node's first entry in the entry arrays
+		size_t numEntries; // Number of entries stored in the node
+		size_t children[2]; // Indices of the node's children for intervals entirely below and entirely above the split value; 0 if there is no child
+		};
+	
+	/* Elements: */
+	size_t numCells; // Number of indexed cells
+	std::vector<Node> nodes; // Array of interval tree nodes; first node is the root
+	std::vector<Entry> minEntries; // Array of interval minima, sorted by ascending value inside each node
+	std::vector<Entry> maxEntries; // Array of interval maxima, sorted by descending value inside each node
+	
+	/* Private methods: */
+	size_t buildTree(Interval* intervalsBegin,Interval* intervalsEnd); // Creates a subtree for the given range of intervals; returns index of subtree's root
+	
+	/* Constructors and destructors: */
+	public:
+	ActiveCellIndex(const DataSet& dataSet,const ScalarExtractor& scalarExtractor); // Indexes all cells of the given data set by their ranges of scalar values extracted by the given scalar extractor
+	private:
+	ActiveCellIndex(const ActiveCellIndex& source); // Prohibit copy constructor
+	ActiveCellIndex& operator=(const ActiveCellIndex& source); // Prohibit assignment operator
+	
+	/* Methods: */
+	public:
+	size_t getNumCells(void) const // Returns the number of indexed cells; cells with constant scalar values are never active and not indexed
+		{
+		return numCells;
+		}
+	size_t getMemorySize(void) const; // Returns the number of bytes of memory used by the index
+	void getActiveCells(VScalar isovalue,std::vector<CellID>& activeCells) const; // Appends the IDs of all cells intersecting the isosurface of the given isovalue to the given vector
+	void getActiveBlocks(VScalar isovalue,std::vector<CellBlock>& activeBlocks) const // Appends all blocks of cells intersecting the isosurface of the given isovalue to the given vector
+		{
+		getActiveCells(isovalue,activeBlocks);
+		}
+	size_t getNumBlockCells(const CellBlock& block) const // Returns the number of cells in the given block
+		{
+		return 1;
+		}
+	template <class CellFunctorParam>
+	void processBlockCells(const DataSet& dataSet,const CellBlock& block,CellFunctorParam& cellFunctor) const // Calls the given functor for all cells of the given block of the given data set
+		{
+		cellFunctor(dataSet.getCell(block));
+		}
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_ACTIVECELLINDEX_IMPLEMENTATION
+#include <Templatized/ActiveCellIndex.icpp>
+#endif
+
+#endif
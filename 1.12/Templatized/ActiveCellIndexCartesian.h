@@ -0,0 +1,137 @@
+/***********************************************************************
+ActiveCellIndexCartesian - Specialized active cell index class for
+Cartesian data sets, using a pyramid of value ranges of bricks of cells
+to skip empty space.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_ACTIVECELLINDEXCARTESIAN_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_ACTIVECELLINDEXCARTESIAN_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+#include <Misc/Array.h>
+
+#include <Templatized/ActiveCellIndex.h>
+
+/* Forward declarations: */
+namespace Visualization {
+namespace Templatized {
+template <class ScalarParam,int dimensionParam,class ValueParam>
+class Cartesian;
+}
+}
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class ScalarParam,int dimensionParam,class ValueParam,class ScalarExtractorParam>
+class ActiveCellIndex<Cartesian<ScalarParam,dimensionParam,ValueParam>,ScalarExtractorParam>
+	{
+	/* Embedded classes: */
+	public:
+	typedef Cartesian<ScalarParam,dimensionParam,ValueParam> DataSet; // Type of indexed data set
+	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from the data set
+	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
+	typedef typename DataSet::CellID CellID; // Type of the data set's cell IDs
+	static const bool compact=true; // The pyramid only stores one value range per brick of cells
+	static const int brickSize=8; // Number of cells along each dimension of the bricks on the finest pyramid level
+	
+	typedef typename DataSet::Index Index; // Type for array indices
+	
+	struct CellBlock // Structure for a box of cells inside an active brick
+		{
+		/* Elements: */
+		public:
+		Index begin,end; // Index of the box's first cell, and index one behind its last cell along each dimension
+		};
+	
+	private:
+
+	struct ValueRange // Structure for the range of scalar values inside a brick
+		{
+		/* Elements: */
+		public:
+		VScalar min,max; // Minimum and maximum scalar value of all vertices of the brick
+		};
+	
+	typedef Misc::Array<ValueRange,dimensionParam> Level; // Type for pyramid levels
+	
+	/* Elements: */
+	const DataSet& dataSet; // The indexed data set
+	int numLevels; // Number of levels in the pyramid
+	Level* levels; // Array of pyramid levels, from bricks of cells on level 0 up to the single brick covering the entire data set
+	size_t numCells; // Number of cells in bricks that are not of constant value
+	
+	/* Private methods: */
+	void collectActiveBlocks(int level,const Index& brickIndex,VScalar isovalue,std::vector<CellBlock>& activeBlocks) const; // Appends the cell boxes of all active bricks below the given brick
+	
+	/* Constructors and destructors: */
+	public:
+	ActiveCellIndex(const DataSet& sDataSet,const ScalarExtractor& scalarExtractor); // Creates a pyramid of value ranges of the given data set's bricks for the given scalar extractor
+	private:
+	ActiveCellIndex(const ActiveCellIndex& source); // Prohibit copy constructor
+	ActiveCellIndex& operator=(const ActiveCellIndex& source); // Prohibit assignment operator
+	public:
+	~ActiveCellIndex(void); // Destroys the pyramid
+	
+	/* Methods: */
+	int getNumLevels(void) const // Returns the number of levels in the pyramid
+		{
+		return numLevels;
+		}
+	Index getNumBricks(int level) const // Returns the number of bricks on the given pyramid level
+		{
+		return levels[level].getSize();
+		}
+	VScalar getBrickMin(int level,const Index& brickIndex) const // Returns the minimum scalar value inside the given brick on the given pyramid level
+		{
+		return levels[level](brickIndex).min;
+		}
+	VScalar getBrickMax(int level,const Index& brickIndex) const // Returns the maximum scalar value inside the given brick on the given pyramid level
+		{
+		return levels[level](brickIndex).max;
+		}
+	size_t getNumCells(void) const // Returns the number of cells in bricks that are not of constant value
+		{
+		return numCells;
+		}
+	size_t getMemorySize(void) const; // Returns the number of bytes of memory used by the pyramid
+	void getActiveBlocks(VScalar isovalue,std::vector<CellBlock>& activeBlocks) const; // Appends the cell boxes of all bricks intersecting the isosurface of the given isovalue to the given vector
+	size_t getNumBlockCells(const CellBlock& block) const // Returns the number of cells in the given block
+		{
+		size_t result=1;
+		for(int i=0;i<dimensionParam;++i)
+			result*=size_t(block.end[i]-block.begin[i]);
+		return result;
+		}
+	template <class CellFunctorParam>
+	void processBlockCells(const DataSet& dataSet,const CellBlock& block,CellFunctorParam& cellFunctor) const; // Calls the given functor for all cells of the given block of the given data set
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_ACTIVECELLINDEXCARTESIAN_IMPLEMENTATION
+#include <Templatized/ActiveCellIndexCartesian.icpp>
+#endif
+
+#endif
@@ -0,0 +1,267 @@
+/***********************************************************************
+BrickFile - Helper class to split a raw volume file into fixed-size
+bricks of vertex values with a one-vertex ghost layer, and to read
+individual bricks back from the resulting brick file on demand.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Templatized/BrickFile.h>
+
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdexcept>
+#include <Misc/ThrowStdErr.h>
+#include <Misc/File.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+namespace {
+
+/**************
+Helper objects:
+**************/
+
+const char brickFileHeader[]="Visualizer brick file v1.0"; // Identifier at the beginning of brick files
+const unsigned int endiannessMarker=0x01020304U; // Marker to reject brick files written on machines of different endianness
+
+/**************
+Helper methods:
+**************/
+
+template <class ValueParam>
+inline
+void appendToHeader(std::vector<char>& header,const ValueParam& value)
+	{
+	const char* vPtr=reinterpret_cast<const char*>(&value);
+	header.insert(header.end(),vPtr,vPtr+sizeof(ValueParam));
+	}
+
+bool readFully(int fd,void* buffer,size_t size,off_t offset)
+	{
+	/* Read until the buffer is full, the file ends, or an error occurs: */
+	char* bufPtr=static_cast<char*>(buffer);
+	while(size>0)
+		{
+		ssize_t readSize=pread(fd,bufPtr,size,offset);
+		if(readSize<=0)
+			return false;
+		bufPtr+=readSize;
+		size-=size_t(readSize);
+		offset+=off_t(readSize);
+		}
+	return true;
+	}
+
+inline int clampIndex(int index,int size)
+	{
+	return index<0?0:index>=size?size-1:index;
+	}
+
+}
+
+/**************************
+Methods of class BrickFile:
+**************************/
+
+bool BrickFile::open(void)
+	{
+	/* Open the brick file: */
+	fd=::open(brickFileName.c_str(),O_RDONLY);
+	if(fd<0)
+		return false;
+	
+	/* Check the brick file's header and size: */
+	bool valid=false;
+	struct stat brickFileStats;
+	size_t totalNumBricks=1;
+	for(size_t i=0;i<numBricks.size();++i)
+		totalNumBricks*=size_t(numBricks[i]);
+	if(fstat(fd,&brickFileStats)==0&&size_t(brickFileStats.st_size)>=header.size()+totalNumBricks*brickDataSize)
+		{
+		std::vector<char> fileHeader(header.size());
+		valid=readFully(fd,&fileHeader[0],header.size(),0)&&memcmp(&fileHeader[0],&header[0],header.size())==0;
+		}
+	
+	if(!valid)
+		{
+		/* Close the stale brick file: */
+		close(fd);
+		fd=-1;
+		}
+	
+	return valid;
+	}
+
+void BrickFile::create(const std::string& rawFileName) const
+	{
+	/* Open the raw volume file: */
+	int rawFd=::open(rawFileName.c_str(),O_RDONLY);
+	if(rawFd<0)
+		Misc::throwStdErr("BrickFile::create: Could not open raw volume file %s",rawFileName.c_str());
+	
+	/* Create a temporary brick file to not clobber the current one until the new one is complete: */
+	std::string tempFileName=brickFileName+".tmp";
+	try
+		{
+		Misc::File brickFile(tempFileName.c_str(),"wb");
+		brickFile.write<char>(&header[0],header.size());
+		
+		/* Calculate the layout of a column of bricks along the last dimension: */
+		int outerDimension=int(numVertices.size())-1;
+		int side=brickSize+3;
+		size_t rowSize=size_t(numVertices[outerDimension])*valueSize;
+		size_t numRows=1;
+		for(int i=0;i<outerDimension;++i)
+			numRows*=size_t(side);
+		std::vector<char> column(numRows*rowSize);
+		std::vector<char> brick(brickDataSize);
+		
+		/* Process all columns of bricks in brick file order: */
+		std::vector<int> columnIndex(outerDimension+1,0);
+		while(true)
+			{
+			/* Read all raw rows overlapping the current column of bricks, including the ghost layer: */
+			for(size_t row=0;row<numRows;++row)
+				{
+				size_t rowIndex=row;
+				size_t rawRow=0;
+				size_t rawRowStride=1;
+				for(int i=outerDimension-1;i>=0;--i)
+					{
+					int vertex=clampIndex(columnIndex[i]*brickSize-1+int(rowIndex%side),numVertices[i]);
+					rowIndex/=side;
+					rawRow+=size_t(vertex)*rawRowStride;
+					rawRowStride*=size_t(numVertices[i]);
+					}
+				if(!readFully(rawFd,&column[row*rowSize],rowSize,off_t(rawRow*rowSize)))
+					Misc::throwStdErr("BrickFile::create: Raw volume file %s is truncated",rawFileName.c_str());
+				}
+			
+			/* Assemble and write all bricks of the column: */
+			for(int b=0;b<numBricks[outerDimension];++b)
+				{
+				char* bPtr=&brick[0];
+				for(size_t row=0;row<numRows;++row)
+					{
+					const char* rowPtr=&column[row*rowSize];
+					for(int j=0;j<side;++j,bPtr+=valueSize)
+						memcpy(bPtr,rowPtr+size_t(clampIndex(b*brickSize-1+j,numVertices[outerDimension]))*valueSize,valueSize);
+					}
+				brickFile.write<char>(&brick[0],brickDataSize);
+				}
+			
+			/* Go to the next column of bricks: */
+			int i;
+			for(i=outerDimension-1;i>=0;--i)
+				{
+				if(++columnIndex[i]<numBricks[i])
+					break;
+				columnIndex[i]=0;
+				}
+			if(i<0)
+				break;
+			}
+		}
+	catch(std::runtime_error err)
+		{
+		/* Remove the incomplete brick file: */
+		close(rawFd);
+		unlink(tempFileName.c_str());
+		throw;
+		}
+	close(rawFd);
+	
+	/* Move the new brick file into place: */
+	if(rename(tempFileName.c_str(),brickFileName.c_str())!=0)
+		{
+		unlink(tempFileName.c_str());
+		Misc::throwStdErr("BrickFile::create: Could not replace brick file %s",brickFileName.c_str());
+		}
+	}
+
+BrickFile::BrickFile(const std::string& sBrickFileName,const std::string& rawFileName,size_t sValueSize,int dimension,const int sNumVertices[],int sBrickSize)
+	:brickFileName(sBrickFileName),
+	 valueSize(sValueSize),
+	 numVertices(sNumVertices,sNumVertices+dimension),
+	 brickSize(sBrickSize),
+	 numBricks(dimension),
+	 brickDataSize(sValueSize),
+	 fd(-1)
+	{
+	/* Calculate the brick layout: */
+	if(brickSize<1)
+		Misc::throwStdErr("BrickFile::BrickFile: Invalid brick size %d",brickSize);
+	for(int i=0;i<dimension;++i)
+		{
+		if(numVertices[i]<2)
+			Misc::throwStdErr("BrickFile::BrickFile: Volume has fewer than two vertices in dimension %d",i);
+		numBricks[i]=(numVertices[i]-2)/brickSize+1;
+		brickDataSize*=size_t(brickSize+3);
+		}
+	
+	/* Get the raw volume file's size and modification time: */
+	struct stat rawFileStats;
+	if(stat(rawFileName.c_str(),&rawFileStats)!=0)
+		Misc::throwStdErr("BrickFile::BrickFile: Could not access raw volume file %s",rawFileName.c_str());
+	size_t rawSize=valueSize;
+	for(int i=0;i<dimension;++i)
+		rawSize*=size_t(numVertices[i]);
+	if(size_t(rawFileStats.st_size)<rawSize)
+		Misc::throwStdErr("BrickFile::BrickFile: Raw volume file %s is truncated",rawFileName.c_str());
+	
+	/* Assemble the expected brick file header: */
+	header.insert(header.end(),brickFileHeader,brickFileHeader+sizeof(brickFileHeader));
+	appendToHeader(header,endiannessMarker);
+	appendToHeader(header,(unsigned int)valueSize);
+	appendToHeader(header,dimension);
+	for(int i=0;i<dimension;++i)
+		appendToHeader(header,numVertices[i]);
+	appendToHeader(header,brickSize);
+	appendToHeader(header,double(rawFileStats.st_size));
+	appendToHeader(header,double(rawFileStats.st_mtime));
+	
+	/* Open the brick file, or (re-)create it from the raw volume file if it is stale: */
+	if(!open())
+		{
+		create(rawFileName);
+		if(!open())
+			Misc::throwStdErr("BrickFile::BrickFile: Could not open brick file %s",brickFileName.c_str());
+		}
+	}
+
+BrickFile::~BrickFile(void)
+	{
+	close(fd);
+	}
+
+void BrickFile::readBrick(size_t brickIndex,void* brickData) const
+	{
+	if(!readFully(fd,brickData,brickDataSize,off_t(header.size()+brickIndex*brickDataSize)))
+		Misc::throwStdErr("BrickFile::readBrick: Could not read brick %u from brick file %s",(unsigned int)brickIndex,brickFileName.c_str());
+	}
+
+}
+
+}
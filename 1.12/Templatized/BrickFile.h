@@ -0,0 +1,81 @@
+/***********************************************************************
+BrickFile - Helper class to split a raw volume file into fixed-size
+bricks of vertex values with a one-vertex ghost layer, and to read
+individual bricks back from the resulting brick file on demand.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_BRICKFILE_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_BRICKFILE_INCLUDED
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace Visualization {
+
+namespace Templatized {
+
+class BrickFile
+	{
+	/* Elements: */
+	private:
+	std::string brickFileName; // Name of the brick file
+	size_t valueSize; // Size of a single vertex value in bytes
+	std::vector<int> numVertices; // Number of vertices of the volume in each dimension
+	int brickSize; // Number of cells covered by a brick in each dimension
+	std::vector<int> numBricks; // Number of bricks in each dimension
+	size_t brickDataSize; // Size of a brick's vertex values including the ghost layer in bytes
+	std::vector<char> header; // Expected contents of the brick file's header
+	int fd; // File descriptor of the opened brick file
+	
+	/* Private methods: */
+	bool open(void); // Opens the brick file and returns true if its header matches the expected header
+	void create(const std::string& rawFileName) const; // Creates the brick file from the given raw volume file
+	
+	/* Constructors and destructors: */
+	public:
+	BrickFile(const std::string& sBrickFileName,const std::string& rawFileName,size_t sValueSize,int dimension,const int sNumVertices[],int sBrickSize); // Opens the given brick file for a raw volume file of vertex values laid out with the last dimension varying fastest; (re-)creates the brick file if it is missing, was created with different parameters, or does not match the raw file's current size and modification time
+	private:
+	BrickFile(const BrickFile& source); // Prohibit copy constructor
+	BrickFile& operator=(const BrickFile& source); // Prohibit assignment operator
+	public:
+	~BrickFile(void); // Closes the brick file
+	
+	/* Methods: */
+	int getBrickSize(void) const // Returns the number of cells covered by a brick in each dimension
+		{
+		return brickSize;
+		}
+	int getNumBricks(int dimension) const // Returns the number of bricks in the given dimension
+		{
+		return numBricks[dimension];
+		}
+	size_t getBrickDataSize(void) const // Returns the size of a brick's vertex values in bytes
+		{
+		return brickDataSize;
+		}
+	void readBrick(size_t brickIndex,void* brickData) const; // Reads the vertex values of the brick of the given linear index; can be called concurrently
+	};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,471 @@
+/***********************************************************************
+BrickedCartesian - Base class for out-of-core data sets containing
+Cartesian grids of vertex values stored as bricks in a file, which are
+faulted into a least-recently-used brick cache of bounded size on
+demand.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_BRICKEDCARTESIAN_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_BRICKEDCARTESIAN_INCLUDED
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include <Misc/ArrayIndex.h>
+#include <Threads/Mutex.h>
+#include <Geometry/ComponentArray.h>
+#include <Geometry/Point.h>
+#include <Geometry/Vector.h>
+#include <Geometry/Box.h>
+
+#include <Templatized/Tesseract.h>
+#include <Templatized/WideLinearIndexID.h>
+#include <Templatized/IteratorWrapper.h>
+
+/* Forward declarations: */
+namespace Visualization {
+namespace Templatized {
+class BrickFile;
+}
+}
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class ScalarParam,int dimensionParam,class ValueParam>
+class BrickedCartesian
+	{
+	/* Embedded classes: */
+	public:
+	
+	/* Definition of the data set's domain space: */
+	typedef ScalarParam Scalar; // Scalar type of data set's domain
+	static const int dimension=dimensionParam; // Dimension of data set's domain
+	typedef Geometry::Point<Scalar,dimensionParam> Point; // Type for points in data set's domain
+	typedef Geometry::Vector<Scalar,dimensionParam> Vector; // Type for vectors in data set's domain
+	typedef Geometry::ComponentArray<Scalar,dimensionParam> Size; // Type for sizes in data set's domain
+	typedef Geometry::Box<Scalar,dimensionParam> Box; // Type for axis-aligned boxes in data set's domain
+	
+	/* Definition of the data set's cell topology: */
+	typedef Tesseract<dimensionParam> CellTopology; // Policy class to select appropriate cell algorithms
+	
+	/* Definition of the data set's value space: */
+	typedef ValueParam Value; // Data set's value type
+	
+	/* Low-level definitions of data set storage: */
+	typedef Misc::ArrayIndex<dimensionParam> Index; // Index type for vertices, cells, and bricks
+	
+	/* Data set interface classes: */
+	private:
+	struct CachedBrick; // Structure for a brick of vertex values in the brick cache
+	
+	public:
+	typedef WideLinearIndexID VertexID; // Class to identify vertices
+	
+	class Vertex // Class to represent and iterate through vertices; iterates brick by brick to keep the brick cache coherent
+		{
+		friend class BrickedCartesian;
+		
+		/* Elements: */
+		private:
+		const BrickedCartesian* ds; // Pointer to data set containing the vertex
+		Index index; // Index of vertex in data set's grid
+		
+		/* Constructors and destructors: */
+		public:
+		Vertex(void) // Creates an invalid vertex
+			:ds(0)
+			{
+			}
+		private:
+		Vertex(const BrickedCartesian* sDs,const Index& sIndex)
+			:ds(sDs),index(sIndex)
+			{
+			}
+		
+		/* Methods: */
+		public:
+		Point getPosition(void) const; // Returns vertex' position in domain
+		template <class ValueExtractorParam>
+		typename ValueExtractorParam::DestValue getValue(const ValueExtractorParam& extractor) const // Returns vertex' value based on given extractor
+			{
+			return extractor.getValue(ds->getVertexValue(index));
+			}
+		template <class ScalarExtractorParam>
+		Vector calcGradient(const ScalarExtractorParam& extractor) const // Returns gradient at the vertex, based on given scalar extractor
+			{
+			return ds->calcVertexGradient(index,extractor);
+			}
+		VertexID getID(void) const // Returns vertex' ID
+			{
+			return VertexID(ds->calcVertexLinearIndex(index));
+			}
+		
+		/* Iterator methods: */
+		friend bool operator==(const Vertex& v1,const Vertex& v2)
+			{
+			return v1.index==v2.index&&v1.ds==v2.ds;
+			}
+		friend bool operator!=(const Vertex& v1,const Vertex& v2)
+			{
+			return v1.index!=v2.index||v1.ds!=v2.ds;
+			}
+		Vertex& operator++(void) // Pre-increment operator
+			{
+			ds->advanceVertexIndex(index);
+			return *this;
+			}
+		};
+	
+	typedef IteratorWrapper<Vertex> VertexIterator; // Class to iterate through vertices
+	
+	typedef WideLinearIndexID EdgeID; // Class to identify cell edges
+	
+	typedef WideLinearIndexID CellID; // Class to identify cells; cell IDs enumerate cells brick by brick
+	
+	class Locator;
+	
+	class Cell // Class to represent and iterate through cells; iterates brick by brick to keep the brick cache coherent
+		{
+		friend class BrickedCartesian;
+		friend class Locator;
+		
+		/* Elements: */
+		private:
+		const BrickedCartesian* ds; // Pointer to the data set containing the cell
+		Index index; // Index of cell's base vertex in data set's grid
+		mutable CachedBrick* brick; // Brick containing the cell, pinned in the brick cache while the cell accesses its vertices, or 0
+		mutable const Value* baseVertex; // Pointer to the cell's base vertex inside the pinned brick, or 0 if not yet located
+		
+		/* Private methods: */
+		const Value* getBaseVertex(void) const // Returns a pointer to the cell's base vertex inside its brick, pinning the brick on first access
+			{
+			if(baseVertex==0)
+				baseVertex=ds->pinCellBrick(index,brick);
+			return baseVertex;
+			}
+		void unpinBrick(void) const // Releases the cell's pinned brick
+			{
+			baseVertex=0;
+			if(brick!=0)
+				{
+				ds->unpinBrick(brick);
+				brick=0;
+				}
+			}
+		
+		/* Constructors and destructors: */
+		public:
+		Cell(void) // Creates an invalid cell
+			:ds(0),brick(0),baseVertex(0)
+			{
+			}
+		Cell(const Cell& source) // Copies a cell; the copy pins its brick separately
+			:ds(source.ds),index(source.index),brick(0),baseVertex(0)
+			{
+			}
+		private:
+		Cell(const BrickedCartesian* sDs)
+			:ds(sDs),index(-1),brick(0),baseVertex(0)
+			{
+			}
+		Cell(const BrickedCartesian* sDs,const Index& sIndex)
+			:ds(sDs),index(sIndex),brick(0),baseVertex(0)
+			{
+			}
+		public:
+		~Cell(void)
+			{
+			unpinBrick();
+			}
+		
+		
+		/* Methods: */
+		Cell& operator=(const Cell& source) // Assigns a cell; the cell releases its pinned brick
+			{
+			if(this!=&source)
+				{
+				unpinBrick();
+				ds=source.ds;
+				index=source.index;
+				}
+			return *this;
+			}
+		bool isValid(void) const // Returns true if the cell is valid
+			{
+			return ds!=0&&index[0]>=0;
+			}
+		VertexID getVertexID(int vertexIndex) const; // Returns ID of given vertex of the cell
+		Vertex getVertex(int vertexIndex) const; // Returns the given vertex of the cell
+		Point getVertexPosition(int vertexIndex) const; // Returns position of given vertex of the cell
+		template <class ValueExtractorParam>
+		typename ValueExtractorParam::DestValue getVertexValue(int vertexIndex,const ValueExtractorParam& extractor) const // Returns value of given vertex of the cell, based on given extractor
+			{
+			return extractor.getValue(getBaseVertex()[ds->vertexOffsets[vertexIndex]]);
+			}
+		template <class ScalarExtractorParam>
+		Vector calcVertexGradient(int vertexIndex,const ScalarExtractorParam& extractor) const; // Returns gradient at given vertex of the cell, based on given scalar extractor
+		EdgeID getEdgeID(int edgeIndex) const; // Returns ID of given edge of the cell
+		Point calcEdgePosition(int edgeIndex,Scalar weight) const; // Returns an interpolated point along the given edge
+		CellID getID(void) const // Returns cell's ID
+			{
+			return CellID(ds->calcCellLinearIndex(index));
+			}
+		CellID getNeighbourID(int neighbourIndex) const; // Returns ID of neighbour across the given face of the cell
+		
+		/* Iterator methods: */
+		friend bool operator==(const Cell& cell1,const Cell& cell2)
+			{
+			return cell1.index==cell2.index&&cell1.ds==cell2.ds;
+			}
+		friend bool operator!=(const Cell& cell1,const Cell& cell2)
+			{
+			return cell1.index!=cell2.index||cell1.ds!=cell2.ds;
+			}
+		Cell& operator++(void) // Pre-increment operator; keeps the pinned brick while iterating inside it
+			{
+			baseVertex=0;
+			if(ds->advanceCellIndex(index)&&brick!=0)
+				unpinBrick();
+			return *this;
+			}
+		};
+	
+	typedef IteratorWrapper<Cell> CellIterator; // Class to iterate through cells
+	
+	class Locator:private Cell // Class responsible for evaluating a data set at a given position
+		{
+		friend class BrickedCartesian;
+		
+		/* Embedded classes: */
+		private:
+		typedef Geometry::ComponentArray<Scalar,dimensionParam> CellPosition; // Type for local cell coordinates
+		
+		/* Elements: */
+		using Cell::ds;
+		using Cell::index;
+		using Cell::brick;
+		using Cell::baseVertex;
+		CellPosition cellPos; // Local coordinates of last located point inside its cell
+		
+		/* Constructors and destructors: */
+		public:
+		Locator(void); // Creates invalid locator
+		private:
+		Locator(const BrickedCartesian* sDs); // Creates non-localized locator associated with given data set
+		
+		/* Methods: */
+		public:
+		void setEpsilon(Scalar newEpsilon) // Sets a new accuracy threshold in local cell dimension
+			{
+			/* Not needed for Cartesian data sets */
+			}
+		CellID getCellID(void) const // Returns the ID of the cell containing the last located point
+			{
+			return Cell::getID();
+			}
+		bool locatePoint(const Point& position,bool traceHint =false); // Sets locator to given position; returns true if position is inside found cell
+		template <class ValueExtractorParam>
+		typename ValueExtractorParam::DestValue calcValue(const ValueExtractorParam& extractor) const; // Calculates value at last located position, based on given value extractor
+		template <class ScalarExtractorParam>
+		Vector calcGradient(const ScalarExtractorParam& extractor) const; // Calculates gradient at last located position, based on given scalar extractor
+		};
+	
+	friend class Vertex;
+	friend class Cell;
+	friend class Locator;
+	
+	private:
+	struct CachedBrick // Structure for a brick of vertex values in the brick cache
+		{
+		/* Elements: */
+		public:
+		size_t brickIndex; // Linear index of the brick
+		Value* values; // The brick's vertex values, including the ghost layer
+		unsigned int pinCount; // Number of cells pinning the brick; pinned bricks are not evicted
+		CachedBrick* pred; // Pointer to the next more recently used brick
+		CachedBrick* succ; // Pointer to the next less recently used brick
+		};
+	
+	struct CacheShard // Structure for an independently locked part of the brick cache holding the bricks of the same linear index modulo the number of shards
+		{
+		/* Elements: */
+		public:
+		Threads::Mutex mutex; // Mutex serializing access to the shard
+		size_t maxNumCachedBricks; // Maximum number of bricks held in the shard while not all of them are pinned
+		size_t numCachedBricks; // Number of bricks currently held in the shard
+		CachedBrick* mostRecentBrick; // Head of the list of the shard's bricks in order of last use
+		CachedBrick* leastRecentBrick; // Tail of the list of the shard's bricks in order of last use
+		
+		/* Constructors and destructors: */
+		CacheShard(void)
+			:maxNumCachedBricks(0),numCachedBricks(0),
+			 mostRecentBrick(0),leastRecentBrick(0)
+			{
+			}
+		
+		/* Methods: */
+		void unlink(CachedBrick* cb) // Removes the given brick from the usage list
+			{
+			if(cb->pred!=0)
+				cb->pred->succ=cb->succ;
+			else
+				mostRecentBrick=cb->succ;
+			if(cb->succ!=0)
+				cb->succ->pred=cb->pred;
+			else
+				leastRecentBrick=cb->pred;
+			}
+		void linkFront(CachedBrick* cb) // Adds the given brick to the front of the usage list
+			{
+			cb->pred=0;
+			cb->succ=mostRecentBrick;
+			if(mostRecentBrick!=0)
+				mostRecentBrick->pred=cb;
+			else
+				leastRecentBrick=cb;
+			mostRecentBrick=cb;
+			}
+		};
+	
+	static const unsigned int maxNumCacheShards=16; // Maximum number of independently locked brick cache shards
+	
+	/* Elements: */
+	Index numVertices; // Number of vertices in data set in each dimension
+	Index numCells; // Number of cells in data set in each dimension
+	Size cellSize; // Size of the data set's cells in each dimension
+	BrickFile* brickFile; // File containing the data set's bricks of vertex values
+	int brickSize; // Number of cells covered by a brick in each dimension
+	Index numBricks; // Number of bricks in each dimension
+	size_t numBrickValues; // Number of vertex values in a brick, including the ghost layer
+	ptrdiff_t brickStrides[dimension]; // Array of pointer stride values in a brick's vertex array
+	ptrdiff_t brickOrigin; // Offset from the beginning of a brick's vertex array to its first non-ghost vertex
+	int vertexOffsets[CellTopology::numVertices]; // Array of pointer offsets from a cell's base vertex to all cell vertices inside a brick
+	VertexIterator firstVertex,lastVertex; // Bounds of vertex list
+	CellIterator firstCell,lastCell; // Bounds of cell list
+	Box domainBox; // Bounding box of all vertices
+	
+	/* Brick cache state: */
+	size_t maxNumCachedBricks; // Maximum number of bricks held in the brick cache while not all of them are pinned
+	unsigned int numCacheShards; // Number of independently locked brick cache shards
+	mutable CacheShard* cacheShards; // Array of brick cache shards
+	mutable std::vector<CachedBrick*> cachedBricks; // Array of pointers to cached bricks, indexed by linear brick index; 0 for bricks not in the cache; entries are protected by their shards' mutexes
+	
+	/* Private methods: */
+	CacheShard& getCacheShard(size_t brickIndex) const // Returns the brick cache shard holding the brick of the given linear index
+		{
+		return cacheShards[brickIndex%numCacheShards];
+		}
+	ptrdiff_t locateBrickVertex(const Index& cellIndex,const Index& vertexIndex,size_t& brickIndex) const; // Returns the linear index of the brick containing the given cell, and the offset of the given vertex inside that brick
+	CachedBrick* getBrick(CacheShard& shard,size_t brickIndex) const; // Returns the cached brick of the given linear index and marks it most recently used, faulting in the brick if necessary; must be called with the shard's mutex locked
+	const Value* pinCellBrick(const Index& cellIndex,CachedBrick*& brick) const; // Returns a pointer to the base vertex of the given cell inside its brick; pins the brick and stores it in the given pointer unless it is already pinned there
+	void unpinBrick(CachedBrick* brick) const; // Releases a pin on the given brick
+	void releaseCache(void); // Deletes all cached bricks
+	size_t calcVertexLinearIndex(const Index& vertexIndex) const; // Returns the linear index of a vertex in row-major order
+	void advanceVertexIndex(Index& vertexIndex) const; // Advances the given vertex index to the next vertex in brick order
+	size_t calcCellLinearIndex(const Index& cellIndex) const; // Returns the linear index of a cell in brick order
+	Index calcCellIndex(size_t cellLinearIndex) const; // Returns the index of the cell of the given linear index in brick order
+	bool advanceCellIndex(Index& cellIndex) const; // Advances the given cell index to the next cell in brick order; returns true if the new cell is in a different brick
+	template <class ScalarExtractorParam>
+	Vector calcBrickVertexGradient(const Value* vertex,const Index& vertexIndex,const ScalarExtractorParam& extractor) const; // Returns gradient at a vertex based on the given scalar extractor, given a pointer to the vertex inside a cached brick
+	template <class ScalarExtractorParam>
+	Vector calcVertexGradient(const Index& vertexIndex,const ScalarExtractorParam& extractor) const; // Returns gradient at a vertex based on the given scalar extractor
+	
+	/* Constructors and destructors: */
+	public:
+	BrickedCartesian(void); // Creates an "empty" data set
+	private:
+	BrickedCartesian(const BrickedCartesian& source); // Prohibit copy constructor
+	BrickedCartesian& operator=(const BrickedCartesian& source); // Prohibit assignment operator
+	public:
+	~BrickedCartesian(void); // Destroys the data set
+	
+	/* Data set construction methods: */
+	void setData(const Index& sNumVertices,const Size& sCellSize,const std::string& rawFileName,const std::string& brickFileName,int sBrickSize,size_t cacheSize); // Sets the number of vertices and cell size of the data set and attaches it to the given brick file, which is (re-)created from the given raw file of vertex values if necessary; cacheSize is the brick cache's memory budget in bytes
+	
+	/* Low-level data access methods: */
+	const Index& getNumVertices(void) const // Returns number of vertices in the data set
+		{
+		return numVertices;
+		}
+	Point getVertexPosition(const Index& vertexIndex) const; // Returns a vertex' position
+	Value getVertexValue(const Index& vertexIndex) const; // Returns a vertex' data value
+	const Index& getNumCells(void) const // Returns number of cells in grid
+		{
+		return numCells;
+		}
+	const Size& getCellSize(void) const // Returns size of a single cell
+		{
+		return cellSize;
+		}
+	int getBrickSize(void) const // Returns the number of cells covered by a brick in each dimension
+		{
+		return brickSize;
+		}
+	size_t getMaxNumCachedBricks(void) const // Returns the maximum number of bricks held in the brick cache
+		{
+		return maxNumCachedBricks;
+		}
+	
+	/* Methods implementing the data set interface: */
+	size_t getTotalNumVertices(void) const; // Returns total number of vertices in the data set
+	Vertex getVertex(const VertexID& vertexID) const; // Returns vertex of given valid ID
+	const VertexIterator& beginVertices(void) const // Returns iterator to first vertex in the data set
+		{
+		return firstVertex;
+		}
+	const VertexIterator& endVertices(void) const // Returns iterator behind last vertex in the data set
+		{
+		return lastVertex;
+		}
+	size_t getTotalNumCells(void) const; // Returns total number of cells in the data set
+	Cell getCell(const CellID& cellID) const // Return cell of given valid ID
+		{
+		return Cell(this,calcCellIndex(cellID.getIndex()));
+		}
+	const CellIterator& beginCells(void) const // Returns iterator to first cell in the data set
+		{
+		return firstCell;
+		}
+	const CellIterator& endCells(void) const // Returns iterator behind last cell in the data set
+		{
+		return lastCell;
+		}
+	const Box& getDomainBox(void) const // Returns bounding box of the data set's domain
+		{
+		return domainBox;
+		}
+	Scalar calcAverageCellSize(void) const; // Calculates an estimate of the average cell size in the data set
+	Locator getLocator(void) const // Returns an unlocalized locator for the data set
+		{
+		return Locator(this);
+		}
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_BRICKEDCARTESIAN_IMPLEMENTATION
+#include <Templatized/BrickedCartesian.icpp>
+#endif
+
+#endif
@@ -0,0 +1,143 @@
+/***********************************************************************
+CellBoxGrid - Generic class to index the cells of hypercubic data sets
+by their bounding boxes in a uniform grid of buckets. Used by
+curvilinear data set classes to directly locate cells containing query
+points.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_CELLBOXGRID_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_CELLBOXGRID_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class DataSetParam>
+class CellBoxGrid
+	{
+	/* Embedded classes: */
+	public:
+	typedef DataSetParam DataSet; // Type of indexed data set
+	typedef typename DataSet::Scalar Scalar; // Scalar type of data set's domain
+	static const int dimension=DataSet::dimension; // Dimension of data set's domain
+	typedef typename DataSet::Point Point; // Type for points in data set's domain
+	typedef typename DataSet::Box Box; // Type for axis-aligned boxes in data set's domain
+	typedef typename DataSet::CellTopology CellTopology; // Data set's cell topology
+	typedef typename DataSet::CellID CellID; // Data set's cell ID type
+	typedef typename DataSet::Cell Cell; // Data set's cell type
+	static const int cellsPerBucket=8; // Average number of cells per bucket the grid layout aims for
+	
+	private:
+	typedef typename DataSet::CellIterator CellIterator; // Type of the data set's cell iterators
+	
+	class BuildJob // Helper class to process all cells on a team of worker threads
+		{
+		/* Elements: */
+		private:
+		CellBoxGrid* cbg; // The cell box grid
+		
+		/* Constructors and destructors: */
+		public:
+		BuildJob(CellBoxGrid* sCbg)
+			:cbg(sCbg)
+			{
+			}
+		
+		/* Methods: */
+		void operator()(unsigned int workerIndex)
+			{
+			cbg->processCells(workerIndex);
+			}
+		};
+	
+	friend class BuildJob;
+	
+	struct BucketEntry // Structure for a cell overlapping a bucket
+		{
+		/* Elements: */
+		public:
+		size_t bucketIndex; // Linear index of the bucket
+		CellID cellID; // ID of the cell
+		};
+	
+	struct WorkerState // Structure for the range of cells and partial results of a worker thread
+		{
+		/* Elements: */
+		public:
+		CellIterator cellBegin,cellEnd; // Range of cells processed by the worker
+		std::vector<BucketEntry> bucketEntries; // Bucket entries of the worker's cells, in cell order
+		Scalar minCellRadius2,maxCellRadius2; // Range of squared cell "radii" of the worker's cells
+		double cellRadiusSum; // Sum of cell "radii" of the worker's cells
+		};
+	
+	/* Elements: */
+	Box gridBox; // Bounding box covered by the bucket grid
+	int numBuckets[dimension]; // Number of buckets in each dimension
+	Scalar bucketScales[dimension]; // Scale factors from domain coordinates to bucket indices
+	std::vector<size_t> bucketStarts; // Index of the first cell ID of each bucket in the cell ID array, plus one end index
+	std::vector<CellID> cellIDs; // IDs of all cells overlapping each bucket, sorted by bucket
+	Scalar minCellRadius2,maxCellRadius2; // Range of squared cell "radii" of all cells
+	Scalar avgCellRadius; // Average cell "radius" of all cells
+	
+	/* Parallel construction state: */
+	std::vector<WorkerState> workerStates; // Cell ranges and partial results of all worker threads
+	
+	/* Private methods: */
+	void calcBucketRange(const Box& box,int bucketMin[dimension],int bucketMax[dimension]) const; // Calculates the range of buckets overlapped by the given box
+	void processCells(unsigned int workerIndex); // Worker method to process the worker's range of cells
+	
+	/* Constructors and destructors: */
+	public:
+	CellBoxGrid(void); // Creates an empty cell box grid
+	private:
+	CellBoxGrid(const CellBoxGrid& source); // Prohibit copy constructor
+	CellBoxGrid& operator=(const CellBoxGrid& source); // Prohibit assignment operator
+	
+	/* Methods: */
+	public:
+	static Box calcCellBox(const Cell& cell); // Returns the bounding box of the given cell, slightly enlarged to account for point location tolerances
+	void build(const DataSet& dataSet); // Indexes all cells of the given data set using all worker threads of the worker pool
+	Scalar getMinCellRadius2(void) const // Returns the squared minimal cell "radius" of all indexed cells
+		{
+		return minCellRadius2;
+		}
+	Scalar getMaxCellRadius2(void) const // Returns the squared maximal cell "radius" of all indexed cells
+		{
+		return maxCellRadius2;
+		}
+	Scalar getAvgCellRadius(void) const // Returns the average cell "radius" of all indexed cells
+		{
+		return avgCellRadius;
+		}
+	size_t findCells(const Point& position,const CellID*& cells) const; // Returns the number of cells whose bounding boxes overlap the bucket containing the given position, and a pointer to their IDs
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_CELLBOXGRID_IMPLEMENTATION
+#include <Templatized/CellBoxGrid.icpp>
+#endif
+
+#endif
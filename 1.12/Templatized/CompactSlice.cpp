@@ -0,0 +1,115 @@
+/***********************************************************************
+CompactSlice - Class to store the values of a data set slice in compact
+form, either as 16-bit floating-point numbers or as 8-bit or 16-bit
+linearly quantized integers.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Templatized/CompactSlice.h>
+
+#include <strings.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+/*****************************
+Methods of class CompactSlice:
+*****************************/
+
+void CompactSlice::allocateCodes(void)
+	{
+	if(encoding==QUANTIZED8)
+		codes=new Misc::UInt8[numValues];
+	else
+		codes=new Misc::UInt16[numValues];
+	}
+
+void CompactSlice::calcQuantization(double min,double max)
+	{
+	/* Map the value range to the full range of codes: */
+	offset=min;
+	double maxCode=encoding==QUANTIZED8?255.0:65535.0;
+	scale=(max-min)/maxCode;
+	}
+
+CompactSlice::~CompactSlice(void)
+	{
+	if(encoding==QUANTIZED8)
+		delete[] static_cast<Misc::UInt8*>(codes);
+	else
+		delete[] static_cast<Misc::UInt16*>(codes);
+	}
+
+int CompactSlice::parseEncoding(const char* encodingName)
+	{
+	if(strcasecmp(encodingName,"half")==0)
+		return HALF;
+	else if(strcasecmp(encodingName,"quantized8")==0)
+		return QUANTIZED8;
+	else if(strcasecmp(encodingName,"quantized16")==0)
+		return QUANTIZED16;
+	else
+		return -1;
+	}
+
+Misc::UInt16 CompactSlice::encodeHalf(float value)
+	{
+	Misc::UInt32 bits;
+	memcpy(&bits,&value,sizeof(float));
+	Misc::UInt32 sign=bits&0x80000000U;
+	bits^=sign;
+	
+	Misc::UInt16 result;
+	if(bits>=0x47800000U)
+		{
+		/* Map values too large for 16 bits to infinity, and NaNs to a quiet NaN: */
+		result=bits>0x7f800000U?0x7e00U:0x7c00U;
+		}
+	else if(bits<0x38800000U)
+		{
+		/* Let the FPU round the mantissa of subnormal results by adding 0.5: */
+		const Misc::UInt32 magicBits=126U<<23;
+		float magic,v;
+		memcpy(&magic,&magicBits,sizeof(float));
+		memcpy(&v,&bits,sizeof(float));
+		v+=magic;
+		memcpy(&bits,&v,sizeof(float));
+		result=Misc::UInt16(bits-magicBits);
+		}
+	else
+		{
+		/* Re-bias the exponent and round the mantissa to nearest even: */
+		Misc::UInt32 mantissaOdd=(bits>>13)&1U;
+		bits-=(127U-15U)<<23;
+		bits+=0xfffU+mantissaOdd;
+		result=Misc::UInt16(bits>>13);
+		}
+	
+	return result|Misc::UInt16(sign>>16);
+	}
+
+size_t CompactSlice::getMemorySize(void) const
+	{
+	return encoding==QUANTIZED8?numValues:numValues*2;
+	}
+
+}
+
+}
@@ -0,0 +1,193 @@
+/***********************************************************************
+CompactSlice - Class to store the values of a data set slice in compact
+form, either as 16-bit floating-point numbers or as 8-bit or 16-bit
+linearly quantized integers.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_COMPACTSLICE_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_COMPACTSLICE_INCLUDED
+
+#include <stddef.h>
+#include <string.h>
+#include <Misc/SizedTypes.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+class CompactSlice
+	{
+	/* Embedded classes: */
+	public:
+	enum Encoding // Enumerated type for compact value encodings
+		{
+		HALF=0, // IEEE 754 16-bit floating-point numbers
+		QUANTIZED8, // 8-bit integers linearly mapped to the slice's value range
+		QUANTIZED16 // 16-bit integers linearly mapped to the slice's value range
+		};
+	
+	/* Elements: */
+	private:
+	Encoding encoding; // Encoding of the slice's values
+	size_t numValues; // Number of values in the slice
+	void* codes; // Array of encoded values
+	double offset; // Value represented by quantized code 0
+	double scale; // Value difference between consecutive quantized codes
+	
+	/* Private methods: */
+	void allocateCodes(void); // Allocates the code array for the current encoding and number of values
+	void calcQuantization(double min,double max); // Calculates the quantization offset and scale for the given value range
+	double quantize(double value,double invScale,double maxCode) const // Returns the code of the given value
+		{
+		double code=(value-offset)*invScale+0.5;
+		if(!(code>=0.0))
+			return 0.0;
+		if(code>maxCode)
+			return maxCode;
+		return double(size_t(code));
+		}
+	
+	/* Constructors and destructors: */
+	public:
+	template <class ValueScalarParam>
+	CompactSlice(Encoding sEncoding,size_t sNumValues,const ValueScalarParam* values) // Encodes the given array of values
+		:encoding(sEncoding),numValues(sNumValues),codes(0),
+		 offset(0.0),scale(1.0)
+		{
+		allocateCodes();
+		if(encoding==HALF)
+			{
+			Misc::UInt16* cPtr=static_cast<Misc::UInt16*>(codes);
+			for(size_t i=0;i<numValues;++i)
+				cPtr[i]=encodeHalf(float(values[i]));
+			}
+		else
+			{
+			/* Find the range of the slice's values, ignoring NaNs: */
+			double min=0.0,max=0.0;
+			bool first=true;
+			for(size_t i=0;i<numValues;++i)
+				{
+				double v=double(values[i]);
+				if(v==v)
+					{
+					if(first||min>v)
+						min=v;
+					if(first||max<v)
+						max=v;
+					first=false;
+					}
+				}
+			calcQuantization(min,max);
+			
+			/* Quantize the slice's values: */
+			double invScale=scale!=0.0?1.0/scale:0.0;
+			if(encoding==QUANTIZED8)
+				{
+				Misc::UInt8* cPtr=static_cast<Misc::UInt8*>(codes);
+				for(size_t i=0;i<numValues;++i)
+					cPtr[i]=Misc::UInt8(quantize(double(values[i]),invScale,255.0));
+				}
+			else
+				{
+				Misc::UInt16* cPtr=static_cast<Misc::UInt16*>(codes);
+				for(size_t i=0;i<numValues;++i)
+					cPtr[i]=Misc::UInt16(quantize(double(values[i]),invScale,65535.0));
+				}
+			}
+		}
+	private:
+	CompactSlice(const CompactSlice& source); // Prohibit copy constructor
+	CompactSlice& operator=(const CompactSlice& source); // Prohibit assignment operator
+	public:
+	~CompactSlice(void);
+	
+	/* Methods: */
+	static int parseEncoding(const char* encodingName); // Returns the encoding of the given name ("half", "quantized8", or "quantized16"), or -1 if the name is not recognized
+	static Misc::UInt16 encodeHalf(float value); // Converts a value to the nearest 16-bit floating-point number
+	static float decodeHalf(Misc::UInt16 code) // Converts a 16-bit floating-point number to a value
+		{
+		/* Move exponent and mantissa into place and re-bias the exponent: */
+		const Misc::UInt32 shiftedExp=0x7c00U<<13;
+		Misc::UInt32 bits=(Misc::UInt32(code)&0x7fffU)<<13;
+		Misc::UInt32 exp=bits&shiftedExp;
+		bits+=(127U-15U)<<23;
+		float result;
+		if(exp==shiftedExp)
+			{
+			/* Adjust the exponent of infinities and NaNs: */
+			bits+=(128U-16U)<<23;
+			memcpy(&result,&bits,sizeof(float));
+			}
+		else if(exp==0U)
+			{
+			/* Renormalize subnormal numbers: */
+			bits+=1U<<23;
+			memcpy(&result,&bits,sizeof(float));
+			result-=6.103515625e-05f; // 2^-14
+			}
+		else
+			memcpy(&result,&bits,sizeof(float));
+		
+		/* Apply the sign: */
+		return (code&0x8000U)?-result:result;
+		}
+	Encoding getEncoding(void) const // Returns the slice's encoding
+		{
+		return encoding;
+		}
+	size_t getNumValues(void) const // Returns the number of values in the slice
+		{
+		return numValues;
+		}
+	const void* getCodes(void) const // Returns the array of encoded values
+		{
+		return codes;
+		}
+	double getOffset(void) const // Returns the value represented by quantized code 0
+		{
+		return offset;
+		}
+	double getScale(void) const // Returns the value difference between consecutive quantized codes
+		{
+		return scale;
+		}
+	size_t getMemorySize(void) const; // Returns the size of the code array in bytes
+	double getValue(size_t index) const // Decodes the value of the given index
+		{
+		switch(encoding)
+			{
+			case HALF:
+				return double(decodeHalf(static_cast<const Misc::UInt16*>(codes)[index]));
+			
+			case QUANTIZED8:
+				return offset+scale*double(static_cast<const Misc::UInt8*>(codes)[index]);
+			
+			default:
+				return offset+scale*double(static_cast<const Misc::UInt16*>(codes)[index]);
+			}
+		}
+	};
+
+}
+
+}
+
+#endif
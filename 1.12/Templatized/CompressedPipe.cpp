@@ -0,0 +1,496 @@
+/***********************************************************************
+CompressedPipe - Helper class to stream data from the master node to the
+slave nodes of a cluster through a multicast pipe, compressing it with a
+fast LZ codec after delta-coding vertex and index arrays.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Templatized/CompressedPipe.h>
+
+#include <string.h>
+#include <Misc/ThrowStdErr.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+namespace {
+
+/**************
+Helper objects:
+**************/
+
+const int hashTableBits=14; // Number of bits in match finder hash values
+const size_t minMatchLength=4; // Length of the shortest encoded match
+const size_t maxMatchOffset=65535; // Largest distance between a match and its source
+const size_t matchFindLimit=12; // Number of bytes at the end of a block where no match can start
+const size_t lastLiterals=5; // Number of bytes at the end of a block that are always stored as literals
+
+/****************
+Helper functions:
+****************/
+
+inline Misc::UInt32 readWord(const CompressedPipe::Byte* ptr)
+	{
+	Misc::UInt32 result;
+	memcpy(&result,ptr,sizeof(Misc::UInt32));
+	return result;
+	}
+
+inline void writeWord(CompressedPipe::Byte* ptr,Misc::UInt32 word)
+	{
+	memcpy(ptr,&word,sizeof(Misc::UInt32));
+	}
+
+inline unsigned int hashWord(Misc::UInt32 word)
+	{
+	return (unsigned int)((word*2654435761U)>>(32-hashTableBits));
+	}
+
+inline CompressedPipe::Byte* writeLength(CompressedPipe::Byte* ptr,size_t length)
+	{
+	/* Write the length as a run of 255 bytes terminated by a byte less than 255: */
+	while(length>=255)
+		{
+		*(ptr++)=255;
+		length-=255;
+		}
+	*(ptr++)=CompressedPipe::Byte(length);
+	return ptr;
+	}
+
+inline CompressedPipe::Byte* writeSequence(CompressedPipe::Byte* ptr,const CompressedPipe::Byte* literals,size_t numLiterals,size_t matchOffset,size_t matchLength)
+	{
+	/* Write the sequence's token and extended literal length: */
+	CompressedPipe::Byte* token=ptr++;
+	if(numLiterals>=15)
+		{
+		*token=15<<4;
+		ptr=writeLength(ptr,numLiterals-15);
+		}
+	else
+		*token=CompressedPipe::Byte(numLiterals<<4);
+	
+	/* Copy the literals: */
+	memcpy(ptr,literals,numLiterals);
+	ptr+=numLiterals;
+	
+	if(matchLength>0)
+		{
+		/* Write the match offset and extended match length: */
+		*(ptr++)=CompressedPipe::Byte(matchOffset&0xffU);
+		*(ptr++)=CompressedPipe::Byte(matchOffset>>8);
+		size_t codedLength=matchLength-minMatchLength;
+		if(codedLength>=15)
+			{
+			*token|=15;
+			ptr=writeLength(ptr,codedLength-15);
+			}
+		else
+			*token|=CompressedPipe::Byte(codedLength);
+		}
+	
+	return ptr;
+	}
+
+inline size_t readLength(const CompressedPipe::Byte*& ptr,const CompressedPipe::Byte* end)
+	{
+	size_t result=0;
+	CompressedPipe::Byte b;
+	do
+		{
+		if(ptr==end)
+			Misc::throwStdErr("CompressedPipe::decompress: Truncated sequence length");
+		b=*(ptr++);
+		result+=b;
+		}
+	while(b==255);
+	return result;
+	}
+
+}
+
+/***************************************
+Static elements of class CompressedPipe:
+***************************************/
+
+const unsigned int CompressedPipe::protocolVersion;
+const size_t CompressedPipe::segmentSize;
+const size_t CompressedPipe::minArraySize;
+bool CompressedPipe::compressing=false;
+int CompressedPipe::numQuantizationBits=0;
+
+/*******************************
+Methods of class CompressedPipe:
+*******************************/
+
+void CompressedPipe::sendSegment(const CompressedPipe::Byte* data,size_t dataSize,CompressedPipe::Transform transform,unsigned int strideWords)
+	{
+	/* Transform the segment: */
+	const Byte* raw=data;
+	if(transform!=NONE)
+		{
+		transformBuffer.resize(dataSize);
+		applyTransform(data,dataSize,transform,strideWords,transform==VERTEX_DELTA?numQuantizationBits:0,&transformBuffer[0]);
+		raw=&transformBuffer[0];
+		}
+	
+	/* Compress the segment, and send it uncompressed if it did not shrink: */
+	encodeBuffer.resize(getMaxCompressedSize(dataSize));
+	size_t compressedSize=compress(raw,dataSize,&encodeBuffer[0]);
+	if(compressedSize>=dataSize)
+		compressedSize=dataSize;
+	
+	/* Send the segment header and the segment: */
+	#ifdef VISUALIZATION_USE_PROFILING
+	Profiler::count(Profiler::PIPE_BYTES,2*sizeof(Misc::UInt32)+2*sizeof(Misc::UInt8)+compressedSize);
+	#endif
+	pipe->write<Misc::UInt32>(Misc::UInt32(dataSize));
+	pipe->write<Misc::UInt32>(Misc::UInt32(compressedSize));
+	pipe->write<Misc::UInt8>(Misc::UInt8(transform));
+	pipe->write<Misc::UInt8>(Misc::UInt8(strideWords));
+	pipe->write<Byte>(compressedSize<dataSize?&encodeBuffer[0]:raw,compressedSize);
+	}
+
+void CompressedPipe::sendBuffer(void)
+	{
+	if(!buffer.empty())
+		{
+		sendSegment(&buffer[0],buffer.size(),NONE,0);
+		buffer.clear();
+		}
+	}
+
+void CompressedPipe::writeBytes(const void* data,size_t dataSize)
+	{
+	const Byte* dPtr=static_cast<const Byte*>(data);
+	while(dataSize>0)
+		{
+		/* Append as much data as fits into the current segment: */
+		size_t appendSize=segmentSize-buffer.size();
+		if(appendSize>dataSize)
+			appendSize=dataSize;
+		buffer.insert(buffer.end(),dPtr,dPtr+appendSize);
+		dPtr+=appendSize;
+		dataSize-=appendSize;
+		
+		/* Send the segment if it is full: */
+		if(buffer.size()==segmentSize)
+			sendBuffer();
+		}
+	}
+
+void CompressedPipe::sendArray(const void* data,size_t itemSize,size_t numItems,CompressedPipe::Transform transform)
+	{
+	/* Buffer short arrays as plain data: */
+	if(itemSize*numItems<minArraySize)
+		{
+		writeBytes(data,itemSize*numItems);
+		return;
+		}
+	
+	/* Check if the items can be delta-coded as 32-bit words: */
+	unsigned int strideWords=(unsigned int)(itemSize/sizeof(Misc::UInt32));
+	if(itemSize%sizeof(Misc::UInt32)!=0||strideWords>255||(transform==INDEX_DELTA&&strideWords!=1))
+		{
+		transform=NONE;
+		strideWords=0;
+		}
+	
+	/* Send all buffered plain data first to maintain the stream order: */
+	sendBuffer();
+	
+	/* Send the array in segments of whole items: */
+	size_t segmentNumItems=segmentSize/itemSize;
+	if(segmentNumItems<1)
+		segmentNumItems=1;
+	const Byte* dPtr=static_cast<const Byte*>(data);
+	while(numItems>0)
+		{
+		size_t numSegmentItems=numItems;
+		if(numSegmentItems>segmentNumItems)
+			numSegmentItems=segmentNumItems;
+		sendSegment(dPtr,numSegmentItems*itemSize,transform,strideWords);
+		dPtr+=numSegmentItems*itemSize;
+		numItems-=numSegmentItems;
+		}
+	}
+
+void CompressedPipe::receiveSegment(void)
+	{
+	/* Read the segment header: */
+	size_t rawSize=pipe->read<Misc::UInt32>();
+	size_t compressedSize=pipe->read<Misc::UInt32>();
+	Transform transform=Transform(pipe->read<Misc::UInt8>());
+	unsigned int strideWords=pipe->read<Misc::UInt8>();
+	if(rawSize==0||rawSize>segmentSize||compressedSize>rawSize||transform>INDEX_DELTA)
+		Misc::throwStdErr("CompressedPipe: Received malformed segment header");
+	
+	/* Read the segment and decompress it if necessary: */
+	encodeBuffer.resize(compressedSize);
+	pipe->read<Byte>(&encodeBuffer[0],compressedSize);
+	if(compressedSize<rawSize)
+		{
+		transformBuffer.resize(rawSize);
+		decompress(&encodeBuffer[0],compressedSize,&transformBuffer[0],rawSize);
+		}
+	else
+		transformBuffer.swap(encodeBuffer);
+	
+	/* Revert the segment's transformation: */
+	if(transform!=NONE)
+		{
+		buffer.resize(rawSize);
+		revertTransform(&transformBuffer[0],rawSize,transform,strideWords,&buffer[0]);
+		}
+	else
+		buffer.swap(transformBuffer);
+	readPos=0;
+	}
+
+void CompressedPipe::readBytes(void* data,size_t dataSize)
+	{
+	Byte* dPtr=static_cast<Byte*>(data);
+	while(dataSize>0)
+		{
+		/* Receive the next segment if the buffer is exhausted: */
+		if(readPos==buffer.size())
+			receiveSegment();
+		
+		/* Copy as much data as possible from the buffer: */
+		size_t copySize=buffer.size()-readPos;
+		if(copySize>dataSize)
+			copySize=dataSize;
+		memcpy(dPtr,&buffer[readPos],copySize);
+		readPos+=copySize;
+		dPtr+=copySize;
+		dataSize-=copySize;
+		}
+	}
+
+CompressedPipe::CompressedPipe(Cluster::MulticastPipe* sPipe)
+	:pipe(sPipe),readPos(0)
+	{
+	}
+
+size_t CompressedPipe::getMaxCompressedSize(size_t rawSize)
+	{
+	return rawSize+rawSize/255+16;
+	}
+
+size_t CompressedPipe::compress(const CompressedPipe::Byte* raw,size_t rawSize,CompressedPipe::Byte* compressed)
+	{
+	Byte* cPtr=compressed;
+	const Byte* literals=raw;
+	if(rawSize>matchFindLimit)
+		{
+		/* Find matches through a hash table of the most recent positions of four-byte sequences: */
+		std::vector<Misc::UInt32> hashTable(size_t(1)<<hashTableBits,0U);
+		const Byte* rPtr=raw;
+		const Byte* matchEnd=raw+rawSize-lastLiterals;
+		const Byte* findEnd=raw+rawSize-matchFindLimit;
+		unsigned int numMisses=0;
+		while(rPtr<findEnd)
+			{
+			/* Look up the most recent position of the current sequence: */
+			Misc::UInt32 word=readWord(rPtr);
+			unsigned int hash=hashWord(word);
+			const Byte* mPtr=raw+hashTable[hash];
+			hashTable[hash]=Misc::UInt32(rPtr-raw);
+			if(mPtr<rPtr&&size_t(rPtr-mPtr)<=maxMatchOffset&&readWord(mPtr)==word)
+				{
+				/* Extend the match forward: */
+				const Byte* ePtr=rPtr+minMatchLength;
+				const Byte* emPtr=mPtr+minMatchLength;
+				while(ePtr<matchEnd&&*ePtr==*emPtr)
+					{
+					++ePtr;
+					++emPtr;
+					}
+				
+				/* Write the literals and the match: */
+				cPtr=writeSequence(cPtr,literals,size_t(rPtr-literals),size_t(rPtr-mPtr),size_t(ePtr-rPtr));
+				rPtr=ePtr;
+				literals=rPtr;
+				numMisses=0;
+				
+				/* Enter a position inside the match into the hash table to improve the next search: */
+				if(rPtr<findEnd)
+					hashTable[hashWord(readWord(rPtr-2))]=Misc::UInt32(rPtr-2-raw);
+				}
+			else
+				{
+				/* Skip ahead faster through incompressible data: */
+				rPtr+=1+(numMisses>>6);
+				++numMisses;
+				}
+			}
+		}
+	
+	/* Write the remaining literals as the final sequence: */
+	cPtr=writeSequence(cPtr,literals,size_t(raw+rawSize-literals),0,0);
+	
+	return size_t(cPtr-compressed);
+	}
+
+void CompressedPipe::decompress(const CompressedPipe::Byte* compressed,size_t compressedSize,CompressedPipe::Byte* raw,size_t rawSize)
+	{
+	const Byte* cPtr=compressed;
+	const Byte* cEnd=compressed+compressedSize;
+	Byte* rPtr=raw;
+	Byte* rEnd=raw+rawSize;
+	while(true)
+		{
+		/* Read the next sequence's token: */
+		if(cPtr==cEnd)
+			Misc::throwStdErr("CompressedPipe::decompress: Truncated data");
+		unsigned int token=*(cPtr++);
+		
+		/* Copy the sequence's literals: */
+		size_t numLiterals=token>>4;
+		if(numLiterals==15)
+			numLiterals+=readLength(cPtr,cEnd);
+		if(numLiterals>size_t(cEnd-cPtr)||numLiterals>size_t(rEnd-rPtr))
+			Misc::throwStdErr("CompressedPipe::decompress: Literal run out of bounds");
+		memcpy(rPtr,cPtr,numLiterals);
+		cPtr+=numLiterals;
+		rPtr+=numLiterals;
+		
+		/* Stop after the final sequence, which has no match: */
+		if(cPtr==cEnd)
+			break;
+		
+		/* Read the match offset and length: */
+		if(cEnd-cPtr<2)
+			Misc::throwStdErr("CompressedPipe::decompress: Truncated match offset");
+		size_t matchOffset=size_t(cPtr[0])|(size_t(cPtr[1])<<8);
+		cPtr+=2;
+		size_t matchLength=token&0xfU;
+		if(matchLength==15)
+			matchLength+=readLength(cPtr,cEnd);
+		matchLength+=minMatchLength;
+		if(matchOffset==0||matchOffset>size_t(rPtr-raw)||matchLength>size_t(rEnd-rPtr))
+			Misc::throwStdErr("CompressedPipe::decompress: Match out of bounds");
+		
+		/* Copy the match byte by byte, as it might overlap the destination: */
+		const Byte* mPtr=rPtr-matchOffset;
+		for(size_t i=0;i<matchLength;++i)
+			rPtr[i]=mPtr[i];
+		rPtr+=matchLength;
+		}
+	
+	if(rPtr!=rEnd)
+		Misc::throwStdErr("CompressedPipe::decompress: Decompressed size mismatch");
+	}
+
+void CompressedPipe::applyTransform(const CompressedPipe::Byte* raw,size_t rawSize,CompressedPipe::Transform transform,unsigned int strideWords,int numClearedBits,CompressedPipe::Byte* transformed)
+	{
+	size_t numWords=rawSize/sizeof(Misc::UInt32);
+	Misc::UInt32 mask=numClearedBits>0?~((Misc::UInt32(1)<<numClearedBits)-1U):~Misc::UInt32(0);
+	for(size_t i=0;i<numWords;++i)
+		{
+		/* Delta-code the word against the same word of the previous item: */
+		Misc::UInt32 word=readWord(raw+i*sizeof(Misc::UInt32))&mask;
+		if(transform==VERTEX_DELTA)
+			{
+			if(i>=strideWords)
+				word^=readWord(raw+(i-strideWords)*sizeof(Misc::UInt32))&mask;
+			}
+		else if(i>=1)
+			word-=readWord(raw+(i-1)*sizeof(Misc::UInt32));
+		
+		/* Shuffle the word's bytes into four separate planes: */
+		for(int j=0;j<4;++j)
+			transformed[j*numWords+i]=Byte(word>>(j*8));
+		}
+	}
+
+void CompressedPipe::revertTransform(const CompressedPipe::Byte* transformed,size_t rawSize,CompressedPipe::Transform transform,unsigned int strideWords,CompressedPipe::Byte* raw)
+	{
+	size_t numWords=rawSize/sizeof(Misc::UInt32);
+	for(size_t i=0;i<numWords;++i)
+		{
+		/* Gather the word's bytes from the four planes: */
+		Misc::UInt32 word=0;
+		for(int j=0;j<4;++j)
+			word|=Misc::UInt32(transformed[j*numWords+i])<<(j*8);
+		
+		/* Undo the delta coding against the already decoded previous item: */
+		if(transform==VERTEX_DELTA)
+			{
+			if(i>=strideWords)
+				word^=readWord(raw+(i-strideWords)*sizeof(Misc::UInt32));
+			}
+		else if(i>=1)
+			word+=readWord(raw+(i-1)*sizeof(Misc::UInt32));
+		writeWord(raw+i*sizeof(Misc::UInt32),word);
+		}
+	}
+
+void CompressedPipe::negotiate(Cluster::MulticastPipe* pipe,bool requestCompression,int requestNumQuantizationBits)
+	{
+	/* Single-machine environments don't stream anything: */
+	if(pipe==0)
+		{
+		compressing=false;
+		numQuantizationBits=0;
+		return;
+		}
+	
+	if(pipe->isMaster())
+		{
+		/* Limit the quantization to the low-order mantissa bits of single-precision values: */
+		if(requestNumQuantizationBits<0)
+			requestNumQuantizationBits=0;
+		if(requestNumQuantizationBits>16)
+			requestNumQuantizationBits=16;
+		
+		/* Announce the codec version and settings to the slaves: */
+		pipe->write<Misc::UInt32>(protocolVersion);
+		pipe->write<Misc::UInt8>(requestCompression?1:0);
+		pipe->write<Misc::UInt8>(Misc::UInt8(requestNumQuantizationBits));
+		pipe->flush();
+		compressing=requestCompression;
+		numQuantizationBits=requestNumQuantizationBits;
+		}
+	else
+		{
+		/* Receive the master's codec version and settings: */
+		unsigned int masterProtocolVersion=pipe->read<Misc::UInt32>();
+		compressing=pipe->read<Misc::UInt8>()!=0;
+		numQuantizationBits=pipe->read<Misc::UInt8>();
+		if(compressing&&masterProtocolVersion!=protocolVersion)
+			Misc::throwStdErr("CompressedPipe::negotiate: Master uses pipe compression version %u; this node supports version %u",masterProtocolVersion,protocolVersion);
+		}
+	}
+
+void CompressedPipe::flush(void)
+	{
+	#ifdef VISUALIZATION_USE_PROFILING
+	Profiler::ScopedTimer flushTimer(Profiler::PIPE_FLUSH_TIME);
+	#endif
+	
+	if(compressing)
+		sendBuffer();
+	pipe->flush();
+	}
+
+}
+
+}
@@ -0,0 +1,182 @@
+/***********************************************************************
+CompressedPipe - Helper class to stream data from the master node to the
+slave nodes of a cluster through a multicast pipe, compressing it with a
+fast LZ codec after delta-coding vertex and index arrays.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_COMPRESSEDPIPE_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_COMPRESSEDPIPE_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+#include <Misc/SizedTypes.h>
+#include <Cluster/MulticastPipe.h>
+
+#ifdef VISUALIZATION_USE_PROFILING
+#include <Templatized/Profiler.h>
+#endif
+
+namespace Visualization {
+
+namespace Templatized {
+
+class CompressedPipe
+	{
+	/* Embedded classes: */
+	public:
+	typedef Misc::UInt8 Byte; // Type for raw data
+	
+	enum Transform // Enumerated type for reversible transformations applied to segments before compression
+		{
+		NONE=0, // Segment is compressed as is
+		VERTEX_DELTA, // Each 32-bit word is XORed with the same word of the previous vertex
+		INDEX_DELTA // Each 32-bit index is replaced by its difference to the previous index
+		};
+	
+	/* Elements: */
+	private:
+	static const unsigned int protocolVersion=1; // Version of the segment format; master and slaves must agree
+	static const size_t segmentSize=1024*1024; // Maximum amount of raw data per segment
+	static const size_t minArraySize=1024; // Minimum size of vertex or index arrays to be sent in their own segments
+	static bool compressing; // Flag if data is compressed, as announced by the master node
+	static int numQuantizationBits; // Number of low-order bits cleared in every 32-bit word of vertex arrays before compression
+	Cluster::MulticastPipe* pipe; // The wrapped multicast pipe
+	std::vector<Byte> buffer; // Plain data not yet sent on the master node; decoded data not yet read on the slave nodes
+	size_t readPos; // Index of the next unread byte in the buffer on the slave nodes
+	std::vector<Byte> transformBuffer; // Buffer holding a transformed segment
+	std::vector<Byte> encodeBuffer; // Buffer holding a compressed segment
+	
+	/* Private methods: */
+	void sendSegment(const Byte* data,size_t dataSize,Transform transform,unsigned int strideWords); // Transforms, compresses, and sends a segment of raw data
+	void sendBuffer(void); // Sends all buffered plain data as a segment
+	void sendArray(const void* data,size_t itemSize,size_t numItems,Transform transform); // Sends an array of items in segments of whole items
+	void receiveSegment(void); // Receives and decodes the next segment into the buffer
+	void writeBytes(const void* data,size_t dataSize); // Appends plain data to the buffer, sending full segments as needed
+	void readBytes(void* data,size_t dataSize); // Reads decoded data from the buffer, receiving segments as needed
+	
+	/* Constructors and destructors: */
+	public:
+	CompressedPipe(Cluster::MulticastPipe* sPipe); // Wraps the given multicast pipe
+	private:
+	CompressedPipe(const CompressedPipe& source); // Prohibit copy constructor
+	CompressedPipe& operator=(const CompressedPipe& source); // Prohibit assignment operator
+	
+	/* Codec methods: */
+	public:
+	static size_t getMaxCompressedSize(size_t rawSize); // Returns the largest possible size of compressed data for the given amount of raw data
+	static size_t compress(const Byte* raw,size_t rawSize,Byte* compressed); // Compresses a block of raw data and returns the compressed size
+	static void decompress(const Byte* compressed,size_t compressedSize,Byte* raw,size_t rawSize); // Decompresses a block of data of known raw size; throws exception on corrupted data
+	static void applyTransform(const Byte* raw,size_t rawSize,Transform transform,unsigned int strideWords,int numClearedBits,Byte* transformed); // Delta-codes and byte-shuffles a segment of 32-bit words
+	static void revertTransform(const Byte* transformed,size_t rawSize,Transform transform,unsigned int strideWords,Byte* raw); // Reverts a transformation
+	
+	/* Methods: */
+	static void negotiate(Cluster::MulticastPipe* pipe,bool requestCompression,int requestNumQuantizationBits); // Announces the master node's compression settings to the slave nodes; must be called on all nodes before any compressed pipe is used
+	static bool isCompressing(void) // Returns true if pipe transfers are compressed
+		{
+		return compressing;
+		}
+	bool isMaster(void) const // Returns true if the pipe is on the master node
+		{
+		return pipe->isMaster();
+		}
+	Cluster::MulticastPipe* getPipe(void) const // Returns the wrapped pipe
+		{
+		return pipe;
+		}
+	template <class DataParam>
+	void write(const DataParam& value) // Writes a single value
+		{
+		if(compressing)
+			writeBytes(&value,sizeof(DataParam));
+		else
+			{
+			#ifdef VISUALIZATION_USE_PROFILING
+			Profiler::count(Profiler::PIPE_BYTES,sizeof(DataParam));
+			#endif
+			pipe->write<DataParam>(value);
+			}
+		}
+	template <class DataParam>
+	void write(const DataParam* data,size_t numItems) // Writes an array of values
+		{
+		if(compressing)
+			writeBytes(data,numItems*sizeof(DataParam));
+		else
+			{
+			#ifdef VISUALIZATION_USE_PROFILING
+			Profiler::count(Profiler::PIPE_BYTES,numItems*sizeof(DataParam));
+			#endif
+			pipe->write<DataParam>(data,numItems);
+			}
+		}
+	template <class VertexParam>
+	void writeVertices(const VertexParam* vertices,size_t numVertices) // Writes an array of vertices consisting only of float or double components
+		{
+		if(compressing)
+			sendArray(vertices,sizeof(VertexParam),numVertices,VERTEX_DELTA);
+		else
+			{
+			#ifdef VISUALIZATION_USE_PROFILING
+			Profiler::count(Profiler::PIPE_BYTES,numVertices*sizeof(VertexParam));
+			#endif
+			pipe->write<VertexParam>(vertices,numVertices);
+			}
+		}
+	template <class IndexParam>
+	void writeIndices(const IndexParam* indices,size_t numIndices) // Writes an array of vertex indices
+		{
+		if(compressing)
+			sendArray(indices,sizeof(IndexParam),numIndices,INDEX_DELTA);
+		else
+			{
+			#ifdef VISUALIZATION_USE_PROFILING
+			Profiler::count(Profiler::PIPE_BYTES,numIndices*sizeof(IndexParam));
+			#endif
+			pipe->write<IndexParam>(indices,numIndices);
+			}
+		}
+	template <class DataParam>
+	DataParam read(void) // Reads a single value
+		{
+		if(compressing)
+			{
+			DataParam result;
+			readBytes(&result,sizeof(DataParam));
+			return result;
+			}
+		else
+			return pipe->read<DataParam>();
+		}
+	template <class DataParam>
+	void read(DataParam* data,size_t numItems) // Reads an array of values written by any of the write methods
+		{
+		if(compressing)
+			readBytes(data,numItems*sizeof(DataParam));
+		else
+			pipe->read<DataParam>(data,numItems);
+		}
+	void flush(void); // Sends all buffered data and flushes the pipe
+	};
+
+}
+
+}
+
+#endif
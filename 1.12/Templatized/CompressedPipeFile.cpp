@@ -0,0 +1,154 @@
+/***********************************************************************
+CompressedPipeFile - Class for files that are read on the master node of
+a cluster and whose contents are streamed to the slave nodes through a
+compressed multicast pipe.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Templatized/CompressedPipeFile.h>
+
+#include <string.h>
+#include <string>
+#include <stdexcept>
+#include <Misc/ThrowStdErr.h>
+#include <IO/OpenFile.h>
+#include <Cluster/Multiplexer.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+namespace {
+
+/**************
+Helper objects:
+**************/
+
+const Misc::UInt32 errorMarker=~Misc::UInt32(0); // Block size announcing an error message instead of file data
+const size_t streamBufferSize=256*1024; // Size of the file's read buffer, and therefore of the blocks streamed to the slave nodes
+
+}
+
+/***********************************
+Methods of class CompressedPipeFile:
+***********************************/
+
+size_t CompressedPipeFile::readData(IO::File::Byte* buffer,size_t bufferSize)
+	{
+	if(pipe->isMaster())
+		{
+		/* Read the next block from the source file: */
+		size_t readSize;
+		try
+			{
+			readSize=source->readUpTo(buffer,bufferSize);
+			}
+		catch(std::runtime_error err)
+			{
+			/* Pass the error on to the slaves and the caller: */
+			sendError(err.what());
+			throw;
+			}
+		
+		/* Stream the block to the slaves: */
+		stream.write<Misc::UInt32>(Misc::UInt32(readSize));
+		stream.write<Byte>(buffer,readSize);
+		stream.flush();
+		
+		return readSize;
+		}
+	else
+		{
+		/* Receive the next block from the master: */
+		Misc::UInt32 readSize=stream.read<Misc::UInt32>();
+		if(readSize==errorMarker)
+			receiveError();
+		if(readSize>bufferSize)
+			Misc::throwStdErr("CompressedPipeFile: Received block larger than read buffer");
+		stream.read<Byte>(buffer,readSize);
+		
+		return readSize;
+		}
+	}
+
+void CompressedPipeFile::sendError(const char* error)
+	{
+	Misc::UInt32 errorLength=Misc::UInt32(strlen(error));
+	stream.write<Misc::UInt32>(errorMarker);
+	stream.write<Misc::UInt32>(errorLength);
+	stream.write<char>(error,errorLength);
+	stream.flush();
+	}
+
+void CompressedPipeFile::receiveError(void)
+	{
+	Misc::UInt32 errorLength=stream.read<Misc::UInt32>();
+	std::string error(errorLength,'\0');
+	if(errorLength>0)
+		stream.read<char>(&error[0],errorLength);
+	throw std::runtime_error(error);
+	}
+
+CompressedPipeFile::CompressedPipeFile(Cluster::Multiplexer* multiplexer,const char* fileName)
+	:IO::File(ReadOnly),
+	 pipe(new Cluster::MulticastPipe(multiplexer)),stream(pipe)
+	{
+	/* Read the file in large blocks to compress efficiently: */
+	resizeReadBuffer(streamBufferSize);
+	
+	try
+		{
+		if(pipe->isMaster())
+			{
+			/* Open the source file and tell the slaves whether it succeeded: */
+			try
+				{
+				source=IO::openFile(fileName);
+				}
+			catch(std::runtime_error err)
+				{
+				sendError(err.what());
+				throw;
+				}
+			stream.write<Misc::UInt32>(0U);
+			stream.flush();
+			}
+		else
+			{
+			/* Check whether the master could open the source file: */
+			if(stream.read<Misc::UInt32>()==errorMarker)
+				receiveError();
+			}
+		}
+	catch(...)
+		{
+		/* Clean up and pass the exception on: */
+		delete pipe;
+		throw;
+		}
+	}
+
+CompressedPipeFile::~CompressedPipeFile(void)
+	{
+	delete pipe;
+	}
+
+}
+
+}
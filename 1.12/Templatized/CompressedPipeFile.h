@@ -0,0 +1,67 @@
+/***********************************************************************
+CompressedPipeFile - Class for files that are read on the master node of
+a cluster and whose contents are streamed to the slave nodes through a
+compressed multicast pipe.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_COMPRESSEDPIPEFILE_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_COMPRESSEDPIPEFILE_INCLUDED
+
+#include <IO/File.h>
+
+#include <Templatized/CompressedPipe.h>
+
+/* Forward declarations: */
+namespace Cluster {
+class Multiplexer;
+}
+
+namespace Visualization {
+
+namespace Templatized {
+
+class CompressedPipeFile:public IO::File
+	{
+	/* Elements: */
+	private:
+	Cluster::MulticastPipe* pipe; // Private pipe to stream the file's contents to the slave nodes
+	CompressedPipe stream; // Compressing wrapper around the private pipe
+	IO::FilePtr source; // The source file on the master node
+	
+	/* Protected methods from IO::File: */
+	protected:
+	virtual size_t readData(Byte* buffer,size_t bufferSize);
+	
+	/* Private methods: */
+	private:
+	void sendError(const char* error); // Sends an error message to the slave nodes
+	void receiveError(void); // Receives an error message from the master node and throws an exception
+	
+	/* Constructors and destructors: */
+	public:
+	CompressedPipeFile(Cluster::Multiplexer* multiplexer,const char* fileName); // Opens the given file for reading on the master node; must be called on all nodes
+	virtual ~CompressedPipeFile(void); // Closes the file; must be called on all nodes
+	};
+
+}
+
+}
+
+#endif
@@ -28,12 +28,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Point.h>
 #include <Geometry/Vector.h>
 #include <Geometry/Box.h>
-#include <Geometry/ValuedPoint.h>
-#include <Geometry/ArrayKdTree.h>
 
 #include <Templatized/Tesseract.h>
 #include <Templatized/LinearIndexID.h>
 #include <Templatized/IteratorWrapper.h>
+#include <Templatized/CellBoxGrid.h>
 
 /* Forward declarations: */
 namespace Visualization {
@@ -275,10 +274,9 @@ class Curvilinear
 		Vector calcGradient(const ScalarExtractorParam& extractor) const; // Calculates gradient at last located position
 		};
 	
-	private:
-	typedef Geometry::ValuedPoint<Point,CellID> CellCenter; // Data type to associate a cell's center point and its ID
-	typedef Geometry::ArrayKdTree<CellCenter> CellCenterTree; // Data type for kd-trees to locate closest cell centers
+	typedef Visualization::Templatized::CellBoxGrid<Curvilinear> CellBoxGrid; // Data type for grids of cell bounding boxes to locate cells containing points
 	
+	private:
 	friend class Vertex;
 	friend class Cell;
 	friend class Locator;
@@ -290,7 +288,7 @@ class Curvilinear
 	int vertexStrides[dimension]; // Array of pointer stride values in the vertex array
 	Index numCells; // Number of cells in data set in each dimension
 	int vertexOffsets[CellTopology::numVertices]; // Array of pointer offsets from a cell's base vertex to all cell vertices
-	CellCenterTree cellCenterTree; // Kd-tree containing cell centers
+	CellBoxGrid cellBoxGrid; // Grid of cell bounding boxes
 	VertexIterator firstVertex,lastVertex; // Bounds of vertex list
 	CellIterator firstCell,lastCell; // Bounds of cell list
 	Box domainBox; // Bounding box of all vertices
@@ -356,7 +354,11 @@ class Curvilinear
 		return numCells;
 		}
 	void finalizeGrid(void); // Recalculates derived grid information after grid structure change
-	CellID findClosestCell(const Point& position) const; // Finds the cell whose center is closest to the given position, or an invalid ID if there is no close cell
+	const CellBoxGrid& getCellBoxGrid(void) const // Returns the grid of cell bounding boxes used for point location
+		{
+		return cellBoxGrid;
+		}
+	CellID findClosestCell(const Point& position) const; // Finds the cell whose center is closest to the given position among the cells whose bounding boxes are close to it, or an invalid ID if there is no close cell
 	Scalar getLocatorEpsilon(void) const // Returns the current default accuracy threshold for locators working on this data set
 		{
 		return locatorEpsilon;
@@ -23,6 +23,16 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_HYPERCUBICLOCATOR_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_HYPERCUBICLOCATOR_INCLUDED
 
+#include <stddef.h>
+
+/* Forward declarations: */
+namespace Visualization {
+namespace Templatized {
+template <class DataSetParam>
+class CellBoxGrid;
+}
+}
+
 namespace Visualization {
 
 namespace Templatized {
@@ -42,10 +52,13 @@ class HypercubicLocator
 	typedef typename DataSet::Cell Cell; // Data set's cell type
 	typedef typename DataSet::Locator Locator; // Data set's locator type
 	typedef typename Locator::CellPosition CellPosition; // Type for cell-relative positions
+	typedef Visualization::Templatized::CellBoxGrid<DataSet> CellBoxGrid; // Type of the data set's index of cell bounding boxes
 	
 	/* Private methods: */
 	private:
 	static bool newtonRaphsonStep(Locator& loc,const Point& position);
+	static Scalar calcCellPosition(Locator& loc,const Point& position,int& maxOutDim,int& maxOutDir); // Iterates the target position's local coordinates in the locator's current cell; returns the largest out-of-cell component and its dimension and direction
+	static bool findCell(Locator& loc,const Point& position); // Moves the locator to the cell containing the target position using the data set's cell box grid; returns false if no cell contains the position
 	
 	/* Methods: */
 	public:
@@ -0,0 +1,148 @@
+/***********************************************************************
+IndexedTriangleFragment - Class to collect a batch of indexed triangles
+in private growable buffers, to be appended to an indexed triangle set
+later. Vertex indices stored in the fragment are local to the fragment.
+Used by worker threads during parallel extraction.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_INDEXEDTRIANGLEFRAGMENT_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_INDEXEDTRIANGLEFRAGMENT_INCLUDED
+
+#include <stddef.h>
+#include <GL/gl.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class VertexParam>
+class IndexedTriangleFragment
+	{
+	/* Embedded classes: */
+	public:
+	typedef VertexParam Vertex; // Type for triangle vertices
+	typedef GLuint Index; // Type for vertex indices
+	
+	/* Elements: */
+	private:
+	size_t numVertices; // Number of vertices in the fragment
+	size_t maxNumVertices; // Number of vertices the vertex buffer can hold
+	Vertex* vertices; // Buffer of vertices
+	size_t numTriangles; // Number of triangles (index triples) in the fragment
+	size_t maxNumTriangles; // Number of triangles the index buffer can hold
+	Index* indices; // Buffer of vertex index triples
+	
+	/* Private methods: */
+	void growVertices(void) // Doubles the size of the vertex buffer
+		{
+		size_t newMaxNumVertices=maxNumVertices!=0?maxNumVertices*2:1024;
+		Vertex* newVertices=new Vertex[newMaxNumVertices];
+		for(size_t i=0;i<numVertices;++i)
+			newVertices[i]=vertices[i];
+		delete[] vertices;
+		maxNumVertices=newMaxNumVertices;
+		vertices=newVertices;
+		}
+	void growIndices(void) // Doubles the size of the index buffer
+		{
+		size_t newMaxNumTriangles=maxNumTriangles!=0?maxNumTriangles*2:1024;
+		Index* newIndices=new Index[newMaxNumTriangles*3];
+		for(size_t i=0;i<numTriangles*3;++i)
+			newIndices[i]=indices[i];
+		delete[] indices;
+		maxNumTriangles=newMaxNumTriangles;
+		indices=newIndices;
+		}
+	
+	/* Constructors and destructors: */
+	public:
+	IndexedTriangleFragment(void) // Creates an empty fragment
+		:numVertices(0),maxNumVertices(0),vertices(0),
+		 numTriangles(0),maxNumTriangles(0),indices(0)
+		{
+		}
+	private:
+	IndexedTriangleFragment(const IndexedTriangleFragment& source); // Prohibit copy constructor
+	IndexedTriangleFragment& operator=(const IndexedTriangleFragment& source); // Prohibit assignment operator
+	public:
+	~IndexedTriangleFragment(void)
+		{
+		delete[] vertices;
+		delete[] indices;
+		}
+	
+	/* Methods: */
+	void clear(void) // Removes all vertices and triangles from the fragment, but keeps the allocated buffers
+		{
+		numVertices=0;
+		numTriangles=0;
+		}
+	Vertex* getNextVertex(void) // Returns pointer to next vertex in buffer
+		{
+		if(numVertices==maxNumVertices)
+			growVertices();
+		return vertices+numVertices;
+		}
+	Index addVertex(void) // Just advances the vertex counter and returns the most recent fragment-local index; assumes caller wrote data into buffer
+		{
+		++numVertices;
+		return Index(numVertices-1);
+		}
+	Index* getNextTriangle(void) // Returns pointer to next index triple in buffer
+		{
+		if(numTriangles==maxNumTriangles)
+			growIndices();
+		return indices+numTriangles*3;
+		}
+	void addTriangle(void) // Just advances the triangle counter; assumes caller wrote data into buffer
+		{
+		++numTriangles;
+		}
+	size_t getNumVertices(void) const // Returns number of vertices in the fragment
+		{
+		return numVertices;
+		}
+	const Vertex* getVertices(void) const // Returns the fragment's vertices
+		{
+		return vertices;
+		}
+	Vertex* getVertices(void) // Ditto
+		{
+		return vertices;
+		}
+	size_t getNumTriangles(void) const // Returns number of triangles in the fragment
+		{
+		return numTriangles;
+		}
+	const Index* getIndices(void) const // Returns the fragment's fragment-local vertex index triples
+		{
+		return indices;
+		}
+	Index* getIndices(void) // Ditto
+		{
+		return indices;
+		}
+	};
+
+}
+
+}
+
+#endif
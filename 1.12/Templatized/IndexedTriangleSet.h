@@ -30,11 +30,18 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 namespace Cluster {
 class MulticastPipe;
 }
+namespace IO {
+class File;
+class SeekableFile;
+}
 
 namespace Visualization {
 
 namespace Templatized {
 
+/* Forward declarations: */
+class CompressedPipe;
+
 template <class VertexParam>
 class IndexedTriangleSet:public GLObject
 	{
@@ -92,7 +99,7 @@ class IndexedTriangleSet:public GLObject
 	
 	/* Elements: */
 	private:
-	Cluster::MulticastPipe* pipe; // Pipe to stream triangle set data in a cluster environment (owned by caller)
+	CompressedPipe* pipe; // Wrapper around the pipe to stream triangle set data in a cluster environment, or 0 in single-machine environment
 	unsigned int version; // Version number of the triangle set (incremented on each clear operation)
 	size_t numVertices; // Number of vertices in the triangle set
 	size_t numTriangles; // Number of triangles (index triples) in the triangle set
@@ -158,8 +165,12 @@ class IndexedTriangleSet:public GLObject
 		--numTrianglesLeft;
 		nextTriangle+=3;
 		}
+	Index addVertices(const Vertex* newVertices,size_t numNewVertices); // Appends the given vertices to the set; returns index of first appended vertex
+	void addTriangles(const Index* newIndices,size_t numNewTriangles,Index indexOffset); // Appends the given index triples to the set after adding the given offset to each index
 	void receive(void); // Receives triangle set data via multicast pipe until next flush() point
 	void flush(void); // Sends pending triangle set data across the multicast pipe and terminates receive() method on slaves
+	void write(IO::File& file) const; // Writes the triangle set to a binary file
+	void read(IO::SeekableFile& file); // Appends a triangle set read from a binary file to the set; throws exception if the file does not match the set's vertex layout or is corrupted; sends the appended data across the multicast pipe on the next flush()
 	size_t getNumVertices(void) const // Returns number of vertices currently in buffer
 		{
 		return numVertices;
@@ -168,6 +179,10 @@ class IndexedTriangleSet:public GLObject
 		{
 		return numTriangles;
 		}
+	size_t getMemorySize(void) const // Returns the size of the stored vertices and vertex indices in bytes
+		{
+		return numVertices*sizeof(Vertex)+numTriangles*3*sizeof(Index);
+		}
 	void glRenderAction(GLContextData& contextData) const; // Renders all triangles in the buffer
 	};
 
@@ -23,7 +23,10 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_ISOSURFACEEXTRACTOR_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_ISOSURFACEEXTRACTOR_INCLUDED
 
+#include <vector>
 #include <Misc/OneTimeQueue.h>
+#include <Threads/Mutex.h>
+#include <Templatized/TriangleFragment.h>
 
 /* Forward declarations: */
 namespace Visualization {
@@ -33,6 +36,8 @@ class Algorithm;
 namespace Templatized {
 template <class CellTopologyParam>
 class IsosurfaceCaseTable;
+template <class DataSetParam,class ScalarExtractorParam>
+class ActiveCellIndex;
 }
 }
 
@@ -53,6 +58,7 @@ class IsosurfaceExtractor
 	typedef typename DataSet::Locator Locator; // Type of data set locators
 	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set
 	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
+	typedef Visualization::Templatized::ActiveCellIndex<DataSet,ScalarExtractor> ActiveCellIndex; // Type of active cell indices for the data set and scalar extractor
 	typedef IsosurfaceParam Isosurface; // Type of isosurface representation
 	
 	enum ExtractionMode // Enumerated type for isosurface extraction modes
@@ -67,21 +73,93 @@ class IsosurfaceExtractor
 	typedef Misc::OneTimeQueue<CellID,CellID> CellQueue; // Type for queues of cell IDs waiting for expansion
 	typedef IsosurfaceCaseTable<CellTopology> CaseTable; // Type of isosurface case table
 	typedef typename Isosurface::Vertex Vertex; // Type of vertices stored in isosurface
+	typedef TriangleFragment<Vertex> Fragment; // Type for isosurface fragments extracted from batches of cells by worker threads
+	typedef typename ActiveCellIndex::CellBlock CellBlock; // Type for blocks of cells reported by active cell indices
+	
+	template <class SurfaceParam>
+	class CellFunctor // Helper class to extract isosurface fragments from the cells of active blocks
+		{
+		/* Elements: */
+		private:
+		const IsosurfaceExtractor* ise; // The isosurface extractor
+		SurfaceParam& surface; // The surface representation receiving the extracted fragments
+		
+		/* Constructors and destructors: */
+		public:
+		CellFunctor(const IsosurfaceExtractor* sIse,SurfaceParam& sSurface)
+			:ise(sIse),surface(sSurface)
+			{
+			}
+		
+		/* Methods: */
+		void operator()(const Cell& cell)
+			{
+			if(ise->extractionMode==FLAT)
+				ise->extractFlatIsosurfaceFragment(cell,surface);
+			else
+				ise->extractSmoothIsosurfaceFragment(cell,surface);
+			}
+		};
+	
+	template <class SurfaceParam>
+	friend class CellFunctor;
+	
+	class BatchJob // Helper class to run batch extraction on a team of worker threads
+		{
+		/* Elements: */
+		private:
+		IsosurfaceExtractor* ise; // The isosurface extractor
+		
+		/* Constructors and destructors: */
+		public:
+		BatchJob(IsosurfaceExtractor* sIse)
+			:ise(sIse)
+			{
+			}
+		
+		/* Methods: */
+		void operator()(unsigned int workerIndex)
+			{
+			ise->extractBatches(workerIndex);
+			}
+		};
+	
+	friend class BatchJob;
 	
 	/* Elements: */
 	private:
 	const DataSet* dataSet; // Data set the isosurface extractor works on
 	ScalarExtractor scalarExtractor; // Scalar extractor working on data set
 	ExtractionMode extractionMode; // Surface extraction mode
+	const ActiveCellIndex* activeCellIndex; // Optional index to find the cells intersecting a global isosurface; 0 to visit all cells
 	
 	/* Isosurface extraction state: */
 	VScalar isovalue; // The current isovalue
 	Isosurface* isosurface; // Pointer to the isosurface representation storing extracted isosurface fragments
 	CellQueue cellQueue; // Queue of cells waiting for fragment extraction
+	std::vector<CellBlock> activeBlocks; // Blocks of cells intersecting the current global isosurface if extracted through the active cell index
+	
+	/* Parallel global isosurface extraction state: */
+	Visualization::Abstract::Algorithm* busyAlgorithm; // Algorithm receiving progress updates during parallel extraction
+	Threads::Mutex batchMutex; // Mutex serializing access to the batch dispatch and merge state
+	size_t numBatchCells; // Total number of cells to extract from
+	size_t batchSize; // Number of cells per batch
+	size_t numBatches; // Total number of batches
+	size_t nextBatch; // Index of the next batch to be handed to a worker
+	std::vector<size_t> batchBlocks; // Indices of the first active block of each batch, followed by the number of active blocks
+	typename DataSet::CellIterator nextBatchCell; // Iterator to the first cell of the next batch to be handed to a worker
+	std::vector<Fragment*> batchFragments; // Fragments extracted from finished batches that have not been merged into the isosurface yet
+	size_t nextMergeBatch; // Index of the next batch to be merged into the isosurface
+	size_t numProcessedCells; // Number of cells in all finished batches
+	int lastPercent; // Last progress percentage reported to the busy algorithm
 	
 	/* Private methods: */
-	int extractFlatIsosurfaceFragment(const Cell& cell); // Extracts a flat-shaded isosurface fragment from a cell and stores it in the current isosurface representation
-	int extractSmoothIsosurfaceFragment(const Cell& cell); // Extracts a gradient-shaded isosurface fragment from a cell and stores it in the current isosurface representation
+	template <class SurfaceParam>
+	int extractFlatIsosurfaceFragment(const Cell& cell,SurfaceParam& surface) const; // Extracts a flat-shaded isosurface fragment from a cell and stores it in the given surface representation
+	template <class SurfaceParam>
+	int extractSmoothIsosurfaceFragment(const Cell& cell,SurfaceParam& surface) const; // Extracts a gradient-shaded isosurface fragment from a cell and stores it in the given surface representation
+	void mergeBatches(void); // Appends the fragments of all finished batches to the isosurface in cell order and reports progress; must only be called from worker 0
+	void extractBatches(unsigned int workerIndex); // Worker method to extract isosurface fragments from batches of cells until all batches are done
 	
 	/* Constructors and destructors: */
 	public:
@@ -113,9 +191,18 @@ class IsosurfaceExtractor
 		{
 		dataSet=newDataSet;
 		scalarExtractor=newScalarExtractor;
+		activeCellIndex=0;
+		}
+	const ActiveCellIndex* getActiveCellIndex(void) const // Returns the active cell index
+		{
+		return activeCellIndex;
+		}
+	void setActiveCellIndex(const ActiveCellIndex* newActiveCellIndex) // Sets an active cell index for the current data set and scalar extractor to speed up global isosurface extraction; 0 to visit all cells
+		{
+		activeCellIndex=newActiveCellIndex;
 		}
 	void setExtractionMode(ExtractionMode newExtractionMode); // Sets the current isosurface extraction mode
-	void extractIsosurface(VScalar newIsovalue,Isosurface& newIsosurface,Visualization::Abstract::Algorithm* algorithm); // Extracts a global isosurface for the given isovalue and stores it in the given isosurface
+	void extractIsosurface(VScalar newIsovalue,Isosurface& newIsosurface,Visualization::Abstract::Algorithm* algorithm); // Extracts a global isosurface for the given isovalue and stores it in the given isosurface; uses all worker threads of the worker pool
 	void extractSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface); // Extracts a seeded isosurface for the given isovalue from the given cell and stores it in the given isosurface
 	void startSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface); // Starts extracting a seeded isosurface for the given isovalue from the given cell
 	template <class ContinueFunctorParam>
@@ -23,9 +23,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_ISOSURFACEEXTRACTORINDEXEDTRIANGLESET_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_ISOSURFACEEXTRACTORINDEXEDTRIANGLESET_INCLUDED
 
+#include <vector>
 #include <Misc/HashTable.h>
 #include <Misc/OneTimeQueue.h>
+#include <Threads/Mutex.h>
 #include <Templatized/IndexedTriangleSet.h>
+#include <Templatized/IndexedTriangleFragment.h>
 #include <Templatized/IsosurfaceExtractor.h>
 
 /* Forward declarations: */
@@ -36,6 +39,8 @@ class Algorithm;
 namespace Templatized {
 template <class CellTopologyParam>
 class IsosurfaceCaseTable;
+template <class DataSetParam,class ScalarExtractorParam>
+class ActiveCellIndex;
 }
 }
 
@@ -56,6 +61,7 @@ class IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<V
 	typedef typename DataSet::Locator Locator; // Type of data set locators
 	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set
 	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
+	typedef Visualization::Templatized::ActiveCellIndex<DataSet,ScalarExtractor> ActiveCellIndex; // Type of active cell indices for the data set and scalar extractor
 	typedef IndexedTriangleSet<VertexParam> Isosurface; // Type of isosurface representation
 	
 	enum ExtractionMode // Enumerated type for isosurface extraction modes
@@ -73,22 +79,146 @@ class IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<V
 	typedef typename Isosurface::Vertex Vertex; // Type of vertices stored in isosurface
 	typedef typename Isosurface::Index Index; // Type for vertex indices
 	typedef Misc::HashTable<EdgeID,Index,EdgeID> VertexIndexHasher; // Hash table to map edge IDs to vertex indices in the isosurface
+	typedef IndexedTriangleFragment<VertexParam> Fragment; // Type for isosurface fragments extracted from batches of cells by worker threads
+	typedef Misc::HashTable<CellID,void,CellID> CellSet; // Type for sets of cell IDs
+	typedef typename ActiveCellIndex::CellBlock CellBlock; // Type for blocks of cells reported by active cell indices
+	
+	struct SharedVertex // Structure for fragment vertices on edges that might be shared with other batches of cells
+		{
+		/* Elements: */
+		public:
+		Index vertexIndex; // Fragment-local index of the vertex
+		EdgeID edgeID; // ID of the edge containing the vertex
+		};
+	
+	struct BatchFragment // Structure for the result of extracting isosurface fragments from a batch of cells
+		{
+		/* Elements: */
+		public:
+		Fragment fragment; // Fragment containing the batch's vertices and triangles
+		std::vector<SharedVertex> sharedVertices; // Vertices of smooth-shaded fragments that have to be reconciled with those of other batches
+		};
+	
+	struct BatchCell // Structure to remember the intersected cells of a batch until the batch's boundary is known
+		{
+		/* Elements: */
+		public:
+		CellID cellID; // ID of the cell
+		int caseIndex; // Isosurface case index of the cell
+		Index edgeVertexIndices[CellTopology::numEdges]; // Fragment-local indices of the vertices on the cell's intersected edges
+		};
+	
+	class BatchJob // Helper class to run batch extraction on a team of worker threads
+		{
+		/* Elements: */
+		private:
+		IsosurfaceExtractor* ise; // The isosurface extractor
+		
+		/* Constructors and destructors: */
+		public:
+		BatchJob(IsosurfaceExtractor* sIse)
+			:ise(sIse)
+			{
+			}
+		
+		/* Methods: */
+		void operator()(unsigned int workerIndex)
+			{
+			ise->extractBatches(workerIndex);
+			}
+		};
+	
+	friend class BatchJob;
+	
+	class CellFunctor // Helper class to extract isosurface fragments from the cells of active blocks into the isosurface
+		{
+		/* Elements: */
+		private:
+		IsosurfaceExtractor* ise; // The isosurface extractor
+		
+		/* Constructors and destructors: */
+		public:
+		CellFunctor(IsosurfaceExtractor* sIse)
+			:ise(sIse)
+			{
+			}
+		
+		/* Methods: */
+		void operator()(const Cell& cell)
+			{
+			if(ise->extractionMode==FLAT)
+				ise->extractFlatIsosurfaceFragment(cell,*ise->isosurface);
+			else
+				{
+				Index edgeVertexIndices[CellTopology::numEdges];
+				ise->extractSmoothIsosurfaceFragment(cell,*ise->isosurface,ise->vertexIndices,edgeVertexIndices);
+				}
+			}
+		};
+	
+	class BatchCellFunctor // Helper class to extract isosurface fragments from the cells of active blocks into a batch fragment
+		{
+		/* Elements: */
+		private:
+		const IsosurfaceExtractor* ise; // The isosurface extractor
+		BatchFragment& batchFragment; // The batch fragment receiving the extracted fragments
+		VertexIndexHasher& fragmentVertexIndices; // Hasher mapping edge IDs to the batch fragment's vertex indices
+		std::vector<BatchCell>& batchCells; // List of the batch's intersected cells
+		
+		/* Constructors and destructors: */
+		public:
+		BatchCellFunctor(const IsosurfaceExtractor* sIse,BatchFragment& sBatchFragment,VertexIndexHasher& sFragmentVertexIndices,std::vector<BatchCell>& sBatchCells)
+			:ise(sIse),batchFragment(sBatchFragment),fragmentVertexIndices(sFragmentVertexIndices),batchCells(sBatchCells)
+			{
+			}
+		
+		/* Methods: */
+		void operator()(const Cell& cell)
+			{
+			ise->extractBatchCell(cell,batchFragment,fragmentVertexIndices,batchCells);
+			}
+		};
+	
+	friend class CellFunctor;
+	friend class BatchCellFunctor;
 	
 	/* Elements: */
 	private:
 	const DataSet* dataSet; // Data set the isosurface extractor works on
 	ScalarExtractor scalarExtractor; // Scalar extractor working on data set
 	ExtractionMode extractionMode; // Surface extraction mode
+	const ActiveCellIndex* activeCellIndex; // Optional index to find the cells intersecting a global isosurface; 0 to visit all cells
 	
 	/* Isosurface extraction state: */
 	VScalar isovalue; // The current isovalue
 	Isosurface* isosurface; // Pointer to the isosurface representation storing extracted isosurface fragments
-	VertexIndexHasher vertexIndices; // Hasher mapping edge IDs to vertex indices in the isosurface
+	VertexIndexHasher vertexIndices; // Hasher mapping edge IDs to vertex indices in the isosurface; only contains vertices shared between batches during parallel extraction
 	CellQueue cellQueue; // Queue of cells waiting for fragment extraction
+	std::vector<CellBlock> activeBlocks; // Blocks of cells intersecting the current global isosurface if extracted through the active cell index
+	
+	/* Parallel global isosurface extraction state: */
+	Visualization::Abstract::Algorithm* busyAlgorithm; // Algorithm receiving progress updates during parallel extraction
+	Threads::Mutex batchMutex; // Mutex serializing access to the batch dispatch and merge state
+	size_t numBatchCells; // Total number of cells to extract from
+	size_t batchSize; // Number of cells per batch
+	size_t numBatches; // Total number of batches
+	size_t nextBatch; // Index of the next batch to be handed to a worker
+	std::vector<size_t> batchBlocks; // Indices of the first active block of each batch, followed by the number of active blocks
+	typename DataSet::CellIterator nextBatchCell; // Iterator to the first cell of the next batch to be handed to a worker
+	std::vector<BatchFragment*> batchFragments; // Fragments extracted from finished batches that have not been merged into the isosurface yet
+	size_t nextMergeBatch; // Index of the next batch to be merged into the isosurface
+	size_t numProcessedCells; // Number of cells in all finished batches
+	int lastPercent; // Last progress percentage reported to the busy algorithm
 	
 	/* Private methods: */
-	int extractFlatIsosurfaceFragment(const Cell& cell); // Extracts a flat-shaded isosurface fragment from a cell and stores it in the current isosurface representation
-	int extractSmoothIsosurfaceFragment(const Cell& cell); // Extracts a gradient-shaded isosurface fragment from a cell and stores it in the current isosurface representation
+	template <class SurfaceParam>
+	int extractFlatIsosurfaceFragment(const Cell& cell,SurfaceParam& surface) const; // Extracts a flat-shaded isosurface fragment from a cell and stores it in the given surface representation
+	template <class SurfaceParam>
+	int extractSmoothIsosurfaceFragment(const Cell& cell,SurfaceParam& surface,VertexIndexHasher& surfaceVertexIndices,Index edgeVertexIndices[CellTopology::numEdges]) const; // Extracts a gradient-shaded isosurface fragment from a cell and stores it in the given surface representation, sharing vertices through the given hasher; returns the surface's indices of the vertices on the cell's intersected edges
+	void extractBatchCell(const Cell& cell,BatchFragment& batchFragment,VertexIndexHasher& fragmentVertexIndices,std::vector<BatchCell>& batchCells) const; // Extracts the isosurface fragment of a cell into the given batch fragment
+	void findSharedVertices(const std::vector<BatchCell>& batchCells,BatchFragment& batchFragment) const; // Collects the vertices of the given batch's smooth-shaded fragment that lie on edges of cells on the batch's boundary
+	void mergeBatches(void); // Appends the fragments of all finished batches to the isosurface in cell order, reconciles their shared vertices, and reports progress; must only be called from worker 0
+	void extractBatches(unsigned int workerIndex); // Worker method to extract isosurface fragments from batches of cells until all batches are done
 	
 	/* Constructors and destructors: */
 	public:
@@ -120,9 +250,18 @@ class IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<V
 		{
 		dataSet=newDataSet;
 		scalarExtractor=newScalarExtractor;
+		activeCellIndex=0;
+		}
+	const ActiveCellIndex* getActiveCellIndex(void) const // Returns the active cell index
+		{
+		return activeCellIndex;
+		}
+	void setActiveCellIndex(const ActiveCellIndex* newActiveCellIndex) // Sets an active cell index for the current data set and scalar extractor to speed up global isosurface extraction; 0 to visit all cells
+		{
+		activeCellIndex=newActiveCellIndex;
 		}
 	void setExtractionMode(ExtractionMode newExtractionMode); // Sets the current isosurface extraction mode
-	void extractIsosurface(VScalar newIsovalue,Isosurface& newIsosurface,Visualization::Abstract::Algorithm* algorithm); // Extracts a global isosurface for the given isovalue and stores it in the given isosurface
+	void extractIsosurface(VScalar newIsovalue,Isosurface& newIsosurface,Visualization::Abstract::Algorithm* algorithm); // Extracts a global isosurface for the given isovalue and stores it in the given isosurface; uses all worker threads of the worker pool
 	void extractSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface); // Extracts a seeded isosurface for the given isovalue from the given cell and stores it in the given isosurface
 	void startSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface); // Starts extracting a seeded isosurface for the given isovalue from the given cell
 	template <class ContinueFunctorParam>
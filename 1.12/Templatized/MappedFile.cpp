@@ -0,0 +1,73 @@
+/***********************************************************************
+MappedFile - Helper class to map a data file copy-on-write into memory,
+to back data set arrays directly with the file's pages.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Templatized/MappedFile.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <Misc/ThrowStdErr.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+/***************************
+Methods of class MappedFile:
+***************************/
+
+MappedFile::MappedFile(const char* fileName)
+	:data(0),size(0)
+	{
+	/* Open the file: */
+	int fd=open(fileName,O_RDONLY);
+	if(fd<0)
+		Misc::throwStdErr("MappedFile::MappedFile: Could not open file %s",fileName);
+	
+	/* Map the entire file copy-on-write, so that concurrent readers share the file's pages: */
+	struct stat fileStats;
+	void* mapping=MAP_FAILED;
+	if(fstat(fd,&fileStats)==0&&fileStats.st_size>0)
+		mapping=mmap(0,size_t(fileStats.st_size),PROT_READ|PROT_WRITE,MAP_PRIVATE,fd,0);
+	close(fd);
+	if(mapping==MAP_FAILED)
+		Misc::throwStdErr("MappedFile::MappedFile: Could not map file %s",fileName);
+	data=static_cast<char*>(mapping);
+	size=size_t(fileStats.st_size);
+	}
+
+MappedFile::~MappedFile(void)
+	{
+	munmap(data,size);
+	}
+
+bool MappedFile::isHostLittleEndian(void)
+	{
+	unsigned int probe=1U;
+	return *reinterpret_cast<unsigned char*>(&probe)==1U;
+	}
+
+}
+
+}
@@ -0,0 +1,68 @@
+/***********************************************************************
+MappedFile - Helper class to map a data file copy-on-write into memory,
+to back data set arrays directly with the file's pages.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_MAPPEDFILE_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_MAPPEDFILE_INCLUDED
+
+#include <stddef.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+class MappedFile
+	{
+	/* Elements: */
+	private:
+	char* data; // Pointer to the mapped file contents
+	size_t size; // Size of the mapped file in bytes
+	
+	/* Constructors and destructors: */
+	public:
+	MappedFile(const char* fileName); // Maps the given file into memory; writes to the mapping are private to the process
+	private:
+	MappedFile(const MappedFile& source); // Prohibit copy constructor
+	MappedFile& operator=(const MappedFile& source); // Prohibit assignment operator
+	public:
+	~MappedFile(void); // Unmaps the file
+	
+	/* Methods: */
+	static bool isHostLittleEndian(void); // Returns true if the host stores multi-byte values in little-endian byte order
+	size_t getSize(void) const // Returns the size of the mapped file in bytes
+		{
+		return size;
+		}
+	const char* getData(void) const // Returns the mapped file contents
+		{
+		return data;
+		}
+	char* getData(void) // Ditto
+		{
+		return data;
+		}
+	};
+
+}
+
+}
+
+#endif
@@ -29,12 +29,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Point.h>
 #include <Geometry/Vector.h>
 #include <Geometry/Box.h>
-#include <Geometry/ValuedPoint.h>
-#include <Geometry/ArrayKdTree.h>
 
 #include <Templatized/Tesseract.h>
 #include <Templatized/LinearIndexID.h>
 #include <Templatized/IteratorWrapper.h>
+#include <Templatized/CellBoxGrid.h>
 
 /* Forward declarations: */
 namespace Visualization {
@@ -363,10 +362,9 @@ class MultiCurvilinear
 		Vector calcGradient(const ScalarExtractorParam& extractor) const; // Calculates gradient at last located position
 		};
 	
-	private:
-	typedef Geometry::ValuedPoint<Point,CellID> CellCenter; // Data type to associate a cell's center point and its ID
-	typedef Geometry::ArrayKdTree<CellCenter> CellCenterTree; // Data type for kd-trees to locate closest cell centers
+	typedef Visualization::Templatized::CellBoxGrid<MultiCurvilinear> CellBoxGrid; // Data type for grids of cell bounding boxes to locate cells containing points
 	
+	private:
 	friend class Vertex;
 	friend class Cell;
 	friend class Locator;
@@ -381,7 +379,7 @@ class MultiCurvilinear
 	EdgeID::Index* edgeIDBases; // Bases of edge IDs for each grid
 	CellID::Index* cellIDBases; // Bases of cell IDs for each grid
 	CellID** gridConnectors; // Arrays mapping outer faces of all grids to stitched grid cells
-	CellCenterTree cellCenterTree; // Kd-tree containing cell centers of all grids
+	CellBoxGrid cellBoxGrid; // Grid of cell bounding boxes of all grids
 	VertexIterator firstVertex,lastVertex; // Bounds of vertex list
 	CellIterator firstCell,lastCell; // Bounds of cell list
 	Box domainBox; // Bounding box of all vertices
@@ -422,7 +420,11 @@ class MultiCurvilinear
 		return grids[gridIndex];
 		}
 	void finalizeGrid(void); // Recalculates derived grid information after grid structure change
-	CellID findClosestCell(const Point& position) const; // Finds the cell whose center is closest to the given position, or an invalid ID if there is no close cell
+	const CellBoxGrid& getCellBoxGrid(void) const // Returns the grid of cell bounding boxes used for point location
+		{
+		return cellBoxGrid;
+		}
+	CellID findClosestCell(const Point& position) const; // Finds the cell whose center is closest to the given position among the cells whose bounding boxes are close to it, or an invalid ID if there is no close cell
 	Scalar getLocatorEpsilon(void) const // Returns the current default accuracy threshold for locators working on this data set
 		{
 		return locatorEpsilon;
@@ -29,11 +29,18 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 namespace Cluster {
 class MulticastPipe;
 }
+namespace IO {
+class File;
+class SeekableFile;
+}
 
 namespace Visualization {
 
 namespace Templatized {
 
+/* Forward declarations: */
+class CompressedPipe;
+
 template <class VertexParam>
 class MultiPolyline:public GLObject
 	{
@@ -98,7 +105,7 @@ class MultiPolyline:public GLObject
 	/* Elements: */
 	private:
 	unsigned int numPolylines; // Number of individual polylines
-	Cluster::MulticastPipe* pipe; // Pipe to stream polyline data in a cluster environment (owned by caller)
+	CompressedPipe* pipe; // Wrapper around the pipe to stream polyline data in a cluster environment, or 0 in single-machine environment
 	unsigned int version; // Version number of the multipolyline (incremented on each clear operation)
 	Polyline* polylines; // Array of individual polylines
 	size_t maxNumVertices; // Maximum number of vertices in any individual polyline
@@ -138,6 +145,8 @@ class MultiPolyline:public GLObject
 		}
 	void receive(void); // Receives multi-polyline data via multicast pipe until next flush() point
 	void flush(void); // Sends pending multi-polyline data across the multicast pipe and terminates receive() method on slaves
+	void write(IO::File& file) const; // Writes all polylines to a binary file
+	void read(IO::SeekableFile& file); // Appends polylines read from a binary file to the polylines; throws exception if the numbers of polylines or the vertex layouts do not match or the file is corrupted; sends the appended data across the multicast pipe on the next flush()
 	unsigned int getNumPolylines(void) const // Returns the number of individual polylines
 		{
 		return numPolylines;
@@ -150,6 +159,13 @@ class MultiPolyline:public GLObject
 		{
 		return maxNumVertices;
 		}
+	size_t getMemorySize(void) const // Returns the size of the stored vertices of all polylines in bytes
+		{
+		size_t numVertices=0;
+		for(unsigned int i=0;i<numPolylines;++i)
+			numVertices+=polylines[i].numVertices;
+		return numVertices*sizeof(Vertex);
+		}
 	void glRenderAction(GLContextData& contextData) const; // Renders the polyline
 	};
 
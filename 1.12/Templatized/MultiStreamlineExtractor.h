@@ -23,6 +23,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_MULTISTREAMLINEEXTRACTOR_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_MULTISTREAMLINEEXTRACTOR_INCLUDED
 
+#include <vector>
+#include <Threads/Mutex.h>
+
 namespace Visualization {
 
 namespace Templatized {
@@ -57,6 +60,28 @@ class MultiStreamlineExtractor
 	private:
 	typedef typename MultiStreamline::Vertex Vertex; // Type of vertices stored in streamlines
 	
+	class StepJob // Helper class to advance streamlines on a team of worker threads
+		{
+		/* Elements: */
+		private:
+		MultiStreamlineExtractor* mse; // The streamline extractor
+		
+		/* Constructors and destructors: */
+		public:
+		StepJob(MultiStreamlineExtractor* sMse)
+			:mse(sMse)
+			{
+			}
+		
+		/* Methods: */
+		void operator()(unsigned int workerIndex)
+			{
+			mse->stepStreamlines();
+			}
+		};
+	
+	friend class StepJob;
+	
 	/* Elements: */
 	private:
 	const DataSet* dataSet; // Data set the isosurface extractor works on
@@ -69,9 +94,17 @@ class MultiStreamlineExtractor
 	StreamlineState* streamlineStates; // Array of streamline states
 	MultiStreamline* multiStreamline; // Pointer to the multi-streamline representations
 	
+	/* Parallel tracing state: */
+	std::vector<std::vector<Vertex> > vertexBuffers; // Per-streamline buffers of the vertices generated during the current round
+	static const unsigned int numRoundSteps=512; // Maximum number of steps by which each streamline advances during a round, independent of the number of workers
+	Threads::Mutex streamlineMutex; // Mutex serializing access to the streamline dispatch counter
+	unsigned int nextStreamline; // Index of the next streamline to be advanced during the current round
+	
 	/* Private methods: */
 	Vector cashKarpStep(unsigned int index,const Vector& vfp1,Scalar trialStepSize,Vector& error); // Computes a trial step vector with Cash-Karp coefficients
-	bool stepStreamline(unsigned int index); // Advances one current streamline position by one step
+	bool stepStreamline(unsigned int index,Vertex& vertex); // Advances one current streamline position by one step and returns the vertex at the previous position; returns false if the streamline left the data set's domain
+	void stepStreamlines(void); // Worker method to advance valid streamlines by up to numRoundSteps steps until all streamlines are done with the current round
+	bool traceRound(void); // Advances all valid streamlines by one round on the worker pool and appends the new vertices to the multi-streamline; returns true if any streamline is still valid
 	
 	/* Constructors and destructors: */
 	public:
@@ -29,11 +29,18 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 namespace Cluster {
 class MulticastPipe;
 }
+namespace IO {
+class File;
+class SeekableFile;
+}
 
 namespace Visualization {
 
 namespace Templatized {
 
+/* Forward declarations: */
+class CompressedPipe;
+
 template <class VertexParam>
 class Polyline:public GLObject
 	{
@@ -73,7 +80,7 @@ class Polyline:public GLObject
 	
 	/* Elements: */
 	private:
-	Cluster::MulticastPipe* pipe; // Pipe to stream polyline data in a cluster environment (owned by caller)
+	CompressedPipe* pipe; // Wrapper around the pipe to stream polyline data in a cluster environment, or 0 in single-machine environment
 	unsigned int version; // Version number of the polyline (incremented on each clear operation)
 	size_t numVertices; // Total number of vertices currently in set
 	Chunk* head; // Pointer to first vertex buffer chunk
@@ -115,10 +122,16 @@ class Polyline:public GLObject
 		}
 	void receive(void); // Receives polyline data via multicast pipe until next flush() point
 	void flush(void); // Sends pending polyline data across the multicast pipe and terminates receive() method on slaves
+	void write(IO::File& file) const; // Writes the polyline to a binary file
+	void read(IO::SeekableFile& file); // Appends a polyline read from a binary file to the polyline; throws exception if the file does not match the polyline's vertex layout or is corrupted; sends the appended data across the multicast pipe on the next flush()
 	size_t getNumVertices(void) const // Returns number of vertices currently in buffer
 		{
 		return numVertices;
 		}
+	size_t getMemorySize(void) const // Returns the size of the stored vertices in bytes
+		{
+		return numVertices*sizeof(Vertex);
+		}
 	void glRenderAction(GLContextData& contextData) const; // Renders the polyline
 	};
 
@@ -0,0 +1,144 @@
+/***********************************************************************
+Profiler - Helper class to collect low-overhead counters and timers on
+the hot paths of point location and visualization element extraction,
+and to aggregate them per extractor. The entire facility is only
+compiled if VISUALIZATION_USE_PROFILING is defined.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Templatized/Profiler.h>
+
+#ifdef VISUALIZATION_USE_PROFILING
+
+namespace Visualization {
+
+namespace Templatized {
+
+/*********************************
+Static elements of class Profiler:
+*********************************/
+
+__thread Profiler::Profile* Profiler::currentProfile=0;
+__thread Profiler::Counters* Profiler::currentCounters=0;
+
+/***********************************
+Methods of class Profiler::Counters:
+***********************************/
+
+Profiler::Counters::Counters(void)
+	{
+	for(int i=0;i<NUM_COUNTERS;++i)
+		counts[i]=0;
+	for(int i=0;i<NUM_TIMERS;++i)
+		times[i]=0.0;
+	}
+
+Profiler::Counters& Profiler::Counters::operator+=(const Profiler::Counters& other)
+	{
+	for(int i=0;i<NUM_COUNTERS;++i)
+		counts[i]+=other.counts[i];
+	for(int i=0;i<NUM_TIMERS;++i)
+		times[i]+=other.times[i];
+	return *this;
+	}
+
+/**********************************
+Methods of class Profiler::Profile:
+**********************************/
+
+Profiler::Profile::Profile(void)
+	{
+	}
+
+void Profiler::Profile::add(const Profiler::Counters& counters)
+	{
+	Threads::Mutex::Lock totalsLock(totalsMutex);
+	totals+=counters;
+	}
+
+Profiler::Counters Profiler::Profile::getTotals(void) const
+	{
+	Threads::Mutex::Lock totalsLock(totalsMutex);
+	return totals;
+	}
+
+void Profiler::Profile::reset(void)
+	{
+	Threads::Mutex::Lock totalsLock(totalsMutex);
+	totals=Counters();
+	}
+
+/********************************
+Methods of class Profiler::Scope:
+********************************/
+
+Profiler::Scope::Scope(Profiler::Profile* sProfile)
+	:profile(sProfile),
+	 previousProfile(currentProfile),previousCounters(currentCounters)
+	{
+	/* Collect the calling thread's counters in this scope: */
+	if(profile!=0)
+		{
+		currentProfile=profile;
+		currentCounters=&counters;
+		}
+	}
+
+Profiler::Scope::~Scope(void)
+	{
+	if(profile!=0)
+		{
+		/* Restore the enclosing scope: */
+		currentProfile=previousProfile;
+		currentCounters=previousCounters;
+		
+		/* Publish the collected counters: */
+		profile->add(counters);
+		}
+	}
+
+/*************************
+Methods of class Profiler:
+*************************/
+
+const char* Profiler::getCounterName(int counterIndex)
+	{
+	static const char* counterNames[NUM_COUNTERS]=
+		{
+		"Extracted elements","Locator queries","Newton-Raphson steps","Cell traversals",
+		"Global cell searches","Cells tested in searches","Extractor cells","Extracted triangles",
+		"Triangle set chunks","Pipe bytes"
+		};
+	return counterNames[counterIndex];
+	}
+
+const char* Profiler::getTimerName(int timerIndex)
+	{
+	static const char* timerNames[NUM_TIMERS]=
+		{
+		"Extraction time","Global search time","Pipe flush time"
+		};
+	return timerNames[timerIndex];
+	}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,172 @@
+/***********************************************************************
+Profiler - Helper class to collect low-overhead counters and timers on
+the hot paths of point location and visualization element extraction,
+and to aggregate them per extractor. The entire facility is only
+compiled if VISUALIZATION_USE_PROFILING is defined.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_PROFILER_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_PROFILER_INCLUDED
+
+#ifdef VISUALIZATION_USE_PROFILING
+
+#include <Misc/SizedTypes.h>
+#include <Misc/Timer.h>
+#include <Threads/Mutex.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+class Profiler
+	{
+	/* Embedded classes: */
+	public:
+	enum Counter // Enumerated type for event counters
+		{
+		EXTRACTED_ELEMENTS=0, // Number of visualization elements extracted
+		LOCATOR_QUERIES, // Number of point location requests
+		LOCATOR_NEWTON_STEPS, // Number of Newton-Raphson steps to calculate local cell coordinates
+		LOCATOR_TRAVERSALS, // Number of steps from a cell to one of its neighbours while tracing a point
+		LOCATOR_GLOBAL_SEARCHES, // Number of fallbacks to a global cell search in a data set's cell box grid
+		LOCATOR_SEARCH_CELLS, // Number of cells tested during global cell searches
+		EXTRACTOR_CELLS, // Number of cells visited by extraction algorithms
+		EXTRACTOR_TRIANGLES, // Number of triangles produced by extraction algorithms
+		TRIANGLE_SET_CHUNKS, // Number of vertex or index buffer chunks allocated by triangle sets
+		PIPE_BYTES, // Number of bytes written into multicast pipes
+		NUM_COUNTERS
+		};
+	
+	enum Timer // Enumerated type for timers
+		{
+		EXTRACTION_TIME=0, // Time spent extracting visualization elements
+		LOCATOR_SEARCH_TIME, // Time spent in global cell searches
+		PIPE_FLUSH_TIME, // Time spent sending buffered data across multicast pipes
+		NUM_TIMERS
+		};
+	
+	struct Counters // Structure holding the values of all counters and timers
+		{
+		/* Elements: */
+		public:
+		Misc::UInt64 counts[NUM_COUNTERS]; // Values of all event counters
+		double times[NUM_TIMERS]; // Values of all timers in seconds
+		
+		/* Constructors and destructors: */
+		Counters(void); // Creates zero counters and timers
+		
+		/* Methods: */
+		Counters& operator+=(const Counters& other); // Adds the given counters and timers
+		};
+	
+	class Profile // Class to aggregate the counters and timers of all threads working for the same client
+		{
+		/* Elements: */
+		private:
+		mutable Threads::Mutex totalsMutex; // Mutex protecting the aggregated counters and timers
+		Counters totals; // Aggregated counters and timers
+		
+		/* Constructors and destructors: */
+		public:
+		Profile(void); // Creates an empty profile
+		
+		/* Methods: */
+		void add(const Counters& counters); // Adds the given counters and timers to the profile
+		Counters getTotals(void) const; // Returns the aggregated counters and timers
+		void reset(void); // Resets all counters and timers to zero
+		};
+	
+	class Scope // Class to collect the counters and timers of the calling thread into a profile for the lifetime of the scope object
+		{
+		/* Elements: */
+		private:
+		Profile* profile; // The profile receiving the counters and timers, or 0 if nothing is collected
+		Counters counters; // Counters and timers collected inside the scope
+		Profile* previousProfile; // Profile active in the calling thread when the scope was entered
+		Counters* previousCounters; // Counters active in the calling thread when the scope was entered
+		
+		/* Constructors and destructors: */
+		public:
+		Scope(Profile* sProfile); // Starts collecting into the given profile if it is not 0
+		private:
+		Scope(const Scope& source); // Prohibit copy constructor
+		Scope& operator=(const Scope& source); // Prohibit assignment operator
+		public:
+		~Scope(void); // Adds the collected counters and timers to the profile
+		};
+	
+	class ScopedTimer // Class to add the lifetime of the timer object to one of the calling thread's timers
+		{
+		/* Elements: */
+		private:
+		Timer timer; // The timer to which to add
+		Misc::Timer clock; // Timer measuring the object's lifetime
+		
+		/* Constructors and destructors: */
+		public:
+		ScopedTimer(Timer sTimer)
+			:timer(sTimer)
+			{
+			}
+		~ScopedTimer(void)
+			{
+			if(currentCounters!=0)
+				{
+				clock.elapse();
+				currentCounters->times[timer]+=clock.getTime();
+				}
+			}
+		};
+	
+	/* Elements: */
+	private:
+	static __thread Profile* currentProfile; // Profile collecting the calling thread's counters and timers, or 0
+	static __thread Counters* currentCounters; // Counters and timers of the calling thread's innermost scope, or 0
+	
+	/* Methods: */
+	public:
+	static const char* getCounterName(int counterIndex); // Returns the display name of the given counter
+	static const char* getTimerName(int timerIndex); // Returns the display name of the given timer
+	static Profile* getCurrentProfile(void) // Returns the profile collecting the calling thread's counters, to collect into it from helper threads
+		{
+		return currentProfile;
+		}
+	static void count(Counter counter,Misc::UInt64 amount =1) // Increments the given counter of the calling thread
+		{
+		if(currentCounters!=0)
+			currentCounters->counts[counter]+=amount;
+		}
+	static void countCell(unsigned int numTriangles) // Counts an extractor cell and the number of triangles it produced
+		{
+		if(currentCounters!=0)
+			{
+			++currentCounters->counts[EXTRACTOR_CELLS];
+			currentCounters->counts[EXTRACTOR_TRIANGLES]+=numTriangles;
+			}
+		}
+	};
+
+}
+
+}
+
+#endif
+
+#endif
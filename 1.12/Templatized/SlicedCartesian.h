@@ -23,6 +23,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_SLICEDCARTESIAN_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_SLICEDCARTESIAN_INCLUDED
 
+#include <vector>
 #include <Misc/ArrayIndex.h>
 #include <Geometry/ComponentArray.h>
 #include <Geometry/Point.h>
@@ -30,10 +31,18 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Box.h>
 
 #include <Templatized/SlicedDataValue.h>
+#include <Templatized/CompactSlice.h>
 #include <Templatized/Tesseract.h>
 #include <Templatized/LinearIndexID.h>
 #include <Templatized/IteratorWrapper.h>
 
+/* Forward declarations: */
+namespace Visualization {
+namespace Templatized {
+class MappedFile;
+}
+}
+
 namespace Visualization {
 
 namespace Templatized {
@@ -254,6 +263,8 @@ class SlicedCartesian
 	Box domainBox; // Bounding box of all vertices
 	int numSlices; // Number of scalar value slices in the data set
 	ValueScalar** slices; // Array of vertex value slices
+	MappedFile** sliceFiles; // Array of memory-mapped files backing vertex value slices, or null for slices allocated by the data set
+	std::vector<CompactSlice*> compactSlices; // Compact representations of vertex value slices; null for slices stored in full
 	
 	/* Private methods: */
 	template <class ScalarExtractorParam>
@@ -268,6 +279,11 @@ class SlicedCartesian
 	/* Data set construction methods: */
 	void setData(const Index& sNumVertices,const Size& sCellSize,int sNumSlices,const ValueScalar* sVertexValues =0); // Sets the number of vertices and cell size of the data set; copies slice-major vertex data if pointer is not null
 	int addSlice(const ValueScalar* sSliceValues =0); // Adds another slice to the data set; copies vertex data if pointer is not null
+	int addMappedSlice(MappedFile* sSliceFile,size_t sliceOffset); // Adds another slice whose vertex values are stored at the given byte offset in the given memory-mapped file; data set takes ownership of the mapped file
+	int addDeferredSlice(void); // Adds another slice to the data set without allocating its vertex data; returns index of new slice
+	ValueScalar* allocateSlice(int sliceIndex); // Allocates the vertex data of a deferred or released slice; returns the slice's value array
+	void releaseSlice(int sliceIndex); // Releases the vertex data of a slice allocated by the data set; the slice must be allocated again before it is accessed
+	void compactSlice(int sliceIndex,CompactSlice::Encoding encoding); // Replaces the vertex data of a complete slice allocated by the data set with a compact representation; compacted slices can only be accessed through the data set's value extractors
 	
 	/* Low-level data access methods: */
 	const Index& getNumVertices(void) const // Returns number of vertices in the data set
@@ -299,6 +315,10 @@ class SlicedCartesian
 		{
 		return slices[sliceIndex][numVertices.calcOffset(vertexIndex)];
 		}
+	const CompactSlice* getCompactSlice(int sliceIndex) const // Returns the compact representation of a value slice, or null if the slice is stored in full
+		{
+		return sliceIndex<int(compactSlices.size())?compactSlices[sliceIndex]:0;
+		}
 	const Index& getNumCells(void) const // Returns number of cells in grid
 		{
 		return numCells;
@@ -24,6 +24,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_SLICEDCURVILINEAR_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_SLICEDCURVILINEAR_INCLUDED
 
+#include <vector>
 #include <Misc/Array.h>
 #include <Geometry/ComponentArray.h>
 #include <Geometry/Point.h>
@@ -33,6 +34,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/ArrayKdTree.h>
 
 #include <Templatized/SlicedDataValue.h>
+#include <Templatized/CompactSlice.h>
 #include <Templatized/Tesseract.h>
 #include <Templatized/LinearIndexID.h>
 #include <Templatized/IteratorWrapper.h>
@@ -264,6 +266,7 @@ class SlicedCurvilinear
 	GridArray grid; // Array defining data set's grid
 	int numSlices; // Number of scalar value slices in data set
 	ValueArray* slices; // Array of arrays defining data set's value slices
+	std::vector<CompactSlice*> compactSlices; // Compact representations of value slices; null for slices stored in full
 	int vertexStrides[dimension]; // Array of pointer stride values in the vertex array
 	Index numCells; // Number of cells in data set in each dimension
 	int vertexOffsets[CellTopology::numVertices]; // Array of pointer offsets from a cell's base vertex to all cell vertices
@@ -289,6 +292,10 @@ class SlicedCurvilinear
 	/* Data set construction methods: */
 	void setGrid(const Index& sNumVertices,const Point* sVertexPositions =0); // Creates a data set with the given number of vertices; copies vertex positions if pointer is not null
 	int addSlice(const ValueScalar* sSliceValues =0); // Adds another slice to the data set; copies slice values from given array if pointer is not null; returns index of new slice
+	int addDeferredSlice(void); // Adds another slice to the data set without allocating its values; returns index of new slice
+	ValueScalar* allocateSlice(int sliceIndex); // Allocates the values of a deferred or released slice; returns the slice's value array
+	void releaseSlice(int sliceIndex); // Releases the values of a slice; the slice must be allocated again before it is accessed
+	void compactSlice(int sliceIndex,CompactSlice::Encoding encoding); // Replaces the values of a complete slice with a compact representation; compacted slices can only be accessed through the data set's value extractors
 	
 	/* Low-level data access methods: */
 	const Index& getNumVertices(void) const // Returns number of vertices in the data set
@@ -339,6 +346,10 @@ class SlicedCurvilinear
 		{
 		return slices[sliceIndex](vertexIndex);
 		}
+	const CompactSlice* getCompactSlice(int sliceIndex) const // Returns the compact representation of a value slice, or null if the slice is stored in full
+		{
+		return sliceIndex<int(compactSlices.size())?compactSlices[sliceIndex]:0;
+		}
 	const Index& getNumCells(void) const // Returns number of cells in grid
 		{
 		return numCells;
@@ -36,6 +36,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/ArrayKdTree.h>
 
 #include <Templatized/SlicedDataValue.h>
+#include <Templatized/CompactSlice.h>
 #include <Templatized/Tesseract.h>
 #include <Templatized/LinearIndexID.h>
 #include <Templatized/IteratorWrapper.h>
@@ -291,6 +292,7 @@ class SlicedHypercubic
 	int numSlices; // Number of scalar value slices in data set
 	size_t allocatedSliceSize; // Allocated size of all slice arrays
 	ValueScalar** slices; // Array of 1D arrays defining data set's value slices
+	std::vector<CompactSlice*> compactSlices; // Compact representations of value slices; null for slices stored in full
 	CellCenterTree cellCenterTree; // Kd-tree containing cell centers
 	VertexIterator firstVertex,lastVertex; // Bounds of vertex list
 	CellIterator firstCell,lastCell; // Bounds of cell list
@@ -314,6 +316,7 @@ class SlicedHypercubic
 	VertexID addVertex(const Point& vertexPosition); // Adds a vertex to the grid; returns vertex' ID
 	CellID addCell(const VertexID cellVertices[CellTopology::numVertices]); // Adds a cell to the grid; returns cell's ID
 	int addSlice(const ValueScalar* sSliceValues =0); // Adds another slice to the data set; copies slice values for all points in all grids from given array if pointer is not null; returns index of new slice
+	void compactSlice(int sliceIndex,CompactSlice::Encoding encoding); // Replaces the values of a slice with a compact representation after all vertices and vertex values have been added; compacted slices can only be accessed through the data set's value extractors
 	
 	/* Low-level data access methods: */
 	const Point& getVertexPosition(VertexIndex vertexIndex) const // Returns position of a vertex
@@ -340,6 +343,10 @@ class SlicedHypercubic
 		{
 		return slices[sliceIndex][vertexIndex];
 		}
+	const CompactSlice* getCompactSlice(int sliceIndex) const // Returns the compact representation of a value slice, or null if the slice is stored in full
+		{
+		return sliceIndex<int(compactSlices.size())?compactSlices[sliceIndex]:0;
+		}
 	void setVertexValue(int sliceIndex,VertexIndex vertexIndex,ValueScalar newValue); // Sets the given vertex' value in the given slice
 	void finalizeGrid(void); // Recalculates derived grid information after grid structure change
 	Scalar getLocatorEpsilon(void) const // Returns the current default accuracy threshold for locators working on this data set
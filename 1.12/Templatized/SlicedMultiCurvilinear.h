@@ -25,6 +25,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_SLICEDMULTICURVILINEAR_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_SLICEDMULTICURVILINEAR_INCLUDED
 
+#include <vector>
 #include <Misc/Array.h>
 #include <Geometry/ComponentArray.h>
 #include <Geometry/Point.h>
@@ -34,6 +35,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/ArrayKdTree.h>
 
 #include <Templatized/SlicedDataValue.h>
+#include <Templatized/CompactSlice.h>
 #include <Templatized/Tesseract.h>
 #include <Templatized/LinearIndexID.h>
 #include <Templatized/IteratorWrapper.h>
@@ -349,6 +351,7 @@ class SlicedMultiCurvilinear
 	size_t totalNumCells; // Total number of cells in all grids
 	int numSlices; // Number of scalar value slices in data set
 	ValueScalar** slices; // Array of 1D arrays defining data set's value slices
+	std::vector<CompactSlice*> compactSlices; // Compact representations of value slices; null for slices stored in full
 	CellCenterTree cellCenterTree; // Kd-tree containing cell centers of all grids
 	CellID** gridConnectors; // Arrays mapping outer faces of all grids to stitched grid cells
 	VertexIterator firstVertex,lastVertex; // Bounds of vertex list
@@ -376,6 +379,7 @@ class SlicedMultiCurvilinear
 	void setGrid(int gridIndex,const Index& sNumVertices,const Point* sVertexPositions =0); // Creates a grid with the given number of vertices; copies vertex positions if pointer is not null
 	int addGrid(const Index& sNumVertices,const Point* sVertexPositions =0); // Adds another grid with the given number of vertices; copies vertex positions if pointer is not null; returns index of new grid
 	int addSlice(const ValueScalar* sSliceValues =0); // Adds another slice to the data set; copies slice values for all points in all grids from given array if pointer is not null; returns index of new slice
+	void compactSlice(int sliceIndex,CompactSlice::Encoding encoding); // Replaces the values of a slice with a compact representation after all grids have been defined; compacted slices can only be accessed through the data set's value extractors
 	
 	/* Low-level data access methods: */
 	const int getNumGrids(void) const // Returns number of grids in the data set
@@ -418,6 +422,10 @@ class SlicedMultiCurvilinear
 		{
 		return slices[sliceIndex][grids[gridIndex].getVertexLinearIndex(vertexIndex)];
 		}
+	const CompactSlice* getCompactSlice(int sliceIndex) const // Returns the compact representation of a value slice, or null if the slice is stored in full
+		{
+		return sliceIndex<int(compactSlices.size())?compactSlices[sliceIndex]:0;
+		}
 	void finalizeGrid(void); // Recalculates derived grid information after grid structure change
 	Scalar getLocatorEpsilon(void) const // Returns the current default accuracy threshold for locators working on this data set
 		{
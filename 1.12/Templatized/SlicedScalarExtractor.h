@@ -26,6 +26,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <stddef.h>
 
 #include <Templatized/SlicedDataValue.h>
+#include <Templatized/CompactSlice.h>
 
 /* Forward declarations: */
 namespace Visualization {
@@ -51,12 +52,17 @@ class ScalarExtractor<ScalarParam,SlicedDataValue<SourceValueScalarParam> >
 	/* Elements: */
 	private:
 	int sliceIndex; // Index of the value slice from which this extractor reads
-	const SourceValueScalar* valueArray; // Pointer to the used slice value array
+	const SourceValueScalar* valueArray; // Pointer to the used slice value array, or 0 if the slice is stored in compact form
+	const CompactSlice* compactSlice; // Pointer to the used compact slice if the slice is not stored in full
 	
 	/* Constructors and destructors: */
 	public:
 	ScalarExtractor(int sSliceIndex,const SourceValueScalar* sValueArray) // Creates extractor for given value array
-		:sliceIndex(sSliceIndex),valueArray(sValueArray)
+		:sliceIndex(sSliceIndex),valueArray(sValueArray),compactSlice(0)
+		{
+		}
+	ScalarExtractor(int sSliceIndex,const CompactSlice* sCompactSlice) // Creates extractor for given compact slice
+		:sliceIndex(sSliceIndex),valueArray(0),compactSlice(sCompactSlice)
 		{
 		}
 	
@@ -67,7 +73,10 @@ class ScalarExtractor<ScalarParam,SlicedDataValue<SourceValueScalarParam> >
 		}
 	DestValue getValue(ptrdiff_t linearIndex) const // Extracts scalar from given linear index in slice value array
 		{
-		return DestValue(valueArray[linearIndex]);
+		if(valueArray!=0)
+			return DestValue(valueArray[linearIndex]);
+		else
+			return DestValue(compactSlice->getValue(linearIndex));
 		}
 	};
 
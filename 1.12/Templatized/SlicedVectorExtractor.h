@@ -27,6 +27,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Vector.h>
 
 #include <Templatized/SlicedDataValue.h>
+#include <Templatized/CompactSlice.h>
 
 /* Forward declarations: */
 namespace Visualization {
@@ -52,11 +53,14 @@ class VectorExtractor<VectorParam,SlicedDataValue<SourceValueScalarParam> >
 	
 	/* Elements: */
 	private:
-	const SourceValueScalar* valueArrays[dimension]; // Pointers to the used slice value arrays
+	const SourceValueScalar* valueArrays[dimension]; // Pointers to the used slice value arrays; 0 for slices stored in compact form
+	const CompactSlice* compactSlices[dimension]; // Pointers to the used compact slices for components whose slices are not stored in full
+	bool compact; // Flag if any component's slice is stored in compact form
 	
 	/* Constructors and destructors: */
 	public:
 	VectorExtractor(void) // Creates an undefined vector extractor
+		:compact(false)
 		{
 		}
 	
@@ -64,12 +68,32 @@ class VectorExtractor<VectorParam,SlicedDataValue<SourceValueScalarParam> >
 	void setSlice(int sliceIndex,const SourceValueScalar* sValueArray) // Sets the value array for one result vector component
 		{
 		valueArrays[sliceIndex]=sValueArray;
+		compactSlices[sliceIndex]=0;
+		}
+	void setSlice(int sliceIndex,const CompactSlice* sCompactSlice) // Sets the compact slice for one result vector component
+		{
+		valueArrays[sliceIndex]=0;
+		compactSlices[sliceIndex]=sCompactSlice;
+		compact=true;
 		}
 	DestValue getValue(ptrdiff_t linearIndex) const // Extracts vector from given linear index in all slice value arrays
 		{
 		DestValue result;
-		for(int i=0;i<dimension;++i)
-			result[i]=typename Vector::Scalar(valueArrays[i][linearIndex]);
+		if(!compact)
+			{
+			for(int i=0;i<dimension;++i)
+				result[i]=typename Vector::Scalar(valueArrays[i][linearIndex]);
+			}
+		else
+			{
+			for(int i=0;i<dimension;++i)
+				{
+				if(valueArrays[i]!=0)
+					result[i]=typename Vector::Scalar(valueArrays[i][linearIndex]);
+				else
+					result[i]=typename Vector::Scalar(compactSlices[i]->getValue(linearIndex));
+				}
+			}
 		return result;
 		}
 	};
@@ -0,0 +1,102 @@
+/***********************************************************************
+TriangleFragment - Class to collect a batch of unconnected triangles in
+a private growable buffer, to be appended to a triangle set later. Used
+by worker threads during parallel extraction.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_TRIANGLEFRAGMENT_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_TRIANGLEFRAGMENT_INCLUDED
+
+#include <stddef.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class VertexParam>
+class TriangleFragment
+	{
+	/* Embedded classes: */
+	public:
+	typedef VertexParam Vertex; // Type for triangle vertices
+	
+	/* Elements: */
+	private:
+	size_t numTriangles; // Number of triangles in the fragment
+	size_t maxNumTriangles; // Number of triangles the vertex buffer can hold
+	Vertex* vertices; // Buffer of triangle vertices
+	
+	/* Private methods: */
+	void grow(void) // Doubles the size of the vertex buffer
+		{
+		size_t newMaxNumTriangles=maxNumTriangles!=0?maxNumTriangles*2:1024;
+		Vertex* newVertices=new Vertex[newMaxNumTriangles*3];
+		for(size_t i=0;i<numTriangles*3;++i)
+			newVertices[i]=vertices[i];
+		delete[] vertices;
+		maxNumTriangles=newMaxNumTriangles;
+		vertices=newVertices;
+		}
+	
+	/* Constructors and destructors: */
+	public:
+	TriangleFragment(void) // Creates an empty fragment
+		:numTriangles(0),maxNumTriangles(0),vertices(0)
+		{
+		}
+	private:
+	TriangleFragment(const TriangleFragment& source); // Prohibit copy constructor
+	TriangleFragment& operator=(const TriangleFragment& source); // Prohibit assignment operator
+	public:
+	~TriangleFragment(void)
+		{
+		delete[] vertices;
+		}
+	
+	/* Methods: */
+	void clear(void) // Removes all triangles from the fragment, but keeps the allocated buffer
+		{
+		numTriangles=0;
+		}
+	Vertex* getNextTriangleVertices(void) // Returns pointer to next vertex triple in buffer
+		{
+		if(numTriangles==maxNumTriangles)
+			grow();
+		return vertices+numTriangles*3;
+		}
+	void addTriangle(void) // Just advances the triangle counter; assumes caller wrote data into buffer
+		{
+		++numTriangles;
+		}
+	size_t getNumTriangles(void) const // Returns number of triangles in the fragment
+		{
+		return numTriangles;
+		}
+	const Vertex* getVertices(void) const // Returns the fragment's triangle vertices
+		{
+		return vertices;
+		}
+	};
+
+}
+
+}
+
+#endif
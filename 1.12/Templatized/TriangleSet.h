@@ -30,11 +30,18 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 namespace Cluster {
 class MulticastPipe;
 }
+namespace IO {
+class File;
+class SeekableFile;
+}
 
 namespace Visualization {
 
 namespace Templatized {
 
+/* Forward declarations: */
+class CompressedPipe;
+
 template <class VertexParam>
 class TriangleSet:public GLObject
 	{
@@ -74,7 +81,7 @@ class TriangleSet:public GLObject
 	
 	/* Elements: */
 	private:
-	Cluster::MulticastPipe* pipe; // Pipe to stream triangle set data in a cluster environment (owned by caller)
+	CompressedPipe* pipe; // Wrapper around the pipe to stream triangle set data in a cluster environment, or 0 in single-machine environment
 	unsigned int version; // Version number of the triangle set (incremented on each clear operation)
 	size_t numTriangles; // Total number of triangles currently in set
 	Chunk* head; // Pointer to first triangle buffer chunk
@@ -114,12 +121,19 @@ class TriangleSet:public GLObject
 		--tailRoomLeft;
 		nextVertex+=3;
 		}
+	void addTriangles(const Vertex* triangleVertices,size_t numNewTriangles); // Appends the given number of triangles, stored as consecutive vertex triples, to the set
 	void receive(void); // Receives triangle set data via multicast pipe until next flush() point
 	void flush(void); // Sends pending triangle set data across the multicast pipe and terminates receive() method on slaves
+	void write(IO::File& file) const; // Writes the triangle set to a binary file
+	void read(IO::SeekableFile& file); // Appends a triangle set read from a binary file to the set; throws exception if the file does not match the set's vertex layout or is corrupted; sends the appended data across the multicast pipe on the next flush()
 	size_t getNumTriangles(void) const // Returns number of triangles currently in buffer
 		{
 		return numTriangles;
 		}
+	size_t getMemorySize(void) const // Returns the size of the stored triangle vertices in bytes
+		{
+		return numTriangles*3*sizeof(Vertex);
+		}
 	void glRenderAction(GLContextData& contextData) const; // Renders all triangles in the buffer
 	};
 
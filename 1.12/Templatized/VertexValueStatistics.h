@@ -0,0 +1,142 @@
+/***********************************************************************
+VertexValueStatistics - Generic class to calculate the range, mean, and
+histogram of values associated with a data set's vertices in parallel.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_VERTEXVALUESTATISTICS_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_VERTEXVALUESTATISTICS_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+#include <Threads/Mutex.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class DataSetParam,class ValueFunctorParam>
+class VertexValueStatistics
+	{
+	/* Embedded classes: */
+	public:
+	typedef DataSetParam DataSet; // Type of data set whose vertices are evaluated
+	typedef ValueFunctorParam ValueFunctor; // Type of functor returning a scalar value for a vertex of the data set
+	typedef typename ValueFunctor::Scalar VScalar; // Value type of the functor
+	static const size_t chunkSize=65536; // Number of vertices processed by a worker thread at a time
+	
+	private:
+	typedef typename DataSet::VertexIterator VertexIterator; // Type of the data set's vertex iterators
+	
+	class StatisticsJob // Helper class to run one pass over all vertices on a team of worker threads
+		{
+		/* Elements: */
+		private:
+		VertexValueStatistics* vvs; // The statistics calculator
+		
+		/* Constructors and destructors: */
+		public:
+		StatisticsJob(VertexValueStatistics* sVvs)
+			:vvs(sVvs)
+			{
+			}
+		
+		/* Methods: */
+		void operator()(unsigned int workerIndex)
+			{
+			vvs->processChunks(workerIndex);
+			}
+		};
+	
+	friend class StatisticsJob;
+	
+	struct WorkerState // Structure for the partial results of a worker thread
+		{
+		/* Elements: */
+		public:
+		bool haveRange; // Flag if the worker has processed any vertices
+		VScalar min,max; // Range of values processed by the worker
+		std::vector<size_t> bins; // Histogram of values processed by the worker
+		};
+	
+	/* Elements: */
+	const DataSet& dataSet; // The evaluated data set
+	const ValueFunctor& valueFunctor; // The functor returning a scalar value for each vertex
+	int numBins; // Number of histogram bins
+	size_t numValues; // Number of evaluated vertices
+	VScalar min,max; // Range of values
+	double mean; // Mean value
+	std::vector<size_t> bins; // Histogram of values in equal-sized bins covering the value range
+	
+	/* Parallel calculation state: */
+	int pass; // Index of the current pass over all vertices; 0 calculates range and sums, 1 calculates the histogram
+	Threads::Mutex chunkMutex; // Mutex serializing access to the chunk dispatch state
+	size_t numChunks; // Number of chunks of vertices
+	size_t nextChunk; // Index of the next chunk to be handed to a worker
+	VertexIterator nextChunkVertex; // Iterator to the first vertex of the next chunk to be handed to a worker
+	std::vector<double> chunkSums; // Sums of the values in each chunk, added in chunk order to keep the mean reproducible
+	std::vector<WorkerState> workerStates; // Partial results of all worker threads
+	
+	/* Private methods: */
+	void processChunks(unsigned int workerIndex); // Worker method to process chunks of vertices until all chunks are done
+	
+	/* Constructors and destructors: */
+	public:
+	VertexValueStatistics(const DataSet& sDataSet,const ValueFunctor& sValueFunctor,int sNumBins); // Calculates statistics of the values of all vertices of the given data set using all worker threads of the worker pool; skips the histogram if numBins is zero
+	private:
+	VertexValueStatistics(const VertexValueStatistics& source); // Prohibit copy constructor
+	VertexValueStatistics& operator=(const VertexValueStatistics& source); // Prohibit assignment operator
+	
+	/* Methods: */
+	public:
+	size_t getNumValues(void) const // Returns the number of evaluated vertices
+		{
+		return numValues;
+		}
+	VScalar getMin(void) const // Returns the minimum value
+		{
+		return min;
+		}
+	VScalar getMax(void) const // Returns the maximum value
+		{
+		return max;
+		}
+	double getMean(void) const // Returns the mean value
+		{
+		return mean;
+		}
+	int getNumBins(void) const // Returns the number of histogram bins
+		{
+		return numBins;
+		}
+	size_t getBin(int binIndex) const // Returns the number of values in the given histogram bin
+		{
+		return bins[binIndex];
+		}
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_VERTEXVALUESTATISTICS_IMPLEMENTATION
+#include <Templatized/VertexValueStatistics.icpp>
+#endif
+
+#endif
@@ -0,0 +1,147 @@
+/***********************************************************************
+VolumeFilter - Generic class to run separable and sliding-window filters
+over three-dimensional arrays of integer voxel values in parallel, to
+preprocess image stacks.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_VOLUMEFILTER_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_VOLUMEFILTER_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+#include <Threads/Mutex.h>
+
+/* Forward declarations: */
+namespace Misc {
+template <class ContentParam,int dimensionParam>
+class Array;
+}
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class ValueParam>
+class VolumeFilter
+	{
+	/* Embedded classes: */
+	public:
+	typedef ValueParam Value; // Type of voxel values
+	
+	private:
+	enum Filter // Enumerated type for filters applied to lines of voxels
+		{
+		MINIMUM,MAXIMUM,MEDIAN,LOWPASS,BOX,SPHERE
+		};
+	
+	class FilterJob // Helper class to filter lines of voxels on a team of worker threads
+		{
+		/* Elements: */
+		private:
+		VolumeFilter* vf; // The volume filter
+		
+		/* Constructors and destructors: */
+		public:
+		FilterJob(VolumeFilter* sVf)
+			:vf(sVf)
+			{
+			}
+		
+		/* Methods: */
+		void operator()(unsigned int workerIndex)
+			{
+			vf->filterLines(workerIndex);
+			}
+		};
+	
+	friend class FilterJob;
+	
+	struct MinOp // Operator selecting the smaller of two values
+		{
+		/* Methods: */
+		public:
+		static Value apply(Value v1,Value v2)
+			{
+			return v1<v2?v1:v2;
+			}
+		};
+	
+	struct MaxOp // Operator selecting the larger of two values
+		{
+		/* Methods: */
+		public:
+		static Value apply(Value v1,Value v2)
+			{
+			return v1>v2?v1:v2;
+			}
+		};
+	
+	/* Elements: */
+	Value* data; // Pointer to the filtered voxel values
+	int size[3]; // Number of voxels in each dimension
+	ptrdiff_t increments[3]; // Pointer increments between neighboring voxels in each dimension
+	
+	/* Parallel filtering state: */
+	Filter filter; // Filter applied in the current pass
+	int direction; // Dimension along which lines of voxels are filtered in the current pass
+	int filterSize; // Half width of the current pass's filter window
+	Value sphereValue; // Reference value for the sphere filter
+	const Value* source; // Unfiltered copy of the voxel values for the sphere filter, laid out with the last dimension varying fastest
+	std::vector<int> sphereRows; // Offsets in the first two dimensions and half widths in the last dimension of the voxel rows making up the sphere filter's sphere
+	Threads::Mutex slabMutex; // Mutex serializing access to the slab dispatch state
+	int numSlabs; // Number of slabs of lines in the current pass
+	int nextSlab; // Index of the next slab of lines to be handed to a worker
+	
+	/* Private methods: */
+	template <class OpParam>
+	static void vanHerkLine(const Value* in,Value* out,int n,int k,Value* prefix,Value* suffix); // Applies a sliding-window minimum or maximum of half width k to a line of n values using the van Herk/Gil-Werman algorithm
+	static void medianLine(const Value* in,Value* out,int n); // Applies a median-of-three filter to a line of n values, leaving the end values unchanged
+	static void lowpassLine(const Value* in,Value* out,int n); // Applies a 1-2-3-2-1 lowpass filter to a line of n values using running box sums
+	static void boxLine(const Value* in,Value* out,int n,int k); // Replaces each of a line of n values with the mean of the values within half width k using a running sum
+	void filterLines(unsigned int workerIndex); // Worker method to filter slabs of voxel lines until all slabs are done
+	void runPass(Filter newFilter,int newDirection,int newFilterSize); // Filters all voxel lines in one direction using all worker threads of the worker pool
+	
+	/* Constructors and destructors: */
+	public:
+	VolumeFilter(Misc::Array<Value,3>& array); // Creates a filter for the given array
+	VolumeFilter(Value* sData,const int sSize[3],const ptrdiff_t sIncrements[3]); // Creates a filter for a voxel array of the given size and pointer increments
+	private:
+	VolumeFilter(const VolumeFilter& source); // Prohibit copy constructor
+	VolumeFilter& operator=(const VolumeFilter& source); // Prohibit assignment operator
+	
+	/* Methods: */
+	public:
+	void minimumFilter(int newFilterSize); // Replaces each voxel with the minimum of the cube of half width filterSize around it
+	void maximumFilter(int newFilterSize); // Replaces each voxel with the maximum of the cube of half width filterSize around it
+	void medianFilter(int newDirection); // Replaces each voxel with the median of itself and its two neighbors along the given direction
+	void lowpassFilter(int newDirection); // Applies a five-tap 1-2-3-2-1 lowpass filter along the given direction
+	void boxFilter(int newFilterSize); // Replaces each voxel with the mean of the cube of half width filterSize around it
+	void sphereFilter(int radius,Value newSphereValue); // Replaces each voxel with the RMS deviation of the voxels in the sphere of the given radius around it from the given value
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_VOLUMEFILTER_IMPLEMENTATION
+#include <Templatized/VolumeFilter.icpp>
+#endif
+
+#endif
@@ -23,6 +23,10 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_VOLUMERENDERINGSAMPLER_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_VOLUMERENDERINGSAMPLER_INCLUDED
 
+#include <stddef.h>
+#include <vector>
+#include <Threads/Mutex.h>
+
 /* Forward declarations: */
 namespace Cluster {
 class MulticastPipe;
@@ -37,6 +41,9 @@ namespace Visualization {
 
 namespace Templatized {
 
+/* Forward declarations: */
+class CompressedPipe;
+
 template <class DataSetParam>
 class VolumeRenderingSampler
 	{
@@ -48,6 +55,49 @@ class VolumeRenderingSampler
 	typedef typename DataSet::Box Box; // Type for domain boxes
 	typedef typename Box::Size Size; // Type for domain sizes
 	
+	private:
+	template <class ScalarExtractorParam,class VoxelParam>
+	class SampleJob // Helper class to sample slices of a voxel block on a team of worker threads
+		{
+		/* Embedded classes: */
+		public:
+		typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from the data set
+		typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
+		typedef VoxelParam Voxel; // Type of voxels in the voxel block
+		
+		/* Elements: */
+		private:
+		const VolumeRenderingSampler& sampler; // The sampler
+		const ScalarExtractor& scalarExtractor; // The scalar extractor
+		VScalar sampleFactor,sampleOffset; // Conversion factors from scalar values to voxel values
+		Voxel outOfDomainVoxel; // Voxel value for samples outside the data set's domain
+		Voxel* voxels; // Pointer to the voxel block
+		const ptrdiff_t* voxelStrides; // Strides of the voxel block
+		const int* dims; // Dimensions of the voxel block sorted by decreasing stride
+		CompressedPipe* pipe; // Pipe to stream spans of voxels to the slaves, or 0
+		Voxel* spanBuffer; // Buffer to stream spans of voxels
+		float percentageScale,percentageOffset; // Scaling factors for progress reports
+		Visualization::Abstract::Algorithm* algorithm; // Algorithm receiving progress reports
+		Threads::Mutex sliceMutex; // Mutex serializing access to the slice dispatch state
+		unsigned int nextSlice; // Index of the next slice to be handed to a worker
+		std::vector<bool> sliceDone; // Flags for slices that have been sampled completely
+		unsigned int nextStreamSlice; // Index of the next slice to be streamed to the slaves
+		
+		/* Private methods: */
+		void sampleSlice(typename DataSet::Locator& locator,unsigned int slice); // Samples one slice of the voxel block
+		
+		/* Constructors and destructors: */
+		public:
+		SampleJob(const VolumeRenderingSampler& sSampler,const ScalarExtractor& sScalarExtractor,VScalar minValue,VScalar maxValue,VScalar outOfDomainValue,Voxel* sVoxels,const ptrdiff_t sVoxelStrides[3],const int sDims[3],CompressedPipe* sPipe,Voxel* sSpanBuffer,float sPercentageScale,float sPercentageOffset,Visualization::Abstract::Algorithm* sAlgorithm);
+		
+		/* Methods: */
+		void streamSlices(void); // Streams all finished slices to the slaves in order and reports progress; must only be called from worker 0
+		void operator()(unsigned int workerIndex); // Worker method to sample slices until all slices are done
+		};
+	
+	template <class ScalarExtractorParam,class VoxelParam>
+	friend class SampleJob;
+	
 	/* Elements: */
 	private:
 	const DataSet& dataSet; // The data set from which the sampler samples
@@ -65,7 +115,7 @@ class VolumeRenderingSampler
 		return samplerSize;
 		}
 	template <class ScalarExtractorParam,class VoxelParam>
-	void sample(const ScalarExtractorParam& scalarExtractor,typename ScalarExtractorParam::Scalar minValue,typename ScalarExtractorParam::Scalar maxValue,typename ScalarExtractorParam::Scalar outOfDomainValue,VoxelParam* voxels,const ptrdiff_t voxelStrides[3],Cluster::MulticastPipe* pipe,float percentageScale,float percentageOffset,Visualization::Abstract::Algorithm* algorithm) const; // Samples scalar values from the given scalar extractor into the given voxel block
+	void sample(const ScalarExtractorParam& scalarExtractor,typename ScalarExtractorParam::Scalar minValue,typename ScalarExtractorParam::Scalar maxValue,typename ScalarExtractorParam::Scalar outOfDomainValue,VoxelParam* voxels,const ptrdiff_t voxelStrides[3],Cluster::MulticastPipe* pipe,float percentageScale,float percentageOffset,Visualization::Abstract::Algorithm* algorithm) const; // Samples scalar values from the given scalar extractor into the given voxel block using all worker threads of the worker pool
 	};
 
 }
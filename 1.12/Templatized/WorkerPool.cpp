@@ -0,0 +1,103 @@
+/***********************************************************************
+WorkerPool - Helper class to run data-parallel jobs on a team of worker
+threads, to distribute extraction and data loading work across all
+available CPUs.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Templatized/WorkerPool.h>
+
+#include <unistd.h>
+#include <new>
+#include <stdexcept>
+
+namespace Visualization {
+
+namespace Templatized {
+
+/***********************************
+Static elements of class WorkerPool:
+***********************************/
+
+unsigned int WorkerPool::numWorkers=0;
+__thread bool WorkerPool::insidePool=false;
+
+/***************************
+Methods of class WorkerPool:
+***************************/
+
+void WorkerPool::rethrow(WorkerPool::ErrorType errorType,const std::string& error)
+	{
+	switch(errorType)
+		{
+		case BAD_ALLOC:
+			throw std::bad_alloc();
+		
+		case RANGE_ERROR:
+			throw std::range_error(error);
+		
+		case OVERFLOW_ERROR:
+			throw std::overflow_error(error);
+		
+		case UNDERFLOW_ERROR:
+			throw std::underflow_error(error);
+		
+		case LOGIC_ERROR:
+			throw std::logic_error(error);
+		
+		case DOMAIN_ERROR:
+			throw std::domain_error(error);
+		
+		case INVALID_ARGUMENT:
+			throw std::invalid_argument(error);
+		
+		case LENGTH_ERROR:
+			throw std::length_error(error);
+		
+		case OUT_OF_RANGE:
+			throw std::out_of_range(error);
+		
+		default:
+			throw std::runtime_error(error);
+		}
+	}
+
+unsigned int WorkerPool::getNumCpus(void)
+	{
+	#ifdef _SC_NPROCESSORS_ONLN
+	long numCpus=sysconf(_SC_NPROCESSORS_ONLN);
+	if(numCpus>=1)
+		return (unsigned int)numCpus;
+	#endif
+	return 1;
+	}
+
+unsigned int WorkerPool::getNumWorkers(void)
+	{
+	return numWorkers!=0?numWorkers:getNumCpus();
+	}
+
+void WorkerPool::setNumWorkers(unsigned int newNumWorkers)
+	{
+	numWorkers=newNumWorkers;
+	}
+
+}
+
+}
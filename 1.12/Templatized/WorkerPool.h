@@ -0,0 +1,250 @@
+/***********************************************************************
+WorkerPool - Helper class to run data-parallel jobs on a team of worker
+threads, to distribute extraction and data loading work across all
+available CPUs.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_WORKERPOOL_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_WORKERPOOL_INCLUDED
+
+#include <string>
+#include <new>
+#include <exception>
+#include <stdexcept>
+#include <Threads/Thread.h>
+
+#ifdef VISUALIZATION_USE_PROFILING
+#include <Templatized/Profiler.h>
+#endif
+
+namespace Visualization {
+
+namespace Templatized {
+
+class WorkerPool
+	{
+	/* Embedded classes: */
+	private:
+	enum ErrorType // Enumerated type for the standard exception classes forwarded from worker threads
+		{
+		NO_ERROR=0,BAD_ALLOC,RUNTIME_ERROR,RANGE_ERROR,OVERFLOW_ERROR,UNDERFLOW_ERROR,
+		LOGIC_ERROR,DOMAIN_ERROR,INVALID_ARGUMENT,LENGTH_ERROR,OUT_OF_RANGE
+		};
+	
+	template <class JobParam>
+	class Worker // Class to run one worker's share of a job in a separate thread
+		{
+		/* Elements: */
+		public:
+		JobParam* job; // Pointer to the job
+		unsigned int workerIndex; // Index of this worker in its team
+		ErrorType errorType; // Standard exception class of the exception thrown in this worker, or NO_ERROR
+		std::string error; // Error message of the exception thrown in this worker
+		#ifdef VISUALIZATION_USE_PROFILING
+		Profiler::Profile* profile; // Profile collecting the counters of the thread that started the job, or 0
+		#endif
+		
+		/* Constructors and destructors: */
+		Worker(void)
+			:job(0),workerIndex(0),errorType(NO_ERROR)
+			 #ifdef VISUALIZATION_USE_PROFILING
+			 ,profile(0)
+			 #endif
+			{
+			}
+		
+		/* Methods: */
+		void fail(ErrorType newErrorType,const char* what) // Records an exception thrown by the job
+			{
+			errorType=newErrorType;
+			try
+				{
+				error=what;
+				}
+			catch(...)
+				{
+				/* Report the failure as a memory allocation failure if the message cannot be stored: */
+				errorType=BAD_ALLOC;
+				}
+			}
+		void* threadMethod(void) // Runs the job's share; never lets an exception escape the thread
+			{
+			#ifdef VISUALIZATION_USE_PROFILING
+			/* Collect this worker's counters into the profile of the thread that started the job: */
+			Profiler::Scope profilerScope(profile);
+			#endif
+			
+			/* Mark the executing thread as a pool worker so that nested runs execute serially: */
+			bool wasInsidePool=insidePool;
+			insidePool=true;
+			
+			try
+				{
+				(*job)(workerIndex);
+				}
+			catch(const std::bad_alloc& err)
+				{
+				errorType=BAD_ALLOC;
+				}
+			catch(const std::range_error& err)
+				{
+				fail(RANGE_ERROR,err.what());
+				}
+			catch(const std::overflow_error& err)
+				{
+				fail(OVERFLOW_ERROR,err.what());
+				}
+			catch(const std::underflow_error& err)
+				{
+				fail(UNDERFLOW_ERROR,err.what());
+				}
+			catch(const std::domain_error& err)
+				{
+				fail(DOMAIN_ERROR,err.what());
+				}
+			catch(const std::invalid_argument& err)
+				{
+				fail(INVALID_ARGUMENT,err.what());
+				}
+			catch(const std::length_error& err)
+				{
+				fail(LENGTH_ERROR,err.what());
+				}
+			catch(const std::out_of_range& err)
+				{
+				fail(OUT_OF_RANGE,err.what());
+				}
+			catch(const std::logic_error& err)
+				{
+				fail(LOGIC_ERROR,err.what());
+				}
+			catch(const std::exception& err)
+				{
+				/* Forward all other exceptions, including std::runtime_error, as std::runtime_error: */
+				fail(RUNTIME_ERROR,err.what());
+				}
+			catch(...)
+				{
+				fail(RUNTIME_ERROR,"WorkerPool: Unknown exception in worker thread");
+				}
+			insidePool=wasInsidePool;
+			return 0;
+			}
+		};
+	
+	/* Elements: */
+	static unsigned int numWorkers; // Number of worker threads for parallel jobs; 0 selects the number of available CPUs
+	static __thread bool insidePool; // Flag whether the current thread is executing a worker pool job
+	
+	/* Private methods: */
+	static void rethrow(ErrorType errorType,const std::string& error); // Throws an exception of the given standard exception class and message
+	
+	/* Methods: */
+	public:
+	static unsigned int getNumCpus(void); // Returns the number of CPUs available to the process
+	static unsigned int getNumWorkers(void); // Returns the number of worker threads to use for parallel jobs
+	static void setNumWorkers(unsigned int newNumWorkers); // Sets the number of worker threads for parallel jobs; 0 selects the number of available CPUs
+	template <class JobParam>
+	static void run(JobParam& job,unsigned int numJobWorkers) // Calls job(workerIndex) for all worker indices in [0, numJobWorkers) in parallel; worker 0 runs in the calling thread
+		{
+		if(numJobWorkers<=1)
+			{
+			/* Run the job in the calling thread: */
+			job(0U);
+			return;
+			}
+		
+		if(insidePool)
+			{
+			/* Run all workers' shares serially in the calling worker to not multiply the number of threads: */
+			for(unsigned int i=0;i<numJobWorkers;++i)
+				job(i);
+			return;
+			}
+		
+		/* Create the team of workers: */
+		Worker<JobParam>* workers=new Worker<JobParam>[numJobWorkers];
+		Threads::Thread* threads;
+		try
+			{
+			threads=new Threads::Thread[numJobWorkers-1];
+			}
+		catch(...)
+			{
+			delete[] workers;
+			throw;
+			}
+		for(unsigned int i=0;i<numJobWorkers;++i)
+			{
+			workers[i].job=&job;
+			workers[i].workerIndex=i;
+			#ifdef VISUALIZATION_USE_PROFILING
+			if(i>0)
+				workers[i].profile=Profiler::getCurrentProfile();
+			#endif
+			}
+		
+		/* Start as many of workers 1 to numJobWorkers-1 in their own threads as possible: */
+		unsigned int numStartedWorkers=1;
+		try
+			{
+			for(;numStartedWorkers<numJobWorkers;++numStartedWorkers)
+				threads[numStartedWorkers-1].start(&workers[numStartedWorkers],&Worker<JobParam>::threadMethod);
+			}
+		catch(...)
+			{
+			/* The shares of workers whose threads could not be started are run in the calling thread below: */
+			}
+		
+		/* Run worker 0 and all workers that could not be started in the calling thread: */
+		workers[0].threadMethod();
+		for(unsigned int i=numStartedWorkers;i<numJobWorkers;++i)
+			workers[i].threadMethod();
+		
+		/* Wait for all other workers to finish: */
+		for(unsigned int i=1;i<numStartedWorkers;++i)
+			threads[i-1].join();
+		delete[] threads;
+		
+		/* Forward the first exception thrown by any worker as an exception of the same standard class: */
+		ErrorType errorType=NO_ERROR;
+		std::string error;
+		for(unsigned int i=0;i<numJobWorkers&&errorType==NO_ERROR;++i)
+			if(workers[i].errorType!=NO_ERROR)
+				{
+				errorType=workers[i].errorType;
+				error.swap(workers[i].error);
+				}
+		delete[] workers;
+		if(errorType!=NO_ERROR)
+			rethrow(errorType,error);
+		}
+	template <class JobParam>
+	static void run(JobParam& job) // Runs the given job on the default number of worker threads
+		{
+		run(job,getNumWorkers());
+		}
+	};
+
+}
+
+}
+
+#endif
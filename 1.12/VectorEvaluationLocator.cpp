@@ -139,6 +139,12 @@ VectorEvaluationLocator::VectorEvaluationLocator(Vrui::LocatorTool* sLocatorTool
 
 VectorEvaluationLocator::~VectorEvaluationLocator(void)
 	{
+	/* Release the vector and scalar extractors: */
+	Visualization::Abstract::VariableManager* vm=application->variableManager;
+	if(vectorExtractor!=0)
+		vm->releaseVectorExtractor(vm->getVectorVariable(vectorExtractor));
+	if(scalarExtractor!=0)
+		vm->releaseScalarExtractor(vm->getScalarVariable(scalarExtractor));
 	}
 
 void VectorEvaluationLocator::storeState(Misc::ConfigurationFileSection& configFileSection) const
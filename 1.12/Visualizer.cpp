@@ -24,6 +24,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <ctype.h>
 #include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 #include <stdexcept>
 #include <vector>
 #include <iostream>
@@ -35,8 +38,10 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Misc/CreateNumberedFileName.h>
 #include <Misc/StandardValueCoders.h>
 #include <Misc/ConfigurationFile.h>
+#include <Threads/Mutex.h>
 #include <IO/File.h>
 #include <IO/OpenFile.h>
+#include <IO/SeekableFile.h>
 #include <IO/ValueSource.h>
 #include <Cluster/MulticastPipe.h>
 #include <Geometry/OrthogonalTransformation.h>
@@ -77,6 +82,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Abstract/Algorithm.h>
 #include <Abstract/Element.h>
 #include <Abstract/Module.h>
+#include <Templatized/CompressedPipe.h>
+#include <Templatized/WorkerPool.h>
 
 #include "CuttingPlane.h"
 #ifdef VISUALIZER_USE_COLLABORATION
@@ -88,8 +95,149 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include "VectorEvaluationLocator.h"
 #include "ExtractorLocator.h"
 #include "ElementList.h"
+#ifdef VISUALIZATION_USE_PROFILING
+#include "ProfileDialog.h"
+#endif
+#include "ElementCache.h"
+#include "ElementGeometryFile.h"
 #include "GLRenderState.h"
 
+namespace {
+
+/**************
+Helper classes:
+**************/
+
+struct LoadedElement // Structure for a visualization element read from an element file
+	{
+	/* Elements: */
+	public:
+	std::string algorithmName; // Name of the algorithm extracting the element
+	Visualization::Abstract::Algorithm* algorithm; // Algorithm extracting the element
+	Visualization::Abstract::Parameters* parameters; // Extraction parameters read from the element file; inherited by the extracted element
+	ElementCache::ElementPointer element; // The extracted element, or 0 if extraction has not happened or failed
+	bool cached; // Flag if the element was returned from the element cache instead of being extracted
+	bool precomputed; // Flag if the element was read from a geometry file instead of being extracted
+	std::string error; // Error message if extraction failed
+	double extractionTime; // Time spent extracting the element in seconds
+	
+	/* Constructors and destructors: */
+	LoadedElement(const std::string& sAlgorithmName,Visualization::Abstract::Algorithm* sAlgorithm,Visualization::Abstract::Parameters* sParameters)
+		:algorithmName(sAlgorithmName),algorithm(sAlgorithm),parameters(sParameters),
+		 element(0),cached(false),precomputed(false),extractionTime(0.0)
+		{
+		}
+	};
+
+class ElementExtractionJob // Class to extract a list of loaded visualization elements on a team of worker threads
+	{
+	/* Elements: */
+	private:
+	std::vector<LoadedElement>& loadedElements; // List of elements to extract
+	ElementCache* elementCache; // Cache of previously extracted visualization elements, or 0 if extracted elements are not cached
+	Threads::Mutex nextElementMutex; // Mutex protecting the index of the next element to extract
+	size_t nextElementIndex; // Index of the next element to be picked up by any worker
+	
+	/* Constructors and destructors: */
+	public:
+	ElementExtractionJob(std::vector<LoadedElement>& sLoadedElements,ElementCache* sElementCache)
+		:loadedElements(sLoadedElements),elementCache(sElementCache),nextElementIndex(0)
+		{
+		}
+	
+	/* Methods: */
+	void operator()(unsigned int)
+		{
+		while(true)
+			{
+			/* Pick up the next element that has not been extracted yet: */
+			size_t elementIndex;
+			{
+			Threads::Mutex::Lock nextElementLock(nextElementMutex);
+			if(nextElementIndex==loadedElements.size())
+				break;
+			elementIndex=nextElementIndex;
+			++nextElementIndex;
+			}
+			
+			/* Skip elements that were read from a geometry file: */
+			LoadedElement& le=loadedElements[elementIndex];
+			if(le.precomputed)
+				continue;
+			
+			/* Extract the element: */
+			Misc::Timer extractionTimer;
+			try
+				{
+				if(elementCache!=0&&le.algorithm->getPipe()==0)
+					{
+					/* Check if an identical element was extracted before; elements streamed to cluster slaves can't be shared: */
+					ElementCache::Key key(le.algorithm->getVariableManager(),le.algorithm->getName(),le.parameters);
+					le.element=elementCache->lookup(key,le.algorithm);
+					if(le.element!=0)
+						{
+						/* Delete the unused extraction parameters; the cached element holds an identical copy: */
+						delete le.parameters;
+						le.parameters=0;
+						le.cached=true;
+						}
+					else
+						{
+						/* Extract and cache the element: */
+						le.element=le.algorithm->createElement(le.parameters);
+						if(le.element!=0)
+							elementCache->insert(key,le.element.getPointer());
+						}
+					}
+				else
+					le.element=le.algorithm->createElement(le.parameters);
+				}
+			catch(std::runtime_error err)
+				{
+				le.error=err.what();
+				}
+			extractionTimer.elapse();
+			le.extractionTime=extractionTimer.getTime();
+			}
+		}
+	};
+
+/****************
+Helper functions:
+****************/
+
+void extractLoadedElements(std::vector<LoadedElement>& loadedElements,ElementCache* elementCache,unsigned int numWorkers,ElementList* elementList)
+	{
+	/* Extract all elements on the given number of workers; each algorithm streams its element to the slaves through its own pipe: */
+	ElementExtractionJob job(loadedElements,elementCache);
+	if(numWorkers>loadedElements.size())
+		numWorkers=(unsigned int)loadedElements.size();
+	Visualization::Templatized::WorkerPool::run(job,numWorkers);
+	
+	/* Store the extracted elements in file order: */
+	for(std::vector<LoadedElement>::iterator leIt=loadedElements.begin();leIt!=loadedElements.end();++leIt)
+		{
+		if(leIt->element!=0)
+			{
+			elementList->addElement(leIt->element.getPointer(),leIt->algorithmName.c_str());
+			if(leIt->cached)
+				std::cout<<"Reused cached "<<leIt->algorithmName<<std::endl;
+			else if(leIt->precomputed)
+				std::cout<<"Loaded pre-computed "<<leIt->algorithmName<<" in "<<leIt->extractionTime*1000.0<<" ms"<<std::endl;
+			else
+				std::cout<<"Created "<<leIt->algorithmName<<" in "<<leIt->extractionTime*1000.0<<" ms"<<std::endl;
+			}
+		else
+			std::cout<<"Cancelled "<<leIt->algorithmName<<" due to exception "<<leIt->error<<std::endl;
+		
+		/* Destroy the extractor: */
+		delete leIt->algorithm;
+		}
+	loadedElements.clear();
+	}
+
+}
+
 /***************************
 Methods of class Visualizer:
 ***************************/
@@ -230,6 +378,11 @@ GLMotif::Popup* Visualizer::createElementsMenu(void)
 	showElementListToggle=new GLMotif::ToggleButton("ShowElementListToggle",elementsMenu,"Show Element List");
 	showElementListToggle->getValueChangedCallbacks().add(this,&Visualizer::showElementListCallback);
 	
+	#ifdef VISUALIZATION_USE_PROFILING
+	showProfileDialogToggle=new GLMotif::ToggleButton("ShowProfileDialogToggle",elementsMenu,"Show Extractor Profiles");
+	showProfileDialogToggle->getValueChangedCallbacks().add(this,&Visualizer::showProfileDialogCallback);
+	#endif
+	
 	GLMotif::Button* loadElementsButton=new GLMotif::Button("LoadElementsButton",elementsMenu,"Load Visualization Elements");
 	loadElementsButton->getSelectCallbacks().add(this,&Visualizer::loadElementsCallback);
 	
@@ -364,7 +517,7 @@ GLMotif::PopupMenu* Visualizer::createMainMenu(void)
 	return mainMenuPopup;
 	}
 
-void Visualizer::loadElements(const char* elementFileName,bool ascii)
+void Visualizer::loadElements(const char* elementFileName,bool ascii,bool geometry)
 	{
 	/* Open a pipe for cluster communication: */
 	Cluster::MulticastPipe* pipe=Vrui::openPipe();
@@ -374,6 +527,15 @@ void Visualizer::loadElements(const char* elementFileName,bool ascii)
 		/* Create a data sink to send element parameters to the slaves: */
 		Visualization::Abstract::BinaryParametersSink sink(variableManager,*pipe,true);
 		
+		/*****************************************************************
+		On a single node, read all element definitions from the file before
+		extracting any of them concurrently. In a cluster, opening each
+		algorithm's pipe is a collective operation, and the slaves receive
+		one element at a time; extract each element in file order right
+		after reading its definition.
+		*****************************************************************/
+		
+		std::vector<LoadedElement> loadedElements;
 		if(ascii)
 			{
 			/* Open the element file: */
@@ -400,12 +562,9 @@ void Visualizer::loadElements(const char* elementFileName,bool ascii)
 				Cluster::MulticastPipe* algorithmPipe=Vrui::openPipe();
 				Algorithm* algorithm=module->getAlgorithm(algorithmName.c_str(),variableManager,algorithmPipe);
 				
-				/* Extract an element using the given extractor: */
+				/* Read the element's extraction parameters using the given extractor: */
 				if(algorithm!=0)
 					{
-					std::cout<<"Creating "<<algorithmName<<"..."<<std::flush;
-					Misc::Timer extractionTimer;
-					
 					try
 						{
 						/* Read the element's extraction parameters from the file: */
@@ -421,11 +580,8 @@ void Visualizer::loadElements(const char* elementFileName,bool ascii)
 							pipe->flush();
 							}
 						
-						/* Extract the element: */
-						Element* element=algorithm->createElement(parameters);
-						
-						/* Store the element: */
-						elementList->addElement(element,algorithmName.c_str());
+						/* Queue the element for extraction: */
+						loadedElements.push_back(LoadedElement(algorithmName,algorithm,parameters));
 						}
 					catch(std::runtime_error err)
 						{
@@ -436,31 +592,39 @@ void Visualizer::loadElements(const char* elementFileName,bool ascii)
 							pipe->flush();
 							}
 						
-						std::cout<<"Cancelled due to exception "<<err.what()<<"...";
+						std::cout<<"Cancelled "<<algorithmName<<" due to exception "<<err.what()<<std::endl;
+						
+						/* Destroy the extractor: */
+						delete algorithm;
 						}
-					
-					/* Destroy the extractor: */
-					delete algorithm;
-					
-					extractionTimer.elapse();
-					std::cout<<" done in "<<extractionTimer.getTime()*1000.0<<" ms"<<std::endl;
 					}
 				else
 					{
 					std::cout<<"Ignoring unknown algorithm "<<algorithmName<<std::endl;
 					delete algorithmPipe;
 					}
+				
+				/* Extract the element before reading the next one when running in a cluster: */
+				if(pipe!=0&&!loadedElements.empty())
+					extractLoadedElements(loadedElements,elementCache,1,elementList);
 				}
 			}
 		else
 			{
-			/* Open the element file and create a data source to read from it: */
-			IO::FilePtr elementFile(IO::openFile(elementFileName));
-			elementFile->setEndianness(Misc::LittleEndian);
+			/* Open the element file and create a data source to read from it; geometry readers check array sizes against the file size: */
+			IO::SeekableFilePtr elementFile(IO::openSeekableFile(elementFileName));
+			if(geometry)
+				{
+				/* Check the geometry file's header and data set identity; this also sets the file's endianness: */
+				ElementGeometryFile::readHeader(*elementFile,dataSetKey);
+				}
+			else
+				elementFile->setEndianness(Misc::LittleEndian);
 			Visualization::Abstract::BinaryParametersSource source(variableManager,*elementFile,false);
 			
 			/* Read all elements from the file: */
-			while(!elementFile->eof())
+			bool fileOk=true;
+			while(fileOk&&!elementFile->eof())
 				{
 				/* Read the next algorithm name: */
 				std::string algorithmName=Misc::Marshaller<std::string>::read(*elementFile);
@@ -475,56 +639,94 @@ void Visualizer::loadElements(const char* elementFileName,bool ascii)
 				Cluster::MulticastPipe* algorithmPipe=Vrui::openPipe();
 				Algorithm* algorithm=module->getAlgorithm(algorithmName.c_str(),variableManager,algorithmPipe);
 				
-				/* Extract an element using the given extractor: */
+				/* Read the element's extraction parameters using the given extractor: */
 				if(algorithm!=0)
 					{
-					std::cout<<"Creating "<<algorithmName<<"..."<<std::flush;
-					Misc::Timer extractionTimer;
-					
+					bool sentParameters=false;
 					try
 						{
 						/* Read the element's extraction parameters from the file: */
 						Parameters* parameters=algorithm->cloneParameters();
 						parameters->read(source);
 						
+						/* Read the element's extraction statistics from a geometry file: */
+						ElementGeometryFile::ElementStats stats;
+						stats.hasGeometry=false;
+						if(geometry)
+							stats=ElementGeometryFile::readElementStats(*elementFile);
+						
+						LoadedElement le(algorithmName,algorithm,parameters);
+						if(stats.hasGeometry)
+							{
+							/* Read the pre-computed element before sending its parameters, so the slaves only wait for elements that were read successfully: */
+							Misc::Timer readTimer;
+							le.element=algorithm->readElement(parameters,*elementFile);
+							readTimer.elapse();
+							le.precomputed=true;
+							le.extractionTime=readTimer.getTime();
+							}
+						
 						if(pipe!=0)
 							{
-							/* Send the extraction parameters to the slaves: */
+							/* Send the extraction parameters to the slaves; they pick up a pre-computed element's geometry already queued on the algorithm's pipe: */
 							pipe->write<int>(1);
 							parameters->write(sink);
 							pipe->flush();
+							sentParameters=true;
 							}
 						
-						/* Extract the element: */
-						Element* element=algorithm->createElement(parameters);
-						
-						/* Store the element: */
-						elementList->addElement(element,algorithmName.c_str());
+						/* Queue the element for extraction: */
+						loadedElements.push_back(le);
 						}
 					catch(std::runtime_error err)
 						{
-						if(pipe!=0)
+						/* Tell the slaves to drop the element unless they already received its parameters: */
+						if(pipe!=0&&!sentParameters)
 							{
 							/* Tell the slaves there was a problem: */
 							pipe->write<int>(0);
 							pipe->flush();
 							}
 						
-						std::cout<<"Cancelled due to exception "<<err.what()<<"...";
+						std::cout<<"Cancelled "<<algorithmName<<" due to exception "<<err.what()<<std::endl;
+						
+						/* Destroy the extractor: */
+						delete algorithm;
+						
+						/* Geometry files can't be re-synchronized after an error: */
+						fileOk=!geometry;
 						}
-					
-					/* Destroy the extractor: */
-					delete algorithm;
-					
-					extractionTimer.elapse();
-					std::cout<<" done in "<<extractionTimer.getTime()*1000.0<<" ms"<<std::endl;
 					}
 				else
 					{
 					std::cout<<"Ignoring unknown algorithm "<<algorithmName<<std::endl;
 					delete algorithmPipe;
+					
+					/* Geometry files can't skip the elements of unknown algorithms: */
+					fileOk=!geometry;
 					}
+				
+				/* Extract the element before reading the next one when running in a cluster: */
+				if(pipe!=0&&!loadedElements.empty())
+					extractLoadedElements(loadedElements,elementCache,1,elementList);
 				}
+			
+			if(!fileOk)
+				std::cout<<"Stopped reading geometry file "<<elementFileName<<" due to an unreadable element"<<std::endl;
+			}
+		
+		if(!loadedElements.empty())
+			{
+			/* Extract all remaining elements concurrently: */
+			size_t numExtractedElements=0;
+			for(std::vector<LoadedElement>::iterator leIt=loadedElements.begin();leIt!=loadedElements.end();++leIt)
+				if(!leIt->precomputed)
+					++numExtractedElements;
+			std::cout<<"Creating "<<numExtractedElements<<" visualization elements..."<<std::endl;
+			Misc::Timer extractionTimer;
+			extractLoadedElements(loadedElements,elementCache,Visualization::Templatized::WorkerPool::getNumWorkers(),elementList);
+			extractionTimer.elapse();
+			std::cout<<"Created all visualization elements in "<<extractionTimer.getTime()*1000.0<<" ms"<<std::endl;
 			}
 		
 		if(pipe!=0)
@@ -609,7 +811,10 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 	 collaborationClient(0),sharedVisualizationClient(0),
 	 #endif
 	 numCuttingPlanes(0),cuttingPlanes(0),
-	 elementList(0),
+	 elementList(0),elementCache(0),
+	 #ifdef VISUALIZATION_USE_PROFILING
+	 profileDialog(0),
+	 #endif
 	 algorithm(0),
 	 mainMenu(0),
 	 inLoadPalette(false),inLoadElements(false)
@@ -619,6 +824,13 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 	std::string moduleClassName="";
 	std::vector<std::string> dataSetArgs;
 	const char* argColorMapName=0;
+	bool argUseActiveCellIndices=false;
+	bool argCacheStatistics=false;
+	bool argCompressPipes=false;
+	int argNumQuantizationBits=0;
+	size_t argElementCacheSize=0;
+	size_t argElementCacheSpillSize=0;
+	const char* argElementCacheSpillDirectory="/tmp";
 	std::vector<const char*> loadFileNames;
 	for(int i=1;i<argc;++i)
 		{
@@ -646,6 +858,76 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 				else
 					std::cerr<<"Missing palette file name after -palette"<<std::endl;
 				}
+			else if(strcasecmp(argv[i]+1,"numThreads")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Set the number of worker threads for parallel extraction: */
+					Visualization::Templatized::WorkerPool::setNumWorkers((unsigned int)atoi(argv[i]));
+					}
+				else
+					std::cerr<<"Missing number of threads after -numThreads"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"activeCellIndex")==0)
+				{
+				/* Index the data set's cells to speed up repeated global isosurface extraction: */
+				argUseActiveCellIndices=true;
+				}
+			else if(strcasecmp(argv[i]+1,"cacheStatistics")==0)
+				{
+				/* Cache scalar variable statistics next to the data file to speed up later sessions: */
+				argCacheStatistics=true;
+				}
+			else if(strcasecmp(argv[i]+1,"compressPipes")==0)
+				{
+				/* Compress data loaded or extracted on the master node before streaming it to the slave nodes: */
+				argCompressPipes=true;
+				}
+			else if(strcasecmp(argv[i]+1,"quantizeVertices")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Drop low-order mantissa bits from streamed vertex components to improve compression: */
+					argNumQuantizationBits=atoi(argv[i]);
+					}
+				else
+					std::cerr<<"Missing number of bits after -quantizeVertices"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"elementCacheSize")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Keep extracted visualization elements up to the given number of megabytes to answer repeated extraction requests: */
+					argElementCacheSize=size_t(atoi(argv[i]))*1024*1024;
+					}
+				else
+					std::cerr<<"Missing cache size after -elementCacheSize"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"elementCacheSpillSize")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Spill visualization elements evicted from the element cache to geometry files up to the given number of megabytes: */
+					argElementCacheSpillSize=size_t(atoi(argv[i]))*1024*1024;
+					}
+				else
+					std::cerr<<"Missing spill size after -elementCacheSpillSize"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"elementCacheSpillDirectory")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Create the element cache's geometry files in the given directory: */
+					argElementCacheSpillDirectory=argv[i];
+					}
+				else
+					std::cerr<<"Missing directory name after -elementCacheSpillDirectory"<<std::endl;
+				}
 			else if(strcasecmp(argv[i]+1,"load")==0)
 				{
 				++i;
@@ -807,6 +1089,7 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 		/* Load a data set: */
 		Misc::Timer t;
 		Cluster::MulticastPipe* pipe=Vrui::openPipe(); // Implicit synchronization point
+		Visualization::Templatized::CompressedPipe::negotiate(pipe,argCompressPipes,argNumQuantizationBits);
 		dataSet=module->load(dataSetArgs,pipe);
 		delete pipe; // Implicit synchronization point
 		t.elapse();
@@ -818,8 +1101,40 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 		Misc::throwStdErr("Visualizer::Visualizer: Could not load data set due to exception %s",err.what());
 		}
 	
+	/* Identify the data set by its module, arguments, and source files to detect stale statistics caches and geometry files: */
+	dataSetKey=module->getDataSetKey(dataSetArgs);
+	
+	/* Find the data file next to which to cache scalar variable statistics: */
+	std::string statisticsCacheFileName;
+	if(argCacheStatistics)
+		{
+		/* Store the cache file next to the first argument naming a data file: */
+		for(std::vector<std::string>::iterator daIt=dataSetArgs.begin();daIt!=dataSetArgs.end()&&statisticsCacheFileName.empty();++daIt)
+			{
+			std::string fileName=daIt->c_str()[0]=='/'?*daIt:baseDirectory+*daIt;
+			struct stat fileStats;
+			if(stat(fileName.c_str(),&fileStats)==0&&S_ISREG(fileStats.st_mode))
+				statisticsCacheFileName=fileName+".stats";
+			}
+		
+		std::vector<std::string> sourceFileNames=module->getSourceFiles();
+		if(sourceFileNames.empty())
+			{
+			/* The cache could not be invalidated if the module's source files changed: */
+			statisticsCacheFileName.clear();
+			if(Vrui::isMaster())
+				std::cerr<<"Not caching variable statistics because module "<<moduleClassName<<" did not record its source files"<<std::endl;
+			}
+		else if(statisticsCacheFileName.empty())
+			{
+			/* Store the cache file next to the first source file: */
+			statisticsCacheFileName=sourceFileNames.front()+".stats";
+			}
+		}
+	
 	/* Create a variable manager: */
-	variableManager=new VariableManager(dataSet,argColorMapName);
+	variableManager=new VariableManager(dataSet,argColorMapName,statisticsCacheFileName.empty()?0:statisticsCacheFileName.c_str(),dataSetKey.c_str());
+	variableManager->setUseActiveCellIndices(argUseActiveCellIndices);
 	variableManager->getColorBarDialog()->setCloseButton(true);
 	variableManager->getColorBarDialog()->getCloseCallbacks().add(this,&Visualizer::colorBarClosedCallback);
 	variableManager->getPaletteEditor()->setCloseButton(true);
@@ -876,11 +1191,26 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 	mainMenu=createMainMenu();
 	Vrui::setMainMenu(mainMenu);
 	
+	/* Create the element cache on single-machine environments; slave nodes could not follow the master node's cache hits: */
+	if(argElementCacheSize>0&&Vrui::getClusterMultiplexer()==0)
+		{
+		elementCache=new ElementCache(argElementCacheSize);
+		if(argElementCacheSpillSize>0)
+			elementCache->setSpilling(argElementCacheSpillDirectory,argElementCacheSpillSize,dataSetKey);
+		}
+	
 	/* Create the element list: */
 	elementList=new ElementList(Vrui::getWidgetManager());
 	elementList->getElementListDialog()->setCloseButton(true);
 	elementList->getElementListDialog()->getCloseCallbacks().add(this,&Visualizer::elementListClosedCallback);
 	
+	#ifdef VISUALIZATION_USE_PROFILING
+	/* Create the extractor profile dialog: */
+	profileDialog=new ProfileDialog(Vrui::getWidgetManager());
+	profileDialog->getProfileDialog()->setCloseButton(true);
+	profileDialog->getProfileDialog()->getCloseCallbacks().add(this,&Visualizer::profileDialogClosedCallback);
+	#endif
+	
 	/* Load all element files listed on the command line: */
 	for(std::vector<const char*>::const_iterator lfnIt=loadFileNames.begin();lfnIt!=loadFileNames.end();++lfnIt)
 		{
@@ -895,6 +1225,11 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 			/* Load a binary elements file: */
 			loadElements(*lfnIt,false);
 			}
+		else if(Misc::hasCaseExtension(*lfnIt,ElementGeometryFile::getFileExtension()))
+			{
+			/* Load a file of pre-computed elements: */
+			loadElements(*lfnIt,false,true);
+			}
 		}
 	
 	/* Initialize navigation transformation: */
@@ -912,6 +1247,11 @@ Visualizer::~Visualizer(void)
 	for(BaseLocatorList::iterator blIt=baseLocators.begin();blIt!=baseLocators.end();++blIt)
 		delete *blIt;
 	
+	#ifdef VISUALIZATION_USE_PROFILING
+	/* Delete the extractor profile dialog: */
+	delete profileDialog;
+	#endif
+	
 	/* Delete the cutting planes: */
 	delete[] cuttingPlanes;
 	
@@ -920,6 +1260,9 @@ Visualizer::~Visualizer(void)
 	delete collaborationClient;
 	#endif
 	
+	/* Release all cached visualization elements: */
+	delete elementCache;
+	
 	/* Delete the coordinate transformer: */
 	delete coordinateTransformer;
 	
@@ -1040,6 +1383,14 @@ void Visualizer::toolDestructionCallback(Vrui::ToolManager::ToolDestructionCallb
 
 void Visualizer::frame(void)
 	{
+	#ifdef VISUALIZATION_USE_PROFILING
+	if(showProfileDialogToggle->getToggle())
+		{
+		/* Show the extractors' current counters and timers: */
+		profileDialog->update();
+		}
+	#endif
+	
 	#ifdef VISUALIZER_USE_COLLABORATION
 	if(collaborationClient!=0)
 		{
@@ -1289,7 +1640,7 @@ void Visualizer::loadElementsCallback(Misc::CallbackData*)
 	if(!inLoadElements)
 		{
 		/* Create a file selection dialog to select an element file: */
-		GLMotif::FileSelectionDialog* fsDialog=new GLMotif::FileSelectionDialog(Vrui::getWidgetManager(),"Load Visualization Elements...",Vrui::openDirectory("."),".asciielem;.binelem");
+		GLMotif::FileSelectionDialog* fsDialog=new GLMotif::FileSelectionDialog(Vrui::getWidgetManager(),"Load Visualization Elements...",Vrui::openDirectory("."),".asciielem;.binelem;.elemgeom");
 		fsDialog->getOKCallbacks().add(this,&Visualizer::loadElementsOKCallback);
 		fsDialog->getCancelCallbacks().add(this,&Visualizer::loadElementsCancelCallback);
 		Vrui::popupPrimaryWidget(fsDialog);
@@ -1312,6 +1663,11 @@ void Visualizer::loadElementsOKCallback(GLMotif::FileSelectionDialog::OKCallback
 			/* Load the binary elements file: */
 			loadElements(cbData->selectedDirectory->getPath(cbData->selectedFileName).c_str(),false);
 			}
+		else if(Misc::hasCaseExtension(cbData->selectedFileName,ElementGeometryFile::getFileExtension()))
+			{
+			/* Load the pre-computed elements file: */
+			loadElements(cbData->selectedDirectory->getPath(cbData->selectedFileName).c_str(),false,true);
+			}
 		}
 	catch(std::runtime_error err)
 		{
@@ -1380,6 +1736,27 @@ void Visualizer::clientDialogClosedCallback(Misc::CallbackData* cbData)
 	#endif
 	}
 
+void Visualizer::showProfileDialogCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData)
+	{
+	#ifdef VISUALIZATION_USE_PROFILING
+	/* Hide or show the extractor profile dialog based on toggle button state: */
+	if(cbData->set)
+		{
+		profileDialog->update();
+		Vrui::popupPrimaryWidget(profileDialog->getProfileDialog());
+		}
+	else
+		Vrui::popdownPrimaryWidget(profileDialog->getProfileDialog());
+	#endif
+	}
+
+void Visualizer::profileDialogClosedCallback(Misc::CallbackData* cbData)
+	{
+	#ifdef VISUALIZATION_USE_PROFILING
+	showProfileDialogToggle->setToggle(false);
+	#endif
+	}
+
 void Visualizer::centerDisplayCallback(Misc::CallbackData*)
 	{
 	/* Get the data set's domain box: */
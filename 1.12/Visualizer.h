@@ -70,6 +70,10 @@ class SharedVisualizationClient;
 #endif
 class BaseLocator;
 class ElementList;
+class ElementCache;
+#ifdef VISUALIZATION_USE_PROFILING
+class ProfileDialog;
+#endif
 
 class Visualizer:public Vrui::Application
 	{
@@ -111,6 +115,7 @@ class Visualizer:public Vrui::Application
 	ModuleManager moduleManager; // Manager to load 3D visualization modules from dynamic libraries
 	Module* module; // Visualization module
 	DataSet* dataSet; // Data set to visualize
+	std::string dataSetKey; // Key identifying the data set by module class name, module arguments, and source file sizes and modification times
 	VariableManager* variableManager; // Manager to organize data sets and scalar and vector variables
 	bool renderDataSet; // Flag whether to render the data set
 	GLColor<GLfloat,4> dataSetRenderColor; // Color to use when rendering the data set
@@ -128,11 +133,16 @@ class Visualizer:public Vrui::Application
 	CuttingPlane* cuttingPlanes; // Array of available cutting planes
 	BaseLocatorList baseLocators; // List of active locators
 	ElementList* elementList; // List of previously extracted visualization elements
+	ElementCache* elementCache; // Cache returning previously extracted visualization elements for identical extraction requests, or 0 if caching is disabled
+	#ifdef VISUALIZATION_USE_PROFILING
+	ProfileDialog* profileDialog; // Dialog showing the profiling counters and timers of all extractors
+	#endif
 	int algorithm; // The currently selected algorithm
 	GLMotif::PopupMenu* mainMenu; // The main menu widget
 	GLMotif::ToggleButton* showColorBarToggle; // Toggle button to show the color bar
 	GLMotif::ToggleButton* showPaletteEditorToggle; // Toggle button to show the palette editor
 	GLMotif::ToggleButton* showElementListToggle; // Toggle button to show the element list dialog
+	GLMotif::ToggleButton* showProfileDialogToggle; // Toggle button to show the extractor profile dialog
 	GLMotif::ToggleButton* showClientDialogToggle; // Toggle button to show the collaboration client dialog
 	
 	/* Lock flags for modal dialogs: */
@@ -149,7 +159,7 @@ class Visualizer:public Vrui::Application
 	GLMotif::Popup* createStandardSaturationPalettesMenu(void);
 	GLMotif::Popup* createColorMenu(void);
 	GLMotif::PopupMenu* createMainMenu(void);
-	void loadElements(const char* elementFileName,bool ascii); // Loads all visualization elements defined in the given file
+	void loadElements(const char* elementFileName,bool ascii,bool geometry =false); // Loads all visualization elements defined in the given file; reads pre-computed element geometry if geometry flag is true
 	
 	/* Constructors and destructors: */
 	public:
@@ -187,6 +197,8 @@ class Visualizer:public Vrui::Application
 	void clearElementsCallback(Misc::CallbackData* cbData);
 	void showClientDialogCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData);
 	void clientDialogClosedCallback(Misc::CallbackData* cbData);
+	void showProfileDialogCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData);
+	void profileDialogClosedCallback(Misc::CallbackData* cbData);
 	void centerDisplayCallback(Misc::CallbackData* cbData);
 	};
 
@@ -0,0 +1,607 @@
+/***********************************************************************
+VisualizerBenchmark - Utility to measure the performance of all
+visualization algorithms, data set locators, and value range
+calculations on synthetic or loaded data sets without a display, and to
+report the results in a machine-readable format to compare runs over
+time.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdexcept>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <Misc/Timer.h>
+#include <Misc/Autopointer.h>
+#include <Misc/SelfDestructPointer.h>
+#include <Misc/StandardValueCoders.h>
+#include <Math/Math.h>
+#include <Math/Random.h>
+#include <Plugins/FactoryManager.h>
+
+#include <Abstract/DataSet.h>
+#include <Abstract/ScalarExtractor.h>
+#include <Abstract/VectorExtractor.h>
+#include <Abstract/VariableManager.h>
+#include <Abstract/Parameters.h>
+#include <Abstract/Algorithm.h>
+#include <Abstract/Element.h>
+#include <Abstract/Module.h>
+#include <Templatized/WorkerPool.h>
+
+namespace {
+
+/**************
+Helper classes:
+**************/
+
+typedef Visualization::Abstract::DataSet DataSet;
+typedef Visualization::Abstract::ScalarExtractor ScalarExtractor;
+typedef Visualization::Abstract::VectorExtractor VectorExtractor;
+typedef Visualization::Abstract::VariableManager VariableManager;
+typedef Visualization::Abstract::Algorithm Algorithm;
+typedef Visualization::Abstract::Element Element;
+typedef Visualization::Abstract::Module Module;
+typedef Plugins::FactoryManager<Module> ModuleManager;
+
+struct BenchmarkSettings // Structure for settings shared by all benchmarks
+	{
+	/* Elements: */
+	public:
+	int numRuns; // Number of times each measurement is repeated
+	int numProbes; // Number of points evaluated in each locator measurement
+	unsigned int seed; // Seed for the random number generator creating probe positions
+	bool useActiveCellIndices; // Flag whether to index the data set's scalar variables before extracting global isosurfaces
+	
+	/* Constructors and destructors: */
+	BenchmarkSettings(void)
+		:numRuns(5),numProbes(100000),seed(1U),useActiveCellIndices(false)
+		{
+		}
+	};
+
+struct DataSetSource // Structure describing how to load a data set
+	{
+	/* Elements: */
+	public:
+	std::string moduleClassName; // Name of the visualization module class loading the data set
+	std::vector<std::string> args; // Data set arguments passed to the module
+	
+	/* Constructors and destructors: */
+	DataSetSource(const std::string& sModuleClassName)
+		:moduleClassName(sModuleClassName)
+		{
+		}
+	
+	/* Methods: */
+	std::string getName(void) const // Returns a name identifying the data set in the benchmark report
+		{
+		std::string result=moduleClassName;
+		for(std::vector<std::string>::const_iterator aIt=args.begin();aIt!=args.end();++aIt)
+			{
+			result.push_back(' ');
+			result.append(*aIt);
+			}
+		return result;
+		}
+	};
+
+class TimingStatistics // Class to accumulate the times of repeated measurements
+	{
+	/* Elements: */
+	private:
+	int numRuns; // Number of accumulated measurements
+	double minTime,maxTime,sumTime; // Time statistics in seconds
+	
+	/* Constructors and destructors: */
+	public:
+	TimingStatistics(void)
+		:numRuns(0),minTime(0.0),maxTime(0.0),sumTime(0.0)
+		{
+		}
+	
+	/* Methods: */
+	void addTime(double time) // Adds a measurement
+		{
+		if(numRuns==0||minTime>time)
+			minTime=time;
+		if(numRuns==0||maxTime<time)
+			maxTime=time;
+		sumTime+=time;
+		++numRuns;
+		}
+	int getNumRuns(void) const
+		{
+		return numRuns;
+		}
+	double getMinTime(void) const
+		{
+		return minTime;
+		}
+	double getMeanTime(void) const
+		{
+		return numRuns>0?sumTime/double(numRuns):0.0;
+		}
+	double getMaxTime(void) const
+		{
+		return maxTime;
+		}
+	};
+
+class BenchmarkReport // Class to write benchmark results as comma-separated records
+	{
+	/* Elements: */
+	private:
+	std::ostream& os; // Stream receiving the records
+	
+	/* Constructors and destructors: */
+	public:
+	BenchmarkReport(std::ostream& sOs)
+		:os(sOs)
+		{
+		/* Write the column header: */
+		os<<"dataSet,benchmark,variant,runs,minMs,meanMs,maxMs,items,memoryBytes"<<std::endl;
+		}
+	
+	/* Methods: */
+	void writeRecord(const std::string& dataSetName,const char* benchmark,const std::string& variant,const TimingStatistics& times,size_t numItems,size_t memorySize) // Writes one result record; times are reported in milliseconds
+		{
+		os<<dataSetName<<','<<benchmark<<','<<variant<<',';
+		os<<times.getNumRuns()<<','<<times.getMinTime()*1000.0<<','<<times.getMeanTime()*1000.0<<','<<times.getMaxTime()*1000.0<<',';
+		os<<numItems<<','<<memorySize<<std::endl;
+		}
+	void writeError(const std::string& dataSetName,const char* benchmark,const std::string& variant,const char* error) // Writes a record for a failed measurement
+		{
+		os<<dataSetName<<','<<benchmark<<','<<variant<<",0,,,,,"<<std::endl;
+		std::cerr<<"Benchmark "<<benchmark<<" "<<variant<<" on "<<dataSetName<<" failed due to exception "<<error<<std::endl;
+		}
+	};
+
+/****************
+Helper functions:
+****************/
+
+std::string makeVariant(const char* prefix,const char* variableName) // Creates a report variant name from a prefix and a variable name without separator characters
+	{
+	std::string result=prefix;
+	result.push_back(':');
+	for(const char* vnPtr=variableName;*vnPtr!='\0';++vnPtr)
+		result.push_back(*vnPtr==','||*vnPtr==' '?'_':*vnPtr);
+	return result;
+	}
+
+void benchmarkValueRanges(const DataSet* dataSet,const std::string& dataSetName,const BenchmarkSettings& settings,BenchmarkReport& report)
+	{
+	/* Calculate the value range of each scalar variable: */
+	for(int svi=0;svi<dataSet->getNumScalarVariables();++svi)
+		{
+		std::string variant=makeVariant("scalar",dataSet->getScalarVariableName(svi));
+		bool acquired=false;
+		try
+			{
+			Misc::SelfDestructPointer<ScalarExtractor> extractor(dataSet->getScalarExtractor(svi));
+			acquired=true;
+			TimingStatistics times;
+			for(int run=0;run<settings.numRuns;++run)
+				{
+				Misc::Timer timer;
+				dataSet->calcScalarValueRange(extractor.getTarget());
+				timer.elapse();
+				times.addTime(timer.getTime());
+				}
+			report.writeRecord(dataSetName,"valueRange",variant,times,0,0);
+			}
+		catch(std::runtime_error err)
+			{
+			report.writeError(dataSetName,"valueRange",variant,err.what());
+			}
+		
+		/* Release the extractor only if it was acquired successfully: */
+		if(acquired)
+			dataSet->releaseScalarExtractor(svi);
+		}
+	
+	/* Calculate the magnitude range of each vector variable: */
+	for(int vvi=0;vvi<dataSet->getNumVectorVariables();++vvi)
+		{
+		std::string variant=makeVariant("vector",dataSet->getVectorVariableName(vvi));
+		bool acquired=false;
+		try
+			{
+			Misc::SelfDestructPointer<VectorExtractor> extractor(dataSet->getVectorExtractor(vvi));
+			acquired=true;
+			TimingStatistics times;
+			for(int run=0;run<settings.numRuns;++run)
+				{
+				Misc::Timer timer;
+				dataSet->calcVectorValueMagnitudeRange(extractor.getTarget());
+				timer.elapse();
+				times.addTime(timer.getTime());
+				}
+			report.writeRecord(dataSetName,"valueRange",variant,times,0,0);
+			}
+		catch(std::runtime_error err)
+			{
+			report.writeError(dataSetName,"valueRange",variant,err.what());
+			}
+		
+		/* Release the extractor only if it was acquired successfully: */
+		if(acquired)
+			dataSet->releaseVectorExtractor(vvi);
+		}
+	}
+
+void createProbes(const DataSet* dataSet,bool coherent,const BenchmarkSettings& settings,std::vector<DataSet::Point>& probes)
+	{
+	/* Seed the random number generator to evaluate the same points in every run: */
+	srand(settings.seed);
+	DataSet::Box box=dataSet->getDomainBox();
+	probes.clear();
+	probes.reserve(size_t(settings.numProbes));
+	if(coherent)
+		{
+		/* Create a random walk through the domain with steps of half the average cell size, as when dragging a locator: */
+		DataSet::Scalar stepSize=dataSet->calcAverageCellSize()*DataSet::Scalar(0.5);
+		DataSet::Point p=Geometry::mid(box.min,box.max);
+		for(int i=0;i<settings.numProbes;++i)
+			{
+			probes.push_back(p);
+			for(int j=0;j<3;++j)
+				{
+				/* Reflect the walk at the domain boundary: */
+				p[j]+=DataSet::Scalar(Math::randUniformCC(-1.0,1.0))*stepSize;
+				if(p[j]<box.min[j])
+					p[j]=box.min[j]+(box.min[j]-p[j]);
+				if(p[j]>box.max[j])
+					p[j]=box.max[j]-(p[j]-box.max[j]);
+				}
+			}
+		}
+	else
+		{
+		/* Create uniformly distributed random points inside the domain's bounding box: */
+		for(int i=0;i<settings.numProbes;++i)
+			{
+			DataSet::Point p;
+			for(int j=0;j<3;++j)
+				p[j]=DataSet::Scalar(Math::randUniformCO(box.min[j],box.max[j]));
+			probes.push_back(p);
+			}
+		}
+	}
+
+void benchmarkLocators(const DataSet* dataSet,VariableManager* variableManager,const std::string& dataSetName,const BenchmarkSettings& settings,BenchmarkReport& report)
+	{
+	for(int pattern=0;pattern<2;++pattern)
+		{
+		/* Create the probe points: */
+		bool coherent=pattern==0;
+		std::vector<DataSet::Point> probes;
+		createProbes(dataSet,coherent,settings,probes);
+		bool* valids=new bool[probes.size()];
+		
+		if(dataSet->getNumScalarVariables()>0)
+			{
+			/* Evaluate the first scalar variable at all probe points: */
+			std::string variant=coherent?"scalarCoherent":"scalarRandom";
+			bool acquired=false;
+			try
+				{
+				const ScalarExtractor* extractor=variableManager->getScalarExtractor(0);
+				acquired=true;
+				DataSet::VScalar* values=new DataSet::VScalar[probes.size()];
+				TimingStatistics times;
+				size_t numValid=0;
+				for(int run=0;run<settings.numRuns;++run)
+					{
+					Misc::SelfDestructPointer<DataSet::Locator> locator(dataSet->getLocator());
+					Misc::Timer timer;
+					numValid=locator->calcScalars(extractor,probes.size(),&probes[0],values,valids);
+					timer.elapse();
+					times.addTime(timer.getTime());
+					}
+				delete[] values;
+				report.writeRecord(dataSetName,"locator",variant,times,probes.size(),0);
+				std::cerr<<variant<<": "<<numValid<<" of "<<probes.size()<<" probes inside the domain"<<std::endl;
+				}
+			catch(std::runtime_error err)
+				{
+				report.writeError(dataSetName,"locator",variant,err.what());
+				}
+			
+			/* Release the extractor only if it was acquired successfully: */
+			if(acquired)
+				variableManager->releaseScalarExtractor(0);
+			}
+		
+		if(dataSet->getNumVectorVariables()>0)
+			{
+			/* Evaluate the first vector variable at all probe points: */
+			std::string variant=coherent?"vectorCoherent":"vectorRandom";
+			bool acquired=false;
+			try
+				{
+				const VectorExtractor* extractor=variableManager->getVectorExtractor(0);
+				acquired=true;
+				DataSet::VVector* values=new DataSet::VVector[probes.size()];
+				TimingStatistics times;
+				for(int run=0;run<settings.numRuns;++run)
+					{
+					Misc::SelfDestructPointer<DataSet::Locator> locator(dataSet->getLocator());
+					Misc::Timer timer;
+					locator->calcVectors(extractor,probes.size(),&probes[0],values,valids);
+					timer.elapse();
+					times.addTime(timer.getTime());
+					}
+				delete[] values;
+				report.writeRecord(dataSetName,"locator",variant,times,probes.size(),0);
+				}
+			catch(std::runtime_error err)
+				{
+				report.writeError(dataSetName,"locator",variant,err.what());
+				}
+			
+			/* Release the extractor only if it was acquired successfully: */
+			if(acquired)
+				variableManager->releaseVectorExtractor(0);
+			}
+		
+		delete[] valids;
+		}
+	}
+
+void benchmarkAlgorithm(Algorithm* algorithm,const DataSet::Locator* seedLocator,const std::string& dataSetName,const BenchmarkSettings& settings,BenchmarkReport& report)
+	{
+	std::string variant=algorithm->getName();
+	const char* benchmark=algorithm->hasSeededCreator()?"seededAlgorithm":"globalAlgorithm";
+	try
+		{
+		/* Set up the algorithm's extraction parameters: */
+		if(algorithm->hasSeededCreator())
+			{
+			if(seedLocator==0)
+				throw std::runtime_error("Seed point is outside the data set's domain");
+			algorithm->setSeedLocator(seedLocator);
+			}
+		else if(!algorithm->hasGlobalCreator())
+			throw std::runtime_error("Algorithm has no immediate creation method");
+		
+		/* Extract the element repeatedly: */
+		TimingStatistics times;
+		size_t elementSize=0;
+		size_t memorySize=0;
+		for(int run=0;run<settings.numRuns;++run)
+			{
+			Misc::Timer timer;
+			Misc::Autopointer<Element> element(algorithm->createElement(algorithm->cloneParameters()));
+			timer.elapse();
+			times.addTime(timer.getTime());
+			elementSize=element->getSize();
+			memorySize=element->getMemorySize();
+			}
+		report.writeRecord(dataSetName,benchmark,variant,times,elementSize,memorySize);
+		}
+	catch(std::runtime_error err)
+		{
+		report.writeError(dataSetName,benchmark,variant,err.what());
+		}
+	}
+
+void benchmarkDataSet(ModuleManager& moduleManager,const DataSetSource& source,const BenchmarkSettings& settings,BenchmarkReport& report)
+	{
+	std::string dataSetName=source.getName();
+	std::cerr<<"Benchmarking "<<dataSetName<<"..."<<std::endl;
+	
+	/* Load the appropriate visualization module: */
+	Module* module=moduleManager.loadClass(source.moduleClassName.c_str());
+	
+	/* Load the data set: */
+	TimingStatistics loadTimes;
+	Misc::Timer loadTimer;
+	Misc::SelfDestructPointer<DataSet> dataSet(module->load(source.args,0));
+	loadTimer.elapse();
+	loadTimes.addTime(loadTimer.getTime());
+	report.writeRecord(dataSetName,"load","",loadTimes,0,0);
+	
+	/* Create a variable manager without user interface: */
+	Misc::SelfDestructPointer<VariableManager> variableManager(new VariableManager(dataSet.getTarget(),0,0,0,true));
+	variableManager->setUseActiveCellIndices(settings.useActiveCellIndices);
+	
+	/* Measure value range calculation and locator throughput: */
+	benchmarkValueRanges(dataSet.getTarget(),dataSetName,settings,report);
+	benchmarkLocators(dataSet.getTarget(),variableManager.getTarget(),dataSetName,settings,report);
+	
+	if(settings.useActiveCellIndices&&variableManager->getNumScalarVariables()>0)
+		{
+		/* Measure the creation of the current scalar variable's active cell index once, as it is cached afterwards: */
+		TimingStatistics indexTimes;
+		Misc::Timer indexTimer;
+		variableManager->getActiveCellIndex(variableManager->getCurrentScalarVariable());
+		indexTimer.elapse();
+		indexTimes.addTime(indexTimer.getTime());
+		report.writeRecord(dataSetName,"activeCellIndex",variableManager->getScalarVariableName(variableManager->getCurrentScalarVariable()),indexTimes,0,0);
+		}
+	
+	/* Place the seed point off-center, to avoid degenerate elements in data sets that are symmetric around their center: */
+	DataSet::Box box=dataSet->getDomainBox();
+	DataSet::Point seedPoint;
+	for(int i=0;i<3;++i)
+		seedPoint[i]=Math::mid(box.min[i],box.max[i]);
+	seedPoint[0]+=(box.max[0]-box.min[0])*DataSet::Scalar(0.3);
+	seedPoint[1]+=(box.max[1]-box.min[1])*DataSet::Scalar(0.05);
+	Misc::SelfDestructPointer<DataSet::Locator> seedLocator(dataSet->getLocator());
+	seedLocator->setPosition(seedPoint);
+	const DataSet::Locator* validSeedLocator=seedLocator->isValid()?seedLocator.getTarget():0;
+	
+	/* Measure all scalar and vector algorithms: */
+	if(variableManager->getNumScalarVariables()>0)
+		for(int i=0;i<module->getNumScalarAlgorithms();++i)
+			{
+			Misc::SelfDestructPointer<Algorithm> algorithm(module->getScalarAlgorithm(i,variableManager.getTarget(),0));
+			benchmarkAlgorithm(algorithm.getTarget(),validSeedLocator,dataSetName,settings,report);
+			}
+	if(variableManager->getNumVectorVariables()>0)
+		for(int i=0;i<module->getNumVectorAlgorithms();++i)
+			{
+			Misc::SelfDestructPointer<Algorithm> algorithm(module->getVectorAlgorithm(i,variableManager.getTarget(),0));
+			benchmarkAlgorithm(algorithm.getTarget(),validSeedLocator,dataSetName,settings,report);
+			}
+	}
+
+}
+
+int main(int argc,char* argv[])
+	{
+	/* Parse the command line: */
+	BenchmarkSettings settings;
+	std::vector<DataSetSource> sources;
+	std::vector<std::string> sizeArgs;
+	bool curved=false;
+	const char* outputFileName=0;
+	for(int i=1;i<argc;++i)
+		{
+		if(argv[i][0]=='-')
+			{
+			if(strcasecmp(argv[i]+1,"class")==0)
+				{
+				/* Get visualization module class name and data set arguments from command line: */
+				++i;
+				if(i>=argc)
+					{
+					std::cerr<<"Missing module class name after -class"<<std::endl;
+					return 1;
+					}
+				sources.push_back(DataSetSource(argv[i]));
+				++i;
+				while(i<argc&&strcmp(argv[i],";")!=0)
+					{
+					sources.back().args.push_back(argv[i]);
+					++i;
+					}
+				}
+			else if(strcasecmp(argv[i]+1,"size")==0)
+				{
+				/* Read one or three numbers of vertices for the synthetic data sets: */
+				sizeArgs.clear();
+				while(i+1<argc&&argv[i+1][0]>='0'&&argv[i+1][0]<='9'&&sizeArgs.size()<3)
+					{
+					++i;
+					sizeArgs.push_back(argv[i]);
+					}
+				}
+			else if(strcasecmp(argv[i]+1,"curved")==0)
+				curved=true;
+			else if(strcasecmp(argv[i]+1,"runs")==0&&i+1<argc)
+				{
+				++i;
+				settings.numRuns=atoi(argv[i]);
+				}
+			else if(strcasecmp(argv[i]+1,"numProbes")==0&&i+1<argc)
+				{
+				++i;
+				settings.numProbes=atoi(argv[i]);
+				}
+			else if(strcasecmp(argv[i]+1,"seed")==0&&i+1<argc)
+				{
+				++i;
+				settings.seed=(unsigned int)atoi(argv[i]);
+				}
+			else if(strcasecmp(argv[i]+1,"numThreads")==0&&i+1<argc)
+				{
+				/* Set the number of worker threads for parallel algorithms: */
+				++i;
+				Visualization::Templatized::WorkerPool::setNumWorkers((unsigned int)atoi(argv[i]));
+				}
+			else if(strcasecmp(argv[i]+1,"activeCellIndex")==0)
+				settings.useActiveCellIndices=true;
+			else if(strcasecmp(argv[i]+1,"output")==0&&i+1<argc)
+				{
+				++i;
+				outputFileName=argv[i];
+				}
+			else
+				std::cerr<<"Ignoring unknown option "<<argv[i]<<std::endl;
+			}
+		else
+			std::cerr<<"Ignoring extra argument "<<argv[i]<<std::endl;
+		}
+	
+	/* Check the command line: */
+	if(settings.numRuns<1||settings.numProbes<1)
+		{
+		std::cerr<<"Usage: "<<argv[0]<<" [-size <number of vertices> [<number of vertices> <number of vertices>]] [-curved] [-runs <number of runs>] [-numProbes <number of locator probes>] [-seed <random seed>] [-numThreads <number of threads>] [-activeCellIndex] [-output <report file name>] [-class <module class name> <data set arguments> ;]..."<<std::endl;
+		return 1;
+		}
+	
+	if(sources.empty())
+		{
+		/* Benchmark synthetic data sets of all supported grid types: */
+		static const char* syntheticModuleClassNames[]=
+			{
+			"SyntheticCartesian","SyntheticCurvilinear","SyntheticMultiCurvilinear","SyntheticSimplical",
+			"SyntheticSlicedCartesian","SyntheticSlicedCurvilinear","SyntheticSlicedMultiCurvilinear","SyntheticSlicedHypercubic"
+			};
+		if(sizeArgs.empty())
+			sizeArgs.push_back("32");
+		for(int i=0;i<8;++i)
+			{
+			sources.push_back(DataSetSource(syntheticModuleClassNames[i]));
+			DataSetSource& source=sources.back();
+			source.args=sizeArgs;
+			source.args.push_back("-seed");
+			source.args.push_back(Misc::ValueCoder<unsigned int>::encode(settings.seed));
+			if(curved)
+				source.args.push_back("-curved");
+			}
+		}
+	
+	/* Open the report file: */
+	std::ofstream outputFile;
+	if(outputFileName!=0)
+		{
+		outputFile.open(outputFileName);
+		if(!outputFile)
+			{
+			std::cerr<<"Unable to open report file "<<outputFileName<<std::endl;
+			return 1;
+			}
+		}
+	BenchmarkReport report(outputFileName!=0?static_cast<std::ostream&>(outputFile):std::cout);
+	
+	/* Benchmark all data sets in order: */
+	ModuleManager moduleManager(VISUALIZER_MODULENAMETEMPLATE);
+	int result=0;
+	for(std::vector<DataSetSource>::const_iterator sIt=sources.begin();sIt!=sources.end();++sIt)
+		{
+		try
+			{
+			benchmarkDataSet(moduleManager,*sIt,settings,report);
+			}
+		catch(std::runtime_error err)
+			{
+			std::cerr<<"Skipping data set "<<sIt->getName()<<" due to exception "<<err.what()<<std::endl;
+			result=1;
+			}
+		}
+	
+	return result;
+	}
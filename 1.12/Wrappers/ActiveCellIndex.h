@@ -0,0 +1,77 @@
+/***********************************************************************
+ActiveCellIndex - Wrapper class to map from the abstract active cell
+index interface to its templatized implementation.
+Part of the wrapper layer of the templatized visualization
+components.
+Copyright (c) 2012 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_WRAPPERS_ACTIVECELLINDEX_INCLUDED
+#define VISUALIZATION_WRAPPERS_ACTIVECELLINDEX_INCLUDED
+
+#include <Abstract/ActiveCellIndex.h>
+#include <Templatized/ActiveCellIndex.h>
+
+namespace Visualization {
+
+namespace Wrappers {
+
+template <class DSParam,class SEParam>
+class ActiveCellIndex:public Visualization::Abstract::ActiveCellIndex
+	{
+	/* Embedded classes: */
+	public:
+	typedef Visualization::Abstract::ActiveCellIndex Base; // Base class type
+	typedef DSParam DS; // Type of templatized data set
+	typedef SEParam SE; // Type of templatized scalar extractor
+	typedef Visualization::Templatized::ActiveCellIndex<DS,SE> ACI; // Type of templatized active cell index
+	
+	/* Elements: */
+	private:
+	ACI aci; // Templatized active cell index
+	
+	/* Constructors and destructors: */
+	public:
+	ActiveCellIndex(const DS& ds,const SE& se) // Indexes the cells of the given data set for the given scalar extractor
+		:aci(ds,se)
+		{
+		}
+	
+	/* Methods from Visualization::Abstract::ActiveCellIndex: */
+	virtual size_t getNumCells(void) const
+		{
+		return aci.getNumCells();
+		}
+	virtual size_t getMemorySize(void) const
+		{
+		return aci.getMemorySize();
+		}
+	
+	/* New methods: */
+	const ACI& getAci(void) const // Returns the templatized active cell index
+		{
+		return aci;
+		}
+	};
+
+}
+
+}
+
+#endif
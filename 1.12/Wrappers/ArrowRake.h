@@ -104,6 +104,7 @@ class ArrowRake:public Visualization::Abstract::Element,public GLObject
 	/* Methods from Visualization::Abstract::Element: */
 	virtual std::string getName(void) const;
 	virtual size_t getSize(void) const;
+	virtual size_t getMemorySize(void) const;
 	virtual void glRenderAction(GLRenderState& renderState) const;
 	
 	/* Methods from GLObject: */
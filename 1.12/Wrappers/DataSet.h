@@ -100,10 +100,62 @@ class DataSet:public Visualization::Abstract::DataSet
 			}
 		virtual DestScalar calcScalar(const Visualization::Abstract::ScalarExtractor* scalarExtractor) const;
 		virtual DestVector calcVector(const Visualization::Abstract::VectorExtractor* vectorExtractor) const;
+		virtual size_t calcScalars(const Visualization::Abstract::ScalarExtractor* scalarExtractor,size_t numPoints,const Point* points,DestScalar* values,bool* valids);
+		virtual size_t calcVectors(const Visualization::Abstract::VectorExtractor* vectorExtractor,size_t numPoints,const Point* points,DestVector* values,bool* valids);
 		};
 	
-	/* Elements: */
 	private:
+	class ScalarValueFunctor // Functor class to extract scalar values from data set vertices for statistics calculation
+		{
+		/* Embedded classes: */
+		public:
+		typedef VScalar Scalar; // Type of extracted values
+		
+		/* Elements: */
+		private:
+		const SE& se; // The templatized scalar extractor
+		
+		/* Constructors and destructors: */
+		public:
+		ScalarValueFunctor(const SE& sSe)
+			:se(sSe)
+			{
+			}
+		
+		/* Methods: */
+		template <class VertexParam>
+		Scalar operator()(const VertexParam& vertex) const
+			{
+			return vertex.getValue(se);
+			}
+		};
+	
+	class VectorMagnitudeFunctor // Functor class to extract vector magnitudes from data set vertices for statistics calculation
+		{
+		/* Embedded classes: */
+		public:
+		typedef VScalar Scalar; // Type of extracted values
+		
+		/* Elements: */
+		private:
+		const VE& ve; // The templatized vector extractor
+		
+		/* Constructors and destructors: */
+		public:
+		VectorMagnitudeFunctor(const VE& sVe)
+			:ve(sVe)
+			{
+			}
+		
+		/* Methods: */
+		template <class VertexParam>
+		Scalar operator()(const VertexParam& vertex) const
+			{
+			return Scalar(vertex.getValue(ve).mag());
+			}
+		};
+	
+	/* Elements: */
 	DataValue dataValue; // Descriptor for data values stored in the data set
 	DS ds; // The templatized data set
 	
@@ -149,11 +201,16 @@ class DataSet:public Visualization::Abstract::DataSet
 	virtual int getNumScalarVariables(void) const;
 	virtual const char* getScalarVariableName(int scalarVariableIndex) const;
 	virtual Visualization::Abstract::ScalarExtractor* getScalarExtractor(int scalarVariableIndex) const;
+	virtual void releaseScalarExtractor(int scalarVariableIndex) const;
 	virtual DestScalarRange calcScalarValueRange(const Visualization::Abstract::ScalarExtractor* scalarExtractor) const;
+	virtual void calcScalarValueStatistics(const Visualization::Abstract::ScalarExtractor* scalarExtractor,Visualization::Abstract::ValueStatistics& statistics) const;
+	virtual Visualization::Abstract::ActiveCellIndex* createActiveCellIndex(const Visualization::Abstract::ScalarExtractor* scalarExtractor,bool compactOnly) const;
 	virtual int getNumVectorVariables(void) const;
 	virtual const char* getVectorVariableName(int vectorVariableIndex) const;
 	virtual Visualization::Abstract::VectorExtractor* getVectorExtractor(int vectorVariableIndex) const;
+	virtual void releaseVectorExtractor(int vectorVariableIndex) const;
 	virtual DestScalarRange calcVectorValueMagnitudeRange(const Visualization::Abstract::VectorExtractor* vectorExtractor) const;
+	virtual void calcVectorValueMagnitudeStatistics(const Visualization::Abstract::VectorExtractor* vectorExtractor,Visualization::Abstract::ValueStatistics& statistics) const;
 	virtual BaseLocator* getLocator(void) const
 		{
 		return new Locator(ds);
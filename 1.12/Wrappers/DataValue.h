@@ -73,6 +73,9 @@ class DataValue
 		/* This method is never called */
 		Misc::throwStdErr("DataValue::getScalarExtractor: unimplemented method called");
 		}
+	void releaseScalarExtractor(int scalarVariableIndex) const // Notifies the data value that an extractor returned by getScalarExtractor has been destroyed
+		{
+		}
 	int getNumVectorVariables(void) const // Returns number of vector variables contained in the data value
 		{
 		return 0;
@@ -89,6 +92,9 @@ class DataValue
 		Misc::throwStdErr("DataValue::getVectorExtractor: unimplemented method called");
 		return VE();
 		}
+	void releaseVectorExtractor(int vectorVariableIndex) const // Notifies the data value that an extractor returned by getVectorExtractor has been destroyed
+		{
+		}
 	};
 
 }
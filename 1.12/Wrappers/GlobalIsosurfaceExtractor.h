@@ -52,6 +52,8 @@ class IsosurfaceExtractor;
 namespace Wrappers {
 template <class SEParam>
 class ScalarExtractor;
+template <class DSParam,class SEParam>
+class ActiveCellIndex;
 }
 }
 
@@ -70,6 +72,7 @@ class GlobalIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 	typedef typename DataSetWrapper::SE SE; // Type of templatized scalar extractor
 	typedef typename SE::Scalar VScalar; // Value type of scalar extractor
 	typedef typename DataSetWrapper::ScalarExtractor ScalarExtractor; // Compatible scalar extractor wrapper class
+	typedef Visualization::Wrappers::ActiveCellIndex<DS,SE> ActiveCellIndex; // Compatible active cell index wrapper class
 	typedef Visualization::Wrappers::Isosurface<DataSetWrapper> Isosurface; // Type of created visualization elements
 	typedef Misc::Autopointer<Isosurface> IsosurfacePointer; // Type for pointers to created visualization elements
 	typedef typename Isosurface::Surface Surface; // Type of low-level surface representation
@@ -142,6 +145,7 @@ class GlobalIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 		}
 	virtual Visualization::Abstract::Element* createElement(Visualization::Abstract::Parameters* extractParameters);
 	virtual Visualization::Abstract::Element* startSlaveElement(Visualization::Abstract::Parameters* extractParameters);
+	virtual Visualization::Abstract::Element* readElement(Visualization::Abstract::Parameters* extractParameters,IO::SeekableFile& file);
 	
 	/* New methods: */
 	static const char* getClassName(void) // Returns the algorithm class name
@@ -66,6 +66,9 @@ class MultiStreamline:public Visualization::Abstract::Element
 	/* Methods from Visualization::Abstract::Element: */
 	virtual std::string getName(void) const;
 	virtual size_t getSize(void) const;
+	virtual size_t getMemorySize(void) const;
+	virtual bool canWriteGeometry(void) const;
+	virtual void writeGeometry(IO::File& file) const;
 	virtual void glRenderAction(GLRenderState& renderState) const;
 	
 	/* New methods: */
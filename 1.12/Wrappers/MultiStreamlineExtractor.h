@@ -30,6 +30,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Abstract/DataSet.h>
 #include <Abstract/Parameters.h>
 #include <Abstract/Algorithm.h>
+#include <Abstract/VariableReferences.h>
 
 #include <Wrappers/MultiStreamline.h>
 
@@ -102,6 +103,7 @@ class MultiStreamlineExtractor:public Visualization::Abstract::Algorithm
 		const DS* ds; // Data set from which to extract streamlines
 		const VE* ve; // Vector extractor for data set
 		const SE* cse; // Color scalar extractor for data set
+		Visualization::Abstract::VariableReferences variableReferences; // References to the vector and color scalar extractors, released when the parameters are destroyed
 		DSL dsl; // Templatized data set locator following the seed point
 		bool locatorValid; // Flag if the locator has been properly initialized, and is inside the data set's domain
 		
@@ -169,6 +171,7 @@ class MultiStreamlineExtractor:public Visualization::Abstract::Algorithm
 	virtual void finishElement(void);
 	virtual Visualization::Abstract::Element* startSlaveElement(Visualization::Abstract::Parameters* extractParameters);
 	virtual void continueSlaveElement(void);
+	virtual Visualization::Abstract::Element* readElement(Visualization::Abstract::Parameters* extractParameters,IO::SeekableFile& file);
 	
 	/* New methods: */
 	static const char* getClassName(void) // Returns the algorithm class name
@@ -164,6 +164,7 @@ class SeededIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 	virtual void finishElement(void);
 	virtual Visualization::Abstract::Element* startSlaveElement(Visualization::Abstract::Parameters* extractParameters);
 	virtual void continueSlaveElement(void);
+	virtual Visualization::Abstract::Element* readElement(Visualization::Abstract::Parameters* extractParameters,IO::SeekableFile& file);
 	
 	/* New methods: */
 	static const char* getClassName(void) // Returns the algorithm class name
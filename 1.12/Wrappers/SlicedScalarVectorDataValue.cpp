@@ -29,19 +29,70 @@ namespace Visualization {
 
 namespace Wrappers {
 
+/*************************************************************
+Methods of class SlicedScalarVectorDataValueBase::SliceLoader:
+*************************************************************/
+
+SlicedScalarVectorDataValueBase::SliceLoader::SliceLoader(void)
+	:loaded(false),memorySize(0),
+	 numUsers(0),lastUseTime(0)
+	{
+	}
+
+SlicedScalarVectorDataValueBase::SliceLoader::~SliceLoader(void)
+	{
+	}
+
 /************************************************
 Methods of class SlicedScalarVectorDataValueBase:
 ************************************************/
 
+void SlicedScalarVectorDataValueBase::releaseUnusedSlices(void) const
+	{
+	while(memoryBudget!=0&&loadedMemorySize>memoryBudget)
+		{
+		/* Find the least recently used loaded deferred variable that is not accessed by any extractors: */
+		SliceLoader* lru=0;
+		for(int i=0;i<numScalarVariables;++i)
+			{
+			SliceLoader* sl=sliceLoaders[i];
+			if(sl!=0&&sl->loaded&&sl->numUsers==0&&(lru==0||lru->lastUseTime>sl->lastUseTime))
+				lru=sl;
+			}
+		if(lru==0)
+			break;
+		
+		/* Release the variable's slices: */
+		lru->releaseSlices();
+		lru->loaded=false;
+		loadedMemorySize-=lru->memorySize;
+		}
+	}
+
 SlicedScalarVectorDataValueBase::SlicedScalarVectorDataValueBase(void)
 	:numScalarVariables(0),scalarVariableNames(0),
 	 numVectorComponents(0),
-	 numVectorVariables(0),vectorVariableNames(0),vectorVariableScalarIndices(0)
+	 numVectorVariables(0),vectorVariableNames(0),vectorVariableScalarIndices(0),
+	 sliceLoaders(0),
+	 memoryBudget(0),
+	 loadedMemorySize(0),useCounter(0)
 	{
 	}
 
 SlicedScalarVectorDataValueBase::~SlicedScalarVectorDataValueBase(void)
 	{
+	/* Delete all slice loaders, which can be shared between several scalar variables: */
+	for(int i=0;i<numScalarVariables;++i)
+		if(sliceLoaders[i]!=0)
+			{
+			SliceLoader* sl=sliceLoaders[i];
+			for(int j=i;j<numScalarVariables;++j)
+				if(sliceLoaders[j]==sl)
+					sliceLoaders[j]=0;
+			delete sl;
+			}
+	delete[] sliceLoaders;
+	
 	for(int i=0;i<numScalarVariables;++i)
 		delete[] scalarVariableNames[i];
 	delete[] scalarVariableNames;
@@ -57,10 +108,15 @@ void SlicedScalarVectorDataValueBase::initialize(int sNumScalarVariables,int sNu
 	for(int i=0;i<numScalarVariables;++i)
 		delete[] scalarVariableNames[i];
 	delete[] scalarVariableNames;
+	delete[] sliceLoaders;
 	numScalarVariables=sNumScalarVariables;
 	scalarVariableNames=new char*[numScalarVariables];
+	sliceLoaders=new SliceLoader*[numScalarVariables];
 	for(int i=0;i<numScalarVariables;++i)
+		{
 		scalarVariableNames[i]=0;
+		sliceLoaders[i]=0;
+		}
 	
 	/* Initialize vector variable arrays: */
 	for(int i=0;i<numVectorVariables;++i)
@@ -96,17 +152,24 @@ void SlicedScalarVectorDataValueBase::setScalarVariableName(int scalarVariableIn
 
 int SlicedScalarVectorDataValueBase::addScalarVariable(const char* newScalarVariableName)
 	{
-	/* Make room in the scalar variable array and copy the old variable names and create the new one: */
+	/* Make room in the scalar variable arrays and copy the old variable names and create the new one: */
 	char** newScalarVariableNames=new char*[numScalarVariables+1];
+	SliceLoader** newSliceLoaders=new SliceLoader*[numScalarVariables+1];
 	for(int i=0;i<numScalarVariables;++i)
+		{
 		newScalarVariableNames[i]=scalarVariableNames[i];
+		newSliceLoaders[i]=sliceLoaders[i];
+		}
 	newScalarVariableNames[numScalarVariables]=new char[strlen(newScalarVariableName)+1];
 	strcpy(newScalarVariableNames[numScalarVariables],newScalarVariableName);
+	newSliceLoaders[numScalarVariables]=0;
 	
-	/* Install the new scalar variable array: */
+	/* Install the new scalar variable arrays: */
 	delete[] scalarVariableNames;
+	delete[] sliceLoaders;
 	++numScalarVariables;
 	scalarVariableNames=newScalarVariableNames;
+	sliceLoaders=newSliceLoaders;
 	
 	return numScalarVariables-1;
 	}
@@ -149,6 +212,67 @@ void SlicedScalarVectorDataValueBase::setVectorVariableScalarIndex(int vectorVar
 	vectorVariableScalarIndices[vectorVariableIndex*numVectorComponents+componentIndex]=scalarVariableIndex;
 	}
 
+void SlicedScalarVectorDataValueBase::setSliceLoader(int scalarVariableIndex,SliceLoader* newSliceLoader)
+	{
+	sliceLoaders[scalarVariableIndex]=newSliceLoader;
+	}
+
+void SlicedScalarVectorDataValueBase::setMemoryBudget(size_t newMemoryBudget)
+	{
+	Threads::Mutex::Lock loaderLock(loaderMutex);
+	memoryBudget=newMemoryBudget;
+	releaseUnusedSlices();
+	}
+
+void SlicedScalarVectorDataValueBase::acquireScalarVariable(int scalarVariableIndex) const
+	{
+	SliceLoader* sl=sliceLoaders[scalarVariableIndex];
+	if(sl==0)
+		return;
+	
+	Threads::Mutex::Lock loaderLock(loaderMutex);
+	
+	/* Mark the variable as being accessed: */
+	++sl->numUsers;
+	sl->lastUseTime=++useCounter;
+	
+	if(!sl->loaded)
+		{
+		/* Read the variable's values: */
+		try
+			{
+			sl->memorySize=sl->loadSlices();
+			}
+		catch(...)
+			{
+			/* Release the partially loaded slices and bail out: */
+			sl->releaseSlices();
+			--sl->numUsers;
+			throw;
+			}
+		sl->loaded=true;
+		loadedMemorySize+=sl->memorySize;
+		
+		/* Make room for the new variable by releasing unused ones: */
+		releaseUnusedSlices();
+		}
+	}
+
+void SlicedScalarVectorDataValueBase::releaseScalarVariable(int scalarVariableIndex) const
+	{
+	SliceLoader* sl=sliceLoaders[scalarVariableIndex];
+	if(sl==0)
+		return;
+	
+	Threads::Mutex::Lock loaderLock(loaderMutex);
+	
+	/* Mark the variable as no longer accessed by one extractor; its values stay loaded until memory runs short: */
+	if(sl->numUsers>0)
+		--sl->numUsers;
+	if(sl->numUsers==0)
+		releaseUnusedSlices();
+	}
+
 }
 
 }
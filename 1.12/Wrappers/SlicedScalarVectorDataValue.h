@@ -24,6 +24,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_WRAPPERS_SLICEDSCALARVECTORDATAVALUE_INCLUDED
 #define VISUALIZATION_WRAPPERS_SLICEDSCALARVECTORDATAVALUE_INCLUDED
 
+#include <stddef.h>
+#include <Threads/Mutex.h>
 #include <Templatized/SlicedScalarExtractor.h>
 #include <Templatized/SlicedVectorExtractor.h>
 #include <Wrappers/DataValue.h>
@@ -32,8 +34,31 @@ namespace Visualization {
 
 namespace Wrappers {
 
-class SlicedScalarVectorDataValueBase // Base class managing variable naming and indexing
+class SlicedScalarVectorDataValueBase // Base class managing variable naming and indexing, and loading of deferred variables
 	{
+	/* Embedded classes: */
+	public:
+	class SliceLoader // Abstract base class for objects reading the values of one or more slices on demand
+		{
+		friend class SlicedScalarVectorDataValueBase;
+		
+		/* Elements: */
+		private:
+		bool loaded; // Flag if the loader's slices are currently allocated and filled
+		size_t memorySize; // Amount of memory used by the loader's slices while they are loaded
+		unsigned int numUsers; // Number of extractors currently accessing the loader's slices
+		unsigned int lastUseTime; // Value of the owning data value's use counter when the loader's slices were last requested
+		
+		/* Constructors and destructors: */
+		public:
+		SliceLoader(void);
+		virtual ~SliceLoader(void);
+		
+		/* Methods: */
+		virtual size_t loadSlices(void) =0; // Allocates the loader's slices and reads their values; returns the amount of allocated memory in bytes
+		virtual void releaseSlices(void) =0; // Releases the loader's slices
+		};
+	
 	/* Elements: */
 	private:
 	int numScalarVariables; // Number of scalar variables in the sliced data set
@@ -42,6 +67,14 @@ class SlicedScalarVectorDataValueBase // Base class managing variable naming and
 	int numVectorVariables; // Number of vector variables in the sliced data set
 	char** vectorVariableNames; // Array of names of the individual vector variables
 	int* vectorVariableScalarIndices; // 2D array of indices of scalar variables defining each vector variable
+	SliceLoader** sliceLoaders; // Array of loaders reading the values of deferred scalar variables on demand; 0 for variables whose values are always present
+	size_t memoryBudget; // Maximum amount of memory for loaded deferred variables before unused ones are released; 0 for no limit
+	mutable Threads::Mutex loaderMutex; // Mutex serializing loading and releasing of deferred variables
+	mutable size_t loadedMemorySize; // Amount of memory currently used by loaded deferred variables
+	mutable unsigned int useCounter; // Counter to order deferred variables by last use
+	
+	/* Private methods: */
+	void releaseUnusedSlices(void) const; // Releases least recently used deferred variables that are not accessed by any extractors until the memory budget is met; must be called with the loader mutex locked
 	
 	/* Constructors and destructors: */
 	public:
@@ -55,6 +88,10 @@ class SlicedScalarVectorDataValueBase // Base class managing variable naming and
 	void setVectorVariableName(int vectorVariableIndex,const char* newVectorVariableName); // Sets the given vector variable's name
 	int addVectorVariable(const char* newVectorVariableName); // Adds another vector variable
 	void setVectorVariableScalarIndex(int vectorVariableIndex,int componentIndex,int scalarVariableIndex); // Sets the index-th component of the given vector variable to the given scalar variable
+	void setSliceLoader(int scalarVariableIndex,SliceLoader* newSliceLoader); // Defers loading the values of the given scalar variable to the given loader; a loader filling several slices at once is set for each of their variables; data value takes ownership of the loader
+	void setMemoryBudget(size_t newMemoryBudget); // Sets the maximum amount of memory for loaded deferred variables in bytes; 0 disables releasing unused variables
+	void acquireScalarVariable(int scalarVariableIndex) const; // Loads the values of the given scalar variable if they are deferred and not loaded, and marks them as being accessed
+	void releaseScalarVariable(int scalarVariableIndex) const; // Marks the values of the given scalar variable as no longer being accessed by one extractor
 	int getNumScalarVariables(void) const
 		{
 		return numScalarVariables;
@@ -118,15 +155,42 @@ class SlicedScalarVectorDataValue:public SlicedScalarVectorDataValueBase,public
 	using SlicedScalarVectorDataValueBase::getVectorVariableName;
 	SE getScalarExtractor(int scalarVariableIndex) const
 		{
-		return SE(scalarVariableIndex,dataSet->getSliceArray(scalarVariableIndex));
+		/* Load the scalar variable's slice if it is deferred: */
+		acquireScalarVariable(scalarVariableIndex);
+		
+		/* Decode the slice on the fly if it is stored in compact form: */
+		const Visualization::Templatized::CompactSlice* compactSlice=dataSet->getCompactSlice(scalarVariableIndex);
+		if(compactSlice!=0)
+			return SE(scalarVariableIndex,compactSlice);
+		else
+			return SE(scalarVariableIndex,dataSet->getSliceArray(scalarVariableIndex));
+		}
+	void releaseScalarExtractor(int scalarVariableIndex) const // Notifies the data value that an extractor returned by getScalarExtractor has been destroyed
+		{
+		releaseScalarVariable(scalarVariableIndex);
 		}
 	VE getVectorExtractor(int vectorVariableIndex) const
 		{
 		VE result;
 		for(int i=0;i<dimension;++i)
-			result.setSlice(i,dataSet->getSliceArray(getVectorVariableScalarIndex(vectorVariableIndex,i)));
+			{
+			/* Load the vector component's slice if it is deferred: */
+			int scalarVariableIndex=getVectorVariableScalarIndex(vectorVariableIndex,i);
+			acquireScalarVariable(scalarVariableIndex);
+			
+			const Visualization::Templatized::CompactSlice* compactSlice=dataSet->getCompactSlice(scalarVariableIndex);
+			if(compactSlice!=0)
+				result.setSlice(i,compactSlice);
+			else
+				result.setSlice(i,dataSet->getSliceArray(scalarVariableIndex));
+			}
 		return result;
 		}
+	void releaseVectorExtractor(int vectorVariableIndex) const // Notifies the data value that an extractor returned by getVectorExtractor has been destroyed
+		{
+		for(int i=0;i<dimension;++i)
+			releaseScalarVariable(getVectorVariableScalarIndex(vectorVariableIndex,i));
+		}
 	};
 
 }